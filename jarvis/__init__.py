@@ -1,29 +1,49 @@
 """Jarvis calendar assistant package."""
 
-from .services.calendar_service import CalendarService
-from .logging import JarvisLogger, LogViewerGUI
-from .core import (
-    JarvisConfig,
-    JarvisSystem,
-    DEFAULT_PORT,
-    LOG_DB_PATH,
-    ExecutionResult,
-    BaseRegistry,
-    FunctionRegistry,
-)
-from .ai_clients import (
-    AIClientFactory,
-    BaseAIClient,
-    OpenAIClient,
-    AnthropicClient,
-)
-from .agents.agent_network import AgentNetwork
-from .agents.calendar_agent import CollaborativeCalendarAgent
-from .protocols import Protocol, ProtocolStep
-from .protocols.registry import ProtocolRegistry
-from .protocols.executor import ProtocolExecutor
-from .protocols.builder import create_from_file
-from .utils.performance import PerfTracker, track_async
+from importlib import import_module
+
+# Public names and the submodule each comes from.  They are imported on
+# first access, so importing a light submodule (e.g. the code analysis
+# collectors in a worker process) does not load every agent and AI SDK.
+_EXPORTS = {
+    "CalendarService": ".services.calendar_service",
+    "JarvisLogger": ".logging",
+    "LogViewerGUI": ".logging",
+    "JarvisConfig": ".core",
+    "JarvisSystem": ".core",
+    "DEFAULT_PORT": ".core",
+    "LOG_DB_PATH": ".core",
+    "ExecutionResult": ".core",
+    "BaseRegistry": ".core",
+    "FunctionRegistry": ".core",
+    "AIClientFactory": ".ai_clients",
+    "BaseAIClient": ".ai_clients",
+    "OpenAIClient": ".ai_clients",
+    "AnthropicClient": ".ai_clients",
+    "AgentNetwork": ".agents.agent_network",
+    "CollaborativeCalendarAgent": ".agents.calendar_agent",
+    "Protocol": ".protocols",
+    "ProtocolStep": ".protocols",
+    "ProtocolRegistry": ".protocols.registry",
+    "ProtocolExecutor": ".protocols.executor",
+    "create_from_file": ".protocols.builder",
+    "PerfTracker": ".utils.performance",
+    "track_async": ".utils.performance",
+}
+
+
+def __getattr__(name):
+    module = _EXPORTS.get(name)
+    if module is None:
+        raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+    value = getattr(import_module(module, __name__), name)
+    globals()[name] = value
+    return value
+
+
+def __dir__():
+    return sorted(set(globals()) | set(_EXPORTS))
+
 
 PicovoiceWakeWordListener = None
 OpenAITTSEngine = None
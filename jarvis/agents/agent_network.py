@@ -5,12 +5,13 @@ from __future__ import annotations
 import asyncio
 import time
 from enum import IntEnum
-from typing import Any, Dict, List, Optional, Tuple, TYPE_CHECKING
+from typing import Any, Dict, List, Optional, Set, Tuple, TYPE_CHECKING
 
 from ..logging import JarvisLogger
 from ..logging.tracer import get_tracer
 from ..protocols import InstructionProtocol
 from ..core.method_recorder import MethodRecorder
+from .dependency_health import DependencyHealth
 from .message import Message
 from .response_aggregator import ResponseAggregator, AggregationStrategy
 
@@ -76,6 +77,13 @@ class AgentNetwork:
             default_timeout=future_ttl,
         )
 
+        # Hard-dependency outages, for failing fast instead of timing out
+        self.dependency_health = DependencyHealth(logger=self.logger)
+
+        # Capability requests each provider is still handling, so an agent
+        # can be retired without cutting off work it already accepted
+        self._inflight: Dict[str, Set[asyncio.Task]] = {}
+
         # Metrics tracking
         self._metrics: Dict[str, Any] = {
             "direct_messages": 0,
@@ -134,10 +142,20 @@ class AgentNetwork:
             f"Capabilities: {agent.capabilities}",
         )
 
+        self._register_dependency_probes(agent)
+
         # If this agent has a 'protocols' attribute, register them
         if hasattr(agent, "protocols"):
             self.protocol_registry = list(getattr(agent, "protocols").keys())
 
+    def _register_dependency_probes(self, agent: NetworkAgent) -> None:
+        """Register the recovery probes *agent* offers for its own backend."""
+        probes = getattr(agent, "dependency_probes", None)
+        probes = probes() if callable(probes) else None
+        if isinstance(probes, dict):
+            for dependency, probe in probes.items():
+                self.dependency_health.register_probe(dependency, probe)
+
     def register_night_agent(
         self,
         agent: NetworkAgent,
@@ -166,6 +184,92 @@ class AgentNetwork:
                 else:
                     del self.capability_registry[capability]
 
+    def replace_agent(self, old: NetworkAgent, new: NetworkAgent) -> None:
+        """Swap a registered agent (e.g. a lazy stub) for its replacement.
+
+        Every name the old agent was registered under, aliases included,
+        now points at the new one.  Capability routing is keyed by agent
+        name, so it is only touched if the advertised set changed.  A lazy
+        stub has no backend to probe, so the replacement's dependency
+        probes are registered here.
+        """
+        old_caps = set(old.capabilities)
+        new_caps = set(new.capabilities)
+        for name, registered in list(self.agents.items()):
+            if registered is old:
+                self.agents[name] = new
+        new.set_network(self)
+        if old_caps != new_caps:
+            self.remove_agent_capabilities(old)
+            for capability in new_caps:
+                providers = self.capability_registry.setdefault(capability, [])
+                if new.name not in providers:
+                    providers.append(new.name)
+        self._register_dependency_probes(new)
+
+    def unregister_agent(self, agent: NetworkAgent) -> None:
+        """Remove an agent, its aliases and its capabilities from the network."""
+        self.remove_agent_capabilities(agent)
+        for name, registered in list(self.agents.items()):
+            if registered is agent:
+                del self.agents[name]
+
+    async def retire_agent(self, agent: NetworkAgent, drain_timeout: float = 10.0) -> bool:
+        """Unregister *agent* once the requests it is handling have finished.
+
+        Capabilities are withdrawn first so no new request is routed to
+        it; requests already dispatched run to completion (up to
+        *drain_timeout*).  Returns False if some were still running when
+        the timeout expired.
+        """
+        self.remove_agent_capabilities(agent)
+        pending = [
+            task
+            for name, registered in self.agents.items()
+            if registered is agent
+            for task in self._inflight.get(name, ())
+        ]
+        drained = True
+        if pending:
+            _, still_running = await asyncio.wait(pending, timeout=drain_timeout)
+            drained = not still_running
+            if still_running:
+                self.logger.log(
+                    "WARNING",
+                    f"Retired {agent.name} with requests in flight",
+                    f"{len(still_running)} did not finish in {drain_timeout}s",
+                )
+        self.unregister_agent(agent)
+        return drained
+
+    def inflight_count(self, name: str) -> int:
+        """Capability requests *name* is currently handling."""
+        return len(self._inflight.get(name, ()))
+
+    def _dispatch(self, provider: str, message: Message) -> None:
+        task = asyncio.create_task(self.agents[provider].receive_message(message))
+        tasks = self._inflight.setdefault(provider, set())
+        tasks.add(task)
+        task.add_done_callback(tasks.discard)
+
+    async def get_agent(self, name: str) -> Optional[NetworkAgent]:
+        """Return the agent registered as *name*, building it if it is lazy."""
+        agent = self.agents.get(name)
+        if getattr(agent, "is_materialized", None) is not False:
+            return agent
+        try:
+            return await agent.materialize()
+        except RuntimeError:
+            return None
+
+    def lazy_agents(self) -> List[NetworkAgent]:
+        """Registered agents that have not been built yet."""
+        seen: List[NetworkAgent] = []
+        for agent in self.agents.values():
+            if getattr(agent, "is_materialized", True) is False and agent not in seen:
+                seen.append(agent)
+        return seen
+
     def _get_message_priority(self, message: Message) -> MessagePriority:
         """Determine message priority based on type."""
         if message.message_type in ("capability_response", "error"):
@@ -187,10 +291,8 @@ class AgentNetwork:
         # Fast-path: Direct messages to known agents bypass queue
         if message.to_agent and message.to_agent in self.agents:
             try:
-                # Try immediate delivery (non-blocking)
-                agent = self.agents[message.to_agent]
-                # Use create_task for async delivery without blocking
-                asyncio.create_task(agent.receive_message(message))
+                # Immediate, non-blocking delivery
+                self._dispatch(message.to_agent, message)
                 self._metrics["direct_messages"] += 1
                 self.logger.log(
                     "DEBUG",
@@ -316,6 +418,7 @@ class AgentNetwork:
                 await self._cleanup_task
             except asyncio.CancelledError:
                 pass
+        await self.dependency_health.stop()
         await self.response_aggregator.stop()
         self.logger.log("INFO", "Network stopped")
 
@@ -445,6 +548,7 @@ class AgentNetwork:
 
     async def _handle_capability_response(self, message: Message) -> None:
         """Handle capability response message - fulfill future and optionally deliver to agent."""
+        self.dependency_health.observe_reply(message.from_agent, message.content)
         fut_data = self._response_futures.get(message.request_id)
 
         if fut_data:
@@ -470,6 +574,7 @@ class AgentNetwork:
 
     async def _handle_error_message(self, message: Message) -> None:
         """Handle error message - fulfill future and deliver to agent."""
+        self.dependency_health.observe_reply(message.from_agent, message.content)
         fut_data = self._response_futures.get(message.request_id)
         if fut_data:
             fut, _ = fut_data
@@ -504,6 +609,10 @@ class AgentNetwork:
         if providers:
             for provider in providers:
                 if provider in self.agents:
+                    blocked = self.dependency_health.blocking_dependency(provider)
+                    if blocked:
+                        await self._fail_fast(message, provider, blocked)
+                        continue
                     # Reuse message content instead of full clone
                     cloned = Message(
                         from_agent=message.from_agent,
@@ -516,9 +625,28 @@ class AgentNetwork:
                         parent_span_id=message.parent_span_id,
                     )
                     # Create individual tasks for parallel execution
-                    asyncio.create_task(self.agents[provider].receive_message(cloned))
+                    self._dispatch(provider, cloned)
                     self._metrics["broadcast_messages"] += 1
 
+    async def _fail_fast(self, message: Message, provider: str, dependency: str) -> None:
+        """Answer for *provider* without dispatching: its backend is down."""
+        self.logger.log(
+            "INFO",
+            f"Failing fast: {provider} needs {dependency}",
+            f"capability={message.content.get('capability')} req={message.request_id}",
+        )
+        reply = Message(
+            from_agent=provider,
+            to_agent=message.from_agent,
+            message_type="capability_response",
+            content=self.dependency_health.fail_fast_response(provider, dependency),
+            request_id=message.request_id,
+            reply_to=message.id,
+            trace_id=message.trace_id,
+            parent_span_id=message.parent_span_id,
+        )
+        await self._handle_capability_response(reply)
+
     async def request_capability(
         self,
         from_agent: str,
@@ -695,4 +823,5 @@ class AgentNetwork:
             "backpressure_threshold": self._backpressure_threshold,
             "circuit_breaker_active": self._circuit_breaker_active,
             "response_aggregator": self.response_aggregator.get_stats(),
+            "dependency_health": self.dependency_health.get_stats(),
         }
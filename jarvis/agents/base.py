@@ -11,6 +11,7 @@ from ..services.vector_memory import VectorMemoryService
 
 from .message import Message
 from .agent_network import AgentNetwork
+from .dialogue import context_messages
 from ..logging import JarvisLogger
 from ..logging.tracer import get_tracer, SpanKind
 
@@ -66,18 +67,22 @@ class NetworkAgent:
         """Generate a dialogue response using the agent's AI client.
 
         Called by the messaging layer when a capability request contains
-        ``dialogue_context``.  Builds an LLM prompt from the transcript,
-        goal, and current message, then asks the AI for a JSON reply with
-        ``message`` and ``done`` fields.
+        ``dialogue_context``.  The system prompt depends only on the goal
+        and capability, so it is identical on every turn; earlier turns
+        follow as chat messages (see ``dialogue.context_messages``) and the
+        AI is asked for a JSON reply with ``message``, ``done`` and optional
+        ``data`` fields.
 
         Args:
             message: The current turn's message from the initiator.
-            dialogue_context: Dict with ``goal``, ``transcript``, and
-                ``capability`` describing the ongoing dialogue.
+            dialogue_context: Dict with ``goal``, ``capability``, ``summary``
+                and ``turns`` describing the ongoing dialogue (a legacy
+                ``transcript`` string is also accepted).
 
         Returns:
             Dict with keys ``dialogue_message``, ``dialogue_done``,
-            ``response``, and ``success``.
+            ``response``, and ``success``, plus ``dialogue_data`` when the
+            reply carried structured results.
         """
         ai_client = getattr(self, "ai_client", None)
         if ai_client is None:
@@ -89,7 +94,6 @@ class NetworkAgent:
             }
 
         goal = dialogue_context.get("goal", "")
-        transcript = dialogue_context.get("transcript", "")
         capability = dialogue_context.get("capability", "")
 
         system_prompt = (
@@ -99,40 +103,42 @@ class NetworkAgent:
             "You are having a conversation with the lead agent. "
             "Respond helpfully based on your expertise.\n\n"
             "Reply with ONLY a JSON object (no markdown fences):\n"
-            '{"message": "your response text", "done": true/false}\n\n'
+            '{"message": "your response text", "done": true/false, "data": {...}}\n\n'
+            "Put structured results (values, lists, IDs) in \"data\" instead of "
+            "restating them in prose; omit it when there are none. "
             "Set \"done\" to true when the conversation goal is satisfied "
             "or you have nothing more to add."
         )
 
         messages: List[Dict[str, Any]] = [
             {"role": "system", "content": system_prompt},
+            *context_messages(dialogue_context, self.name),
+            {"role": "user", "content": message},
         ]
 
-        if transcript:
-            messages.append(
-                {"role": "system", "content": f"Dialogue so far:\n{transcript}"}
-            )
-
-        messages.append({"role": "user", "content": message})
-
         try:
             resp_msg, _ = await ai_client.strong_chat(messages, [])
             content = resp_msg.content if hasattr(resp_msg, "content") else str(resp_msg)
 
+            dialogue_data = None
             try:
                 parsed = json.loads(content)
                 dialogue_message = parsed.get("message", content)
                 dialogue_done = bool(parsed.get("done", False))
-            except (json.JSONDecodeError, TypeError):
+                dialogue_data = parsed.get("data") or None
+            except (json.JSONDecodeError, TypeError, AttributeError):
                 dialogue_message = content
                 dialogue_done = False
 
-            return {
+            result = {
                 "dialogue_message": dialogue_message,
                 "dialogue_done": dialogue_done,
                 "response": dialogue_message,
                 "success": True,
             }
+            if dialogue_data is not None:
+                result["dialogue_data"] = dialogue_data
+            return result
         except Exception as exc:
             return {
                 "dialogue_message": f"Error generating dialogue response: {exc}",
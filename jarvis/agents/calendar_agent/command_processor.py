@@ -1,12 +1,15 @@
 # jarvis/agents/calendar_agent/command_processor.py
-from typing import Dict, Any, List
+from typing import Dict, Any, List, Optional
 import json
+import time
 from ...ai_clients import BaseAIClient
 from ...services.calendar_service import CalendarService
 from ...logging import JarvisLogger
 from ...utils import safe_json_dumps
 from .prompt import get_calendar_system_prompt
 from .function_registry import CalendarFunctionRegistry
+from .grammar import build_grammar
+from ..command_grammar import FastPathStats, elapsed_ms
 from ..response import AgentResponse, ErrorInfo
 
 
@@ -20,6 +23,7 @@ class CalendarCommandProcessor:
         function_registry: CalendarFunctionRegistry,
         tools: List[Dict[str, Any]],
         logger: JarvisLogger | None = None,
+        fast_path: bool = True,
     ):
         self.ai_client = ai_client
         self.calendar_service = calendar_service
@@ -27,6 +31,9 @@ class CalendarCommandProcessor:
         self.tools = tools
         self.logger = logger
         self.system_prompt = get_calendar_system_prompt()
+        # Plain "what's on today"-style lookups skip the LLM entirely
+        self.grammar = build_grammar(tools) if fast_path else None
+        self.fast_path_stats = FastPathStats()
 
     async def execute_function(
         self, function_name: str, arguments: Dict[str, Any]
@@ -72,12 +79,37 @@ class CalendarCommandProcessor:
                 )
             return error
 
+    async def _try_fast_path(self, command: str, started: float) -> Optional[Dict[str, Any]]:
+        """Answer *command* directly when the grammar recognizes it."""
+        match = self.grammar.match(command) if self.grammar else None
+        if match is None or not self.function_registry.get_function(match.tool):
+            return None
+        result = await self.execute_function(match.tool, dict(match.arguments))
+        if isinstance(result, dict) and "error" in result:
+            response_text = f"I couldn't check your calendar: {result['error']}"
+        else:
+            response_text = match.rule.reply(match.arguments, result)
+        self.fast_path_stats.record_fast(match.command_class, elapsed_ms(started))
+        if self.logger:
+            self.logger.log("INFO", "Calendar fast path", match.tool)
+        actions = [{"function": match.tool, "arguments": match.arguments, "result": result}]
+        return self._build_result(
+            response_text,
+            actions,
+            {"fast_path": True, "command_class": match.command_class},
+        )
+
     async def process_command(self, command: str) -> Dict[str, Any]:
         """Process a natural language calendar command using AI"""
         if self.logger:
             self.logger.log("DEBUG", "Processing NL command", command)
 
+        started = time.perf_counter()
         try:
+            fast = await self._try_fast_path(command, started)
+            if fast is not None:
+                return fast
+
             current_date = self.calendar_service.current_date()
             messages = [
                 {
@@ -163,32 +195,11 @@ class CalendarCommandProcessor:
             if self.logger:
                 self.logger.log("INFO", "NL command result", response_text)
 
-            # Check if any actions resulted in errors
-            has_errors = any("error" in action.get("result", {}) for action in actions_taken)
-            
-            if has_errors:
-                # Extract the first error for error info
-                error_action = next(
-                    (action for action in actions_taken if "error" in action.get("result", {})),
-                    None
-                )
-                error_msg = error_action["result"]["error"] if error_action else "Unknown error"
-                
-                # Return error response
-                return AgentResponse.error_response(
-                    response=response_text,
-                    error=ErrorInfo(
-                        message=error_msg,
-                        error_type="FunctionExecutionError",
-                    ),
-                    actions=actions_taken,
-                ).to_dict()
-            
-            # Return standardized success response
-            return AgentResponse.success_response(
-                response=response_text,
-                actions=actions_taken,
-            ).to_dict()
+            self.fast_path_stats.record_llm(
+                actions_taken[0]["function"] if actions_taken else "conversation",
+                elapsed_ms(started),
+            )
+            return self._build_result(response_text, actions_taken)
 
         except Exception as e:
             error_msg = f"Error processing command: {str(e)}"
@@ -200,3 +211,45 @@ class CalendarCommandProcessor:
                 response=error_msg,
                 error=ErrorInfo.from_exception(e),
             ).to_dict()
+
+    def _build_result(
+        self,
+        response_text: str,
+        actions_taken: List[Dict[str, Any]],
+        metadata: Optional[Dict[str, Any]] = None,
+    ) -> Dict[str, Any]:
+        """Turn the reply and executed actions into an AgentResponse dict."""
+        # Check if any actions resulted in errors
+        has_errors = any(
+            isinstance(action.get("result"), dict) and "error" in action["result"]
+            for action in actions_taken
+        )
+
+        if has_errors:
+            # Extract the first error for error info
+            error_action = next(
+                (
+                    action
+                    for action in actions_taken
+                    if isinstance(action.get("result"), dict) and "error" in action["result"]
+                ),
+                None,
+            )
+            error_msg = error_action["result"]["error"] if error_action else "Unknown error"
+
+            # Return error response
+            return AgentResponse.error_response(
+                response=response_text,
+                error=ErrorInfo(
+                    message=error_msg,
+                    error_type="FunctionExecutionError",
+                ),
+                actions=actions_taken,
+            ).to_dict()
+
+        # Return standardized success response
+        return AgentResponse.success_response(
+            response=response_text,
+            actions=actions_taken,
+            metadata=metadata,
+        ).to_dict()
@@ -0,0 +1,95 @@
+# jarvis/agents/calendar_agent/grammar.py
+"""Phrase rules for the calendar command fast path (read-only lookups).
+
+Only questions with one obvious tool call and no arguments are covered;
+anything that creates, moves or filters events still goes through the
+model.  Replies are rendered from the tool result here, so a fast-path
+answer reads like the model's summary without the round trip.
+"""
+from datetime import date, datetime
+from typing import Any, Dict, List, Optional
+
+from ..command_grammar import CommandGrammar, Rule
+from .tools.tools import tools
+
+_WHAT = r"what(?:'s| is|s)"
+_THINGS = r"(?:events|schedule|calendar|agenda|meetings|appointments|plans)"
+
+
+def _day_patterns(day: str) -> tuple:
+    return (
+        rf"{_WHAT} (?:on )?(?:my (?:calendar|schedule|agenda) )?(?:for )?{day}",
+        rf"{_WHAT} (?:on )?my (?:calendar|schedule|agenda) (?:for |looking like )?{day}",
+        rf"what do i have(?: on| going on| planned)? {day}",
+        rf"(?:show|list|read|tell|give)(?: me)? (?:my )?{day}'s {_THINGS}",
+        rf"(?:show|list|read|tell|give)(?: me)? (?:my )?{_THINGS} (?:for )?{day}",
+        rf"{day}'s {_THINGS}",
+        rf"(?:do i have )?any {_THINGS} {day}",
+    )
+
+
+def _clock(value: Optional[str]) -> str:
+    if not value:
+        return ""
+    try:
+        dt = datetime.fromisoformat(str(value).replace(" ", "T"))
+    except ValueError:
+        return str(value)
+    return f"{dt.hour % 12 or 12}:{dt.minute:02d} {'AM' if dt.hour < 12 else 'PM'}"
+
+
+def _describe(event: Dict[str, Any]) -> str:
+    title = event.get("title") or "an untitled event"
+    when = _clock(event.get("time"))
+    return f"{title} at {when}" if when else title
+
+
+def _join(items: List[str]) -> str:
+    if len(items) <= 1:
+        return "".join(items)
+    return ", ".join(items[:-1]) + f" and {items[-1]}"
+
+
+def _day_reply(day: str):
+    def reply(args: Dict[str, Any], result: Any) -> str:
+        events = result.get("events", []) if isinstance(result, dict) else list(result or [])
+        if not events:
+            return f"You have nothing on your calendar {day}."
+        events = sorted(events, key=lambda e: str(e.get("time") or ""))
+        noun = "event" if len(events) == 1 else "events"
+        shown = [_describe(e) for e in events[:5]]
+        more = f", plus {len(events) - 5} more" if len(events) > 5 else ""
+        return f"You have {len(events)} {noun} {day}: {_join(shown)}{more}."
+    return reply
+
+
+def _next_reply(args: Dict[str, Any], result: Any) -> str:
+    if not result:
+        return "You don't have any upcoming events."
+    text = f"Your next event is {_describe(result)}"
+    try:
+        when = datetime.fromisoformat(str(result.get("time")).replace(" ", "T")).date()
+    except (TypeError, ValueError):
+        return text + "."
+    if when != date.today():
+        text += f" on {when.strftime('%A, %B')} {when.day}"
+    return text + "."
+
+
+def build_grammar(tool_schemas: List[Dict[str, Any]] = tools) -> CommandGrammar:
+    """Compile the rules whose tool is in *tool_schemas*."""
+    names = {t["function"]["name"] for t in tool_schemas}
+    rules = [
+        Rule("get_today_events", _day_patterns("today"), _day_reply("today")),
+        Rule("get_tomorrow_events", _day_patterns("tomorrow"), _day_reply("tomorrow")),
+        Rule(
+            "get_next_event",
+            (
+                rf"{_WHAT} (?:my )?next (?:event|meeting|appointment)",
+                r"when is my next (?:event|meeting|appointment)",
+                rf"{_WHAT} next(?: on my (?:calendar|schedule|agenda))?",
+            ),
+            _next_reply,
+        ),
+    ]
+    return CommandGrammar(tool_schemas, [r for r in rules if r.tool in names])
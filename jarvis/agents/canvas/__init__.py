@@ -13,6 +13,19 @@ from ...logging import JarvisLogger
 class CanvasAgent(NetworkAgent):
     """Agent that interfaces with Canvas LMS to fetch courses, assignments, to-dos, calendar events, messages, and notifications."""
 
+    CAPABILITIES = frozenset({
+        "get_courses",
+        "get_current_courses",
+        "get_enrollments",
+        "get_course_assignments",
+        "get_todo",
+        "get_calendar_events",
+        "get_notifications",
+        "get_messages",
+        "get_homework_summary",
+        "get_comprehensive_homework",
+    })
+
     def __init__(
         self,
         ai_client: BaseAIClient,
@@ -1,7 +1,9 @@
 from __future__ import annotations
 
+import asyncio
 import json
-from typing import Any, Dict, List, Optional, Set
+import time
+from typing import Any, Dict, List, Optional, Set, Tuple
 
 from ..base import NetworkAgent
 from ..collaboration import CollaborationMixin
@@ -9,6 +11,7 @@ from ..message import Message
 from ...ai_clients.base import BaseAIClient
 from ...core.mission import MissionBrief
 from ...logging import JarvisLogger
+from ...logging.tracer import get_tracer, SpanKind, NullSpan
 from ...core.profile import AgentProfile
 from .tools import tools as chat_tools
 from ..response import AgentResponse, ErrorInfo
@@ -21,12 +24,19 @@ class ChatAgent(NetworkAgent, CollaborationMixin):
     uses CollaborationMixin._execute_as_lead() for multi-agent coordination.
     """
 
+    # Tools with no side effects: safe to memoize within a single chat turn.
+    READ_ONLY_TOOLS: Set[str] = {"get_facts"}
+    # Per-tool execution timeout (seconds) inside the tool-calling loop.
+    DEFAULT_TOOL_TIMEOUT = 15.0
+
     def __init__(
         self, ai_client: BaseAIClient, logger: Optional[JarvisLogger] = None
     ) -> None:
         super().__init__("ChatAgent", logger, memory=None, profile=AgentProfile())
         self.ai_client = ai_client
         self.feedback_collector = None  # set externally by system/builder
+        self.model_cascade = None  # set externally when cascade is enabled
+        self.tool_timeout = self.DEFAULT_TOOL_TIMEOUT
         self.tools = chat_tools
         self.intent_map = {
             "chat": self._process_chat,
@@ -136,11 +146,19 @@ class ChatAgent(NetworkAgent, CollaborationMixin):
     # ------------------------------------------------------------------
     # Chat processing
     # ------------------------------------------------------------------
-    def _build_correction_block(self, user_id: Optional[int] = None) -> str:
-        """Build a correction-log addendum for the system prompt."""
+    def _build_correction_block(
+        self, user_id: Optional[int] = None, user_input: Optional[str] = None
+    ) -> str:
+        """Build a correction-log addendum for the system prompt.
+
+        Corrections most similar to *user_input* are preferred over merely
+        recent ones.
+        """
         if not self.feedback_collector:
             return ""
-        corrections = self.feedback_collector.get_corrections(limit=10, user_id=user_id)
+        corrections = self.feedback_collector.get_corrections(
+            limit=10, user_id=user_id, query=user_input
+        )
         if not corrections:
             return ""
         lines = [
@@ -159,7 +177,7 @@ class ChatAgent(NetworkAgent, CollaborationMixin):
         try:
             # Inject correction history into system prompt
             user_id = getattr(self, "current_user_id", None)
-            effective_prompt = self.system_prompt + self._build_correction_block(user_id)
+            effective_prompt = self.system_prompt + self._build_correction_block(user_id, user_input)
 
             messages: List[Dict[str, Any]] = [
                 {"role": "system", "content": effective_prompt},
@@ -185,42 +203,72 @@ class ChatAgent(NetworkAgent, CollaborationMixin):
             iterations = 0
             message = None
             tool_calls = None
+            # Read-only tool results are memoized for the rest of this turn
+            # (invalidated whenever a mutating tool runs).
+            turn_cache: Dict[str, Any] = {}
+            # Once the cascade escalates, stay on the strong model this turn
+            use_strong = False
+            # Weak-served cascade calls, so feedback on this turn finds them
+            cascade_keys: List[Any] = []
+            tracer = get_tracer()
 
             while iterations < 5:
-                message, tool_calls = await self.ai_client.strong_chat(messages, self.tools)
-                if not tool_calls:
-                    break
-
-                # Build assistant message with tool_calls
-                # OpenAI requires tool_calls field when there are tool messages following
-                content = message.content if message.content is not None else ""
-                assistant_msg = {
-                    "role": "assistant",
-                    "content": content,
-                    "tool_calls": [
-                        {
-                            "id": call.id,
-                            "type": "function",
-                            "function": {
-                                "name": call.function.name,
-                                "arguments": call.function.arguments,
-                            },
-                        }
-                        for call in tool_calls
-                    ],
-                }
-                messages.append(assistant_msg)
-
-                for call in tool_calls:
-                    fn = call.function.name
-                    try:
-                        args = json.loads(call.function.arguments)
-                    except (json.JSONDecodeError, TypeError):
-                        args = {}
-                        result = {
-                            "error": f"Invalid arguments for {fn}: "
-                            f"{call.function.arguments!r}"
-                        }
+                span = (
+                    tracer.span(
+                        "chat.iteration",
+                        kind=SpanKind.AGENT,
+                        agent_name=self.name,
+                        attributes={"iteration": iterations},
+                    )
+                    if tracer
+                    else NullSpan()
+                )
+                async with span as s:
+                    llm_start = time.perf_counter()
+                    if self.model_cascade:
+                        outcome = await self.model_cascade.chat(
+                            "chat", messages, self.tools,
+                            capability="chat", force_strong=use_strong,
+                        )
+                        message, tool_calls = outcome.message, outcome.tool_calls
+                        use_strong = outcome.tier == "strong"
+                        if outcome.key and outcome.key not in cascade_keys:
+                            cascade_keys.append(outcome.key)
+                    else:
+                        message, tool_calls = await self.ai_client.strong_chat(
+                            messages, self.tools
+                        )
+                    llm_ms = (time.perf_counter() - llm_start) * 1000
+                    if not tool_calls:
+                        s.record_output({"llm_ms": round(llm_ms, 2), "tool_calls": 0})
+                        break
+
+                    # Build assistant message with tool_calls
+                    # OpenAI requires tool_calls field when there are tool messages following
+                    content = message.content if message.content is not None else ""
+                    assistant_msg = {
+                        "role": "assistant",
+                        "content": content,
+                        "tool_calls": [
+                            {
+                                "id": call.id,
+                                "type": "function",
+                                "function": {
+                                    "name": call.function.name,
+                                    "arguments": call.function.arguments,
+                                },
+                            }
+                            for call in tool_calls
+                        ],
+                    }
+                    messages.append(assistant_msg)
+
+                    tools_start = time.perf_counter()
+                    tool_results = await self._execute_tool_calls(tool_calls, turn_cache)
+                    tools_ms = (time.perf_counter() - tools_start) * 1000
+
+                    # Results come back in call order regardless of completion order
+                    for call, fn, args, result in tool_results:
                         actions.append({"function": fn, "arguments": args, "result": result})
                         messages.append(
                             {
@@ -229,17 +277,11 @@ class ChatAgent(NetworkAgent, CollaborationMixin):
                                 "content": json.dumps(result),
                             }
                         )
-                        continue
-                    try:
-                        result = await self.run_capability(fn, **args)
-                    except Exception as exc:
-                        result = {"error": str(exc)}
-                    actions.append({"function": fn, "arguments": args, "result": result})
-                    messages.append(
+                    s.record_output(
                         {
-                            "role": "tool",
-                            "tool_call_id": call.id,
-                            "content": json.dumps(result),
+                            "llm_ms": round(llm_ms, 2),
+                            "tools_ms": round(tools_ms, 2),
+                            "tool_calls": len(tool_calls),
                         }
                     )
                 iterations += 1
@@ -299,6 +341,7 @@ class ChatAgent(NetworkAgent, CollaborationMixin):
             return AgentResponse.success_response(
                 response=response_text,
                 actions=actions,
+                metadata={"cascade_keys": cascade_keys} if cascade_keys else None,
             ).to_dict()
         
         except Exception as e:
@@ -315,6 +358,78 @@ class ChatAgent(NetworkAgent, CollaborationMixin):
                 ),
             ).to_dict()
 
+    async def _execute_tool_calls(
+        self, tool_calls: List[Any], turn_cache: Dict[str, Any]
+    ) -> List[Tuple[Any, str, Dict[str, Any], Any]]:
+        """Execute one iteration's tool calls and return results in call order.
+
+        Consecutive calls of the same kind (read-only vs. mutating) are run
+        concurrently as one wave; a change of kind starts a new wave so reads
+        always observe earlier writes from the same batch.
+        """
+        waves: List[List[Tuple[int, Any]]] = []
+        wave_read_only: Optional[bool] = None
+        for index, call in enumerate(tool_calls):
+            read_only = call.function.name in self.READ_ONLY_TOOLS
+            if not waves or read_only != wave_read_only:
+                waves.append([])
+                wave_read_only = read_only
+            waves[-1].append((index, call))
+
+        results: List[Any] = [None] * len(tool_calls)
+        for wave in waves:
+            outcomes = await asyncio.gather(
+                *[self._execute_tool_call(call, turn_cache) for _, call in wave]
+            )
+            for (index, _), outcome in zip(wave, outcomes):
+                results[index] = outcome
+        return results
+
+    async def _execute_tool_call(
+        self, call: Any, turn_cache: Dict[str, Any]
+    ) -> Tuple[Any, str, Dict[str, Any], Any]:
+        """Run a single tool call with a timeout and per-turn memoization."""
+        fn = call.function.name
+        try:
+            args = json.loads(call.function.arguments)
+        except (json.JSONDecodeError, TypeError):
+            return call, fn, {}, {
+                "error": f"Invalid arguments for {fn}: "
+                f"{call.function.arguments!r}"
+            }
+        if not isinstance(args, dict):
+            return call, fn, {}, {
+                "error": f"Invalid arguments for {fn}: "
+                f"{call.function.arguments!r}"
+            }
+
+        if fn not in self.READ_ONLY_TOOLS:
+            result = await self._run_tool(fn, args)
+            # A write may change what reads return; drop memoized reads
+            turn_cache.clear()
+            return call, fn, args, result
+
+        # Memoize the in-flight task so identical reads in one wave share it
+        cache_key = f"{fn}:{json.dumps(args, sort_keys=True, default=str)}"
+        task = turn_cache.get(cache_key)
+        if task is None:
+            task = asyncio.ensure_future(self._run_tool(fn, args))
+            turn_cache[cache_key] = task
+        result = await task
+        if isinstance(result, dict) and "error" in result:
+            turn_cache.pop(cache_key, None)
+        return call, fn, args, result
+
+    async def _run_tool(self, fn: str, args: Dict[str, Any]) -> Any:
+        try:
+            return await asyncio.wait_for(
+                self.run_capability(fn, **args), timeout=self.tool_timeout
+            )
+        except asyncio.TimeoutError:
+            return {"error": f"{fn} timed out after {self.tool_timeout}s"}
+        except Exception as exc:
+            return {"error": str(exc)}
+
     # ------------------------------------------------------------------
     # Tool implementations
     # ------------------------------------------------------------------
@@ -8,6 +8,7 @@ from __future__ import annotations
 
 import asyncio
 import json
+import time
 import uuid
 from typing import Any, Dict, List
 
@@ -18,7 +19,13 @@ from ..core.errors import (
     DialogueError,
 )
 from ..core.mission import MissionBrief
-from .dialogue import DialogueSession, DialogueStatus
+from .dialogue import (
+    DEFAULT_CONTEXT_TOKENS,
+    DialogueSession,
+    DialogueStatus,
+    context_messages,
+    estimate_tokens,
+)
 from .response import AgentResponse
 
 
@@ -264,6 +271,9 @@ class CollaborationMixin:
         iterations = 0
         max_iterations = brief.budget.max_recruitments + 3  # Allow some extra for own tools
         response_message = None
+        cascade = getattr(self, "model_cascade", None)
+        use_strong = False
+        cascade_keys: List[Any] = []
 
         while iterations < max_iterations:
             # Check deadline each iteration
@@ -273,10 +283,23 @@ class CollaborationMixin:
             # Wrap LLM call with budget timeout to prevent API hangs
             llm_timeout = brief.budget.time_remaining
             try:
-                response_message, tool_calls = await asyncio.wait_for(
-                    self.ai_client.strong_chat(messages, tools),
-                    timeout=llm_timeout if llm_timeout > 0 else 0.1,
-                )
+                if cascade:
+                    outcome = await asyncio.wait_for(
+                        cascade.chat(
+                            "lead", messages, tools,
+                            capability=brief.lead_capability, force_strong=use_strong,
+                        ),
+                        timeout=llm_timeout if llm_timeout > 0 else 0.1,
+                    )
+                    response_message, tool_calls = outcome.message, outcome.tool_calls
+                    use_strong = outcome.tier == "strong"
+                    if outcome.key and outcome.key not in cascade_keys:
+                        cascade_keys.append(outcome.key)
+                else:
+                    response_message, tool_calls = await asyncio.wait_for(
+                        self.ai_client.strong_chat(messages, tools),
+                        timeout=llm_timeout if llm_timeout > 0 else 0.1,
+                    )
             except asyncio.TimeoutError:
                 break
             if not tool_calls:
@@ -358,6 +381,8 @@ class CollaborationMixin:
         }
         if brief.budget.is_expired:
             metadata["budget_expired"] = True
+        if cascade_keys:
+            metadata["cascade_keys"] = cascade_keys
 
         return AgentResponse.success_response(
             response=response_text,
@@ -445,11 +470,14 @@ class CollaborationMixin:
         brief: MissionBrief,
         max_turns: int = 5,
         timeout_per_turn: float | None = None,
+        context_tokens: int = DEFAULT_CONTEXT_TOKENS,
     ) -> DialogueSession:
         """Conduct a multi-turn dialogue with a specialist agent.
 
         Each turn to the responder costs 1 ``remaining_recruitment`` from
-        the budget.  Each lead follow-up costs 1 LLM call.
+        the budget.  Each lead follow-up costs 1 LLM call, which also
+        decides whether to conclude; a responder that signals ``done`` or
+        repeats itself ends the dialogue without one.
 
         Args:
             capability: The capability that identifies the responder agent.
@@ -458,6 +486,7 @@ class CollaborationMixin:
             brief: Current mission brief (budget + context).
             max_turns: Maximum number of *responder* turns allowed.
             timeout_per_turn: Per-turn timeout (defaults to budget time_remaining).
+            context_tokens: Turn budget before older turns are summarized.
 
         Returns:
             A ``DialogueSession`` with the full transcript and final status.
@@ -497,6 +526,8 @@ class CollaborationMixin:
         )
 
         current_message = initial_message
+        started = time.perf_counter()
+        session.stats = {"context_tokens": 0, "lead_prompt_tokens": 0, "lead_llm_calls": 0}
 
         try:
             for turn_idx in range(max_turns):
@@ -517,6 +548,13 @@ class CollaborationMixin:
                     else budget.time_remaining
                 )
 
+                # Everything before the message being sent, summarized if long
+                session.compact(context_tokens)
+                dialogue_context = session.context(upto=session.turn_count - 1)
+                session.stats["context_tokens"] += estimate_tokens(
+                    json.dumps(dialogue_context, default=str)
+                )
+
                 request_id = str(uuid.uuid4())
                 try:
                     result = await self._request_and_wait_for_agent(
@@ -524,11 +562,7 @@ class CollaborationMixin:
                         data={
                             "prompt": current_message,
                             "input": current_message,
-                            "dialogue_context": {
-                                "goal": goal,
-                                "transcript": session.format_transcript(),
-                                "capability": capability,
-                            },
+                            "dialogue_context": dialogue_context,
                         },
                         request_id=request_id,
                         timeout=effective_timeout,
@@ -552,12 +586,18 @@ class CollaborationMixin:
                 finally:
                     self.active_tasks.pop(request_id, None)
 
-                # Record responder turn
+                # Record responder turn (structured results kept as data)
                 responder_msg = self._extract_dialogue_response(result)
-                session.add_turn(provider_agent, responder_msg)
+                responder_data = self._extract_dialogue_data(result)
+                if responder_data is not None:
+                    session.add_turn(provider_agent, responder_msg, data=responder_data)
+                else:
+                    session.add_turn(provider_agent, responder_msg)
 
-                # Check if responder signalled completion
-                if self._extract_dialogue_done_signal(result):
+                # Check if responder signalled completion or is going in circles
+                if self._extract_dialogue_done_signal(result) or self._dialogue_stalled(
+                    session, provider_agent
+                ):
                     session.status = DialogueStatus.COMPLETED
                     break
 
@@ -584,6 +624,8 @@ class CollaborationMixin:
             session.status = DialogueStatus.ERROR
             session.add_turn(self.name, f"[dialogue error: {exc}]", error=str(exc))
 
+        session.stats["elapsed_ms"] = round((time.perf_counter() - started) * 1000, 1)
+
         # Record full transcript in mission context
         context.add_result(
             provider_agent,
@@ -592,6 +634,7 @@ class CollaborationMixin:
                 "transcript": session.format_transcript(),
                 "status": session.status.value,
                 "turns": session.turn_count,
+                "stats": dict(session.stats),
             },
         )
 
@@ -613,10 +656,10 @@ class CollaborationMixin:
         if ai_client is None:
             return ("I have no further questions.", True)
 
+        # Fixed prefix; the turns follow as messages so each call extends the last
         system_prompt = (
             f"You are {self.name}, leading a dialogue with {session.responder}.\n"
             f"Goal: {session.goal}\n\n"
-            f"Transcript so far:\n{session.format_transcript()}\n\n"
             "Based on the dialogue so far, generate your next message.\n"
             "Reply with ONLY a JSON object (no markdown fences):\n"
             '{"message": "your next message", "conclude": true/false}\n\n'
@@ -626,8 +669,13 @@ class CollaborationMixin:
 
         messages = [
             {"role": "system", "content": system_prompt},
-            {"role": "user", "content": "Generate your next dialogue message."},
+            *context_messages(session.context(), self.name),
         ]
+        if session.stats:
+            session.stats["lead_llm_calls"] += 1
+            session.stats["lead_prompt_tokens"] += sum(
+                estimate_tokens(m["content"]) for m in messages
+            )
 
         try:
             resp_msg, _ = await ai_client.strong_chat(messages, [])
@@ -661,6 +709,27 @@ class CollaborationMixin:
             return bool(result.get("dialogue_done", False))
         return False
 
+    def _extract_dialogue_data(self, result: Any) -> Any:
+        """Structured payload of a responder's reply, if it carried one.
+
+        Dialogue-aware agents return ``dialogue_data``; plain capability
+        handlers answering a dialogue turn return their usual ``data``.
+        """
+        if isinstance(result, dict):
+            data = result.get("dialogue_data", result.get("data"))
+            return data or None
+        return None
+
+    @staticmethod
+    def _dialogue_stalled(session: DialogueSession, responder: str) -> bool:
+        """True when the responder's latest reply repeats its previous one."""
+        replies = [
+            " ".join(t.message.lower().split())
+            for t in session.turns
+            if t.speaker == responder
+        ]
+        return len(replies) >= 2 and replies[-1] == replies[-2]
+
     def _build_dialogue_tool_definition(
         self, brief: MissionBrief
     ) -> Dict[str, Any]:
@@ -0,0 +1,223 @@
+"""Deterministic slot-filling front end for tool-calling command processors.
+
+Most device commands are one of a few dozen fixed phrasings — "pause",
+"volume up three times", "switch to HDMI 2", "what's on today" — yet the
+Roku and Calendar processors sent every one through an LLM tool loop.
+A ``CommandGrammar`` is compiled from a processor's tool schemas plus a
+short list of phrase rules; a command that matches a rule end to end is
+turned straight into a tool call.  Anything that does not match (extra
+words, unknown slot values, follow-ups) returns ``None`` and the caller
+runs its usual tool loop, so the grammar only has to be right, not
+complete.
+
+Phrase templates are regular expressions with ``{slot}`` placeholders.
+Each slot must be a parameter of the rule's tool; its pattern comes from
+the schema — enum values (plus aliases), integers (digits or number
+words) or free text — and captured text is converted back to the schema
+type.  Rules are validated against the schemas when the grammar is
+built, so a renamed tool or parameter fails loudly at startup instead of
+silently never matching.
+"""
+
+from __future__ import annotations
+
+import re
+import time
+from dataclasses import dataclass, field
+from typing import Any, Callable, Dict, Iterable, List, Mapping, Optional, Tuple
+
+_NUMBER_WORDS = {
+    "a": 1, "one": 1, "once": 1, "two": 2, "twice": 2, "three": 3, "four": 4,
+    "five": 5, "six": 6, "seven": 7, "eight": 8, "nine": 9, "ten": 10,
+}
+_INTEGER_RE = r"\d{1,3}|" + "|".join(sorted(_NUMBER_WORDS, key=len, reverse=True))
+
+# Politeness and wake words that never change which tool is meant
+_PREFIX_RE = re.compile(
+    r"^(?:(?:hey |ok |okay )?jarvis,? )?(?:(?:please|can you|could you|would you|will you)\s+)*"
+)
+_SUFFIX_RE = re.compile(r"(?:,?\s+(?:please|thanks|thank you))+$")
+_SLOT_RE = re.compile(r"\{(\w+)\}")
+
+Reply = Callable[[Dict[str, Any], Any], str]
+
+
+def normalize_command(text: str) -> str:
+    text = text.lower().replace("’", "'").strip()
+    text = re.sub(r"[.!?]+$", "", text).strip()
+    text = _PREFIX_RE.sub("", text)
+    text = _SUFFIX_RE.sub("", text)
+    return " ".join(text.split())
+
+
+@dataclass(frozen=True)
+class Rule:
+    """Phrasings that map onto one tool call.
+
+    ``args`` are fixed arguments merged under the captured slots; ``reply``
+    renders the spoken confirmation from the arguments and tool result.
+    ``guard`` can veto a match whose free-text slots look wrong.
+    """
+
+    tool: str
+    patterns: Tuple[str, ...]
+    reply: Reply
+    args: Mapping[str, Any] = field(default_factory=dict)
+    command_class: Optional[str] = None
+    guard: Optional[Callable[[Dict[str, Any]], bool]] = None
+
+
+@dataclass(slots=True)
+class GrammarMatch:
+    rule: Rule
+    arguments: Dict[str, Any]
+
+    @property
+    def tool(self) -> str:
+        return self.rule.tool
+
+    @property
+    def command_class(self) -> str:
+        return self.rule.command_class or self.rule.tool
+
+
+class CommandGrammar:
+    """Compiled phrase rules for one processor's tool set."""
+
+    def __init__(
+        self,
+        tools: Iterable[Dict[str, Any]],
+        rules: Iterable[Rule],
+        aliases: Optional[Mapping[str, Mapping[str, str]]] = None,
+    ) -> None:
+        self._schemas = {
+            t["function"]["name"]: t["function"].get("parameters", {}) for t in tools
+        }
+        self._aliases = {slot: dict(values) for slot, values in (aliases or {}).items()}
+        self._compiled: List[Tuple[re.Pattern[str], Rule, Dict[str, Callable[[str], Any]]]] = []
+        for rule in rules:
+            self._compile(rule)
+
+    def _compile(self, rule: Rule) -> None:
+        schema = self._schemas.get(rule.tool)
+        if schema is None:
+            raise ValueError(f"Grammar rule targets unknown tool {rule.tool!r}")
+        properties = schema.get("properties", {})
+        for pattern in rule.patterns:
+            slots = _SLOT_RE.findall(pattern)
+            unknown = [s for s in (*slots, *rule.args) if s not in properties]
+            if unknown:
+                raise ValueError(f"{rule.tool}: unknown parameter(s) {unknown}")
+            missing = set(schema.get("required", [])) - set(slots) - set(rule.args)
+            if missing:
+                raise ValueError(f"{rule.tool}: pattern {pattern!r} leaves {sorted(missing)} unfilled")
+            converters = {s: self._converter(s, properties[s]) for s in slots}
+            seen: Dict[str, int] = {}
+
+            def group(m: re.Match[str]) -> str:
+                # A slot may appear in several alternatives: number repeats
+                slot = m.group(1)
+                seen[slot] = seen.get(slot, 0) + 1
+                name = slot if seen[slot] == 1 else f"{slot}__{seen[slot]}"
+                return f"(?P<{name}>{self._slot_pattern(slot, properties[slot])})"
+
+            regex = _SLOT_RE.sub(group, pattern)
+            self._compiled.append((re.compile(rf"^(?:{regex})$"), rule, converters))
+
+    def _slot_pattern(self, slot: str, prop: Dict[str, Any]) -> str:
+        if "enum" in prop:
+            words = [str(v).lower() for v in prop["enum"]] + list(self._aliases.get(slot, {}))
+            return "|".join(re.escape(w) for w in sorted(set(words), key=len, reverse=True))
+        if prop.get("type") == "integer":
+            return _INTEGER_RE
+        return r"[^,;]+?"
+
+    def _converter(self, slot: str, prop: Dict[str, Any]) -> Callable[[str], Any]:
+        if "enum" in prop:
+            lookup = {str(v).lower(): v for v in prop["enum"]}
+            lookup.update(self._aliases.get(slot, {}))
+            return lambda text: lookup[text]
+        if prop.get("type") == "integer":
+            return lambda text: int(text) if text.isdigit() else _NUMBER_WORDS[text]
+        return lambda text: text.strip()
+
+    def match(self, command: str) -> Optional[GrammarMatch]:
+        """Return the tool call for *command*, or None when unsure."""
+        text = normalize_command(command)
+        if not text:
+            return None
+        for regex, rule, converters in self._compiled:
+            found = regex.match(text)
+            if found is None:
+                continue
+            arguments = dict(rule.args)
+            for name, value in found.groupdict().items():
+                if value is not None:
+                    slot = name.split("__")[0]
+                    arguments[slot] = converters[slot](value)
+            if rule.guard is not None and not rule.guard(arguments):
+                continue
+            return GrammarMatch(rule, arguments)
+        return None
+
+
+class FastPathStats:
+    """Per-command-class hit counts and latency for fast path vs. tool loop.
+
+    The LLM path's class is the first tool it called (or "conversation"
+    when it called none), so hit rate reads as "how often commands of this
+    kind skipped the model".  Latency saved is estimated per class as
+    hits x (mean tool-loop latency - mean fast-path latency), using the
+    all-class tool-loop mean until the class has been seen on that path.
+    """
+
+    def __init__(self) -> None:
+        self._classes: Dict[str, Dict[str, float]] = {}
+
+    def _entry(self, command_class: str) -> Dict[str, float]:
+        return self._classes.setdefault(
+            command_class, {"fast": 0, "llm": 0, "fast_ms": 0.0, "llm_ms": 0.0}
+        )
+
+    def record_fast(self, command_class: str, elapsed_ms: float) -> None:
+        entry = self._entry(command_class)
+        entry["fast"] += 1
+        entry["fast_ms"] += elapsed_ms
+
+    def record_llm(self, command_class: str, elapsed_ms: float) -> None:
+        entry = self._entry(command_class)
+        entry["llm"] += 1
+        entry["llm_ms"] += elapsed_ms
+
+    def snapshot(self) -> Dict[str, Any]:
+        llm_calls = sum(e["llm"] for e in self._classes.values())
+        llm_mean = sum(e["llm_ms"] for e in self._classes.values()) / llm_calls if llm_calls else None
+        classes: Dict[str, Any] = {}
+        total_saved = 0.0
+        for name, e in sorted(self._classes.items()):
+            fast_mean = e["fast_ms"] / e["fast"] if e["fast"] else None
+            class_llm_mean = e["llm_ms"] / e["llm"] if e["llm"] else llm_mean
+            saved = None
+            if fast_mean is not None and class_llm_mean is not None:
+                saved = max(0.0, class_llm_mean - fast_mean) * e["fast"]
+                total_saved += saved
+            classes[name] = {
+                "fast": int(e["fast"]),
+                "llm": int(e["llm"]),
+                "hit_rate": round(e["fast"] / (e["fast"] + e["llm"]), 3),
+                "fast_ms_avg": None if fast_mean is None else round(fast_mean, 1),
+                "llm_ms_avg": None if not e["llm"] else round(e["llm_ms"] / e["llm"], 1),
+                "saved_ms": None if saved is None else round(saved, 1),
+            }
+        fast = sum(e["fast"] for e in self._classes.values())
+        return {
+            "fast": int(fast),
+            "llm": int(llm_calls),
+            "hit_rate": round(fast / (fast + llm_calls), 3) if fast + llm_calls else 0.0,
+            "saved_ms": round(total_saved, 1),
+            "classes": classes,
+        }
+
+
+def elapsed_ms(start: float) -> float:
+    return (time.perf_counter() - start) * 1000
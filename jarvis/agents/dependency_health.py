@@ -0,0 +1,355 @@
+"""Live status of the backends agents cannot work without.
+
+The health agent's dependency map knows that RokuAgent needs the Roku,
+LightingAgent the Hue bridge, and so on, but routing used to ignore it:
+with the Roku unplugged every "pause the TV" still went to RokuAgent,
+which spent the HTTP client's timeout finding out, and the user heard a
+generic error after the orchestrator's wait.
+
+``DependencyHealth`` keeps a per-dependency outage record fed from two
+sources — health probe results and the error replies agents send back —
+and the network consults it before dispatching.  While a hard dependency
+is down, requests to the agents behind it are answered immediately with
+a spoken explanation.  A background task re-probes the dependency with
+exponential backoff and re-enables the route as soon as a probe
+succeeds; dependencies without a probe are let through again after the
+retry interval so the next real request acts as the probe.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import time
+from dataclasses import dataclass, field
+from typing import Any, Awaitable, Callable, Dict, List, Optional
+
+from ..logging import JarvisLogger
+from .response import AgentResponse, ErrorInfo, ErrorSeverity
+
+
+# The subset of STATIC_DEPENDENCIES (health_agent.dependency_map) an agent
+# cannot do anything useful without.  Shared backends such as OpenAI_API or
+# SQLite are left out: failing fast on them would silence most agents on a
+# single misclassified error.
+HARD_DEPENDENCIES: Dict[str, List[str]] = {
+    "RokuAgent": ["RokuDevice"],
+    "LightingAgent": ["HueBridge"],
+    "SearchAgent": ["GoogleSearchAPI"],
+    "CalendarAgent": ["CalendarService"],
+    "MemoryAgent": ["ChromaDB"],
+}
+
+# How each dependency is named when Jarvis explains why it did nothing
+SPOKEN_NAMES: Dict[str, str] = {
+    "RokuDevice": "the Roku",
+    "HueBridge": "the lights",
+    "GoogleSearchAPI": "web search",
+    "CalendarService": "your calendar",
+    "ChromaDB": "long-term memory",
+}
+
+# Health probe component names that differ from the dependency they test
+PROBE_COMPONENTS: Dict[str, str] = {
+    "CalendarAPI": "CalendarService",
+}
+
+ProbeFn = Callable[[], Awaitable[bool]]
+
+# Exception types the device and HTTP clients raise when the backend
+# cannot be reached.  Only the type counts: message text such as "timed
+# out" is just as likely to come from the agent's own LLM call.
+_UNREACHABLE_TYPES = frozenset({
+    "ConnectionError",
+    "ConnectionRefusedError",
+    "ConnectionResetError",
+    "ConnectError",
+    "ConnectTimeout",
+    "ReadTimeout",
+    "PhueRequestTimeout",
+    "DependencyUnavailable",
+})
+
+
+def attributed_dependency(error: Any) -> Optional[str]:
+    """The dependency an agent named in ``details["dependency"]``, if any."""
+    if isinstance(error, dict) and isinstance(error.get("details"), dict):
+        return error["details"].get("dependency") or None
+    return None
+
+
+def is_unreachable_error(error: Any) -> bool:
+    """Return True when an agent attributes *error* to its backend.
+
+    That is an explicit ``details["dependency"]``, or an ``error_type`` /
+    ``details["exception_class"]`` raised by a client that could not reach
+    the backend.  Plain messages are never classified.
+    """
+    if not isinstance(error, dict):
+        return False
+    if attributed_dependency(error):
+        return True
+    details = error.get("details") if isinstance(error.get("details"), dict) else {}
+    return (
+        error.get("error_type") in _UNREACHABLE_TYPES
+        or details.get("exception_class") in _UNREACHABLE_TYPES
+    )
+
+
+@dataclass(slots=True)
+class Outage:
+    """An open outage for one dependency."""
+
+    dependency: str
+    reason: str
+    source: str  # "probe" or "requests"
+    since: float = field(default_factory=time.time)
+    # Set once the retry interval passes with no probe to confirm recovery;
+    # the next request goes through and decides.
+    trial: bool = False
+
+    def to_dict(self) -> Dict[str, Any]:
+        return {
+            "reason": self.reason,
+            "source": self.source,
+            "since": self.since,
+            "down_for_s": round(time.time() - self.since, 1),
+            "trial": self.trial,
+        }
+
+
+class DependencyHealth:
+    """Track hard-dependency outages and answer for agents behind them."""
+
+    def __init__(
+        self,
+        hard_dependencies: Optional[Dict[str, List[str]]] = None,
+        failure_threshold: int = 2,
+        retry_interval: float = 15.0,
+        max_retry_interval: float = 300.0,
+        probe_timeout: float = 5.0,
+        assumed_timeout: float = 15.0,
+        logger: Optional[JarvisLogger] = None,
+    ) -> None:
+        self.hard_dependencies = dict(
+            HARD_DEPENDENCIES if hard_dependencies is None else hard_dependencies
+        )
+        self.failure_threshold = max(1, failure_threshold)
+        self.retry_interval = retry_interval
+        self.max_retry_interval = max_retry_interval
+        self.probe_timeout = probe_timeout
+        # What a request to a dead backend would have cost the user; the
+        # orchestrator's response timeout is the usual ceiling.
+        self.assumed_timeout = assumed_timeout
+        self.logger = logger or JarvisLogger()
+
+        self._outages: Dict[str, Outage] = {}
+        self._failures: Dict[str, int] = {}
+        self._probes: Dict[str, ProbeFn] = {}
+        self._recovery_tasks: Dict[str, asyncio.Task] = {}
+        self._fail_fast_by_dependency: Dict[str, int] = {}
+        self._metrics: Dict[str, Any] = {
+            "fail_fast": 0,
+            "outages": 0,
+            "recoveries": 0,
+            "probe_failures": 0,
+        }
+
+    # ------------------------------------------------------------------
+    # Routing
+    # ------------------------------------------------------------------
+    def dependencies_of(self, agent_name: str) -> List[str]:
+        return self.hard_dependencies.get(agent_name, [])
+
+    def blocking_dependency(self, agent_name: str) -> Optional[str]:
+        """Return the down dependency that should stop a request, if any."""
+        if not self._outages:
+            return None
+        for dep in self.hard_dependencies.get(agent_name, ()):
+            outage = self._outages.get(dep)
+            if outage is not None and not outage.trial:
+                return dep
+        return None
+
+    def fail_fast_response(self, agent_name: str, dependency: str) -> Dict[str, Any]:
+        """Build the reply sent in place of dispatching to *agent_name*."""
+        outage = self._outages.get(dependency)
+        self._metrics["fail_fast"] += 1
+        self._fail_fast_by_dependency[dependency] = (
+            self._fail_fast_by_dependency.get(dependency, 0) + 1
+        )
+        spoken = SPOKEN_NAMES.get(dependency, dependency)
+        return AgentResponse.error_response(
+            response=(
+                f"I can't reach {spoken} right now, so I didn't try. "
+                "I'll keep checking and it should work again once it's back."
+            ),
+            error=ErrorInfo(
+                message=f"{dependency} is down: {outage.reason if outage else 'unknown'}",
+                error_type="DependencyUnavailable",
+                severity=ErrorSeverity.WARNING,
+                details={"agent": agent_name, "dependency": dependency},
+                retry_after=int(self.retry_interval),
+            ),
+        ).to_dict()
+
+    # ------------------------------------------------------------------
+    # Evidence
+    # ------------------------------------------------------------------
+    def observe_reply(self, agent_name: str, content: Any) -> None:
+        """Learn from a capability_response or error sent by *agent_name*."""
+        deps = self.hard_dependencies.get(agent_name)
+        if not deps or not isinstance(content, dict):
+            return
+        error = content.get("error")
+        if content.get("success") is False or error:
+            if isinstance(error, dict) and error.get("error_type") == "DependencyUnavailable":
+                return  # our own fail-fast reply
+            if not is_unreachable_error(error):
+                return
+            named = attributed_dependency(error)
+            for dep in deps if named not in deps else [named]:
+                self.record_failure(dep, error.get("message", ""))
+        elif content.get("success") is True:
+            for dep in deps:
+                self.record_success(dep)
+
+    def observe_probe(self, component: str, healthy: Optional[bool], message: str = "") -> None:
+        """Apply a health probe verdict; ``None`` means inconclusive."""
+        dep = PROBE_COMPONENTS.get(component, component)
+        if healthy is None or not any(dep in deps for deps in self.hard_dependencies.values()):
+            return
+        if healthy:
+            self.record_success(dep)
+        else:
+            self.mark_down(dep, message or "health probe failed", source="probe")
+
+    def record_failure(self, dependency: str, reason: str) -> None:
+        count = self._failures.get(dependency, 0) + 1
+        self._failures[dependency] = count
+        outage = self._outages.get(dependency)
+        if outage is not None and outage.trial:
+            # The trial request failed too: close the route again
+            outage.trial = False
+            outage.reason = reason
+            self._schedule_recovery(dependency)
+        elif count >= self.failure_threshold:
+            self.mark_down(dependency, reason, source="requests")
+
+    def record_success(self, dependency: str) -> None:
+        self._failures.pop(dependency, None)
+        if dependency in self._outages:
+            self.mark_up(dependency)
+
+    def mark_down(self, dependency: str, reason: str, source: str = "requests") -> None:
+        outage = self._outages.get(dependency)
+        if outage is not None:
+            outage.reason = reason
+            return
+        self._outages[dependency] = Outage(dependency, reason, source)
+        self._metrics["outages"] += 1
+        self.logger.log(
+            "WARNING",
+            f"Dependency down, failing fast: {dependency}",
+            f"source={source} reason={reason[:200]}",
+        )
+        self._schedule_recovery(dependency)
+
+    def mark_up(self, dependency: str) -> None:
+        outage = self._outages.pop(dependency, None)
+        self._failures.pop(dependency, None)
+        task = self._recovery_tasks.pop(dependency, None)
+        if task is not None and task is not _current_task():
+            task.cancel()
+        if outage is None:
+            return
+        self._metrics["recoveries"] += 1
+        self.logger.log(
+            "INFO",
+            f"Dependency recovered, routing re-enabled: {dependency}",
+            f"down {time.time() - outage.since:.0f}s",
+        )
+
+    # ------------------------------------------------------------------
+    # Recovery probes
+    # ------------------------------------------------------------------
+    def register_probe(self, dependency: str, probe: ProbeFn) -> None:
+        """Register a cheap async check returning True when *dependency* is up."""
+        self._probes[dependency] = probe
+
+    async def probe_all(self) -> Dict[str, bool]:
+        """Run every registered probe once and apply the verdicts."""
+        results: Dict[str, bool] = {}
+        for dependency, probe in list(self._probes.items()):
+            try:
+                healthy = bool(await asyncio.wait_for(probe(), timeout=self.probe_timeout))
+                reason = "" if healthy else "probe reported unreachable"
+            except Exception as exc:
+                healthy, reason = False, str(exc) or type(exc).__name__
+            results[dependency] = healthy
+            self.observe_probe(dependency, healthy, reason)
+        return results
+
+    def _schedule_recovery(self, dependency: str) -> None:
+        task = self._recovery_tasks.get(dependency)
+        if task is not None and not task.done():
+            return
+        try:
+            loop = asyncio.get_running_loop()
+        except RuntimeError:
+            return  # no loop (sync callers/tests); probes will still feed us
+        self._recovery_tasks[dependency] = loop.create_task(self._recover(dependency))
+
+    async def _recover(self, dependency: str) -> None:
+        delay = self.retry_interval
+        while dependency in self._outages:
+            await asyncio.sleep(delay)
+            outage = self._outages.get(dependency)
+            if outage is None:
+                return
+            probe = self._probes.get(dependency)
+            if probe is None:
+                outage.trial = True
+                self._recovery_tasks.pop(dependency, None)
+                return
+            try:
+                healthy = await asyncio.wait_for(probe(), timeout=self.probe_timeout)
+            except Exception as exc:
+                healthy = False
+                outage.reason = str(exc) or type(exc).__name__
+            if healthy:
+                self.mark_up(dependency)
+                return
+            self._metrics["probe_failures"] += 1
+            delay = min(delay * 2, self.max_retry_interval)
+
+    async def stop(self) -> None:
+        tasks = list(self._recovery_tasks.values())
+        self._recovery_tasks.clear()
+        for task in tasks:
+            task.cancel()
+        if tasks:
+            await asyncio.gather(*tasks, return_exceptions=True)
+
+    # ------------------------------------------------------------------
+    # Reporting
+    # ------------------------------------------------------------------
+    def down(self) -> Dict[str, Outage]:
+        return dict(self._outages)
+
+    def get_stats(self) -> Dict[str, Any]:
+        return {
+            **self._metrics,
+            # Every fail-fast reply is a request that would otherwise have
+            # waited on a dead backend until the response timeout
+            "timeouts_avoided": self._metrics["fail_fast"],
+            "seconds_saved_estimate": round(self._metrics["fail_fast"] * self.assumed_timeout, 1),
+            "fail_fast_by_dependency": dict(self._fail_fast_by_dependency),
+            "down": {dep: outage.to_dict() for dep, outage in self._outages.items()},
+        }
+
+
+def _current_task() -> Optional[asyncio.Task]:
+    try:
+        return asyncio.current_task()
+    except RuntimeError:
+        return None
@@ -29,6 +29,8 @@ from ...services.metrics_store import MetricsStore
 class DeviceMonitorAgent(NetworkAgent):
     """Monitors the physical hardware running Jarvis and takes corrective action."""
 
+    CAPABILITIES = frozenset({"device_status", "device_diagnostics", "device_cleanup", "device_history"})
+
     def __init__(
         self,
         device_service: Optional[DeviceMonitorService] = None,
@@ -60,7 +62,7 @@ class DeviceMonitorAgent(NetworkAgent):
 
     @property
     def capabilities(self) -> Set[str]:
-        return {"device_status", "device_diagnostics", "device_cleanup", "device_history"}
+        return set(self.CAPABILITIES)
 
     @property
     def supports_dialogue(self) -> bool:
@@ -230,23 +232,16 @@ class DeviceMonitorAgent(NetworkAgent):
         end = datetime.now(timezone.utc)
         start = end - timedelta(hours=hours)
 
-        # Choose resolution: raw for < 6h, hourly for >= 6h
-        if hours < 6:
-            rows = self.metrics_store.query(
-                component=component,
-                metric_name=metric_name,
-                start=start.isoformat(),
-                end=end.isoformat(),
-            )
-            resolution = "raw"
-        else:
-            rows = self.metrics_store.query_aggregated(
-                component=component,
-                metric_name=metric_name,
-                start=start.isoformat(),
-                end=end.isoformat(),
-            )
-            resolution = "hourly"
+        # The store picks the tier (raw, minute, hourly, daily) for the range
+        history = await self.metrics_store.run(
+            self.metrics_store.history,
+            component,
+            metric_name=metric_name,
+            start=start.isoformat(),
+            end=end.isoformat(),
+        )
+        rows = history["data"]
+        resolution = history["resolution"]
 
         if not rows:
             return AgentResponse.success_response(
@@ -256,10 +251,7 @@ class DeviceMonitorAgent(NetworkAgent):
             )
 
         # Compute summary statistics
-        if resolution == "raw":
-            values = [r["value"] for r in rows]
-        else:
-            values = [r["avg_value"] for r in rows if r.get("avg_value") is not None]
+        values = [r["value"] for r in rows if r.get("value") is not None]
 
         if not values:
             return AgentResponse.success_response(
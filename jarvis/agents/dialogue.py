@@ -3,14 +3,35 @@
 A dialogue is a multi-turn conversation between a lead (initiator) agent
 and a specialist (responder) agent.  Each turn reuses the existing
 ``_request_and_wait_for_agent()`` primitive — no new messaging infra needed.
+
+Both sides prompt their LLM with a fixed system prefix followed by the
+turns as chat messages, so each call only appends to the previous one
+and provider prompt caching applies.  ``DialogueSession.context()`` is
+what travels with a request: earlier turns verbatim, structured results
+as data, and — once the turns outgrow ``DEFAULT_CONTEXT_TOKENS`` — the
+oldest ones folded into a short rolling summary.
 """
 
 from __future__ import annotations
 
+import json
+import re
 import uuid
 from dataclasses import dataclass, field
 from enum import Enum
-from typing import Any, Dict, List
+from typing import Any, Dict, List, Optional
+
+# Rough budget for the turns carried in a dialogue context
+DEFAULT_CONTEXT_TOKENS = 1200
+# Turns that are never folded into the summary
+KEEP_RECENT_TURNS = 2
+_SUMMARY_LINE_CHARS = 160
+_SENTENCE_END_RE = re.compile(r"(?<=[.!?])\s")
+
+
+def estimate_tokens(text: str) -> int:
+    """Cheap token estimate (~4 characters per token)."""
+    return (len(text) + 3) // 4
 
 
 class DialogueStatus(Enum):
@@ -31,6 +52,11 @@ class DialogueTurn:
     message: str
     metadata: Dict[str, Any] = field(default_factory=dict)
 
+    @property
+    def data(self) -> Any:
+        """Structured result the speaker attached to this turn, if any."""
+        return self.metadata.get("data")
+
     def to_dict(self) -> Dict[str, Any]:
         return {
             "turn_number": self.turn_number,
@@ -39,6 +65,26 @@ class DialogueTurn:
             "metadata": self.metadata,
         }
 
+    def to_context(self) -> Dict[str, Any]:
+        entry: Dict[str, Any] = {
+            "turn": self.turn_number,
+            "speaker": self.speaker,
+            "message": self.message,
+        }
+        if self.data is not None:
+            entry["data"] = self.data
+        return entry
+
+    def summary_line(self) -> str:
+        """One-line digest of the turn used by the rolling summary."""
+        first = _SENTENCE_END_RE.split(self.message.strip(), maxsplit=1)[0]
+        if len(first) > _SUMMARY_LINE_CHARS:
+            first = first[: _SUMMARY_LINE_CHARS - 1].rstrip() + "…"
+        line = f"{self.speaker}: {first}"
+        if self.data is not None:
+            line += f" [data: {json.dumps(self.data, default=str)[:_SUMMARY_LINE_CHARS]}]"
+        return line
+
     @classmethod
     def from_dict(cls, data: Dict[str, Any]) -> DialogueTurn:
         return cls(
@@ -61,6 +107,11 @@ class DialogueSession:
     turns: List[DialogueTurn] = field(default_factory=list)
     max_turns: int = 5
     status: DialogueStatus = DialogueStatus.ACTIVE
+    # Rolling summary of turns[:summarized_turns]
+    summary: str = ""
+    summarized_turns: int = 0
+    # Estimated tokens sent, lead LLM calls and wall time for this dialogue
+    stats: Dict[str, Any] = field(default_factory=dict)
 
     # ---- properties ----
 
@@ -84,8 +135,49 @@ class DialogueSession:
         self.turns.append(turn)
         return turn
 
+    def compact(
+        self,
+        max_tokens: int = DEFAULT_CONTEXT_TOKENS,
+        keep_recent: int = KEEP_RECENT_TURNS,
+    ) -> bool:
+        """Fold the oldest turns into ``summary`` until the rest fit *max_tokens*.
+
+        The summary itself is capped at a third of the budget by dropping
+        its oldest lines.  Returns True when anything was folded.
+        """
+        folded = False
+        limit = len(self.turns) - keep_recent
+        while self.summarized_turns < limit and self._live_tokens() > max_tokens:
+            line = self.turns[self.summarized_turns].summary_line()
+            self.summary = f"{self.summary}\n{line}" if self.summary else line
+            self.summarized_turns += 1
+            folded = True
+        lines = self.summary.splitlines()
+        while len(lines) > 1 and estimate_tokens("\n".join(lines)) > max_tokens // 3:
+            lines.pop(0)
+            lines[0] = lines[0] if lines[0].startswith("…") else f"… {lines[0]}"
+        self.summary = "\n".join(lines)
+        return folded
+
+    def _live_tokens(self) -> int:
+        return sum(
+            estimate_tokens(json.dumps(t.to_context(), default=str))
+            for t in self.turns[self.summarized_turns:]
+        )
+
     # ---- formatting ----
 
+    def context(self, upto: Optional[int] = None) -> Dict[str, Any]:
+        """Compact context for a dialogue request: turns[:upto] after the summary."""
+        end = self.turn_count if upto is None else upto
+        return {
+            "session_id": self.session_id,
+            "goal": self.goal,
+            "capability": self.capability,
+            "summary": self.summary,
+            "turns": [t.to_context() for t in self.turns[self.summarized_turns:end]],
+        }
+
     def format_transcript(self) -> str:
         lines: List[str] = []
         for t in self.turns:
@@ -104,6 +196,9 @@ class DialogueSession:
             "turns": [t.to_dict() for t in self.turns],
             "max_turns": self.max_turns,
             "status": self.status.value,
+            "summary": self.summary,
+            "summarized_turns": self.summarized_turns,
+            "stats": self.stats,
         }
 
     @classmethod
@@ -117,4 +212,38 @@ class DialogueSession:
             turns=[DialogueTurn.from_dict(t) for t in data.get("turns", [])],
             max_turns=data.get("max_turns", 5),
             status=DialogueStatus(data.get("status", "active")),
+            summary=data.get("summary", ""),
+            summarized_turns=data.get("summarized_turns", 0),
+            stats=data.get("stats", {}),
+        )
+
+
+def context_messages(
+    dialogue_context: Dict[str, Any], own_name: str
+) -> List[Dict[str, Any]]:
+    """Chat messages for the turns in *dialogue_context*, after the system prefix.
+
+    The agent's own turns become ``assistant`` messages and the other
+    side's ``user`` messages; structured turn data is appended as JSON
+    rather than paraphrased.  A legacy ``transcript`` string is passed
+    through as a single system message.
+    """
+    messages: List[Dict[str, Any]] = []
+    summary = dialogue_context.get("summary")
+    if summary:
+        messages.append(
+            {"role": "system", "content": f"Earlier in this dialogue (summarized):\n{summary}"}
         )
+    turns = dialogue_context.get("turns")
+    if turns is None:
+        transcript = dialogue_context.get("transcript", "")
+        if transcript:
+            messages.append({"role": "system", "content": f"Dialogue so far:\n{transcript}"})
+        return messages
+    for turn in turns:
+        content = turn.get("message", "")
+        if turn.get("data") is not None:
+            content += "\nData: " + json.dumps(turn["data"], default=str)
+        role = "assistant" if turn.get("speaker") == own_name else "user"
+        messages.append({"role": role, "content": content})
+    return messages
@@ -1,15 +1,18 @@
 from __future__ import annotations
 
 import asyncio
-from typing import Any, Dict, Optional, TYPE_CHECKING
+import time
+from typing import Any, Callable, Dict, Optional, Tuple, TYPE_CHECKING
 
 from ..core import JarvisConfig
+from ..core.container import Lifetime, ServiceContainer
 from ..logging import JarvisLogger
 from ..ai_clients import BaseAIClient
 from ..agents.agent_network import AgentNetwork
 from ..agents.nlu_agent import NLUAgent
 from ..agents.protocol_agent import ProtocolAgent
-from ..agents.lights_agent.lighting_agent import create_lighting_agent
+from ..agents.lights_agent.lighting_agent import LightingAgent, create_lighting_agent
+from ..agents.lazy_agent import LazyAgent
 from ..agents.calendar_agent.agent import CollaborativeCalendarAgent
 from ..agents.memory_agent import MemoryAgent
 from ..agents.chat_agent import ChatAgent
@@ -30,6 +33,7 @@ from ..services.health_service import HealthService
 from ..services.device_monitor_service import DeviceMonitorService
 from ..services.notification_service import NotificationService
 from ..services.markdown_memory import MarkdownMemoryService
+from ..storage import StartupSnapshot
 from ..night_agents import (
     NightAgent,
     NightModeControllerAgent,
@@ -41,13 +45,115 @@ from ..night_agents import (
 if TYPE_CHECKING:
     from ..core import JarvisSystem
 
+# Feature flags whose agents can be added to or removed from a running
+# network, mapped to every name (aliases included) each one registers
+TOGGLEABLE_AGENTS: Dict[str, Tuple[str, ...]] = {
+    "enable_canvas": ("CanvasAgent",),
+    "enable_lights": ("LightingAgent", "PhillipsHueAgent"),
+    "enable_roku": ("RokuAgent",),
+    "enable_todo": ("TodoAgent",),
+    "enable_scheduler": ("SchedulerAgent",),
+    "enable_health": ("HealthAgent",),
+    "enable_device_monitor": ("DeviceMonitorAgent",),
+    "enable_server_manager": ("ServerManagerAgent",),
+    "enable_notifications": ("NotificationAgent",),
+    "enable_coding": ("CodingAgent",),
+    "enable_capabilities": ("CapabilitiesAgent",),
+}
+
+# Builders that need the AI client, and features registered as LazyAgent
+# stubs under ``enable_lazy_agents`` (in registration order)
+_AI_FEATURES = {"canvas", "lights", "roku", "todo", "scheduler", "capabilities"}
+_LAZY_FEATURES = ("canvas", "lights", "roku", "device_monitor", "server_manager")
+
 
 class AgentFactory:
     """Builds and wires agents/services based on configuration."""
 
-    def __init__(self, config: JarvisConfig, logger: JarvisLogger):
+    def __init__(
+        self,
+        config: JarvisConfig,
+        logger: JarvisLogger,
+        snapshot: Optional[StartupSnapshot] = None,
+        services: Optional[ServiceContainer] = None,
+    ):
         self.config = config
         self.logger = logger
+        self.snapshot = snapshot
+        if services is None:
+            root = ServiceContainer()
+            root.register("logger", lambda scope: logger)
+            services = root.scope(Lifetime.TENANT)
+        self.register_services(services)
+        # The first factory to register supplies the snapshot the shared
+        # classifier checks its seed phrases against
+        services.register("fast_classifier", self._create_fast_classifier, replace=False)
+        self.services = services
+        # Wall time (ms) spent building each component, in build order
+        self.timings: Dict[str, float] = {}
+        self.lazy_agents: Dict[str, LazyAgent] = {}
+
+    @staticmethod
+    def register_services(container: ServiceContainer) -> None:
+        """Install defaults for the services agents share across systems.
+
+        All are process-wide; the arguments they are resolved with (paths,
+        URLs, credentials) keep differently configured systems apart.
+        Existing registrations are left alone.
+        """
+        for key, factory in (
+            ("logger", lambda scope: JarvisLogger()),
+            (
+                "vector_memory",
+                lambda scope, memory_dir, api_key: VectorMemoryService(
+                    persist_directory=memory_dir, api_key=api_key
+                ),
+            ),
+            ("fact_memory", lambda scope: FactMemoryService()),
+            (
+                "calendar_service",
+                lambda scope, url: CalendarService(url, logger=scope.resolve("logger")),
+            ),
+            (
+                "search_service",
+                lambda scope, api_key, engine_id: GoogleSearchService(
+                    api_key=api_key,
+                    search_engine_id=engine_id,
+                    logger=scope.resolve("logger"),
+                ),
+            ),
+            ("todo_service", lambda scope: TodoService(logger=scope.resolve("logger"))),
+        ):
+            container.register(key, factory, replace=False)
+
+    def _timed(self, label: str, fn: Callable[..., Any], *args: Any) -> Any:
+        start = time.perf_counter()
+        try:
+            return fn(*args)
+        finally:
+            self.timings[label] = round((time.perf_counter() - start) * 1000, 2)
+
+    def _register_lazy(
+        self,
+        network: AgentNetwork,
+        refs: Dict[str, Any],
+        name: str,
+        agent_cls: type,
+        agent_key: str,
+        create: Callable[[], Dict[str, Any]],
+    ) -> LazyAgent:
+        """Register a stub for *agent_cls* that calls *create* on first use."""
+        stub = LazyAgent(
+            name,
+            agent_cls,
+            lambda: self._timed(name, create),
+            agent_key,
+            logger=self.logger,
+            refs=refs,
+        )
+        network.register_agent(stub)
+        self.lazy_agents[name] = stub
+        return stub
 
     def build_all(
         self,
@@ -122,58 +228,68 @@ class AgentFactory:
         """Create all agents with heavy I/O running in parallel.
 
         ChromaDB init is offloaded to a thread while instant agents
-        are built immediately on the main thread.
+        are built immediately on the main thread.  With
+        ``enable_lazy_agents`` the device-backed agents (lights, Roku,
+        Canvas, device monitor, server manager) are registered as
+        :class:`LazyAgent` stubs and the night workers are left to
+        :meth:`build_deferred`.
         """
         refs: Dict[str, Any] = {}
+        flags = self.config.flags
+        lazy = flags.enable_lazy_agents
 
         # --- Kick off slow I/O in background threads ---
         chromadb_future = None
         if self.config.api_key:
             chromadb_future = asyncio.to_thread(
-                VectorMemoryService,
-                persist_directory=self.config.memory_dir,
-                api_key=self.config.api_key,
+                self._timed,
+                "vector_memory",
+                self.services.resolve,
+                "vector_memory",
+                self.config.memory_dir,
+                self.config.api_key,
             )
 
         # --- Build all instant agents while I/O runs ---
-        refs.update(self._build_calendar(network, ai_client))
-        refs.update(self._build_chat(network, ai_client))
-        refs.update(self._build_search(network, ai_client))
-        refs.update(self._build_protocol(network))
-
-        if self.config.flags.enable_canvas:
-            refs.update(self._build_canvas(network, ai_client))
-        if self.config.flags.enable_lights:
-            refs.update(self._build_lights(network, ai_client))
-        if self.config.flags.enable_roku:
-            refs.update(self._build_roku(network, ai_client))
-        if self.config.flags.enable_todo:
-            refs.update(self._build_todo(network, ai_client))
-        if self.config.flags.enable_scheduler:
-            refs.update(self._build_scheduler(network, ai_client))
-        if self.config.flags.enable_health:
-            refs.update(self._build_health(network))
-        if self.config.flags.enable_device_monitor:
-            refs.update(self._build_device_monitor(network))
-        if self.config.flags.enable_server_manager:
-            refs.update(self._build_server_manager(network))
-        if self.config.flags.enable_notifications:
-            refs.update(self._build_notifications(network))
-        if self.config.flags.enable_coding:
-            refs.update(self._build_coding(network))
-        if self.config.flags.enable_capabilities:
-            refs.update(self._build_capabilities(network, ai_client))
-        if self.config.flags.enable_night_mode and system is not None:
-            refs.update(self._build_night_agents(network, system))
+        refs.update(self._timed("calendar", self._build_calendar, network, ai_client))
+        refs.update(self._timed("chat", self._build_chat, network, ai_client))
+        refs.update(self._timed("search", self._build_search, network, ai_client))
+        refs.update(self._timed("protocol", self._build_protocol, network))
 
-        if self.config.flags.enable_self_improvement and system is not None:
-            si_refs = self._build_self_improvement(
-                network, system, refs.get("todo_service")
-            )
-            refs.update(si_refs)
-            night_agents = refs.get("night_agents", [])
-            night_agents.append(si_refs["self_improvement_agent"])
-            refs["night_agents"] = night_agents
+        if lazy:
+            self._register_lazy_agents(network, ai_client, refs)
+        else:
+            if flags.enable_canvas:
+                refs.update(self._timed("canvas", self._build_canvas, network, ai_client))
+            if flags.enable_lights:
+                refs.update(self._timed("lights", self._build_lights, network, ai_client))
+            if flags.enable_roku:
+                refs.update(self._timed("roku", self._build_roku, network, ai_client))
+        if flags.enable_todo:
+            refs.update(self._timed("todo", self._build_todo, network, ai_client))
+        if flags.enable_scheduler:
+            refs.update(self._timed("scheduler", self._build_scheduler, network, ai_client))
+        if flags.enable_health:
+            refs.update(self._timed("health", self._build_health, network))
+        if not lazy:
+            if flags.enable_device_monitor:
+                refs.update(self._timed("device_monitor", self._build_device_monitor, network))
+            if flags.enable_server_manager:
+                refs.update(self._timed("server_manager", self._build_server_manager, network))
+        if flags.enable_notifications:
+            refs.update(self._timed("notifications", self._build_notifications, network))
+        if flags.enable_coding:
+            refs.update(self._timed("coding", self._build_coding, network))
+        if flags.enable_capabilities:
+            refs.update(self._timed("capabilities", self._build_capabilities, network, ai_client))
+        if flags.enable_night_mode and system is not None:
+            if lazy:
+                refs.update(self._timed("night_controller", self._build_night_controller, network, system))
+            else:
+                refs.update(self._timed("night_agents", self._build_night_agents, network, system))
+
+        if not lazy:
+            self._add_self_improvement(network, system, refs)
 
         # --- Await ChromaDB init, then build memory + NLU ---
         vector_memory = None
@@ -183,15 +299,17 @@ class AgentFactory:
             except Exception as exc:
                 self.logger.log("WARNING", "VectorMemoryService init failed", str(exc))
 
+        start = time.perf_counter()
         # Markdown vault is always available
         markdown_memory = MarkdownMemoryService(
             vault_dir=self.config.memory_vault_dir,
             short_term_ttl_days=self.config.memory_short_term_ttl_days,
             auto_promote=self.config.memory_auto_promote,
             ai_client=ai_client,
+            snapshot=self.snapshot,
         )
 
-        fact_service = FactMemoryService()
+        fact_service = self.services.resolve("fact_memory")
         memory_agent = MemoryAgent(
             memory_service=vector_memory,
             fact_service=fact_service,
@@ -206,11 +324,123 @@ class AgentFactory:
             "fact_service": fact_service,
             "memory_agent": memory_agent,
         })
+        self.timings["memory"] = round((time.perf_counter() - start) * 1000, 2)
 
-        refs.update(self._build_nlu(network, ai_client, vector_memory))
+        refs.update(self._timed("nlu", self._build_nlu, network, ai_client, vector_memory))
+
+        return refs
+
+    def _register_lazy_agents(
+        self, network: AgentNetwork, ai_client: BaseAIClient, refs: Dict[str, Any]
+    ) -> None:
+        """Register stubs for agents that talk to devices or external APIs."""
+        for feature in _LAZY_FEATURES:
+            if getattr(self.config.flags, f"enable_{feature}"):
+                self._register_lazy_feature(feature, network, ai_client, refs)
+
+    def _register_lazy_feature(
+        self,
+        feature: str,
+        network: AgentNetwork,
+        ai_client: BaseAIClient,
+        refs: Dict[str, Any],
+    ) -> None:
+        if feature == "canvas":
+            self._register_lazy(
+                network, refs, "CanvasAgent", CanvasAgent, "canvas_agent",
+                lambda: self._create_canvas(ai_client),
+            )
+        elif feature == "lights":
+            backend = self._lights_backend()
+            if backend is not None:
+                stub = self._register_lazy(
+                    network, refs, "LightingAgent", LightingAgent, "lights_agent",
+                    lambda: self._create_lights(ai_client, backend),
+                )
+                network.agents["PhillipsHueAgent"] = stub
+        elif feature == "roku":
+            if self._roku_configured():
+                self._register_lazy(
+                    network, refs, "RokuAgent", RokuAgent, "roku_agent",
+                    lambda: self._create_roku(ai_client),
+                )
+        elif feature == "device_monitor":
+            from ..agents.device_monitor_agent import DeviceMonitorAgent
+
+            self._register_lazy(
+                network, refs, "DeviceMonitorAgent", DeviceMonitorAgent,
+                "device_monitor_agent", self._create_device_monitor,
+            )
+        elif feature == "server_manager":
+            from ..agents.server_manager_agent import ServerManagerAgent
+
+            self._register_lazy(
+                network, refs, "ServerManagerAgent", ServerManagerAgent,
+                "server_manager_agent", self._create_server_manager,
+            )
 
+    def build_feature(
+        self,
+        flag: str,
+        network: AgentNetwork,
+        ai_client: BaseAIClient,
+        refs: Dict[str, Any],
+    ) -> Dict[str, Any]:
+        """Build the agent behind one :data:`TOGGLEABLE_AGENTS` flag.
+
+        Used to enable a feature on a running system; follows the same
+        lazy/eager choice as startup.  Returns the refs it added.
+        """
+        if flag not in TOGGLEABLE_AGENTS:
+            raise ValueError(f"{flag} cannot be enabled at runtime")
+        feature = flag.removeprefix("enable_")
+        before = set(refs)
+        if self.config.flags.enable_lazy_agents and feature in _LAZY_FEATURES:
+            self._register_lazy_feature(feature, network, ai_client, refs)
+        else:
+            builder = getattr(self, f"_build_{feature}")
+            args = (network, ai_client) if feature in _AI_FEATURES else (network,)
+            refs.update(self._timed(feature, builder, *args))
+        return {key: refs[key] for key in set(refs) - before}
+
+    def build_deferred(
+        self,
+        network: AgentNetwork,
+        system: Optional["JarvisSystem"],
+        refs: Dict[str, Any],
+    ) -> Dict[str, Any]:
+        """Build the night workers skipped by a lazy :meth:`build_all_async`.
+
+        Updates and returns *refs*.  Safe to call more than once.
+        """
+        if system is None or refs.get("night_agents") is not None:
+            return refs
+        if self.config.flags.enable_night_mode:
+            refs.update(self._timed("night_agents", self._build_night_workers, network))
+        self._add_self_improvement(network, system, refs)
+        refs.setdefault("night_agents", [])
         return refs
 
+    def _add_self_improvement(
+        self,
+        network: AgentNetwork,
+        system: Optional["JarvisSystem"],
+        refs: Dict[str, Any],
+    ) -> None:
+        if not self.config.flags.enable_self_improvement or system is None:
+            return
+        si_refs = self._timed(
+            "self_improvement",
+            self._build_self_improvement,
+            network,
+            system,
+            refs.get("todo_service"),
+        )
+        refs.update(si_refs)
+        night_agents = refs.get("night_agents", [])
+        night_agents.append(si_refs["self_improvement_agent"])
+        refs["night_agents"] = night_agents
+
     # ----- individual builders -----
     def _build_memory(
         self, network: AgentNetwork, ai_client: BaseAIClient
@@ -221,22 +451,22 @@ class AgentFactory:
             short_term_ttl_days=self.config.memory_short_term_ttl_days,
             auto_promote=self.config.memory_auto_promote,
             ai_client=ai_client,
+            snapshot=self.snapshot,
         )
 
         # Vector memory requires an API key for embeddings
         vector_memory = None
         if self.config.api_key:
             try:
-                vector_memory = VectorMemoryService(
-                    persist_directory=self.config.memory_dir,
-                    api_key=self.config.api_key,
+                vector_memory = self.services.resolve(
+                    "vector_memory", self.config.memory_dir, self.config.api_key
                 )
             except Exception as exc:
                 self.logger.log(
                     "WARNING", "VectorMemoryService init failed", str(exc)
                 )
 
-        fact_service = FactMemoryService()
+        fact_service = self.services.resolve("fact_memory")
         memory_agent = MemoryAgent(
             memory_service=vector_memory,
             fact_service=fact_service,
@@ -252,6 +482,15 @@ class AgentFactory:
             "memory_agent": memory_agent,
         }
 
+    def _create_fast_classifier(
+        self, scope: ServiceContainer, vector_memory: VectorMemoryService
+    ) -> Any:
+        from ..agents.nlu_agent.fast_classifier import FastPathClassifier
+
+        return FastPathClassifier(
+            vector_memory, scope.resolve("logger"), snapshot=self.snapshot
+        )
+
     def _build_nlu(
         self,
         network: AgentNetwork,
@@ -260,9 +499,7 @@ class AgentFactory:
     ) -> Dict[str, Any]:
         fast_classifier = None
         if self.config.use_fast_classifier and vector_memory:
-            from ..agents.nlu_agent.fast_classifier import FastPathClassifier
-
-            fast_classifier = FastPathClassifier(vector_memory, self.logger)
+            fast_classifier = self.services.resolve("fast_classifier", vector_memory)
 
         nlu_agent = NLUAgent(
             ai_client,
@@ -277,7 +514,9 @@ class AgentFactory:
     def _build_calendar(
         self, network: AgentNetwork, ai_client: BaseAIClient
     ) -> Dict[str, Any]:
-        calendar_service = CalendarService(self.config.calendar_api_url)
+        calendar_service = self.services.resolve(
+            "calendar_service", self.config.calendar_api_url
+        )
         calendar_agent = CollaborativeCalendarAgent(
             ai_client, calendar_service, self.logger
         )
@@ -304,10 +543,10 @@ class AgentFactory:
             return {}
 
         try:
-            search_service = GoogleSearchService(
-                api_key=self.config.google_search_api_key,
-                search_engine_id=self.config.google_search_engine_id,
-                logger=self.logger,
+            search_service = self.services.resolve(
+                "search_service",
+                self.config.google_search_api_key,
+                self.config.google_search_engine_id,
             )
             search_agent = SearchAgent(search_service, self.logger, ai_client=ai_client)
             network.register_agent(search_agent)
@@ -321,17 +560,16 @@ class AgentFactory:
         network.register_agent(protocol_agent)
         return {"protocol_agent": protocol_agent}
 
-    def _build_lights(
-        self, network: AgentNetwork, ai_client: BaseAIClient
-    ) -> Dict[str, Any]:
+    def _lights_backend(self) -> Optional[Tuple[str, Dict[str, Any]]]:
+        """Resolve the configured lighting backend, or ``None`` to skip lights."""
         backend_type = self.config.lighting_backend.lower()
-        backend_kwargs = {}
+        backend_kwargs: Dict[str, Any] = {}
         if backend_type == "phillips_hue":
             if not self.config.hue_bridge_ip:
                 self.logger.log(
                     "INFO", "Skipping lights agent", "No Hue bridge IP configured"
                 )
-                return {}
+                return None
             backend_kwargs = {
                 "bridge_ip": self.config.hue_bridge_ip,
                 "username": self.config.hue_username,
@@ -347,48 +585,74 @@ class AgentFactory:
                 f"Using 'phillips_hue' as fallback. Got: {backend_type}",
             )
             if not self.config.hue_bridge_ip:
-                return {}
+                return None
             backend_type = "phillips_hue"
             backend_kwargs = {
                 "bridge_ip": self.config.hue_bridge_ip,
                 "username": self.config.hue_username,
             }
+        return backend_type, backend_kwargs
+
+    def _create_lights(
+        self, ai_client: BaseAIClient, backend: Tuple[str, Dict[str, Any]]
+    ) -> Dict[str, Any]:
+        backend_type, backend_kwargs = backend
+        lights_agent = create_lighting_agent(
+            backend_type=backend_type,
+            ai_client=ai_client,
+            logger=self.logger,
+            **backend_kwargs,
+        )
+        return {"lights_agent": lights_agent}
+
+    def _build_lights(
+        self, network: AgentNetwork, ai_client: BaseAIClient
+    ) -> Dict[str, Any]:
+        backend = self._lights_backend()
+        if backend is None:
+            return {}
 
         try:
-            lights_agent = create_lighting_agent(
-                backend_type=backend_type,
-                ai_client=ai_client,
-                logger=self.logger,
-                **backend_kwargs,
-            )
+            refs = self._create_lights(ai_client, backend)
+            lights_agent = refs["lights_agent"]
             network.register_agent(lights_agent)
             network.agents["PhillipsHueAgent"] = lights_agent
             network.logger.log(
                 "INFO",
                 "Registered LightingAgent with alias",
-                f"PhillipsHueAgent (backend: {backend_type})",
+                f"PhillipsHueAgent (backend: {backend[0]})",
             )
-            return {"lights_agent": lights_agent}
+            return refs
         except Exception as exc:
             self.logger.log(
-                "ERROR", f"Failed to create {backend_type} lighting agent", str(exc)
+                "ERROR", f"Failed to create {backend[0]} lighting agent", str(exc)
             )
             return {}
 
-    def _build_canvas(
-        self, network: AgentNetwork, ai_client: BaseAIClient
-    ) -> Dict[str, Any]:
+    def _create_canvas(self, ai_client: BaseAIClient) -> Dict[str, Any]:
         canvas_service = CanvasService(logger=self.logger)
         canvas_agent = CanvasAgent(ai_client, canvas_service, self.logger)
-        network.register_agent(canvas_agent)
         return {
             "canvas_service": canvas_service,
             "canvas_agent": canvas_agent,
         }
 
-    def _build_roku(
+    def _build_canvas(
         self, network: AgentNetwork, ai_client: BaseAIClient
     ) -> Dict[str, Any]:
+        refs = self._create_canvas(ai_client)
+        network.register_agent(refs["canvas_agent"])
+        return refs
+
+    def _roku_configured(self) -> bool:
+        """Cheap check for whether a Roku agent could be built at all."""
+        from ..services.roku_discovery import RokuDeviceRegistry
+
+        if self.config.roku_ip_address or self.config.roku_ip_addresses:
+            return True
+        return bool(RokuDeviceRegistry.load().devices)
+
+    def _create_roku(self, ai_client: BaseAIClient) -> Dict[str, Any]:
         from ..services.roku_discovery import RokuDeviceRegistry
 
         # Load persisted registry (or start fresh)
@@ -422,19 +686,26 @@ class AgentFactory:
             first = next(iter(registry.devices))
             registry.set_default(first)
 
+        roku_agent = RokuAgent(
+            ai_client=ai_client,
+            device_registry=registry,
+            username=self.config.roku_username,
+            password=self.config.roku_password,
+            logger=self.logger,
+        )
+        return {"roku_agent": roku_agent, "roku_registry": registry}
+
+    def _build_roku(
+        self, network: AgentNetwork, ai_client: BaseAIClient
+    ) -> Dict[str, Any]:
         try:
-            roku_agent = RokuAgent(
-                ai_client=ai_client,
-                device_registry=registry,
-                username=self.config.roku_username,
-                password=self.config.roku_password,
-                logger=self.logger,
-            )
-            network.register_agent(roku_agent)
-            return {"roku_agent": roku_agent, "roku_registry": registry}
+            refs = self._create_roku(ai_client)
         except Exception as exc:
             self.logger.log("WARNING", "RokuAgent init failed", str(exc))
             return {}
+        if refs:
+            network.register_agent(refs["roku_agent"])
+        return refs
 
     @staticmethod
     def _probe_roku_device(ip: str) -> Optional[Dict[str, str]]:
@@ -472,7 +743,7 @@ class AgentFactory:
     ) -> Dict[str, Any]:
         """Build and register TodoAgent with SQLite-backed TodoService."""
         try:
-            todo_service = TodoService(logger=self.logger)
+            todo_service = self.services.resolve("todo_service")
             todo_agent = TodoAgent(
                 ai_client=ai_client,
                 todo_service=todo_service,
@@ -521,51 +792,59 @@ class AgentFactory:
             self.logger.log("WARNING", "HealthAgent init failed", str(exc))
             return {}
 
+    def _create_device_monitor(self) -> Dict[str, Any]:
+        from ..agents.device_monitor_agent import DeviceMonitorAgent
+        from ..services.metrics_store import MetricsStore
+
+        device_service = DeviceMonitorService()
+        metrics_store = MetricsStore(logger=self.logger)
+        device_agent = DeviceMonitorAgent(
+            device_service=device_service,
+            metrics_store=metrics_store,
+            logger=self.logger,
+            probe_interval=self.config.device_monitor_probe_interval,
+        )
+        return {
+            "device_service": device_service,
+            "metrics_store": metrics_store,
+            "device_monitor_agent": device_agent,
+        }
+
     def _build_device_monitor(self, network: AgentNetwork) -> Dict[str, Any]:
         """Build and register DeviceMonitorAgent for host hardware monitoring."""
         try:
-            from ..agents.device_monitor_agent import DeviceMonitorAgent
-            from ..services.metrics_store import MetricsStore
-
-            device_service = DeviceMonitorService()
-            metrics_store = MetricsStore(logger=self.logger)
-            device_agent = DeviceMonitorAgent(
-                device_service=device_service,
-                metrics_store=metrics_store,
-                logger=self.logger,
-                probe_interval=self.config.device_monitor_probe_interval,
-            )
-            network.register_agent(device_agent)
-            return {
-                "device_service": device_service,
-                "metrics_store": metrics_store,
-                "device_monitor_agent": device_agent,
-            }
+            refs = self._create_device_monitor()
+            network.register_agent(refs["device_monitor_agent"])
+            return refs
         except Exception as exc:
             self.logger.log("WARNING", "DeviceMonitorAgent init failed", str(exc))
             return {}
 
+    def _create_server_manager(self) -> Dict[str, Any]:
+        from ..agents.server_manager_agent import ServerManagerAgent
+        from ..services.server_manager_service import ServerManagerService
+
+        server_service = ServerManagerService(
+            registry_path=self.config.server_registry_path,
+            logger=self.logger,
+        )
+        server_service.load_registry()
+        server_agent = ServerManagerAgent(
+            server_service=server_service,
+            logger=self.logger,
+            monitor_interval=self.config.server_monitor_interval,
+        )
+        return {
+            "server_service": server_service,
+            "server_manager_agent": server_agent,
+        }
+
     def _build_server_manager(self, network: AgentNetwork) -> Dict[str, Any]:
         """Build and register ServerManagerAgent for server lifecycle management."""
         try:
-            from ..agents.server_manager_agent import ServerManagerAgent
-            from ..services.server_manager_service import ServerManagerService
-
-            server_service = ServerManagerService(
-                registry_path=self.config.server_registry_path,
-                logger=self.logger,
-            )
-            server_service.load_registry()
-            server_agent = ServerManagerAgent(
-                server_service=server_service,
-                logger=self.logger,
-                monitor_interval=self.config.server_monitor_interval,
-            )
-            network.register_agent(server_agent)
-            return {
-                "server_service": server_service,
-                "server_manager_agent": server_agent,
-            }
+            refs = self._create_server_manager()
+            network.register_agent(refs["server_manager_agent"])
+            return refs
         except Exception as exc:
             self.logger.log("WARNING", "ServerManagerAgent init failed", str(exc))
             return {}
@@ -621,13 +900,15 @@ class AgentFactory:
             self.logger.log("WARNING", "CodingAgent init failed", str(exc))
             return {}
 
-    def _build_night_agents(
+    def _build_night_controller(
         self, network: AgentNetwork, system: "JarvisSystem"
     ) -> Dict[str, Any]:
-        night_agents: list[NightAgent] = []
         controller = NightModeControllerAgent(system, self.logger)
         network.register_agent(controller)
+        return {"night_controller": controller}
 
+    def _build_night_workers(self, network: AgentNetwork) -> Dict[str, Any]:
+        night_agents: list[NightAgent] = []
         cleanup_agent = LogCleanupAgent(logger=self.logger)
         network.register_night_agent(cleanup_agent)
         night_agents.append(cleanup_agent)
@@ -636,10 +917,14 @@ class AgentFactory:
         network.register_night_agent(trace_agent)
         night_agents.append(trace_agent)
 
-        return {
-            "night_controller": controller,
-            "night_agents": night_agents,
-        }
+        return {"night_agents": night_agents}
+
+    def _build_night_agents(
+        self, network: AgentNetwork, system: "JarvisSystem"
+    ) -> Dict[str, Any]:
+        refs = self._build_night_controller(network, system)
+        refs.update(self._build_night_workers(network))
+        return refs
 
     def _build_self_improvement(
         self,
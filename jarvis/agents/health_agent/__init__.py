@@ -20,6 +20,7 @@ from .models import (
 from .probes import probe_agents, probe_network
 from .dependency_map import build_dependency_graph
 from .report_writer import ReportWriter
+from .store import HealthStore
 
 
 class HealthAgent(NetworkAgent):
@@ -38,7 +39,9 @@ class HealthAgent(NetworkAgent):
         self._probe_interval = probe_interval
         self._report_interval = report_interval
         self._monitor_task: Optional[asyncio.Task] = None
-        self._last_snapshot: Optional[SystemHealthSnapshot] = None
+        self.store = HealthStore()
+        # Store version current_status.md was last written for
+        self._status_file_version = 0
         self._component_statuses: Dict[str, ComponentStatus] = {}
         self._incidents: List[IncidentRecord] = []
         self._error_counts: Dict[str, int] = {}
@@ -54,6 +57,10 @@ class HealthAgent(NetworkAgent):
             "incident_list": self._incident_list,
         }
 
+    @property
+    def _last_snapshot(self) -> Optional[SystemHealthSnapshot]:
+        return self.store.snapshot
+
     @property
     def description(self) -> str:
         return (
@@ -102,16 +109,17 @@ class HealthAgent(NetworkAgent):
             try:
                 await asyncio.sleep(self._probe_interval)
                 snapshot = await self._build_snapshot()
-                self._last_snapshot = snapshot
+                self.store.update(snapshot)
 
                 # Track status transitions and manage incidents
                 await self._process_transitions(snapshot)
 
-                # Write status file
-                try:
-                    self.report_writer.write_status_file(snapshot)
-                except Exception as exc:
-                    self.logger.log("WARNING", "Failed to write status file", str(exc))
+                # Let routing fail fast on backends the probes found down
+                await self._feed_dependency_health(snapshot)
+
+                # Rewrite the status file only when the health state moved;
+                # live readings are served from the store
+                self._refresh_status_file()
 
                 # Periodic daily report
                 now = datetime.now()
@@ -127,6 +135,22 @@ class HealthAgent(NetworkAgent):
             except Exception as exc:
                 self.logger.log("ERROR", "Health monitor error", str(exc))
 
+    def _refresh_status_file(self) -> None:
+        """Rewrite the status file if the store's state is newer than it.
+
+        HTTP readers update the store too, so the cycle that notices a
+        change is not always this one; the version catches it either way.
+        """
+        version = self.store.version
+        if version <= self._status_file_version or self.store.snapshot is None:
+            return
+        try:
+            self.report_writer.write_status_file(self.store.snapshot)
+        except Exception as exc:
+            self.logger.log("WARNING", "Failed to write status file", str(exc))
+            return
+        self._status_file_version = version
+
     async def _build_snapshot(self) -> SystemHealthSnapshot:
         """Build a full system health snapshot."""
         agent_statuses = probe_agents(self.network)
@@ -153,7 +177,7 @@ class HealthAgent(NetworkAgent):
         # Managed server probes (from ServerManagerAgent)
         if self.network and "ServerManagerAgent" in self.network.agents:
             try:
-                server_agent = self.network.agents["ServerManagerAgent"]
+                server_agent = await self.network.get_agent("ServerManagerAgent")
                 server_probes = await server_agent.get_health_probes()
                 service_statuses.extend(server_probes)
             except Exception:
@@ -188,6 +212,18 @@ class HealthAgent(NetworkAgent):
             summary=summary,
         )
 
+    async def _feed_dependency_health(self, snapshot: SystemHealthSnapshot) -> None:
+        """Push service probe verdicts and agent-provided probes to routing."""
+        tracker = getattr(self.network, "dependency_health", None)
+        if tracker is None:
+            return
+        for result in snapshot.service_statuses:
+            if result.status == ComponentStatus.HEALTHY:
+                tracker.observe_probe(result.component, True)
+            elif result.status == ComponentStatus.UNHEALTHY:
+                tracker.observe_probe(result.component, False, result.message)
+        await tracker.probe_all()
+
     def _compute_overall_status(self, results: List[ProbeResult]) -> ComponentStatus:
         """Compute overall system status from all probe results."""
         if not results:
@@ -239,6 +275,7 @@ class HealthAgent(NetworkAgent):
                     description=result.message,
                     probe_results=[result],
                 )
+                incident.record("opened", result.message, new_status)
                 self._incidents.append(incident)
                 try:
                     self.report_writer.write_incident_report(incident)
@@ -257,6 +294,11 @@ class HealthAgent(NetworkAgent):
                     if inc.component == result.component and inc.is_active:
                         inc.resolved_at = datetime.now()
                         inc.actions_taken.append("Auto-resolved: component returned to healthy")
+                        inc.record(
+                            "resolved",
+                            "Auto-resolved: component returned to healthy",
+                            new_status,
+                        )
                         try:
                             self.report_writer.update_incident_report(inc)
                         except Exception:
@@ -265,6 +307,16 @@ class HealthAgent(NetworkAgent):
                     result.component, old_status, new_status, "Recovered"
                 )
 
+            else:
+                # Moved between degraded and unhealthy: extend the timeline
+                for inc in self._incidents:
+                    if inc.component == result.component and inc.is_active:
+                        inc.record("status_change", result.message, new_status)
+                        try:
+                            self.report_writer.update_incident_report(inc)
+                        except Exception:
+                            pass
+
     async def _broadcast_health_alert(
         self,
         component: str,
@@ -348,7 +400,7 @@ class HealthAgent(NetworkAgent):
     async def _system_health_check(self, **kwargs) -> AgentResponse:
         """Full system health snapshot."""
         snapshot = await self._build_snapshot()
-        self._last_snapshot = snapshot
+        self.store.update(snapshot)
 
         all_results = (
             snapshot.agent_statuses
@@ -522,7 +574,7 @@ class HealthAgent(NetworkAgent):
             content = self.report_writer.read_report(path)
         else:
             snapshot = await self._build_snapshot()
-            self._last_snapshot = snapshot
+            self.store.update(snapshot)
             path = self.report_writer.write_status_file(snapshot)
             content = self.report_writer.read_report(path)
 
@@ -535,7 +587,12 @@ class HealthAgent(NetworkAgent):
 
     async def _dependency_map(self, **kwargs) -> AgentResponse:
         """Generate dependency graph."""
-        nodes = build_dependency_graph(self.network, self._component_statuses)
+        statuses = dict(self._component_statuses)
+        tracker = getattr(self.network, "dependency_health", None)
+        if tracker is not None:
+            for dep in tracker.down():
+                statuses[dep] = ComponentStatus.UNHEALTHY
+        nodes = build_dependency_graph(self.network, statuses)
         path = self.report_writer.write_dependency_map(nodes)
 
         return AgentResponse(
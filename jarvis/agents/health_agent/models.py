@@ -45,6 +45,24 @@ class ProbeResult:
         return result
 
 
+@dataclass
+class IncidentEvent:
+    """One entry in an incident's append-only timeline."""
+
+    kind: str  # "opened", "status_change", "resolved"
+    message: str = ""
+    status: Optional[ComponentStatus] = None
+    timestamp: datetime = field(default_factory=datetime.now)
+
+    def to_dict(self) -> Dict[str, Any]:
+        return {
+            "kind": self.kind,
+            "message": self.message,
+            "status": self.status.value if self.status else None,
+            "timestamp": self.timestamp.isoformat(),
+        }
+
+
 @dataclass
 class IncidentRecord:
     id: str = field(default_factory=lambda: str(uuid.uuid4())[:8])
@@ -56,6 +74,15 @@ class IncidentRecord:
     resolved_at: Optional[datetime] = None
     probe_results: List[ProbeResult] = field(default_factory=list)
     actions_taken: List[str] = field(default_factory=list)
+    timeline: List[IncidentEvent] = field(default_factory=list)
+
+    def record(
+        self, kind: str, message: str = "", status: Optional[ComponentStatus] = None
+    ) -> IncidentEvent:
+        """Append an event to the timeline; earlier events are never edited."""
+        event = IncidentEvent(kind, message, status)
+        self.timeline.append(event)
+        return event
 
     @property
     def is_active(self) -> bool:
@@ -79,6 +106,7 @@ class IncidentRecord:
             "duration_seconds": round(self.duration_seconds, 1),
             "probe_results": [p.to_dict() for p in self.probe_results],
             "actions_taken": self.actions_taken,
+            "timeline": [e.to_dict() for e in self.timeline],
         }
 
 
@@ -1,13 +1,36 @@
 from __future__ import annotations
+import hashlib
 import os
+import tempfile
 from datetime import datetime, timedelta
 from pathlib import Path
-from typing import List, Optional
-from .models import SystemHealthSnapshot, IncidentRecord, DependencyNode
+from typing import Dict, List, Optional, Tuple
+from .models import SystemHealthSnapshot, IncidentEvent, IncidentRecord, DependencyNode
+
+
+def _atomic_write(path: Path, content: str) -> None:
+    """Replace *path* so readers never see a half-written file."""
+    fd, tmp = tempfile.mkstemp(dir=path.parent, prefix=f".{path.name}.", suffix=".tmp")
+    try:
+        with os.fdopen(fd, "w") as f:
+            f.write(content)
+        os.replace(tmp, path)
+    except BaseException:
+        try:
+            os.unlink(tmp)
+        except OSError:
+            pass
+        raise
 
 
 class ReportWriter:
-    """Writes health reports as markdown files."""
+    """Writes health reports as markdown files.
+
+    Status and dependency-map files are only replaced when their content
+    (ignoring the ``Updated`` line) differs from what was last written.
+    Incident reports are append-only: the header is written once and each
+    new timeline event is appended.
+    """
 
     def __init__(self, report_dir: Optional[str] = None):
         if report_dir:
@@ -17,13 +40,29 @@ class ReportWriter:
         self.report_dir.mkdir(parents=True, exist_ok=True)
         (self.report_dir / "incidents").mkdir(exist_ok=True)
         (self.report_dir / "daily").mkdir(exist_ok=True)
+        self._digests: Dict[Path, str] = {}
+        # Incident id -> (report path, timeline events already in the file)
+        self._incident_files: Dict[str, Tuple[Path, int]] = {}
+        self.writes = 0
+        self.skipped = 0
+
+    def _publish(self, path: Path, title: str, updated: datetime, body: List[str]) -> bool:
+        """Write *title*, an Updated line and *body* unless *body* is unchanged."""
+        text = "\n".join(body)
+        digest = hashlib.sha1(text.encode()).hexdigest()
+        if self._digests.get(path) == digest and path.exists():
+            self.skipped += 1
+            return False
+        header = [title, f"**Updated:** {updated.strftime('%Y-%m-%d %H:%M:%S')}"]
+        _atomic_write(path, "\n".join(header) + "\n" + text)
+        self._digests[path] = digest
+        self.writes += 1
+        return True
 
     def write_status_file(self, snapshot: SystemHealthSnapshot) -> str:
-        """Write current_status.md. Returns the file path."""
+        """Write current_status.md if its content changed. Returns the file path."""
         path = self.report_dir / "current_status.md"
         lines = [
-            "# System Health Status",
-            f"**Updated:** {snapshot.timestamp.strftime('%Y-%m-%d %H:%M:%S')}",
             f"**Overall:** {snapshot.overall_status.value.upper()}",
             "",
         ]
@@ -72,13 +111,40 @@ class ReportWriter:
             lines.append("")
 
         lines.append(f"**Summary:** {snapshot.summary}")
-        path.write_text("\n".join(lines))
+        self._publish(path, "# System Health Status", snapshot.timestamp, lines)
         return str(path)
 
     def write_incident_report(self, incident: IncidentRecord) -> str:
-        """Write an incident report markdown file. Returns file path."""
-        filename = f"{incident.started_at.strftime('%Y-%m-%d_%H-%M')}_{incident.component}_{incident.severity.value}.md"
-        path = self.report_dir / "incidents" / filename
+        """Write or extend an incident report. Returns file path.
+
+        The first call writes the header and the timeline so far; later
+        calls append only the events recorded since.
+        """
+        known = self._incident_files.get(incident.id)
+        if known is None or not known[0].exists():
+            filename = f"{incident.started_at.strftime('%Y-%m-%d_%H-%M')}_{incident.component}_{incident.severity.value}.md"
+            path = self.report_dir / "incidents" / filename
+            lines = self._incident_header(incident)
+            lines.extend(self._incident_event_lines(incident, incident.timeline))
+            _atomic_write(path, "\n".join(lines) + "\n")
+            self.writes += 1
+        else:
+            path, written = known
+            new_events = incident.timeline[written:]
+            if not new_events:
+                self.skipped += 1
+                return str(path)
+            with path.open("a") as f:
+                f.write("\n".join(self._incident_event_lines(incident, new_events)) + "\n")
+            self.writes += 1
+        self._incident_files[incident.id] = (path, len(incident.timeline))
+        return str(path)
+
+    def update_incident_report(self, incident: IncidentRecord) -> str:
+        """Append new timeline events to an incident report. Returns file path."""
+        return self.write_incident_report(incident)
+
+    def _incident_header(self, incident: IncidentRecord) -> List[str]:
         lines = [
             f"# Incident: {incident.title}",
             "",
@@ -86,7 +152,6 @@ class ReportWriter:
             f"- **Component:** {incident.component}",
             f"- **Severity:** {incident.severity.value}",
             f"- **Started:** {incident.started_at.isoformat()}",
-            f"- **Status:** {'Active' if incident.is_active else 'Resolved'}",
             "",
             "## Description",
             incident.description,
@@ -99,30 +164,26 @@ class ReportWriter:
                 lines.append(f"- [{pr.timestamp.strftime('%H:%M:%S')}] {pr.component}: {pr.status.value} — {pr.message}")
             lines.append("")
 
-        if incident.actions_taken:
-            lines.append("## Actions Taken")
-            for action in incident.actions_taken:
-                lines.append(f"- {action}")
-            lines.append("")
-
-        if incident.resolved_at:
-            lines.append(f"**Resolved at:** {incident.resolved_at.isoformat()}")
-            lines.append(f"**Duration:** {incident.duration_seconds:.0f}s")
-
-        path.write_text("\n".join(lines))
-        return str(path)
-
-    def update_incident_report(self, incident: IncidentRecord) -> str:
-        """Update an existing incident report. Returns file path."""
-        # Just rewrite it
-        return self.write_incident_report(incident)
+        lines.append("## Timeline")
+        return lines
+
+    def _incident_event_lines(
+        self, incident: IncidentRecord, events: List[IncidentEvent]
+    ) -> List[str]:
+        lines = []
+        for event in events:
+            status = f" ({event.status.value})" if event.status else ""
+            lines.append(
+                f"- [{event.timestamp.isoformat(timespec='seconds')}] **{event.kind}**{status}: {event.message}"
+            )
+            if event.kind == "resolved" and incident.resolved_at:
+                lines.append(f"- **Duration:** {incident.duration_seconds:.0f}s")
+        return lines
 
     def write_dependency_map(self, nodes: List[DependencyNode]) -> str:
-        """Write dependency_map.md with Mermaid diagram. Returns file path."""
+        """Write dependency_map.md with Mermaid diagram if it changed. Returns file path."""
         path = self.report_dir / "dependency_map.md"
         lines = [
-            "# System Dependency Map",
-            f"**Updated:** {datetime.now().strftime('%Y-%m-%d %H:%M:%S')}",
             "",
             "```mermaid",
             "graph TD",
@@ -144,7 +205,7 @@ class ReportWriter:
                 lines.append(f"    {safe_name} --> {safe_dep}")
 
         lines.append("```")
-        path.write_text("\n".join(lines))
+        self._publish(path, "# System Dependency Map", datetime.now(), lines)
         return str(path)
 
     def read_report(self, path: str) -> Optional[str]:
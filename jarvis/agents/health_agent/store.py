@@ -0,0 +1,63 @@
+"""In-memory health state with change detection.
+
+Every probe cycle produces a fresh :class:`SystemHealthSnapshot`, but the
+health *state* — which components are healthy, which incidents are open —
+rarely moves between cycles; only readings such as CPU percent or probe
+latency do.  :class:`HealthStore` keeps the latest snapshot serialized
+once per cycle, so HTTP readers get it from memory with an ETag instead
+of re-probing, and reports whether the state changed so the markdown
+status file is rewritten only when it would say something new.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import json
+from datetime import datetime
+from typing import Optional, Tuple
+
+from .models import SystemHealthSnapshot
+
+
+def state_key(snapshot: SystemHealthSnapshot) -> Tuple:
+    """The parts of *snapshot* that count as a change of health state."""
+    results = snapshot.agent_statuses + snapshot.service_statuses + snapshot.resource_statuses
+    return (
+        snapshot.overall_status.value,
+        tuple(sorted((r.component, r.status.value) for r in results)),
+        tuple(sorted(
+            (i.id, i.severity.value, len(i.timeline)) for i in snapshot.active_incidents
+        )),
+    )
+
+
+class HealthStore:
+    """Latest snapshot, its JSON body and ETag, and a state version."""
+
+    def __init__(self) -> None:
+        self.snapshot: Optional[SystemHealthSnapshot] = None
+        self.body: bytes = b""
+        self.etag: str = ""
+        self.version = 0
+        self.changed_at: Optional[datetime] = None
+        self._state: Optional[Tuple] = None
+
+    def update(self, snapshot: SystemHealthSnapshot) -> bool:
+        """Store *snapshot*; returns True when the health state changed."""
+        self.snapshot = snapshot
+        self.body = json.dumps(snapshot.to_dict(), separators=(",", ":"), default=str).encode()
+        self.etag = f'"{hashlib.sha1(self.body).hexdigest()[:20]}"'
+        state = state_key(snapshot)
+        if state == self._state:
+            return False
+        self._state = state
+        self.version += 1
+        self.changed_at = snapshot.timestamp
+        return True
+
+    def matches(self, if_none_match: Optional[str]) -> bool:
+        """Whether an ``If-None-Match`` header names the current body."""
+        if not if_none_match or not self.etag:
+            return False
+        tags = {t.strip().removeprefix("W/") for t in if_none_match.split(",")}
+        return "*" in tags or self.etag in tags
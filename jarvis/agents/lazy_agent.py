@@ -0,0 +1,115 @@
+from __future__ import annotations
+
+import asyncio
+import time
+from typing import Any, Callable, Dict, Optional, Set
+
+from ..logging import JarvisLogger
+from .base import NetworkAgent
+from .message import Message
+
+AgentBuilder = Callable[[], Dict[str, Any]]
+
+
+class LazyAgent(NetworkAgent):
+    """Placeholder that advertises an agent's capabilities until first use.
+
+    ``builder`` constructs the real agent and its services without touching
+    the network and returns the same refs dict the factory would; the agent
+    itself is stored under ``agent_key``.  It runs on a worker thread the
+    first time the stub receives a capability request, is asked to run a
+    capability, or is materialized explicitly (e.g. by the post-startup
+    warm-up).  The real agent then replaces the stub in the network under
+    every name the stub was registered as.
+    """
+
+    def __init__(
+        self,
+        name: str,
+        agent_cls: type,
+        builder: AgentBuilder,
+        agent_key: str,
+        logger: Optional[JarvisLogger] = None,
+        refs: Optional[Dict[str, Any]] = None,
+    ) -> None:
+        super().__init__(name, logger)
+        self.agent_cls = agent_cls
+        self._capabilities: Set[str] = set(agent_cls.CAPABILITIES)
+        self._builder = builder
+        self._agent_key = agent_key
+        self._refs = refs
+        self._agent: Optional[NetworkAgent] = None
+        self._error: Optional[BaseException] = None
+        self._task: Optional[asyncio.Task] = None
+        self.build_ms: Optional[float] = None
+
+    @property
+    def description(self) -> str:
+        doc = (self.agent_cls.__doc__ or "").strip()
+        return doc.splitlines()[0] if doc else f"{self.name} (not loaded)"
+
+    @property
+    def capabilities(self) -> Set[str]:
+        return set(self._capabilities)
+
+    @property
+    def is_materialized(self) -> bool:
+        return self._agent is not None
+
+    @property
+    def agent(self) -> Optional[NetworkAgent]:
+        """The real agent once built, otherwise ``None``."""
+        return self._agent
+
+    async def materialize(self) -> NetworkAgent:
+        """Build the real agent (once) and swap it into the network."""
+        if self._agent is not None:
+            return self._agent
+        if self._error is not None:
+            raise RuntimeError(f"{self.name} unavailable: {self._error}")
+        if self._task is None:
+            self._task = asyncio.create_task(self._build())
+        return await asyncio.shield(self._task)
+
+    async def _build(self) -> NetworkAgent:
+        start = time.perf_counter()
+        try:
+            refs = await asyncio.to_thread(self._builder)
+            agent = refs.get(self._agent_key)
+            if agent is None:
+                raise RuntimeError("builder returned no agent")
+        except BaseException as exc:
+            self._error = exc
+            self.build_ms = (time.perf_counter() - start) * 1000
+            self.logger.log("WARNING", f"{self.name} failed to load", str(exc))
+            if self.network:
+                self.network.unregister_agent(self)
+            raise RuntimeError(f"{self.name} unavailable: {exc}") from exc
+
+        self.build_ms = (time.perf_counter() - start) * 1000
+        self._agent = agent
+        if self._refs is not None:
+            self._refs.update(refs)
+        if self.network:
+            self.network.replace_agent(self, agent)
+        self.logger.log(
+            "INFO",
+            f"{self.name} materialized",
+            f"{self.build_ms:.1f} ms",
+        )
+        return agent
+
+    async def receive_message(self, message: Message) -> None:
+        if self._agent is None and message.message_type != "capability_request":
+            return  # nothing to react to until something needs the agent
+        try:
+            agent = await self.materialize()
+        except RuntimeError as exc:
+            if message.message_type == "capability_request":
+                await self.send_error(message.from_agent, str(exc), message.request_id)
+            return
+        await agent.receive_message(message)
+
+    async def run_capability(self, capability: str, **kwargs: Any) -> Any:
+        agent = await self.materialize()
+        return await agent.run_capability(capability, **kwargs)
@@ -18,6 +18,16 @@ from ..response import AgentResponse, ErrorInfo
 class LightingAgent(NetworkAgent):
     """Unified lighting agent supporting multiple backends (Phillips Hue, Yeelight, etc.)."""
 
+    CAPABILITIES = frozenset({
+        "lights_on",
+        "lights_off",
+        "lights_brightness",
+        "lights_color",
+        "lights_list",
+        "lights_status",
+        "lights_toggle",
+    })
+
     def __init__(
         self,
         backend: BaseLightingBackend,
@@ -50,15 +60,7 @@ class LightingAgent(NetworkAgent):
 
     @property
     def capabilities(self) -> set[str]:
-        return {
-            "lights_on",
-            "lights_off",
-            "lights_brightness",
-            "lights_color",
-            "lights_list",
-            "lights_status",
-            "lights_toggle",
-        }
+        return set(self.CAPABILITIES)
 
     @property
     def supports_dialogue(self) -> bool:
@@ -134,6 +136,17 @@ class LightingAgent(NetworkAgent):
         """List all lights."""
         return self.backend.list_lights()
 
+    def dependency_probes(self) -> Dict[str, Any]:
+        """Recovery probe for the network's fail-fast routing (Hue only)."""
+        if self._is_yeelight:
+            return {}
+        return {"HueBridge": self._probe_bridge}
+
+    async def _probe_bridge(self) -> bool:
+        loop = asyncio.get_running_loop()
+        lights = await loop.run_in_executor(None, self.backend.list_lights)
+        return isinstance(lights, dict) and "error" not in lights
+
     async def _handle_capability_request(self, message: Message) -> None:
         """Handle incoming capability requests."""
         capability = message.content.get("capability")
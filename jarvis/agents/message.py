@@ -6,7 +6,7 @@ from datetime import datetime
 from typing import Any, Optional
 
 
-@dataclass
+@dataclass(slots=True)
 class Message:
     """Message passed between agents."""
 
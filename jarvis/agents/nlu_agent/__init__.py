@@ -13,6 +13,7 @@ from ...logging import JarvisLogger
 from ...utils import extract_json_from_text
 from ...utils.performance import track_async
 from ...logging.tracer import get_tracer, SpanKind, NullSpan
+from .dag_executor import DagExecution
 
 if TYPE_CHECKING:
     from .fast_classifier import FastPathClassifier
@@ -72,6 +73,7 @@ class NLUAgent(NetworkAgent):
         self.ai_client = ai_client
         self.response_timeout = response_timeout
         self.fast_classifier = fast_classifier
+        self.model_cascade = None  # set externally when cascade is enabled
         self._classification_cache = ClassificationCache(
             ttl=cache_ttl, max_size=cache_max_size
         )
@@ -129,14 +131,11 @@ class NLUAgent(NetworkAgent):
                 )
                 return
 
-        # Add result to agent_results
-        request_info.setdefault("agent_results", []).append(
-            {
-                "from_agent": message.from_agent,
-                "capability": capability,
-                "result": message.content,
-            }
-        )
+        entry = {
+            "from_agent": message.from_agent,
+            "capability": capability,
+            "result": message.content,
+        }
 
         self.logger.log(
             "INFO",
@@ -147,38 +146,23 @@ class NLUAgent(NetworkAgent):
         # Use correlation_id (parent request) for all processing
         request_id = correlation_id
 
-        # Check if this is DAG-based execution
-        dag = request_info.get("dag")
-        if dag is not None:
-            # DAG-based execution
-            if capability:
-                completed_caps = request_info.get("completed_caps", set())
-                running_caps = request_info.get("running_caps", set())
-
-                # Mark capability as completed
-                completed_caps.add(capability)
-                running_caps.discard(capability)
-
-                self.logger.log(
-                    "INFO",
-                    f"Capability '{capability}' completed in DAG",
-                    f"Completed: {len(completed_caps)}/{len(dag)}, Running: {len(running_caps)}",
-                )
-
-                # Check if more capabilities can now run (dependencies satisfied)
-                user_input = request_info.get("user_input", "")
-                context = request_info.get("context", {})
-                allowed_agents = request_info.get("allowed_agents")
-
-                await self._execute_ready_capabilities(
-                    request_id,
-                    dag,
-                    user_input,
-                    context,
-                    allowed_agents,
-                )
+        # DAG-based execution: release the successors this node unblocked
+        execution: Optional[DagExecution] = request_info.get("execution")
+        if execution is not None:
+            ready = execution.complete(capability, entry)
+            self.logger.log(
+                "INFO",
+                f"Capability '{capability}' completed in DAG",
+                f"Released: {ready}, Unfinished: {execution.unfinished()}",
+            )
+            if execution.done:
+                await self._complete_dag_execution(request_id)
+            elif ready:
+                await self._dispatch_dag_nodes(request_id, execution, ready)
             return
 
+        request_info.setdefault("agent_results", []).append(entry)
+
         # Legacy sequential execution handling
         user_input = request_info.get("user_input", "")
         results = request_info.get("agent_results", [])
@@ -394,8 +378,7 @@ class NLUAgent(NetworkAgent):
                 )
 
                 # Clean up
-                if request_id in self.active_requests:
-                    del self.active_requests[request_id]
+                self._forget_request(request_id)
             else:
                 self.logger.log(
                     "ERROR",
@@ -520,29 +503,25 @@ class NLUAgent(NetworkAgent):
             )
             return
 
-        # Multi-capability DAG → parallel execution
-        completed_caps: Set[str] = set()
-        running_caps: Set[str] = set()
-        capability_request_ids: Dict[str, str] = {}
-
+        # Multi-capability DAG → dependency-driven parallel execution
+        execution = DagExecution(dag, context)
         self.active_requests[request_id] = {
             "user_input": user_input,
             "original_requester": original_requester,
             "user_id": user_id,
-            "agent_results": [],
-            "dag": dag,
-            "completed_caps": completed_caps,
-            "running_caps": running_caps,
-            "capability_request_ids": capability_request_ids,
+            "agent_results": execution.results,
+            "execution": execution,
             "original_message_id": message.id,
-            "context": context,
             "allowed_agents": set(allowed_agents) if allowed_agents else None,
+            "trace_id": tracer.current_trace_id() if tracer else None,
+            "parent_span_id": tracer.current_span_id() if tracer else None,
         }
-
-        await self._execute_ready_capabilities(
-            request_id, dag, user_input, context, allowed_agents,
+        execution.timer = asyncio.get_running_loop().call_later(
+            self.response_timeout, self._expire_dag, request_id, execution
         )
 
+        await self._dispatch_dag_nodes(request_id, execution, execution.roots())
+
     @track_async("nlu_reasoning")
     async def classify(
         self,
@@ -650,93 +629,86 @@ class NLUAgent(NetworkAgent):
 
         return True
 
-    async def _execute_ready_capabilities(
-        self,
-        request_id: str,
-        dag: Dict[str, List[str]],
-        user_input: str,
-        context: Dict[str, Any],
-        allowed_agents: Optional[Set[str]],
+    async def _dispatch_dag_nodes(
+        self, request_id: str, execution: DagExecution, capabilities: List[str]
     ) -> None:
-        """
-        Execute all capabilities that have their dependencies satisfied.
-        Capabilities with no dependencies or all dependencies completed can run in parallel.
-        """
+        """Send sub-requests for *capabilities*, which are ready to run."""
         request_info = self.active_requests.get(request_id)
-        if not request_info:
+        if not request_info or request_info.get("execution") is not execution:
             return
 
-        completed_caps = request_info.get("completed_caps", set())
-        running_caps = request_info.get("running_caps", set())
-
-        # Find capabilities ready to execute (dependencies satisfied and not already running/completed)
-        ready_caps = []
-        for cap, deps in dag.items():
-            if cap in completed_caps or cap in running_caps:
-                continue  # Already completed or running
-            # Check if all dependencies are completed
-            if all(dep in completed_caps for dep in deps):
-                ready_caps.append(cap)
-
-        if not ready_caps:
-            # No more capabilities to execute - check if we're done
-            if len(completed_caps) == len(dag):
-                # All capabilities completed, format final response
-                await self._complete_dag_execution(request_id)
-            return
-
-        # Execute all ready capabilities in parallel
         self.logger.log(
             "INFO",
-            f"Executing {len(ready_caps)} capabilities in parallel",
-            f"Capabilities: {ready_caps}",
+            f"Executing {len(capabilities)} capabilities in parallel",
+            f"Capabilities: {capabilities}",
         )
 
-        for cap in ready_caps:
-            running_caps.add(cap)
-            # Use same request_id with capability tracking (simplified)
-            sub_request_id = f"{request_id}:{cap}"  # Simple correlation ID format
-            request_info["capability_request_ids"][cap] = sub_request_id
-
-            # Track sub-request with correlation to parent
-            # Copy original_requester from parent request
-            parent_request_info = self.active_requests.get(request_id, {})
-            self.active_requests[sub_request_id] = {
-                "parent_request_id": request_id,  # For correlation
-                "capability": cap,
-                "user_input": user_input,
-                "current_capability": cap,
-                "original_requester": parent_request_info.get("original_requester"),
-                "user_id": parent_request_info.get("user_id"),
-            }
+        user_input = request_info["user_input"]
+        user_id = request_info.get("user_id")
+        allowed_agents = request_info.get("allowed_agents")
+        sends = []
+        for cap in capabilities:
+            execution.start(cap)
+            capability_data = {"prompt": user_input, "context": execution.context_for(cap)}
+            if user_id is not None:
+                capability_data["user_id"] = user_id
+            # Responses to "parent_id:capability" correlate back to the parent
+            sends.append(
+                self.request_capability(
+                    capability=cap,
+                    data=capability_data,
+                    request_id=f"{request_id}:{cap}",
+                    allowed_agents=allowed_agents,
+                )
+            )
+        await asyncio.gather(*sends)
 
-            # Build context with previous results for dependent capabilities
-            enhanced_context = dict(context)
-            if completed_caps:
-                # Include results from completed capabilities in context
-                results = request_info.get("agent_results", [])
-                enhanced_context["previous_results"] = [
-                    r for r in results if r.get("capability") in completed_caps
-                ]
+    def _expire_dag(self, request_id: str, execution: DagExecution) -> None:
+        """Deadline callback: answer with whatever the DAG has produced."""
+        request_info = self.active_requests.get(request_id)
+        if not request_info or request_info.get("execution") is not execution:
+            return
+        execution.timed_out = execution.unfinished()
+        self.logger.log(
+            "WARNING",
+            f"DAG deadline reached for request {request_id}",
+            f"Unfinished: {execution.timed_out}",
+        )
+        asyncio.create_task(self._complete_dag_execution(request_id))
 
-            # Execute capability (non-blocking - they'll run in parallel)
-            # Use sub_request_id but responses will correlate back to parent
-            capability_data = {"prompt": user_input, "context": enhanced_context}
-            dag_user_id = request_info.get("user_id")
-            if dag_user_id is not None:
-                capability_data["user_id"] = dag_user_id
-            await self.request_capability(
-                capability=cap,
-                data=capability_data,
-                request_id=sub_request_id,
-                allowed_agents=allowed_agents,
-            )
+    def _forget_request(self, request_id: str) -> None:
+        """Drop a tracked request and cancel its DAG deadline, if any."""
+        request_info = self.active_requests.pop(request_id, None)
+        execution = request_info.get("execution") if request_info else None
+        if execution is not None and execution.timer is not None:
+            execution.timer.cancel()
+
+    def _record_dag_span(self, request_info: Dict[str, Any], execution: DagExecution) -> None:
+        tracer = get_tracer()
+        if not tracer:
+            return
+        tracer.record_span(
+            "nlu.dag",
+            trace_id=request_info.get("trace_id"),
+            parent_span_id=request_info.get("parent_span_id"),
+            start_time=execution.started_wall,
+            duration_ms=(time.perf_counter() - execution.started_at) * 1000,
+            kind=SpanKind.AGENT,
+            agent_name="NLUAgent",
+            attributes=execution.summary(),
+            status="ERROR" if execution.timed_out else "OK",
+        )
 
     async def _complete_dag_execution(self, request_id: str) -> None:
         """Format and send final response after all capabilities in DAG are complete."""
         request_info = self.active_requests.get(request_id)
         if not request_info:
             return
+        execution: Optional[DagExecution] = request_info.get("execution")
+        if execution is not None:
+            # Claim the request so a racing deadline cannot answer twice
+            self._forget_request(request_id)
+            self._record_dag_span(request_info, execution)
 
         original_requester = request_info.get("original_requester")
         if not original_requester:
@@ -765,22 +737,28 @@ class NLUAgent(NetworkAgent):
                 else NullSpan()
             )
             async with build_span:
+                cascade_keys: List[Any] = []
                 try:
                     final_response = await self._format_final_response_llm(
-                        user_input, results
+                        user_input, results, cascade_keys
                     )
                 except Exception:
                     final_response = self._build_final_response(user_input, results)
 
+            result: Dict[str, Any] = {"response": final_response, "results": results}
+            if cascade_keys:
+                result["metadata"] = {"cascade_keys": cascade_keys}
+            if execution is not None and execution.timed_out:
+                result["timed_out"] = execution.timed_out
             await self.send_capability_response(
                 to_agent=original_requester,
-                result={"response": final_response, "results": results},
+                result=result,
                 request_id=request_id,
                 original_message_id=request_info.get("original_message_id"),
             )
 
             # Clean up
-            del self.active_requests[request_id]
+            self._forget_request(request_id)
 
         except Exception as e:
             self.logger.log(
@@ -803,8 +781,7 @@ class NLUAgent(NetworkAgent):
                     "",
                 )
             finally:
-                if request_id in self.active_requests:
-                    del self.active_requests[request_id]
+                self._forget_request(request_id)
 
     def _build_final_response(
         self, user_input: str, agent_results: List[Dict[str, Any]]
@@ -833,9 +810,15 @@ class NLUAgent(NetworkAgent):
         return "\n\n".join(responses)
 
     async def _format_final_response_llm(
-        self, user_input: str, agent_results: List[Dict[str, Any]]
+        self,
+        user_input: str,
+        agent_results: List[Dict[str, Any]],
+        cascade_keys: Optional[List[Any]] = None,
     ) -> str:
-        """LLM-based response formatting (kept as fallback, not called by default)."""
+        """LLM-based response formatting (kept as fallback, not called by default).
+
+        A weak-served cascade key is appended to *cascade_keys*.
+        """
         if not agent_results:
             self.logger.log("DEBUG", "No agent results, using default response", "")
             return "I completed your request."
@@ -869,7 +852,13 @@ class NLUAgent(NetworkAgent):
 
         try:
             self.logger.log("DEBUG", "Calling AI client to format response", "")
-            response = await self.ai_client.weak_chat(messages, [])
+            if self.model_cascade:
+                outcome = await self.model_cascade.chat("nlu_format", messages, [])
+                response = (outcome.message, outcome.tool_calls)
+                if outcome.key and cascade_keys is not None:
+                    cascade_keys.append(outcome.key)
+            else:
+                response = await self.ai_client.weak_chat(messages, [])
             formatted = (
                 response[0].content
                 if hasattr(response[0], "content")
@@ -0,0 +1,154 @@
+"""Dependency-counted execution state for multi-capability NLU requests.
+
+The classifier returns a DAG ``{capability: [dependencies]}``.  A
+:class:`DagExecution` is built from it once per request: in-degree
+counters and successor lists are computed up front, so a completed node
+only releases its own successors instead of the whole graph being
+rescanned.  Independent nodes receive the request context as-is;
+dependent nodes get one overlay carrying the results of their
+ancestors as ``previous_results``.  Per-node start and finish times give
+the critical path reported on the request's ``nlu.dag`` span.
+"""
+
+from __future__ import annotations
+
+import time
+from dataclasses import dataclass, field
+from datetime import UTC, datetime
+from typing import Any, Dict, List, Optional, Set, Tuple
+
+
+@dataclass(slots=True)
+class DagNode:
+    """One capability in a :class:`DagExecution`."""
+
+    capability: str
+    deps: Tuple[str, ...]
+    successors: List[str] = field(default_factory=list)
+    ancestors: Set[str] = field(default_factory=set)
+    pending_deps: int = 0
+    started: Optional[float] = None
+    finished: Optional[float] = None
+
+
+class DagExecution:
+    """Tracks which capabilities of one request are ready, running or done.
+
+    Dependencies on capabilities that are not part of the DAG are
+    ignored, since they would never be scheduled.  Nodes caught in a cycle
+    never become ready; the caller's deadline finishes the request.
+    """
+
+    def __init__(
+        self,
+        dag: Dict[str, List[str]],
+        context: Dict[str, Any],
+        clock=time.perf_counter,
+    ) -> None:
+        self.context = context
+        self.results: List[Dict[str, Any]] = []  # completion order
+        self.timed_out: List[str] = []
+        self.timer = None  # deadline handle owned by the caller
+        self._clock = clock
+        self.started_at = clock()
+        self.started_wall = datetime.now(UTC)
+        self._finished = 0
+
+        self.nodes: Dict[str, DagNode] = {}
+        for cap, deps in dag.items():
+            kept = tuple(dict.fromkeys(d for d in deps if d in dag and d != cap))
+            self.nodes[cap] = DagNode(cap, kept, pending_deps=len(kept))
+        for node in self.nodes.values():
+            for dep in node.deps:
+                self.nodes[dep].successors.append(node.capability)
+        for node in self.nodes.values():
+            stack = list(node.deps)
+            while stack:
+                dep = stack.pop()
+                if dep not in node.ancestors:
+                    node.ancestors.add(dep)
+                    stack.extend(self.nodes[dep].deps)
+
+    def roots(self) -> List[str]:
+        """Capabilities with no dependencies, in DAG order."""
+        return [cap for cap, node in self.nodes.items() if not node.deps]
+
+    def start(self, capability: str) -> None:
+        self.nodes[capability].started = self._clock()
+
+    def context_for(self, capability: str) -> Dict[str, Any]:
+        """Context to send with *capability*'s sub-request."""
+        node = self.nodes[capability]
+        if not node.ancestors:
+            return self.context
+        return {
+            **self.context,
+            "previous_results": [
+                r for r in self.results if r.get("capability") in node.ancestors
+            ],
+        }
+
+    def complete(self, capability: str, entry: Dict[str, Any]) -> List[str]:
+        """Record *capability*'s result and return the successors it released.
+
+        A further response for a finished node (several providers) is kept
+        in :attr:`results` but releases nothing.
+        """
+        node = self.nodes.get(capability)
+        if node is None or node.started is None:
+            return []
+        self.results.append(entry)
+        if node.finished is not None:
+            return []
+        node.finished = self._clock()
+        self._finished += 1
+        ready = []
+        for cap in node.successors:
+            successor = self.nodes[cap]
+            successor.pending_deps -= 1
+            if successor.pending_deps == 0:
+                ready.append(cap)
+        return ready
+
+    @property
+    def done(self) -> bool:
+        return self._finished == len(self.nodes)
+
+    def unfinished(self) -> List[str]:
+        """Capabilities still running or never started."""
+        return [cap for cap, node in self.nodes.items() if node.finished is None]
+
+    def critical_path(self) -> Tuple[List[str], float]:
+        """Chain of capabilities that determined the request's duration.
+
+        Starts from the node that finished last and follows, at each step,
+        the dependency that finished last.  Returns the path in execution
+        order and its length in milliseconds from the start of the request.
+        """
+        finished = [n for n in self.nodes.values() if n.finished is not None]
+        if not finished:
+            return [], 0.0
+        node = max(finished, key=lambda n: n.finished)
+        end = node.finished
+        path = [node.capability]
+        # A finished node's dependencies all finished before it did
+        while node.deps:
+            node = max((self.nodes[d] for d in node.deps), key=lambda n: n.finished)
+            path.append(node.capability)
+        path.reverse()
+        return path, (end - self.started_at) * 1000
+
+    def summary(self) -> Dict[str, Any]:
+        """Span attributes: per-node timings and the critical path."""
+        path, path_ms = self.critical_path()
+        return {
+            "nodes": len(self.nodes),
+            "critical_path": path,
+            "critical_path_ms": round(path_ms, 2),
+            "node_ms": {
+                cap: round((node.finished - node.started) * 1000, 2)
+                for cap, node in self.nodes.items()
+                if node.started is not None and node.finished is not None
+            },
+            "timed_out": self.timed_out,
+        }
@@ -19,6 +19,9 @@ from typing import Any, Dict, List, Optional
 
 from ...services.vector_memory import VectorMemoryService
 from ...logging import JarvisLogger
+from ...storage import StartupSnapshot, content_digest
+
+SNAPSHOT_SECTION = "fast_classifier_seeds"
 
 
 # Training phrases for each capability — used to populate the embedding index.
@@ -545,9 +548,11 @@ class FastPathClassifier:
         self,
         vector_service: VectorMemoryService,
         logger: Optional[JarvisLogger] = None,
+        snapshot: Optional[StartupSnapshot] = None,
     ) -> None:
         self.logger = logger or JarvisLogger()
         self._vector_service = vector_service
+        self._snapshot = snapshot
         self._collection = vector_service.client.get_or_create_collection(
             name="capability_router",
             embedding_function=vector_service.embedding_function,
@@ -563,16 +568,35 @@ class FastPathClassifier:
         Auto-trained phrases (source=auto) are excluded from staleness
         checks — they accumulate naturally from LLM classifications and
         are rebuilt from real traffic if the collection is reset.
+
+        With a startup snapshot that already verified this exact seed set
+        against this collection, only the (cheap) total count is checked.
         """
         phrases = training_phrases or CAPABILITY_TRAINING_PHRASES
         expected_seed_count = sum(len(v) for v in phrases.values())
+        seed_digest = content_digest(
+            getattr(self._vector_service, "persist_directory", None),
+            sorted((cap, list(p)) for cap, p in phrases.items()),
+        )
         existing_total = await asyncio.to_thread(self._collection.count)
 
         if existing_total == 0:
             # Empty collection — fresh build
             await self._add_seed_phrases(phrases)
+            self._record_seeds(seed_digest, expected_seed_count)
             return
 
+        if self._snapshot is not None:
+            verified = self._snapshot.get(SNAPSHOT_SECTION, seed_digest)
+            if verified == expected_seed_count and existing_total >= verified:
+                self.logger.log(
+                    "INFO",
+                    "FastPathClassifier already initialized",
+                    f"{verified} seed phrases (from startup snapshot)",
+                )
+                self._initialized = True
+                return
+
         # Count seed phrases specifically (auto-trained ones don't count)
         try:
             seed_items = await asyncio.to_thread(
@@ -591,6 +615,7 @@ class FastPathClassifier:
                 f"{seed_count} seed + {auto_count} auto-trained phrases",
             )
             self._initialized = True
+            self._record_seeds(seed_digest, seed_count)
             return
 
         # Seed data is stale — full rebuild (auto-trained data re-accumulates)
@@ -601,6 +626,10 @@ class FastPathClassifier:
         )
         await self.reinitialize(phrases)
 
+    def _record_seeds(self, seed_digest: str, seed_count: int) -> None:
+        if self._snapshot is not None and self._initialized:
+            self._snapshot.put(SNAPSHOT_SECTION, seed_digest, seed_count)
+
     async def _add_seed_phrases(
         self, phrases: Dict[str, List[str]]
     ) -> None:
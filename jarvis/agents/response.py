@@ -18,7 +18,7 @@ class ErrorSeverity(Enum):
     CRITICAL = "critical"
 
 
-@dataclass
+@dataclass(slots=True)
 class ErrorInfo:
     """Structured error information."""
     message: str
@@ -64,7 +64,7 @@ class ErrorInfo:
         )
 
 
-@dataclass
+@dataclass(slots=True)
 class AgentResponse:
     """Standardized response format for all agents.
     
@@ -3,9 +3,10 @@
 from __future__ import annotations
 
 import asyncio
+import heapq
 import time
 from enum import Enum
-from typing import Any, Dict, List, Optional, Set
+from typing import Any, Dict, List, Optional, Set, Tuple
 from dataclasses import dataclass, field
 
 from ..logging import JarvisLogger
@@ -36,6 +37,8 @@ class ResponseTracker:
     errors: List[Dict[str, Any]] = field(default_factory=list)
     received_from: Set[str] = field(default_factory=set)
     future: Optional[asyncio.Future] = None
+    # Event-loop time at which the request times out
+    deadline: float = 0.0
 
     def is_complete(self) -> bool:
         """Check if aggregation is complete based on strategy."""
@@ -116,7 +119,18 @@ class ResponseTracker:
 
 
 class ResponseAggregator:
-    """Centralized response aggregation service for agent network."""
+    """Centralized response aggregation service for agent network.
+
+    All request deadlines live in one min-heap served by a single
+    ``loop.call_at`` timer, rescheduled only when the earliest deadline
+    changes, instead of one sleeping task per request. Trackers are
+    dropped as soon as their request completes, times out or is cancelled;
+    heap entries for those are skipped when they surface and compacted
+    once they make up most of the heap.
+    """
+
+    # Rebuild the heap once stale entries outnumber live ones (and this many)
+    _COMPACT_MIN_STALE = 1024
 
     def __init__(
         self,
@@ -126,26 +140,27 @@ class ResponseAggregator:
     ) -> None:
         self.logger = logger or JarvisLogger()
         self.default_timeout = default_timeout
+        # Kept for compatibility: completed trackers no longer wait for a sweep
         self.cleanup_interval = cleanup_interval
         self._trackers: Dict[str, ResponseTracker] = {}
         self._running = False
-        self._cleanup_task: Optional[asyncio.Task] = None
+        self._deadlines: List[Tuple[float, int, str]] = []
+        self._seq = 0
+        self._timer: Optional[asyncio.TimerHandle] = None
+        self._timer_at = float("inf")
+        self._completed = 0
+        self._timed_out = 0
 
     async def start(self) -> None:
-        """Start the aggregator and cleanup task."""
+        """Start the aggregator."""
         self._running = True
-        self._cleanup_task = asyncio.create_task(self._cleanup_loop())
+        self._schedule_timer()
         self.logger.log("INFO", "ResponseAggregator started")
 
     async def stop(self) -> None:
         """Stop the aggregator."""
         self._running = False
-        if self._cleanup_task:
-            self._cleanup_task.cancel()
-            try:
-                await self._cleanup_task
-            except asyncio.CancelledError:
-                pass
+        self._cancel_timer()
         self.logger.log("INFO", "ResponseAggregator stopped")
 
     def register_request(
@@ -174,12 +189,16 @@ class ResponseAggregator:
             strategy=strategy,
             timeout=timeout,
             future=fut,
+            deadline=loop.time() + timeout,
         )
 
         self._trackers[request_id] = tracker
+        fut.add_done_callback(lambda _f: self._discard(tracker))
 
-        # Start timeout task
-        asyncio.create_task(self._handle_timeout(request_id, timeout))
+        self._seq += 1
+        heapq.heappush(self._deadlines, (tracker.deadline, self._seq, request_id))
+        if tracker.deadline < self._timer_at:
+            self._schedule_timer()
 
         self.logger.log(
             "DEBUG",
@@ -199,7 +218,8 @@ class ResponseAggregator:
         """
         Add a response to a tracked request.
 
-        Returns True if the response was added, False if request not found.
+        Returns True if the response was added, False if request not found
+        (unknown, or already completed).
         """
         tracker = self._trackers.get(request_id)
         if not tracker:
@@ -220,8 +240,7 @@ class ResponseAggregator:
 
         # Check if aggregation is complete
         if tracker.is_complete() and tracker.future and not tracker.future.done():
-            result = tracker.get_result()
-            tracker.future.set_result(result)
+            self._finish(tracker)
             self.logger.log(
                 "DEBUG",
                 f"Aggregation complete for {request_id}",
@@ -230,52 +249,84 @@ class ResponseAggregator:
 
         return True
 
-    async def _handle_timeout(self, request_id: str, timeout: float) -> None:
-        """Handle timeout for a request."""
-        await asyncio.sleep(timeout)
-
-        tracker = self._trackers.get(request_id)
-        if tracker and tracker.future and not tracker.future.done():
-            # Timeout reached, fulfill with whatever we have
+    def _finish(self, tracker: ResponseTracker) -> None:
+        """Resolve *tracker*'s future with the aggregated result and drop it."""
+        self._discard(tracker)
+        self._completed += 1
+        try:
             result = tracker.get_result()
-            tracker.future.set_result(result)
-            self.logger.log(
-                "DEBUG",
-                f"Request {request_id} timed out",
-                f"Received {len(tracker.responses)} responses from {len(tracker.received_from)} providers",
-            )
-
-    async def _cleanup_loop(self) -> None:
-        """Periodic cleanup of completed trackers."""
-        while self._running:
-            try:
-                await asyncio.sleep(self.cleanup_interval)
-                await self._cleanup_completed()
-            except Exception as exc:
-                self.logger.log("ERROR", "ResponseAggregator cleanup error", str(exc))
+        except Exception as exc:
+            tracker.future.set_exception(exc)
+            return
+        tracker.future.set_result(result)
+
+    def _discard(self, tracker: ResponseTracker) -> None:
+        # The id may already belong to a newer request
+        if self._trackers.get(tracker.request_id) is tracker:
+            del self._trackers[tracker.request_id]
+            self._maybe_compact()
+
+    def _handle_timeouts(self) -> None:
+        """Timer callback: time out every request whose deadline has passed."""
+        self._timer = None
+        self._timer_at = float("inf")
+        now = asyncio.get_event_loop().time()
+        while self._deadlines and self._deadlines[0][0] <= now:
+            deadline, _, request_id = heapq.heappop(self._deadlines)
+            tracker = self._trackers.get(request_id)
+            if tracker is None or tracker.deadline != deadline:
+                continue  # completed, cancelled or re-registered
+            if tracker.future and not tracker.future.done():
+                # Timeout reached, fulfill with whatever we have
+                self._timed_out += 1
+                self._finish(tracker)
+                self.logger.log(
+                    "DEBUG",
+                    f"Request {request_id} timed out",
+                    f"Received {len(tracker.responses)} responses from {len(tracker.received_from)} providers",
+                )
+            else:
+                self._discard(tracker)
+        self._schedule_timer()
+
+    def _schedule_timer(self) -> None:
+        """Arm the timer for the earliest deadline still in the heap."""
+        self._cancel_timer()
+        if not self._deadlines:
+            return
+        self._timer_at = self._deadlines[0][0]
+        self._timer = asyncio.get_event_loop().call_at(self._timer_at, self._handle_timeouts)
+
+    def _cancel_timer(self) -> None:
+        if self._timer is not None:
+            self._timer.cancel()
+            self._timer = None
+        self._timer_at = float("inf")
+
+    def _maybe_compact(self) -> None:
+        stale = len(self._deadlines) - len(self._trackers)
+        if stale > self._COMPACT_MIN_STALE and stale > len(self._trackers):
+            self._compact()
+
+    def _compact(self) -> None:
+        """Drop heap entries whose request is no longer tracked."""
+        self._deadlines = [
+            entry for entry in self._deadlines
+            if (t := self._trackers.get(entry[2])) is not None and t.deadline == entry[0]
+        ]
+        heapq.heapify(self._deadlines)
+        if not self._deadlines:
+            self._cancel_timer()
 
     async def _cleanup_completed(self) -> None:
-        """Remove completed trackers."""
-        current_time = time.time()
-        to_remove = []
-
-        for request_id, tracker in self._trackers.items():
-            # Remove if completed or expired
-            if tracker.future and tracker.future.done():
-                to_remove.append(request_id)
-            elif current_time - tracker.created_at > tracker.timeout * 2:
-                # Expired (2x timeout for safety)
-                to_remove.append(request_id)
-
-        for request_id in to_remove:
-            del self._trackers[request_id]
-
-        if to_remove:
-            self.logger.log(
-                "DEBUG",
-                f"Cleaned up {len(to_remove)} completed trackers",
-                "",
-            )
+        """Remove trackers whose future is already done and compact the heap.
+
+        Completion removes trackers immediately, so this only matters for
+        futures resolved outside the aggregator before their callbacks ran.
+        """
+        for tracker in [t for t in self._trackers.values() if t.future and t.future.done()]:
+            self._discard(tracker)
+        self._compact()
 
     def get_tracker(self, request_id: str) -> Optional[ResponseTracker]:
         """Get tracker for a request ID."""
@@ -285,7 +336,7 @@ class ResponseAggregator:
         """Get aggregator statistics."""
         return {
             "active_trackers": len(self._trackers),
-            "completed_trackers": sum(
-                1 for t in self._trackers.values() if t.future and t.future.done()
-            ),
+            "completed_trackers": self._completed,
+            "timed_out_trackers": self._timed_out,
+            "pending_deadlines": len(self._deadlines),
         }
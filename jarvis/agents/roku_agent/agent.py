@@ -30,6 +30,8 @@ class RokuAgent(NetworkAgent):
     Supports multiple Roku devices on the network, routed through a device registry.
     """
 
+    CAPABILITIES = RokuFunctionRegistry.CAPABILITIES
+
     def __init__(
         self,
         ai_client: BaseAIClient,
@@ -113,6 +115,17 @@ class RokuAgent(NetworkAgent):
             return self._ensure_service(default_dev.serial_number, default_dev.ip_address)
         return None
 
+    def dependency_probes(self) -> Dict[str, Any]:
+        """Recovery probe for the network's fail-fast routing."""
+        return {"RokuDevice": self._probe_device}
+
+    async def _probe_device(self) -> bool:
+        service = self.get_service()
+        if service is None:
+            return False
+        info = await service.get_device_info()
+        return bool(info.get("success"))
+
     @property
     def roku_service(self) -> Optional[RokuService]:
         """Backwards-compat property — returns the service for the default/first online device."""
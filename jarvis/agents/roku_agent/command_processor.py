@@ -8,15 +8,24 @@ the latest device roster from the registry.
 from typing import Dict, Any, List, Optional
 import json
 import asyncio
+import re
+import time
 
 from ...ai_clients.base import BaseAIClient
 from ...logging import JarvisLogger
 from ...services.roku_discovery import RokuDeviceRegistry
 from .function_registry import RokuFunctionRegistry
+from .grammar import build_grammar
 from .tools.tools import tools
+from ..command_grammar import FastPathStats, elapsed_ms
 from ..response import AgentResponse, ErrorInfo
 
 
+def _device_stem(name: str) -> str:
+    """Lowercase *name* without a trailing "tv"/"roku"/"television"."""
+    return re.sub(r"\s+(?:tv|roku|television)s?$", "", name.strip().lower())
+
+
 class RokuCommandProcessor:
     """Processes natural language commands using AI and executes Roku functions."""
 
@@ -28,6 +37,7 @@ class RokuCommandProcessor:
         function_registry: RokuFunctionRegistry,
         logger: Optional[JarvisLogger] = None,
         device_registry: Optional[RokuDeviceRegistry] = None,
+        fast_path: bool = True,
     ):
         self.ai_client = ai_client
         self.function_registry = function_registry
@@ -35,6 +45,9 @@ class RokuCommandProcessor:
         self.device_registry = device_registry
         self.tools = tools
         self._history: List[Dict[str, str]] = []
+        # Common remote-control phrasings skip the LLM entirely
+        self.grammar = build_grammar(self.tools) if fast_path else None
+        self.fast_path_stats = FastPathStats()
 
     def _build_system_prompt(self) -> str:
         """Build the system prompt for the AI — rebuilt per command for fresh device state."""
@@ -128,11 +141,79 @@ DEVICE ROUTING:
 """
         return base_prompt + device_section
 
+    def _known_device(self, name: str) -> Optional[str]:
+        """Map a spoken device name to a registered one, or None if unsure."""
+        hint = _device_stem(name)
+        if hint in ("all", "every", "all the"):
+            return "all"
+        if not self.device_registry or not hint:
+            return None
+        # An exact name wins ("kitchen" over "Kitchen TV 2"); otherwise a
+        # partial hint must pick out a single device ("room" matches both
+        # "Living Room" and "Bedroom", so it is left to the model)
+        exact: Dict[str, str] = {}
+        partial: Dict[str, str] = {}
+        for dev in self.device_registry.get_all_devices():
+            for label in (dev.friendly_name, dev.device_name):
+                if not label:
+                    continue
+                if _device_stem(label) == hint:
+                    exact.setdefault(dev.serial_number, label)
+                elif hint in label.lower():
+                    partial.setdefault(dev.serial_number, label)
+        for found in (exact, partial):
+            if found:
+                return next(iter(found.values())) if len(found) == 1 else None
+        return None
+
+    async def _try_fast_path(self, command: str, started: float) -> Optional[Dict[str, Any]]:
+        """Execute *command* directly when the grammar recognizes it."""
+        match = self.grammar.match(command) if self.grammar else None
+        if match is None or not self.function_registry.get_function(match.tool):
+            return None
+        arguments = dict(match.arguments)
+        if "device" in arguments:
+            device = self._known_device(arguments["device"])
+            if device is None:
+                return None
+            arguments["device"] = device
+
+        result = await self._execute_function(match.tool, arguments)
+        error = result.get("error") if isinstance(result, dict) else None
+        if error:
+            final_response = f"That didn't work: {error}" if isinstance(error, str) else "That didn't work."
+        else:
+            final_response = match.rule.reply(arguments, result)
+        self._remember(command, final_response)
+        self.fast_path_stats.record_fast(match.command_class, elapsed_ms(started))
+        if self.logger:
+            self.logger.log(
+                "INFO", f"Roku fast path: {match.tool}", json.dumps(arguments)
+            )
+        actions = [{"function": match.tool, "arguments": arguments, "result": result}]
+        return self._build_result(
+            final_response,
+            actions,
+            {"fast_path": True, "command_class": match.command_class},
+        )
+
+    def _remember(self, command: str, final_response: str) -> None:
+        """Store a conversation turn so follow-ups retain context."""
+        if final_response:
+            self._history.append({"user": command, "assistant": final_response})
+            if len(self._history) > self.MAX_HISTORY_TURNS:
+                self._history = self._history[-self.MAX_HISTORY_TURNS:]
+
     async def process_command(self, command: str) -> Dict[str, Any]:
         """Process a natural language command using AI and tool calls."""
         if self.logger:
             self.logger.log("INFO", "=== PROCESSING ROKU COMMAND ===", command)
 
+        started = time.perf_counter()
+        fast = await self._try_fast_path(command, started)
+        if fast is not None:
+            return fast
+
         messages = [
             {"role": "system", "content": self._build_system_prompt()},
         ]
@@ -209,16 +290,25 @@ DEVICE ROUTING:
             message.content if message and hasattr(message, "content") else str(message or "")
         )
 
-        # Store conversation turn so follow-ups retain context
-        if final_response:
-            self._history.append({"user": command, "assistant": final_response})
-            if len(self._history) > self.MAX_HISTORY_TURNS:
-                self._history = self._history[-self.MAX_HISTORY_TURNS:]
+        self._remember(command, final_response)
+        self.fast_path_stats.record_llm(
+            actions_taken[0]["function"] if actions_taken else "conversation",
+            elapsed_ms(started),
+        )
 
         if self.logger:
             self.logger.log("INFO", "=== ROKU COMMAND COMPLETE ===")
             self.logger.log("INFO", f"Total actions: {len(actions_taken)}")
 
+        return self._build_result(final_response, actions_taken, {"iterations": iterations})
+
+    def _build_result(
+        self,
+        final_response: str,
+        actions_taken: List[Dict[str, Any]],
+        metadata: Dict[str, Any],
+    ) -> Dict[str, Any]:
+        """Turn the reply and executed actions into an AgentResponse dict."""
         # Check if any actions resulted in errors
         # Only treat as error if "error" key exists AND has a truthy value
         # (True or non-empty string, but not False)
@@ -251,6 +341,9 @@ DEVICE ROUTING:
             # If error is True (boolean), convert to a message
             if error_msg is True:
                 error_msg = "An error occurred during execution"
+            # The device client's exception type tells routing whether the
+            # Roku itself was unreachable
+            exception_class = error_action["result"].get("error_type") if error_action else None
 
             # Return error response
             return AgentResponse.error_response(
@@ -258,6 +351,7 @@ DEVICE ROUTING:
                 error=ErrorInfo(
                     message=error_msg,
                     error_type="FunctionExecutionError",
+                    details={"exception_class": exception_class} if exception_class else None,
                 ),
                 actions=actions_taken,
             ).to_dict()
@@ -266,7 +360,7 @@ DEVICE ROUTING:
         return AgentResponse.success_response(
             response=final_response,
             actions=actions_taken,
-            metadata={"iterations": iterations},
+            metadata=metadata,
         ).to_dict()
 
     async def _execute_function(
@@ -288,7 +382,12 @@ DEVICE ROUTING:
 
             return {"result": result} if not isinstance(result, dict) else result
         except Exception as exc:
-            error = {"error": str(exc), "function": function_name, "args": arguments}
+            error = {
+                "error": str(exc),
+                "error_type": type(exc).__name__,
+                "function": function_name,
+                "args": arguments,
+            }
             if self.logger:
                 self.logger.log(
                     "ERROR", f"Error executing {function_name}", json.dumps(error)
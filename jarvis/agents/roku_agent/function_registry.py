@@ -18,6 +18,44 @@ if TYPE_CHECKING:
 class RokuFunctionRegistry:
     """Maps capability names to agent-routed device methods and manages function lookup."""
 
+    CAPABILITIES = frozenset({
+        # Main command capability
+        "roku_command",
+        # Device information capabilities
+        "roku_device_info",
+        "roku_active_app",
+        "roku_list_apps",
+        "roku_player_info",
+        # App control capabilities
+        "roku_launch_app",
+        # Playback capabilities
+        "roku_play",
+        "roku_pause",
+        "roku_rewind",
+        "roku_fast_forward",
+        "roku_instant_replay",
+        # Navigation capabilities
+        "roku_home",
+        "roku_back",
+        "roku_select",
+        "roku_navigate",
+        # Volume and power capabilities
+        "roku_volume_up",
+        "roku_volume_down",
+        "roku_volume_mute",
+        "roku_power_off",
+        "roku_power_on",
+        # Input switching capabilities
+        "roku_switch_input",
+        # Search capabilities
+        "roku_search",
+        # Device management capabilities
+        "roku_list_devices",
+        "roku_name_device",
+        "roku_set_default",
+        "roku_discover_devices",
+    })
+
     def __init__(self, agent: "RokuAgent"):
         self.agent = agent
         self._build_registry()
@@ -266,43 +304,7 @@ class RokuFunctionRegistry:
     @property
     def capabilities(self) -> Set[str]:
         """Return the set of all available capabilities."""
-        return {
-            # Main command capability
-            "roku_command",
-            # Device information capabilities
-            "roku_device_info",
-            "roku_active_app",
-            "roku_list_apps",
-            "roku_player_info",
-            # App control capabilities
-            "roku_launch_app",
-            # Playback capabilities
-            "roku_play",
-            "roku_pause",
-            "roku_rewind",
-            "roku_fast_forward",
-            "roku_instant_replay",
-            # Navigation capabilities
-            "roku_home",
-            "roku_back",
-            "roku_select",
-            "roku_navigate",
-            # Volume and power capabilities
-            "roku_volume_up",
-            "roku_volume_down",
-            "roku_volume_mute",
-            "roku_power_off",
-            "roku_power_on",
-            # Input switching capabilities
-            "roku_switch_input",
-            # Search capabilities
-            "roku_search",
-            # Device management capabilities
-            "roku_list_devices",
-            "roku_name_device",
-            "roku_set_default",
-            "roku_discover_devices",
-        }
+        return set(self.CAPABILITIES)
 
     def get_function(self, function_name: str) -> Optional[Callable]:
         """Get a function by name."""
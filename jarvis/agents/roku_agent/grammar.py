@@ -0,0 +1,121 @@
+# jarvis/agents/roku_agent/grammar.py
+"""
+Phrase rules for the Roku command fast path.
+
+Compiled against ``tools.tools`` by ``build_grammar``; see
+``jarvis.agents.command_grammar`` for the template syntax.  Every rule
+also accepts a trailing "on the <device>" which the processor only
+honours when the name is a known device.
+"""
+import re
+from typing import Any, Dict, List
+
+from ..command_grammar import CommandGrammar, Rule
+from .tools.tools import tools
+
+_ON_DEVICE = r"(?: (?:on|in) (?:the )?{device})?"
+_TIMES = r"(?: {count}(?: times| notches| clicks| steps)?| by {count})?"
+_TV = r"(?: (?:the )?(?:tv|roku|television))?"
+_MEDIA = r"(?: it| that| this| (?:the )?(?:tv|show|movie|video|episode|playback))?"
+
+_NOT_APP = re.compile(r"\b(?:and|then|watching|episode|season|on|from|with)\b")
+
+
+def _steps(verb: str):
+    def reply(args: Dict[str, Any], result: Any) -> str:
+        count = args.get("count", 1)
+        return f"{verb}." if count == 1 else f"{verb} {count} steps."
+    return reply
+
+
+def _fixed(text: str):
+    return lambda args, result: text
+
+
+def _plausible_app(args: Dict[str, Any]) -> bool:
+    name = args.get("app_name", "")
+    return 0 < len(name.split()) <= 3 and not _NOT_APP.search(name)
+
+
+def _rules():
+    return [
+        Rule("pause", (rf"pause{_MEDIA}", rf"stop{_MEDIA}", r"hold on"), _fixed("Paused.")),
+        Rule("play", (rf"(?:play|resume|unpause|continue){_MEDIA}", r"hit play"), _fixed("Playing.")),
+        Rule("home", (r"(?:go |go to |take me )?(?:the )?home(?: screen)?",), _fixed("Going home.")),
+        Rule("back", (r"(?:go )?back", r"previous screen"), _fixed("Going back.")),
+        Rule("select", (r"select(?: it| that)?", r"press (?:select|enter|ok)", r"click(?: it| that)?"), _fixed("Selected.")),
+        Rule("rewind", (rf"rewind{_MEDIA}",), _fixed("Rewinding.")),
+        Rule("fast_forward", (rf"fast forward{_MEDIA}", r"skip ahead"), _fixed("Fast forwarding.")),
+        Rule(
+            "instant_replay",
+            (r"(?:instant )?replay(?: that)?", r"(?:go|jump|skip) back a (?:few|couple) seconds", r"what did (?:he|she|they) say"),
+            _fixed("Replaying."),
+        ),
+        Rule(
+            "volume_up",
+            (
+                rf"(?:turn (?:it|the volume|the tv|the sound) up|volume up|louder|turn up the volume|(?:raise|increase) the volume){_TIMES}",
+            ),
+            _steps("Volume up"),
+        ),
+        Rule(
+            "volume_down",
+            (
+                rf"(?:turn (?:it|the volume|the tv|the sound) down|volume down|quieter|softer|turn down the volume|(?:lower|decrease) the volume){_TIMES}",
+            ),
+            _steps("Volume down"),
+        ),
+        Rule(
+            "volume_mute",
+            (rf"(?:un)?mute(?: it| the sound| the volume){_TV}", rf"(?:un)?mute{_TV}"),
+            _fixed("Toggled mute."),
+        ),
+        Rule(
+            "power_off",
+            (rf"(?:turn|switch|shut) off{_TV}", rf"(?:turn|switch|shut){_TV} off", r"turn it off", rf"power off{_TV}", r"tv off"),
+            _fixed("Turning the TV off."),
+        ),
+        Rule(
+            "power_on",
+            (rf"(?:turn|switch) on{_TV}", rf"(?:turn|switch){_TV} on", r"turn it on", rf"power on{_TV}", r"tv on"),
+            _fixed("Turning the TV on."),
+        ),
+        Rule(
+            "switch_input",
+            (r"(?:switch|change|go|set)(?: the input| input| over)? to {input_name}", r"{input_name}(?: input)?", r"input {input_name}"),
+            lambda args, result: f"Switched to {args['input_name']}.",
+        ),
+        Rule(
+            "navigate",
+            (r"(?:go|move|press|arrow|scroll) {direction}" + _TIMES,),
+            _steps("Moved"),
+        ),
+        Rule(
+            "launch_app_by_name",
+            (r"(?:open|launch|start|put on|go to|switch to) (?:the )?{app_name}(?: app| channel)?",),
+            lambda args, result: f"Opening {args['app_name'].title()}.",
+            guard=_plausible_app,
+        ),
+    ]
+
+
+_INPUT_ALIASES = {
+    **{f"hdmi {n}": f"HDMI{n}" for n in range(1, 5)},
+    **{f"hdmi {w}": f"HDMI{n}" for n, w in enumerate(("one", "two", "three", "four"), start=1)},
+    "antenna": "Tuner",
+    "live tv": "Tuner",
+    "cable": "Tuner",
+    "av": "AV1",
+}
+
+
+def build_grammar(tool_schemas: List[Dict[str, Any]] = tools) -> CommandGrammar:
+    """Compile the rules whose tool is in *tool_schemas*."""
+    names = {t["function"]["name"] for t in tool_schemas}
+    rules = [
+        Rule(rule.tool, tuple(p + _ON_DEVICE for p in rule.patterns), rule.reply,
+             rule.args, rule.command_class, rule.guard)
+        for rule in _rules()
+        if rule.tool in names
+    ]
+    return CommandGrammar(tool_schemas, rules, aliases={"input_name": _INPUT_ALIASES})
@@ -15,16 +15,24 @@ Two input modes:
     2. Structured (agent-to-agent): If ``data.get("structured")`` is a
        dict, bypass AI parsing and dispatch directly to ``_execute_op``.
 
-A background tick loop (following the ServerManagerAgent pattern) wakes
-every ``tick_interval`` seconds, queries the service for due schedules,
-marks them fired, and dispatches each through the orchestrator.
+A background loop sleeps until the earliest next-run in the service's
+due-time heap (or until the heap changes), marks due schedules fired,
+and dispatches them through the orchestrator with a concurrency cap.
+``tick_interval`` only bounds a single idle wait; it never queries SQLite.
+Fire lateness (actual dispatch time minus scheduled time) is tracked in
+``fire_stats``.
+
+All SchedulerService calls are awaited through ``scheduler_service.run`` so
+SQLite work happens on the service's DB thread, never on the event loop.
 """
 
 from __future__ import annotations
 
 import asyncio
 import json
-from typing import Any, Dict, Optional, Set
+import time
+from datetime import datetime, timezone
+from typing import Any, Dict, List, Optional, Set
 
 from ..base import NetworkAgent
 from ..agent_network import AgentNetwork
@@ -92,6 +100,7 @@ class SchedulerAgent(NetworkAgent):
         scheduler_service: SchedulerService,
         logger: Optional[JarvisLogger] = None,
         tick_interval: float = 15.0,
+        max_concurrent_fires: int = 5,
     ) -> None:
         super().__init__("SchedulerAgent", logger)
         self.ai_client = ai_client
@@ -99,7 +108,17 @@ class SchedulerAgent(NetworkAgent):
         self._tick_interval = tick_interval
         self._tick_task: Optional[asyncio.Task] = None
         self._orchestrator: Any = None
-        self._fire_semaphore = asyncio.Semaphore(5)
+        self._fire_semaphore = asyncio.Semaphore(max_concurrent_fires)
+        self._fire_tasks: Set[asyncio.Task] = set()
+        self._wake_event = asyncio.Event()
+        self._loop: Optional[asyncio.AbstractEventLoop] = None
+        self.fire_stats: Dict[str, Any] = {
+            "fired": 0,
+            "last_lateness_ms": None,
+            "max_lateness_ms": 0.0,
+            "avg_lateness_ms": 0.0,
+        }
+        scheduler_service.add_listener(self._on_schedules_changed)
         self.intent_map: Dict[str, Any] = {
             "schedule_task": self._handle_schedule,
             "list_schedules": self._handle_list,
@@ -133,6 +152,7 @@ class SchedulerAgent(NetworkAgent):
     def set_orchestrator(self, orchestrator: Any) -> None:
         """Store a reference to the RequestOrchestrator for the tick loop."""
         self._orchestrator = orchestrator
+        self._on_schedules_changed()
 
     # -- Lifecycle -----------------------------------------------------------
 
@@ -173,12 +193,12 @@ class SchedulerAgent(NetworkAgent):
                 prompt = data.get("prompt", "") if isinstance(data, dict) else ""
                 result = await self._configure_wake_routine(prompt)
             elif capability == "get_wake_routine":
-                result = self._get_wake_routine()
+                result = await self.scheduler_service.run(self._get_wake_routine)
             else:
                 # Structured input bypasses AI parsing entirely
                 structured = data.get("structured") if isinstance(data, dict) else None
                 if isinstance(structured, dict):
-                    result = self._execute_op(structured)
+                    result = await self.scheduler_service.run(self._execute_op, structured)
                 else:
                     prompt = data.get("prompt", "")
                     result = await self._process(prompt)
@@ -236,10 +256,7 @@ class SchedulerAgent(NetworkAgent):
 
         # Single operation or batch
         ops = parsed if isinstance(parsed, list) else [parsed]
-        results = []
-        for op in ops:
-            result = self._execute_op(op)
-            results.append(result)
+        results = await self.scheduler_service.run(self._execute_ops, ops)
 
         if len(results) == 1:
             return results[0]
@@ -259,6 +276,11 @@ class SchedulerAgent(NetworkAgent):
 
     # -- Operation dispatch --------------------------------------------------
 
+    def _execute_ops(self, ops: List[Dict[str, Any]]) -> List[AgentResponse]:
+        """Run *ops* as one transaction; called on the service's DB thread."""
+        with self.scheduler_service.batch():
+            return [self._execute_op(op) for op in ops]
+
     def _execute_op(self, op: Dict[str, Any]) -> AgentResponse:
         name = op.get("op", "")
         try:
@@ -398,7 +420,7 @@ class SchedulerAgent(NetworkAgent):
 
     async def _configure_wake_routine(self, user_request: str) -> AgentResponse:
         """Use LLM to interpret the user's change and update the routine."""
-        current = self.scheduler_service.get_wake_routine()
+        current = await self.scheduler_service.run(self.scheduler_service.get_wake_routine)
 
         prompt = _WAKE_ROUTINE_PROMPT.format(
             current_routine=current,
@@ -440,7 +462,7 @@ class SchedulerAgent(NetworkAgent):
                 ),
             )
 
-        self.scheduler_service.set_wake_routine(new_routine)
+        await self.scheduler_service.run(self.scheduler_service.set_wake_routine, new_routine)
         return AgentResponse.success_response(
             response=(
                 f"Morning routine updated. New routine: \"{new_routine}\""
@@ -452,30 +474,105 @@ class SchedulerAgent(NetworkAgent):
 
     # -- Background tick loop ------------------------------------------------
 
+    def _on_schedules_changed(self) -> None:
+        """Service listener: wake the tick loop so it re-reads the heap.
+
+        May be called from any thread that mutates the service.
+        """
+        loop = self._loop
+        if loop is None or loop.is_closed():
+            return
+        try:
+            running = asyncio.get_running_loop()
+        except RuntimeError:
+            running = None
+        if running is loop:
+            self._wake_event.set()
+        else:
+            loop.call_soon_threadsafe(self._wake_event.set)
+
+    async def _wait_for_wake(self, timeout: float) -> None:
+        # asyncio.wait (unlike wait_for on 3.11) never swallows a cancel that
+        # races with the event being set, so stop() can't hang here.
+        waiter = asyncio.ensure_future(self._wake_event.wait())
+        try:
+            await asyncio.wait({waiter}, timeout=timeout)
+        finally:
+            waiter.cancel()
+
     async def _tick_loop(self) -> None:
-        """Poll for due schedules and fire them through the orchestrator."""
+        """Sleep until the next due schedule and fire it through the orchestrator."""
+        self._loop = asyncio.get_running_loop()
         while True:
             try:
-                await asyncio.sleep(self._tick_interval)
+                self._wake_event.clear()
                 if not self._orchestrator:
+                    await self._wait_for_wake(self._tick_interval)
+                    continue
+
+                next_due = self.scheduler_service.next_due_at()
+                if next_due is None:
+                    delay = self._tick_interval
+                else:
+                    delay = min(max(0.0, next_due - time.time()), self._tick_interval)
+                if delay > 0:
+                    await self._wait_for_wake(delay)
                     continue
-                due = self.scheduler_service.get_due_schedules()
+
+                due = await self.scheduler_service.run(self._claim_due_schedules)
                 for schedule in due:
-                    self.scheduler_service.mark_fired(schedule.id)
-                    asyncio.create_task(self._fire_schedule(schedule))
+                    task = asyncio.create_task(self._fire_schedule(schedule))
+                    self._fire_tasks.add(task)
+                    task.add_done_callback(self._fire_tasks.discard)
             except asyncio.CancelledError:
                 break
             except Exception as exc:
                 self.logger.log("ERROR", "Scheduler tick error", str(exc))
+                await asyncio.sleep(self._tick_interval)
+
+    def _claim_due_schedules(self) -> List[Any]:
+        """Fetch due schedules and mark them fired in one transaction.
+
+        Runs on the service's DB thread. Returns the pre-fire records so
+        lateness is measured against the time each was scheduled for.
+        """
+        due = self.scheduler_service.get_due_schedules()
+        if due:
+            self.scheduler_service.mark_fired_many([s.id for s in due])
+        return due
+
+    def _record_lateness(self, schedule: Any) -> Optional[float]:
+        """Update fire_stats with how late *schedule* is firing (ms)."""
+        try:
+            scheduled = datetime.fromisoformat(schedule.next_run)
+        except (AttributeError, TypeError, ValueError):
+            return None
+        if scheduled.tzinfo is None:
+            scheduled = scheduled.replace(tzinfo=timezone.utc)
+        lateness_ms = max(
+            0.0, (datetime.now(timezone.utc) - scheduled).total_seconds() * 1000
+        )
+        stats = self.fire_stats
+        stats["fired"] += 1
+        stats["last_lateness_ms"] = round(lateness_ms, 2)
+        stats["max_lateness_ms"] = round(max(stats["max_lateness_ms"], lateness_ms), 2)
+        stats["avg_lateness_ms"] = round(
+            stats["avg_lateness_ms"]
+            + (lateness_ms - stats["avg_lateness_ms"]) / stats["fired"],
+            2,
+        )
+        return lateness_ms
 
     async def _fire_schedule(self, schedule: Any) -> None:
         """Fire a single schedule through the orchestrator."""
         async with self._fire_semaphore:
             try:
+                lateness_ms = self._record_lateness(schedule)
                 self.logger.log(
                     "INFO",
                     "Firing schedule",
-                    f"{schedule.id}: {schedule.name}",
+                    f"{schedule.id}: {schedule.name}"
+                    + (f" (late by {lateness_ms:.0f} ms)" if lateness_ms is not None else ""),
                 )
                 await self._orchestrator.process_request(
                     user_input=schedule.request_text,
@@ -6,6 +6,7 @@ from ..base import NetworkAgent
 from ..message import Message
 from ...services.search_service import GoogleSearchService
 from ...logging import JarvisLogger
+from .extractive import extract_answer
 
 if __name__ != "__main__":
     from ...ai_clients import BaseAIClient
@@ -53,6 +54,24 @@ class SearchAgent(NetworkAgent):
             response_text += f"\n\n(Found {total_results} total results)"
         return response_text
 
+    async def _answer(
+        self, query: str, results: List[Dict[str, Any]], total_results: int = 0
+    ) -> tuple[str, str]:
+        """Return ``(response_text, answer_source)`` for a search.
+
+        A confident extractive answer skips the LLM; everything else goes
+        through synthesis (which itself falls back to raw results).
+        """
+        extracted = extract_answer(query, results)
+        if extracted is not None:
+            self.logger.log(
+                "DEBUG",
+                "Search answered from snippet",
+                f"confidence={extracted.confidence} source={extracted.source.get('link', '')}",
+            )
+            return extracted.text, "extractive"
+        return await self._synthesize_response(query, results, total_results), "synthesized"
+
     async def _synthesize_response(
         self, query: str, results: List[Dict[str, Any]], total_results: int = 0
     ) -> str:
@@ -146,8 +165,8 @@ class SearchAgent(NetworkAgent):
             results = search_results.get("results", [])
             total_results = search_results.get("total_results", 0)
 
-            # Use AI synthesis if available, otherwise format raw results
-            response_text = await self._synthesize_response(query, results, total_results)
+            # Answer from a snippet when confident, else synthesize
+            response_text, answer_source = await self._answer(query, results, total_results)
 
             await self.send_capability_response(
                 message.from_agent,
@@ -157,6 +176,7 @@ class SearchAgent(NetworkAgent):
                     "results": results,
                     "total_results": total_results,
                     "raw_results": results,
+                    "answer_source": answer_source,
                 },
                 message.request_id,
                 message.id,
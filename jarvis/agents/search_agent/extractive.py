@@ -0,0 +1,118 @@
+"""Answer simple fact questions straight from search snippets.
+
+For "who/what/when/where/how many" questions the top snippets usually
+contain the answer verbatim ("Mount Everest is 8,849 metres tall"), and
+paying for an LLM round trip to rephrase it adds a second or more to the
+reply.  ``extract_answer`` scores each snippet sentence against the
+question and returns it when it is confident; otherwise the caller falls
+back to LLM synthesis.
+
+Confidence combines three signals:
+
+- coverage: the share of the question's content words the sentence contains
+- corroboration: other results repeat the sentence's answer-bearing tokens
+  (numbers and proper nouns the question did not contain)
+- rank: the sentence comes from a higher-ranked result
+
+A sentence is only a candidate when it has answer-bearing tokens and at
+least one other result repeats one of them; coverage and rank alone
+would let a top-ranked headline that merely restates the question
+through.
+"""
+
+from __future__ import annotations
+
+import re
+from dataclasses import dataclass
+from typing import Any, Dict, List, Optional, Set
+
+_WORD_RE = re.compile(r"[a-z0-9]+(?:[.,][a-z0-9]+)*")
+_KEY_RE = re.compile(r"\b(?:\d[\d,.]*|[A-Z][a-zA-Z]+)\b")
+_SENTENCE_SPLIT_RE = re.compile(r"(?<=[.!?])\s+(?=[A-Z0-9])|\s+\.\.\.\s*|\s+·\s+")
+# Snippets often start with a crawl date: "Mar 3, 2024 ... " or "3 days ago ... "
+_DATE_PREFIX_RE = re.compile(
+    r"^(?:[A-Z][a-z]{2} \d{1,2}, \d{4}|\d+ (?:minutes?|hours?|days?|weeks?) ago)\s*(?:\.\.\.|[-—–])?\s*"
+)
+
+_FACT_QUESTION_RE = re.compile(
+    r"^\s*(?:who|what|when|where|which|how (?:many|much|old|tall|long|far|big|high|deep|fast))\b",
+    re.IGNORECASE,
+)
+# Asks for a summary, opinion or something that changes by the minute
+_OPEN_ENDED_RE = re.compile(
+    r"\b(?:why|explain|compare|difference|best|recommend|should|news|latest|weather|forecast|today|tonight)\b",
+    re.IGNORECASE,
+)
+
+_STOPWORDS = frozenset(
+    "a an and are as at be by did do does for from has have how in is it its "
+    "many much of on or s the their there this to was were what when where which "
+    "who whom whose with you your".split()
+)
+
+MIN_WORDS = 4
+MAX_WORDS = 45
+
+
+@dataclass(slots=True)
+class ExtractiveAnswer:
+    text: str
+    confidence: float
+    source: Dict[str, Any]
+
+
+def _content_words(text: str) -> Set[str]:
+    return {w for w in _WORD_RE.findall(text.lower()) if w not in _STOPWORDS}
+
+
+def _sentences(snippet: str) -> List[str]:
+    snippet = _DATE_PREFIX_RE.sub("", snippet.strip())
+    parts = (p.strip(" .…-—–") for p in _SENTENCE_SPLIT_RE.split(snippet))
+    return [p for p in parts if MIN_WORDS <= len(p.split()) <= MAX_WORDS]
+
+
+def is_fact_question(query: str) -> bool:
+    return bool(_FACT_QUESTION_RE.match(query)) and not _OPEN_ENDED_RE.search(query)
+
+
+def extract_answer(
+    query: str,
+    results: List[Dict[str, Any]],
+    threshold: float = 0.75,
+) -> Optional[ExtractiveAnswer]:
+    """Return the best snippet sentence for a fact question, or None."""
+    if not results or not is_fact_question(query):
+        return None
+    terms = _content_words(query)
+    if not terms:
+        return None
+
+    snippet_words = [_content_words(r.get("snippet", "")) for r in results]
+    best: Optional[ExtractiveAnswer] = None
+    for rank, result in enumerate(results[:5]):
+        for sentence in _sentences(result.get("snippet", "")):
+            words = _content_words(sentence)
+            coverage = len(terms & words) / len(terms)
+            # Must name something the question did not
+            keys = {k.lower() for k in _KEY_RE.findall(sentence)} - terms
+            if coverage < 0.5 or not keys or not (words - terms):
+                continue
+            corroborated = sum(
+                1
+                for other, other_words in enumerate(snippet_words)
+                if other != rank and keys & other_words
+            )
+            if not corroborated:
+                continue
+            confidence = (
+                0.6 * coverage
+                + 0.25 * min(1.0, corroborated / 2)
+                + 0.15 / (1 + rank)
+            )
+            if best is None or confidence > best.confidence:
+                text = sentence if sentence[-1] in "!?" else sentence + "."
+                best = ExtractiveAnswer(text, round(confidence, 3), result)
+
+    if best is None or best.confidence < threshold:
+        return None
+    return best
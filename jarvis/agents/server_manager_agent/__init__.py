@@ -27,6 +27,8 @@ if TYPE_CHECKING:
 class ServerManagerAgent(NetworkAgent):
     """Manages the lifecycle of registered servers and monitors their health."""
 
+    CAPABILITIES = frozenset({"start_server", "stop_server", "restart_server", "server_status", "list_servers"})
+
     def __init__(
         self,
         server_service: "ServerManagerService",
@@ -46,6 +48,8 @@ class ServerManagerAgent(NetworkAgent):
             "server_status": self._handle_server_status,
             "list_servers": self._handle_list_servers,
         }
+        # Crashes are reported as they happen; the monitor loop only sweeps
+        self.server_service.on_crash(self._notify_crash)
 
     @property
     def description(self) -> str:
@@ -56,7 +60,7 @@ class ServerManagerAgent(NetworkAgent):
 
     @property
     def capabilities(self) -> Set[str]:
-        return {"start_server", "stop_server", "restart_server", "server_status", "list_servers"}
+        return set(self.CAPABILITIES)
 
     @property
     def supports_dialogue(self) -> bool:
@@ -288,7 +292,7 @@ class ServerManagerAgent(NetworkAgent):
 
                 await asyncio.sleep(self._monitor_interval)
 
-                # Detect crashed managed processes
+                # Catch exits the process watchers did not see
                 crashed = await self.server_service.detect_crashes()
                 for name in crashed:
                     await self._notify_crash(name)
@@ -48,6 +48,10 @@ class ServerConfig:
     restart_window: float = 300.0  # seconds of stability before counter resets
     start_on_boot: bool = False
     tags: List[str] = field(default_factory=list)
+    # Servers that must be up (and pass a readiness probe) before this one starts
+    depends_on: List[str] = field(default_factory=list)
+    ready_timeout: float = 30.0
+    health_timeout: float = 5.0
 
     def health_url(self) -> Optional[str]:
         """Build the full health-check URL, or None if not configured."""
@@ -72,6 +76,9 @@ class ServerConfig:
             "restart_window": self.restart_window,
             "start_on_boot": self.start_on_boot,
             "tags": self.tags,
+            "depends_on": self.depends_on,
+            "ready_timeout": self.ready_timeout,
+            "health_timeout": self.health_timeout,
         }
 
     @classmethod
@@ -91,6 +98,9 @@ class ServerConfig:
             restart_window=data.get("restart_window", 300.0),
             start_on_boot=data.get("start_on_boot", False),
             tags=data.get("tags", []),
+            depends_on=data.get("depends_on", []),
+            ready_timeout=data.get("ready_timeout", 30.0),
+            health_timeout=data.get("health_timeout", 5.0),
         )
 
 
@@ -4,13 +4,14 @@ Capabilities:
     create_task, list_tasks, update_task, complete_task, delete_task
 
 The agent uses an AI client to parse natural-language requests into
-structured operations against the TodoService (SQLite-backed).
+structured operations against the TodoService (SQLite-backed). Parsed
+operations run on the service's DB thread as a single transaction.
 """
 
 from __future__ import annotations
 
 import json
-from typing import Any, Dict, Optional, Set
+from typing import Any, Dict, List, Optional, Set
 
 from ..base import NetworkAgent
 from ..message import Message
@@ -133,10 +134,7 @@ class TodoAgent(NetworkAgent):
 
         # Single operation or batch
         ops = parsed if isinstance(parsed, list) else [parsed]
-        results = []
-        for op in ops:
-            result = self._execute_op(op)
-            results.append(result)
+        results = await self.todo_service.run(self._execute_ops, ops)
 
         if len(results) == 1:
             return results[0]
@@ -158,6 +156,11 @@ class TodoAgent(NetworkAgent):
     # Operation dispatch
     # ------------------------------------------------------------------
 
+    def _execute_ops(self, ops: List[Dict[str, Any]]) -> List[AgentResponse]:
+        """Run *ops* as one transaction; called on the service's DB thread."""
+        with self.todo_service.batch():
+            return [self._execute_op(op) for op in ops]
+
     def _execute_op(self, op: Dict[str, Any]) -> AgentResponse:
         name = op.get("op", "")
         try:
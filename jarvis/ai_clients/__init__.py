@@ -5,6 +5,8 @@ from .openai_client import OpenAIClient
 from .anthropic_client import AnthropicClient
 from .dummy_client import DummyAIClient
 from .factory import AIClientFactory
+from .cascade import ModelCascade, CascadePolicy
+from .swappable import SwappableAIClient
 
 __all__ = [
     "BaseAIClient",
@@ -12,4 +14,7 @@ __all__ = [
     "AnthropicClient",
     "DummyAIClient",
     "AIClientFactory",
+    "ModelCascade",
+    "CascadePolicy",
+    "SwappableAIClient",
 ]
@@ -20,3 +20,6 @@ class BaseAIClient(ABC):
     ) -> Tuple[Any, Any]:
         """Lower quality chat for lightweight tasks."""
         raise NotImplementedError
+
+    async def close(self) -> None:
+        """Release the client's connection pool; a no-op unless overridden."""
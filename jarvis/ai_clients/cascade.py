@@ -0,0 +1,373 @@
+"""Weak-first model cascade with confidence-based escalation.
+
+Call sites that would normally hard-code ``strong_chat`` can instead ask a
+:class:`ModelCascade` for a response.  The cascade tries ``weak_chat``
+first and escalates to ``strong_chat`` when the weak answer looks
+unreliable:
+
+* tool calls with malformed / non-object JSON arguments
+* refusals ("I can't help with that", "as an AI ...")
+* empty replies with no tool calls
+* JSON expected but not parseable
+* a self-reported ``uncertain: true`` or low ``confidence`` field
+
+Outcomes are tracked per ``(site, capability)`` key.  Keys whose weak
+answers keep escalating or attract negative user feedback (see
+:class:`~jarvis.core.feedback.FeedbackCollector`) are routed straight to
+the strong model, with periodic weak re-exploration.
+
+Each weak-served :class:`CascadeResult` carries its key, so feedback is
+charged to the calls that produced the rated turn rather than to whatever
+ran last.  With an :class:`~jarvis.services.outcome_store.OutcomeStore`
+attached, outcomes persist across restarts and are reloaded as bounded
+priors: they count as at most ``prior_weight`` pseudo-attempts, so live
+samples soon outweigh old history.
+"""
+
+from __future__ import annotations
+
+import json
+import re
+import time
+from dataclasses import dataclass, field
+from typing import TYPE_CHECKING, Any, Dict, Iterable, List, Optional, Set, Tuple
+
+from .base import BaseAIClient
+from ..utils import extract_json_from_text
+
+if TYPE_CHECKING:
+    from ..services.outcome_store import OutcomeStore
+
+Key = Tuple[str, str]
+
+WEAK = "weak"
+STRONG = "strong"
+
+_REFUSAL_RE = re.compile(
+    r"\b(i\s*(?:can(?:no|')t|am unable|'m unable|am not able|'m not able)"
+    r"|i\s*don'?t have (?:access|the ability)"
+    r"|as an ai\b"
+    r"|i'?m not sure (?:how|what))",
+    re.IGNORECASE,
+)
+
+
+@dataclass
+class CascadePolicy:
+    """Escalation rules for one call site."""
+
+    site: str
+    enabled: bool = True
+    expect_json: bool = False
+    min_confidence: float = 0.6
+    # Learning: skip weak once its failure rate passes this threshold
+    max_failure_rate: float = 0.4
+    min_samples: int = 5
+    # While routed strong-first, still try weak every Nth call
+    explore_every: int = 20
+    # Most pseudo-attempts stored history may contribute as a prior
+    prior_weight: int = 10
+
+
+@dataclass
+class CascadeStats:
+    """Outcome counters for a ``(site, capability)`` key."""
+
+    weak_attempts: int = 0
+    weak_accepted: int = 0
+    escalations: int = 0
+    strong_direct: int = 0
+    negative_feedback: int = 0
+    latency_saved_ms: float = 0.0
+    weak_latency_ewma_ms: Optional[float] = None
+    strong_latency_ewma_ms: Optional[float] = None
+    escalation_reasons: Dict[str, int] = field(default_factory=dict)
+    # Pseudo-observations from stored history and corrections
+    prior_attempts: float = 0.0
+    prior_failures: float = 0.0
+
+    @property
+    def samples(self) -> float:
+        return self.weak_attempts + self.prior_attempts
+
+    @property
+    def escalation_rate(self) -> float:
+        if not self.weak_attempts:
+            return 0.0
+        return self.escalations / self.weak_attempts
+
+    @property
+    def failure_rate(self) -> float:
+        """Escalations plus feedback-flagged weak answers per weak attempt."""
+        if not self.samples:
+            return 0.0
+        failures = self.escalations + self.negative_feedback + self.prior_failures
+        return min(1.0, failures / self.samples)
+
+    def to_dict(self) -> Dict[str, Any]:
+        return {
+            "weak_attempts": self.weak_attempts,
+            "weak_accepted": self.weak_accepted,
+            "escalations": self.escalations,
+            "strong_direct": self.strong_direct,
+            "negative_feedback": self.negative_feedback,
+            "escalation_rate": round(self.escalation_rate, 3),
+            "failure_rate": round(self.failure_rate, 3),
+            "prior_attempts": round(self.prior_attempts, 2),
+            "latency_saved_ms": round(self.latency_saved_ms, 2),
+            "escalation_reasons": dict(self.escalation_reasons),
+        }
+
+
+@dataclass
+class CascadeResult:
+    """Response from :meth:`ModelCascade.chat`."""
+
+    message: Any
+    tool_calls: Any
+    tier: str
+    escalated: bool = False
+    reason: Optional[str] = None
+    # Set when the weak model served the answer: pass it back to
+    # :meth:`ModelCascade.record_negative_feedback` if the turn is rated down
+    key: Optional[Key] = None
+
+
+def _ewma(current: Optional[float], sample: float, alpha: float = 0.2) -> float:
+    return sample if current is None else (1 - alpha) * current + alpha * sample
+
+
+class ModelCascade:
+    """Routes chat calls weak-first and escalates on low confidence."""
+
+    DEFAULT_POLICIES: Dict[str, CascadePolicy] = {
+        "chat": CascadePolicy(site="chat"),
+        "lead": CascadePolicy(site="lead"),
+        "nlu_format": CascadePolicy(site="nlu_format"),
+    }
+
+    def __init__(
+        self,
+        ai_client: BaseAIClient,
+        policies: Optional[Dict[str, CascadePolicy]] = None,
+        outcome_store: Optional["OutcomeStore"] = None,
+    ) -> None:
+        self.ai_client = ai_client
+        self.policies: Dict[str, CascadePolicy] = dict(
+            policies if policies is not None else self.DEFAULT_POLICIES
+        )
+        self.outcome_store = outcome_store
+        self._stats: Dict[Key, CascadeStats] = {}
+        self._strong_first_calls: Dict[Key, int] = {}
+        self._history_keys: Set[Key] = set()
+
+    # ------------------------------------------------------------------
+    # Routing
+    # ------------------------------------------------------------------
+    def policy_for(self, site: str) -> CascadePolicy:
+        if site not in self.policies:
+            self.policies[site] = CascadePolicy(site=site)
+        return self.policies[site]
+
+    def should_try_weak(self, site: str, capability: Optional[str] = None) -> bool:
+        policy = self.policy_for(site)
+        if not policy.enabled:
+            return False
+        key = (site, capability or site)
+        stats = self._stats.get(key)
+        if (
+            stats is None
+            or stats.samples < policy.min_samples
+            or stats.failure_rate <= policy.max_failure_rate
+        ):
+            return True
+        # Learned strong-first; re-explore weak periodically
+        count = self._strong_first_calls.get(key, 0) + 1
+        self._strong_first_calls[key] = count
+        return count % policy.explore_every == 0
+
+    async def chat(
+        self,
+        site: str,
+        messages: List[Dict[str, Any]],
+        tools: List[Dict[str, Any]] | None = None,
+        capability: Optional[str] = None,
+        force_strong: bool = False,
+    ) -> CascadeResult:
+        """Return a response, trying the weak model first when allowed."""
+        policy = self.policy_for(site)
+        key = (site, capability or site)
+        stats = self._stats.setdefault(key, CascadeStats())
+
+        if not force_strong and self.should_try_weak(site, capability):
+            start = time.perf_counter()
+            message, tool_calls = await self.ai_client.weak_chat(messages, tools)
+            weak_ms = (time.perf_counter() - start) * 1000
+            stats.weak_attempts += 1
+            stats.weak_latency_ewma_ms = _ewma(stats.weak_latency_ewma_ms, weak_ms)
+
+            reason = self.low_confidence_reason(message, tool_calls, policy)
+            if reason is None:
+                stats.weak_accepted += 1
+                if stats.strong_latency_ewma_ms is not None:
+                    stats.latency_saved_ms += stats.strong_latency_ewma_ms - weak_ms
+                self._persist(key, "accepted")
+                return CascadeResult(message, tool_calls, WEAK, key=key)
+
+            stats.escalations += 1
+            stats.escalation_reasons[reason] = stats.escalation_reasons.get(reason, 0) + 1
+            # The wasted weak call counts against the savings
+            stats.latency_saved_ms -= weak_ms
+            self._persist(key, "escalated")
+            message, tool_calls = await self._strong(stats, messages, tools)
+            return CascadeResult(message, tool_calls, STRONG, escalated=True, reason=reason)
+
+        stats.strong_direct += 1
+        message, tool_calls = await self._strong(stats, messages, tools)
+        return CascadeResult(message, tool_calls, STRONG)
+
+    async def _strong(
+        self,
+        stats: CascadeStats,
+        messages: List[Dict[str, Any]],
+        tools: List[Dict[str, Any]] | None,
+    ) -> Tuple[Any, Any]:
+        start = time.perf_counter()
+        result = await self.ai_client.strong_chat(messages, tools)
+        stats.strong_latency_ewma_ms = _ewma(
+            stats.strong_latency_ewma_ms, (time.perf_counter() - start) * 1000
+        )
+        return result
+
+    # ------------------------------------------------------------------
+    # Confidence signals
+    # ------------------------------------------------------------------
+    @staticmethod
+    def low_confidence_reason(
+        message: Any, tool_calls: Any, policy: CascadePolicy
+    ) -> Optional[str]:
+        """Return why a weak response should be escalated, or ``None``."""
+        if tool_calls:
+            for call in tool_calls:
+                try:
+                    args = json.loads(call.function.arguments)
+                except (json.JSONDecodeError, TypeError, AttributeError):
+                    return "malformed_tool_args"
+                if not isinstance(args, dict):
+                    return "malformed_tool_args"
+            return None
+
+        content = getattr(message, "content", None) or ""
+        if not content.strip():
+            return "empty"
+        if _REFUSAL_RE.search(content):
+            return "refusal"
+
+        parsed = extract_json_from_text(content)
+        if policy.expect_json and not isinstance(parsed, dict):
+            return "malformed_json"
+        if isinstance(parsed, dict):
+            if parsed.get("uncertain") is True:
+                return "self_reported_uncertainty"
+            confidence = parsed.get("confidence")
+            if isinstance(confidence, (int, float)) and confidence < policy.min_confidence:
+                return "self_reported_uncertainty"
+        return None
+
+    # ------------------------------------------------------------------
+    # Feedback
+    # ------------------------------------------------------------------
+    def record_feedback(
+        self, site: str, capability: Optional[str] = None, positive: bool = False
+    ) -> None:
+        """Record user feedback on a weak-served answer for a key."""
+        if positive:
+            return
+        key = (site, capability or site)
+        self._stats.setdefault(key, CascadeStats()).negative_feedback += 1
+        self._persist(key, "feedback")
+
+    def record_negative_feedback(self, keys: Iterable[Key]) -> int:
+        """Penalize the weak-served calls behind a rated-down turn.
+
+        *keys* are the :attr:`CascadeResult.key` values the turn collected.
+        Returns how many keys were penalized.
+        """
+        penalized = 0
+        for site, capability in dict.fromkeys(tuple(k) for k in keys):
+            self.record_feedback(site, capability)
+            penalized += 1
+        return penalized
+
+    def load_history(self, lookback_days: int = 30) -> int:
+        """Seed priors from the attached outcome store; returns keys seeded.
+
+        History is scaled down to at most ``prior_weight`` pseudo-attempts
+        per key, keeping its failure ratio.
+        """
+        if self.outcome_store is None:
+            return 0
+        seeded = 0
+        for (site, capability), (attempts, failures) in self.outcome_store.cascade_history(
+            lookback_days
+        ).items():
+            if not attempts:
+                continue
+            weight = min(attempts, self.policy_for(site).prior_weight)
+            stats = self._stats.setdefault((site, capability), CascadeStats())
+            stats.prior_attempts = weight
+            stats.prior_failures = failures * weight / attempts
+            self._history_keys.add((site, capability))
+            seeded += 1
+        return seeded
+
+    def learn_from_corrections(self, corrections: List[Dict[str, Any]]) -> int:
+        """Seed penalties from correction records that name their capability.
+
+        A correction is one failed pseudo-attempt for ``("chat", "chat")``
+        or ``("lead", capability)``; records without a capability are
+        skipped, and keys that already have stored history are left to it.
+        Per key, corrections add at most ``min_samples // 2`` priors so
+        they can never route a key strong-first on their own.  Returns the
+        number of records applied.
+        """
+        applied = 0
+        for record in corrections:
+            capability = record.get("capability")
+            if not capability:
+                continue
+            site = record.get("site") or ("chat" if capability == "chat" else "lead")
+            stats = self._stats.setdefault((site, capability), CascadeStats())
+            cap = self.policy_for(site).min_samples // 2
+            if (site, capability) in self._history_keys or stats.prior_attempts >= cap:
+                continue
+            stats.prior_attempts += 1
+            stats.prior_failures += 1
+            applied += 1
+        return applied
+
+    def _persist(self, key: Key, outcome: str) -> None:
+        if self.outcome_store is None:
+            return
+        try:
+            self.outcome_store.record_cascade_outcome(key[0], key[1], outcome)
+        except Exception:
+            pass  # Persistence is best effort; routing never depends on it
+
+    # ------------------------------------------------------------------
+    # Reporting
+    # ------------------------------------------------------------------
+    def get_stats(self) -> Dict[str, Any]:
+        """Per-key stats plus totals for latency saved and escalation rate."""
+        per_key = {f"{site}:{cap}": s.to_dict() for (site, cap), s in self._stats.items()}
+        weak_attempts = sum(s.weak_attempts for s in self._stats.values())
+        escalations = sum(s.escalations for s in self._stats.values())
+        return {
+            "keys": per_key,
+            "total_weak_attempts": weak_attempts,
+            "total_escalations": escalations,
+            "escalation_rate": round(escalations / weak_attempts, 3) if weak_attempts else 0.0,
+            "latency_saved_ms": round(
+                sum(s.latency_saved_ms for s in self._stats.values()), 2
+            ),
+        }
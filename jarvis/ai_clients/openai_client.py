@@ -22,6 +22,9 @@ class OpenAIClient(BaseAIClient):
         self.strong_model = strong_model
         self.weak_model = weak_model
 
+    async def close(self) -> None:
+        await self.client.close()
+
     @traced("llm.chat", kind=SpanKind.LLM)
     async def _chat(
         self,
@@ -65,8 +65,9 @@ class ScriptedAIClient(BaseAIClient):
     4. Calendar Command — system msg contains "calendar" with tool definitions
     5. Todo Command — system msg contains "task-management"
     6. DAG Response Formatting — system msg contains "Format a natural"
-    7. Chat (strong_chat) — system msg contains "Jarvis" or "assistant"
-    8. Fallback — nothing matched
+    7. Dialogue — responder or lead side of an agent-to-agent dialogue
+    8. Chat (strong_chat) — system msg contains "Jarvis" or "assistant"
+    9. Fallback — nothing matched
     """
 
     def __init__(
@@ -82,6 +83,7 @@ class ScriptedAIClient(BaseAIClient):
         self.chat_response = chat_response or DEFAULT_CHAT_RESPONSE
         self.calendar_response = calendar_response or DEFAULT_CALENDAR_RESPONSE
         self.todo_response = todo_response or DEFAULT_TODO_RESPONSE
+        self.dialogue_turns = 0
         self.call_log: List[Dict[str, Any]] = []
 
     async def strong_chat(
@@ -139,11 +141,23 @@ class ScriptedAIClient(BaseAIClient):
         if "format a natural" in system_msg.lower():
             return self._format_dag_response(messages)
 
-        # 7. Chat (strong_chat path)
+        # 7. Dialogue: distinct replies that never end the dialogue early
+        if "multi-turn dialogue" in system_msg or "leading a dialogue" in system_msg:
+            self.dialogue_turns += 1
+            n = self.dialogue_turns
+            if "leading a dialogue" in system_msg:
+                return json.dumps({"message": f"Follow-up question {n}?", "conclude": False})
+            return json.dumps({
+                "message": f"Answer {n}: here is what I found for that part of the request.",
+                "done": False,
+                "data": {"step": n},
+            })
+
+        # 8. Chat (strong_chat path)
         if strong:
             return self.chat_response
 
-        # 8. Fallback
+        # 9. Fallback
         logger.warning("ScriptedAIClient: no script matched for: %s", user_msg[:80])
         return "Scripted response not found."
 
@@ -213,4 +227,5 @@ class ScriptedAIClient(BaseAIClient):
             "system": self._get_system_content(messages)[:200],
             "user": self._get_user_content(messages)[:200],
             "has_tools": bool(tools),
+            "prompt_chars": sum(len(str(m.get("content") or "")) for m in messages),
         })
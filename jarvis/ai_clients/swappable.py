@@ -0,0 +1,81 @@
+"""AI client handle whose backing client can be replaced at runtime.
+
+Every agent, processor and the model cascade hold the same client object
+for the lifetime of the system, so changing provider or model used to
+mean rebuilding all of them.  They now hold a :class:`SwappableAIClient`
+instead; :meth:`swap` points it at a new client in one assignment.
+Calls already in progress finish on the client they started with, so a
+swap never drops or fails a request; :meth:`in_flight_on` tells the
+caller when the previous client is idle and can be closed.
+"""
+
+from __future__ import annotations
+
+from typing import Any, Dict, List, Tuple
+
+from .base import BaseAIClient
+
+
+class SwappableAIClient(BaseAIClient):
+    """Delegates to ``target``; see module docstring."""
+
+    def __init__(self, target: BaseAIClient) -> None:
+        self.target = target
+        self.swaps = 0
+        self._in_flight = 0
+        self._per_client: Dict[int, int] = {}
+
+    @property
+    def in_flight(self) -> int:
+        """Calls currently awaiting any client, old or new."""
+        return self._in_flight
+
+    def in_flight_on(self, client: BaseAIClient) -> int:
+        """Calls currently awaiting *client*."""
+        return self._per_client.get(id(client), 0)
+
+    def swap(self, target: BaseAIClient) -> BaseAIClient:
+        """Route new calls to *target*; returns the previous client."""
+        previous, self.target = self.target, target
+        self.swaps += 1
+        return previous
+
+    async def strong_chat(
+        self, messages: List[Dict[str, Any]], tools: List[Dict[str, Any]] | None = None
+    ) -> Tuple[Any, Any]:
+        client = self.target
+        self._enter(client)
+        try:
+            return await client.strong_chat(messages, tools)
+        finally:
+            self._leave(client)
+
+    async def weak_chat(
+        self, messages: List[Dict[str, Any]], tools: List[Dict[str, Any]] | None = None
+    ) -> Tuple[Any, Any]:
+        client = self.target
+        self._enter(client)
+        try:
+            return await client.weak_chat(messages, tools)
+        finally:
+            self._leave(client)
+
+    def _enter(self, client: BaseAIClient) -> None:
+        self._in_flight += 1
+        key = id(client)
+        self._per_client[key] = self._per_client.get(key, 0) + 1
+
+    def _leave(self, client: BaseAIClient) -> None:
+        self._in_flight -= 1
+        key = id(client)
+        remaining = self._per_client[key] - 1
+        if remaining:
+            self._per_client[key] = remaining
+        else:
+            del self._per_client[key]
+
+    def __getattr__(self, name: str) -> Any:
+        # Provider-specific attributes (strong_model, client, ...) of the current target
+        if name == "target":
+            raise AttributeError(name)
+        return getattr(self.target, name)
@@ -183,7 +183,6 @@ def _handle_switch_profile(
             apply_profile(jarvis.config, profiles[new_key])
             save_config(new_key, profiles)
             console.print(f"  Switched to [bold yellow]{profiles[new_key].label}[/bold yellow]")
-            console.print("  [dim]Restart Jarvis for changes to take full effect.[/dim]")
             return new_key, profiles
     except ValueError:
         pass
@@ -241,7 +240,6 @@ def _handle_edit_connections(
                     profiles[active_key].connections[conn_key] = new_val
                 save_config(active_key, profiles)
                 console.print(f"  {label} updated.")
-                console.print("  [dim]Restart Jarvis for changes to take full effect.[/dim]")
             return
     except ValueError:
         pass
@@ -280,6 +278,33 @@ def _handle_delete_profile(
     return active_key, profiles
 
 
+async def _apply_live(jarvis: JarvisSystem) -> None:
+    """Apply whatever the last action changed to the running system."""
+    if jarvis.live_config is None:
+        console.print("  [dim]Restart Jarvis for changes to take effect.[/dim]")
+        return
+    report = await jarvis.reload_config()
+    applied = [
+        key for key in report["changed"] if key not in report["restart_required"]
+    ]
+    if applied:
+        console.print(
+            f"  [green]Applied live[/green] ({report['elapsed_ms']:.0f} ms): "
+            + ", ".join(applied)
+        )
+    if report["undrained"]:
+        console.print(
+            "  [yellow]Cut off in-flight requests for:[/yellow] "
+            + ", ".join(report["undrained"])
+        )
+    if report["restart_required"]:
+        console.print(
+            "  [dim]Restart Jarvis to apply: "
+            + ", ".join(report["restart_required"])
+            + "[/dim]"
+        )
+
+
 async def run_config_dashboard(jarvis: JarvisSystem) -> None:
     """Main entry point for the /config interactive dashboard."""
     active_key, profiles = _load_state(jarvis)
@@ -298,14 +323,17 @@ async def run_config_dashboard(jarvis: JarvisSystem) -> None:
             break
         elif choice.lower() == "p":
             active_key, profiles = _handle_switch_profile(jarvis, active_key, profiles)
+            await _apply_live(jarvis)
         elif choice.lower() == "n":
             active_key, profiles = _handle_new_profile(jarvis, active_key, profiles)
         elif choice.lower() == "c":
             _handle_edit_connections(jarvis, active_key, profiles)
+            await _apply_live(jarvis)
         elif choice.lower() == "d":
             active_key, profiles = _handle_delete_profile(active_key, profiles)
         elif choice.isdigit():
             _handle_toggle(jarvis, int(choice), active_key, profiles)
+            await _apply_live(jarvis)
         else:
             console.print("[red]  Unknown command.[/red]")
 
@@ -1,11 +1,40 @@
-from .config import JarvisConfig, UserConfig, FeatureFlags
-from .builder import JarvisBuilder, BuilderOptions
-from .system import JarvisSystem
-from .constants import DEFAULT_PORT, LOG_DB_PATH, ExecutionResult
-from .profile import AgentProfile
-from .registry import BaseRegistry, FunctionRegistry
-from .method_recorder_base import MethodRecorderBase
-from .method_recorder import MethodRecorder
+from importlib import import_module
+
+# Imported on first access: ``jarvis.agents`` depends on small modules
+# here (profile, config), and loading the system and builder eagerly
+# would pull the agents back in mid-import.
+_EXPORTS = {
+    "JarvisConfig": ".config",
+    "UserConfig": ".config",
+    "FeatureFlags": ".config",
+    "JarvisBuilder": ".builder",
+    "BuilderOptions": ".builder",
+    "Lifetime": ".container",
+    "ServiceContainer": ".container",
+    "JarvisSystem": ".system",
+    "DEFAULT_PORT": ".constants",
+    "LOG_DB_PATH": ".constants",
+    "ExecutionResult": ".constants",
+    "AgentProfile": ".profile",
+    "BaseRegistry": ".registry",
+    "FunctionRegistry": ".registry",
+    "MethodRecorderBase": ".method_recorder_base",
+    "MethodRecorder": ".method_recorder",
+}
+
+
+def __getattr__(name):
+    module = _EXPORTS.get(name)
+    if module is None:
+        raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+    value = getattr(import_module(module, __name__), name)
+    globals()[name] = value
+    return value
+
+
+def __dir__():
+    return sorted(set(globals()) | set(_EXPORTS))
+
 
 __all__ = [
     "JarvisConfig",
@@ -13,6 +42,8 @@ __all__ = [
     "FeatureFlags",
     "JarvisBuilder",
     "BuilderOptions",
+    "Lifetime",
+    "ServiceContainer",
     "JarvisSystem",
     "DEFAULT_PORT",
     "LOG_DB_PATH",
@@ -10,6 +10,8 @@ from dotenv import load_dotenv
 
 from .config import JarvisConfig
 from .system import JarvisSystem
+from .live_config import LiveConfigReloader
+from .container import ServiceContainer
 from ..agents.factory import AgentFactory
 
 
@@ -49,8 +51,14 @@ class JarvisBuilder:
         self._config = JarvisConfig(**config) if isinstance(config, dict) else config
         self._opts = BuilderOptions()
         self._dotenv_loaded = False
+        self._services: Optional[ServiceContainer] = None
 
     # ------- Fluent toggles --------
+    def services(self, container: Optional[ServiceContainer]) -> "JarvisBuilder":
+        """Resolve shared services from *container* instead of a private one."""
+        self._services = container
+        return self
+
     def protocols(self, enabled: bool = True) -> "JarvisBuilder":
         self._opts.with_protocols = enabled
         return self
@@ -199,13 +207,19 @@ class JarvisBuilder:
             # Keep behavior consistent with your current code paths
             load_dotenv()
 
-        jarvis = JarvisSystem(self._config)
+        jarvis = JarvisSystem(self._config, services=self._services)
 
         # Create shared client + connect MongoDB loggers
         ai_client = jarvis._create_ai_client()
+        jarvis._ai_client = ai_client
         await jarvis._connect_mongo_loggers()
+        if jarvis.snapshot is not None:
+            jarvis.snapshot.load()
 
-        factory = AgentFactory(jarvis.config, jarvis.logger)
+        factory = AgentFactory(
+            jarvis.config, jarvis.logger, snapshot=jarvis.snapshot, services=jarvis.services
+        )
+        jarvis._factory = factory
         refs = {}
         if self._opts.with_memory:
             refs.update(factory._build_memory(jarvis.network, ai_client))
@@ -268,6 +282,7 @@ class JarvisBuilder:
         jarvis._setup_protocol_system(
             load_protocol_directory=self._opts.load_protocol_directory
         )
+        jarvis._save_snapshot()
 
         # Start network
         await jarvis._start_network()
@@ -286,6 +301,10 @@ class JarvisBuilder:
             if chat_agent and hasattr(chat_agent, "feedback_collector"):
                 chat_agent.feedback_collector = feedback_collector
 
+        # Weak-first model cascade for chat, lead and NLU formatting
+        if jarvis.config.flags.enable_model_cascade:
+            jarvis._setup_model_cascade(ai_client, feedback_collector)
+
         # Initialize orchestrator and response logger
         jarvis._response_logger = ResponseLogger(jarvis.interaction_logger)
         jarvis._orchestrator = RequestOrchestrator(
@@ -298,6 +317,7 @@ class JarvisBuilder:
             ai_client=ai_client,
             enable_coordinator=jarvis.config.flags.enable_coordinator,
             feedback_collector=feedback_collector,
+            model_cascade=jarvis.model_cascade,
         )
 
         # Wire scheduler agent to orchestrator
@@ -305,6 +325,8 @@ class JarvisBuilder:
         if scheduler_agent:
             scheduler_agent.set_orchestrator(jarvis._orchestrator)
 
+        jarvis.live_config = LiveConfigReloader(jarvis)
+
         protocol_count = (
             len(jarvis.protocol_runtime.registry.protocols)
             if jarvis.protocol_runtime
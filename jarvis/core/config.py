@@ -26,6 +26,9 @@ class FeatureFlags:
     enable_scheduler: bool = True
     enable_notifications: bool = True
     enable_coding: bool = True
+    enable_model_cascade: bool = False
+    enable_lazy_agents: bool = True  # build device-backed agents on first use
+    enable_startup_snapshot: bool = True  # reuse derived startup state across boots
 
 
 @dataclass
@@ -123,6 +126,9 @@ class JarvisConfig:
     # Scheduler
     scheduler_tick_interval: float = 15.0
 
+    # Startup snapshot of derived state
+    startup_snapshot_path: Optional[str] = None  # defaults to ~/.jarvis/startup_snapshot.bin
+
     flags: FeatureFlags = field(default_factory=FeatureFlags)
 
 
@@ -0,0 +1,240 @@
+"""Service container shared by every system built in one process.
+
+Each :class:`~jarvis.core.system.JarvisSystem` used to construct its own
+ChromaDB client, HTTP clients, SQLite-backed stores and loggers, so tests,
+CLI modes and the server paid the full construction cost per build even
+inside one process.  Services are now registered once, by key, with a
+:class:`Lifetime`, and resolved through a scope:
+
+- ``PROCESS``: one instance per root container, shared by every system
+  built from it (ChromaDB, HTTP clients, SQLite stores, loggers)
+- ``TENANT``: one instance per system, released at its shutdown
+- ``REQUEST``: one instance per request scope
+
+Positional arguments to :meth:`ServiceContainer.resolve` are part of the
+cache key, so systems that configure a service differently (another
+calendar URL, another API key) get separate instances rather than
+silently sharing the first one.  A factory runs in the scope that caches
+its result, so a process-wide service cannot capture a tenant one.
+
+Instances are closed by the scope that owns them, newest first, when
+that scope is closed; a system closing its tenant scope leaves shared
+process services open for the others.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import inspect
+import threading
+import time
+from dataclasses import dataclass
+from enum import Enum
+from typing import Any, Callable, Dict, Hashable, List, Optional, Tuple
+
+Key = Tuple[str, Tuple[Hashable, ...]]
+
+
+class Lifetime(str, Enum):
+    PROCESS = "process"
+    TENANT = "tenant"
+    REQUEST = "request"
+
+
+_DEPTH = {Lifetime.PROCESS: 0, Lifetime.TENANT: 1, Lifetime.REQUEST: 2}
+
+
+@dataclass(frozen=True)
+class Registration:
+    factory: Callable[..., Any]
+    lifetime: Lifetime
+    close: Optional[Callable[[Any], Any]] = None
+
+
+class ServiceContainer:
+    """Registry of service factories plus the instances one scope owns."""
+
+    def __init__(
+        self,
+        lifetime: Lifetime = Lifetime.PROCESS,
+        parent: Optional["ServiceContainer"] = None,
+        name: str = "",
+    ) -> None:
+        if (parent is None) != (lifetime is Lifetime.PROCESS):
+            raise ValueError("Only the root container has process lifetime")
+        if parent is not None and _DEPTH[lifetime] <= _DEPTH[parent.lifetime]:
+            raise ValueError(f"A {lifetime.value} scope cannot nest in a {parent.lifetime.value} scope")
+        self.lifetime = lifetime
+        self.parent = parent
+        self.name = name or lifetime.value
+        self._registrations: Dict[str, Registration] = {}
+        self._instances: Dict[Key, Any] = {}
+        self._order: List[Key] = []
+        self._pending: Dict[Key, asyncio.Future] = {}
+        self._locks: Dict[Key, threading.Lock] = {}
+        self._lock = threading.Lock()
+        self._closed = False
+        # What resolving through this scope cost: key -> [builds, reuses, ms]
+        self._costs: Dict[str, List[float]] = {}
+
+    # ------------------------------------------------------------------
+    # Registration
+    # ------------------------------------------------------------------
+    def register(
+        self,
+        key: str,
+        factory: Callable[..., Any],
+        lifetime: Lifetime = Lifetime.PROCESS,
+        close: Optional[Callable[[Any], Any]] = None,
+        replace: bool = True,
+    ) -> None:
+        """Register *factory* as ``factory(scope, *args)`` for *key*.
+
+        *close* defaults to the instance's ``close`` (or ``aclose``) method.
+        With ``replace=False`` an existing registration is kept, so
+        callers can install defaults without clobbering overrides.
+        """
+        if not replace and self.registration(key) is not None:
+            return
+        self._registrations[key] = Registration(factory, lifetime, close)
+
+    def registration(self, key: str) -> Optional[Registration]:
+        scope: Optional[ServiceContainer] = self
+        while scope is not None:
+            if key in scope._registrations:
+                return scope._registrations[key]
+            scope = scope.parent
+        return None
+
+    def scope(self, lifetime: Lifetime = Lifetime.TENANT, name: str = "") -> "ServiceContainer":
+        """Open a child scope; close it with :meth:`aclose`."""
+        return ServiceContainer(lifetime, parent=self, name=name)
+
+    # ------------------------------------------------------------------
+    # Resolution
+    # ------------------------------------------------------------------
+    def _owner(self, key: str, lifetime: Lifetime) -> "ServiceContainer":
+        scope: Optional[ServiceContainer] = self
+        while scope is not None:
+            if scope.lifetime is lifetime:
+                if scope._closed:
+                    raise RuntimeError(f"Cannot resolve {key!r}: {scope.name} scope is closed")
+                return scope
+            scope = scope.parent
+        raise LookupError(f"{key!r} has {lifetime.value} lifetime but no {lifetime.value} scope is open")
+
+    def _lookup(self, key: str) -> Tuple[Registration, "ServiceContainer"]:
+        reg = self.registration(key)
+        if reg is None:
+            raise KeyError(f"No service registered as {key!r}")
+        return reg, self._owner(key, reg.lifetime)
+
+    def resolve(self, key: str, *args: Hashable) -> Any:
+        """Return the instance for ``(key, args)``, building it on first use.
+
+        Thread-safe: concurrent resolvers of one key wait for a single
+        build; different keys build in parallel.
+        """
+        reg, owner = self._lookup(key)
+        if inspect.iscoroutinefunction(reg.factory):
+            raise TypeError(f"{key!r} has an async factory; use aresolve()")
+        cache_key = (key, args)
+        if cache_key in owner._instances:
+            self._record(key, None)
+            return owner._instances[cache_key]
+        with owner._lock:
+            lock = owner._locks.setdefault(cache_key, threading.Lock())
+        with lock:
+            if cache_key in owner._instances:
+                self._record(key, None)
+                return owner._instances[cache_key]
+            start = time.perf_counter()
+            instance = reg.factory(owner, *args)
+            owner._store(cache_key, instance)
+        self._record(key, start)
+        return instance
+
+    async def aresolve(self, key: str, *args: Hashable) -> Any:
+        """Like :meth:`resolve`, also for factories that must be awaited.
+
+        Concurrent callers share one in-progress build; a failed build is
+        not cached, so the next caller retries.
+        """
+        reg, owner = self._lookup(key)
+        if not inspect.iscoroutinefunction(reg.factory):
+            return self.resolve(key, *args)
+        cache_key = (key, args)
+        if cache_key in owner._instances:
+            self._record(key, None)
+            return owner._instances[cache_key]
+        pending = owner._pending.get(cache_key)
+        if pending is not None:
+            self._record(key, None)
+            return await asyncio.shield(pending)
+        future = asyncio.get_running_loop().create_future()
+        owner._pending[cache_key] = future
+        start = time.perf_counter()
+        try:
+            instance = await reg.factory(owner, *args)
+        except BaseException as exc:
+            future.set_exception(exc)
+            future.exception()  # mark retrieved when nobody else is waiting
+            raise
+        else:
+            owner._store(cache_key, instance)
+            future.set_result(instance)
+        finally:
+            owner._pending.pop(cache_key, None)
+        self._record(key, start)
+        return instance
+
+    def _store(self, cache_key: Key, instance: Any) -> None:
+        self._instances[cache_key] = instance
+        self._order.append(cache_key)
+
+    def _record(self, key: str, start: Optional[float]) -> None:
+        cost = self._costs.setdefault(key, [0, 0, 0.0])
+        if start is None:
+            cost[1] += 1
+        else:
+            cost[0] += 1
+            cost[2] += (time.perf_counter() - start) * 1000
+
+    # ------------------------------------------------------------------
+    # Lifecycle and reporting
+    # ------------------------------------------------------------------
+    async def aclose(self) -> None:
+        """Close the instances this scope owns, newest first."""
+        if self._closed:
+            return
+        self._closed = True
+        for cache_key in reversed(self._order):
+            instance = self._instances.pop(cache_key)
+            reg = self.registration(cache_key[0])
+            closer = reg.close if reg is not None and reg.close is not None else None
+            try:
+                if closer is not None:
+                    result = closer(instance)
+                else:
+                    method = getattr(instance, "close", None) or getattr(instance, "aclose", None)
+                    result = method() if callable(method) else None
+                if inspect.isawaitable(result):
+                    await result
+            except Exception:
+                # One service failing to close must not keep the rest open
+                pass
+        self._order.clear()
+
+    def report(self) -> Dict[str, Any]:
+        """Per-key builds, reuses and build time for lookups via this scope."""
+        services = {
+            key: {"built": int(b), "reused": int(r), "build_ms": round(ms, 2)}
+            for key, (b, r, ms) in sorted(self._costs.items())
+        }
+        return {
+            "scope": self.name,
+            "build_ms": round(sum(s["build_ms"] for s in services.values()), 2),
+            "built": sum(s["built"] for s in services.values()),
+            "reused": sum(s["reused"] for s in services.values()),
+            "services": services,
+        }
@@ -4,15 +4,26 @@ When a user says "bad!" (or similar), the system captures the previous
 interaction and stores it as a correction record.  These corrections are
 injected into future agent prompts so the system avoids repeating the
 same mistakes.
+
+Corrections live in an append-only JSONL log.  Resolving a correction
+appends a ``{"op": "resolve"}`` event instead of rewriting the file; the
+log is compacted once dead lines outnumber live records.  The log is read
+once per process into an index holding a ring buffer of the newest
+corrections per user, so serving a chat turn never touches the disk and
+costs the same whether the log holds ten records or a hundred thousand.
 """
 
 from __future__ import annotations
 
 import json
+import os
+import re
 import uuid
+from collections import deque
 from datetime import datetime, timezone
+from itertools import islice
 from pathlib import Path
-from typing import List, Optional
+from typing import Any, Deque, Dict, FrozenSet, List, Optional, Tuple
 
 
 FEEDBACK_TRIGGERS: set[str] = {
@@ -29,13 +40,47 @@ FEEDBACK_TRIGGERS: set[str] = {
 # Normalised for matching — built once at import time
 _NORMALISED_TRIGGERS: set[str] = {t.lower().strip() for t in FEEDBACK_TRIGGERS}
 
+_WORD_RE = re.compile(r"\w+")
+
+# Words too common to say anything about whether two requests are related
+_STOPWORDS: FrozenSet[str] = frozenset(
+    "a an and are can do for i is it me my of on please the to what you".split()
+)
+
+_Entry = Tuple[FrozenSet[str], dict]
+
+
+def _tokens(text: str) -> FrozenSet[str]:
+    return frozenset(w for w in _WORD_RE.findall(text.lower()) if w not in _STOPWORDS)
+
+
+def _similarity(query: FrozenSet[str], tokens: FrozenSet[str]) -> float:
+    """Jaccard overlap of two token sets."""
+    if not query or not tokens:
+        return 0.0
+    return len(query & tokens) / len(query | tokens)
+
 
 class FeedbackCollector:
     """Detects negative feedback, logs corrections, and serves them back."""
 
-    def __init__(self, feedback_dir: Optional[str] = None) -> None:
+    def __init__(
+        self,
+        feedback_dir: Optional[str] = None,
+        per_user_capacity: int = 200,
+        compact_after: int = 1000,
+    ) -> None:
         self.feedback_dir = Path(feedback_dir) if feedback_dir else Path.home() / ".jarvis" / "feedback"
         self.corrections_file = self.feedback_dir / "corrections.jsonl"
+        self.per_user_capacity = per_user_capacity
+        self.compact_after = compact_after
+
+        self._loaded = False
+        # Unresolved records in log order, keyed by correction ID
+        self._open: Dict[str, dict] = {}
+        self._by_user: Dict[Any, Deque[_Entry]] = {}
+        # Log lines that no longer describe an open correction
+        self._dead_lines = 0
 
     # ------------------------------------------------------------------
     # Detection
@@ -70,62 +115,139 @@ class FeedbackCollector:
             "capability": capability,
             "resolved": False,
         }
-        self.feedback_dir.mkdir(parents=True, exist_ok=True)
-        with open(self.corrections_file, "a", encoding="utf-8") as fh:
-            fh.write(json.dumps(record) + "\n")
+        self._load()
+        self._append(record)
+        self._index(record)
         return correction_id
 
     def get_corrections(
         self,
         limit: int = 20,
         user_id: Optional[int] = None,
+        query: Optional[str] = None,
     ) -> List[dict]:
-        """Return the most recent corrections, optionally filtered by user."""
-        if not self.corrections_file.exists():
+        """Return open corrections, optionally filtered by user.
+
+        Without *query* the most recent *limit* records are returned,
+        oldest first.  With *query* the records whose original input is
+        most similar to it come first, and any remaining slots are filled
+        with the most recent unrelated corrections.  For a single user
+        only the newest ``per_user_capacity`` corrections are considered.
+        """
+        self._load()
+        if limit <= 0:
             return []
-
-        records: list[dict] = []
-        with open(self.corrections_file, "r", encoding="utf-8") as fh:
-            for line in fh:
-                line = line.strip()
-                if not line:
-                    continue
-                try:
-                    record = json.loads(line)
-                except json.JSONDecodeError:
-                    continue
-                if record.get("resolved"):
-                    continue
-                if user_id is not None and record.get("user_id") != user_id:
-                    continue
-                records.append(record)
-
-        # Return the most recent *limit* entries
-        return records[-limit:]
+        if user_id is not None:
+            entries: List[_Entry] = list(self._by_user.get(user_id, ()))
+        elif query is None:
+            return list(islice(reversed(self._open.values()), limit))[::-1]
+        else:
+            recent = islice(reversed(self._open.values()), max(limit, self.per_user_capacity))
+            entries = [(_tokens(r.get("original_input", "")), r) for r in recent][::-1]
+
+        if query is None:
+            return [record for _, record in entries[-limit:]]
+
+        wanted = _tokens(query)
+        scored = [
+            (_similarity(wanted, tokens), pos, record)
+            for pos, (tokens, record) in enumerate(entries)
+        ]
+        relevant = sorted((s for s in scored if s[0] > 0), key=lambda s: (-s[0], -s[1]))
+        chosen = [record for _, _, record in relevant[:limit]]
+        if len(chosen) < limit:
+            fill = [record for score, _, record in reversed(scored) if score == 0]
+            chosen.extend(fill[: limit - len(chosen)])
+        return chosen
 
     def mark_resolved(self, correction_id: str) -> bool:
-        """Mark a correction as resolved by rewriting the file."""
-        if not self.corrections_file.exists():
+        """Mark a correction as resolved by appending a resolve event."""
+        self._load()
+        record = self._open.pop(correction_id, None)
+        if record is None:
             return False
+        ring = self._by_user.get(record.get("user_id"))
+        if ring is not None:
+            for entry in ring:
+                if entry[1] is record:
+                    ring.remove(entry)
+                    break
+        record["resolved"] = True
+        self._append({
+            "op": "resolve",
+            "id": correction_id,
+            "timestamp": datetime.now(timezone.utc).isoformat(),
+        })
+        self._dead_lines += 2
+        if self._dead_lines >= self.compact_after and self._dead_lines > len(self._open):
+            self.compact()
+        return True
+
+    def compact(self) -> None:
+        """Rewrite the log with only the open corrections."""
+        self._load()
+        self.feedback_dir.mkdir(parents=True, exist_ok=True)
+        tmp = self.corrections_file.with_suffix(".jsonl.tmp")
+        with open(tmp, "w", encoding="utf-8") as fh:
+            for record in self._open.values():
+                fh.write(json.dumps(record) + "\n")
+        os.replace(tmp, self.corrections_file)
+        self._dead_lines = 0
 
-        lines: list[str] = []
-        found = False
+    # ------------------------------------------------------------------
+    # Index
+    # ------------------------------------------------------------------
+    def _append(self, entry: dict) -> None:
+        self.feedback_dir.mkdir(parents=True, exist_ok=True)
+        with open(self.corrections_file, "a", encoding="utf-8") as fh:
+            fh.write(json.dumps(entry) + "\n")
+
+    def _index(self, record: dict) -> None:
+        self._open[record["id"]] = record
+        uid = record.get("user_id")
+        ring = self._by_user.get(uid)
+        if ring is None:
+            ring = self._by_user[uid] = deque(maxlen=self.per_user_capacity)
+        ring.append((_tokens(record.get("original_input", "")), record))
+
+    def _load(self) -> None:
+        """Replay the log into the in-memory index, once."""
+        if self._loaded:
+            return
+        self._loaded = True
+        if not self.corrections_file.exists():
+            return
+
+        records: Dict[str, dict] = {}
+        dead = 0
         with open(self.corrections_file, "r", encoding="utf-8") as fh:
             for line in fh:
-                stripped = line.strip()
-                if not stripped:
+                line = line.strip()
+                if not line:
                     continue
                 try:
-                    record = json.loads(stripped)
+                    entry = json.loads(line)
                 except json.JSONDecodeError:
-                    lines.append(stripped)
+                    dead += 1
                     continue
-                if record.get("id") == correction_id:
-                    record["resolved"] = True
-                    found = True
-                lines.append(json.dumps(record))
-
-        if found:
-            with open(self.corrections_file, "w", encoding="utf-8") as fh:
-                fh.write("\n".join(lines) + "\n")
-        return found
+                if entry.get("op") == "resolve":
+                    dead += 2 if records.pop(entry.get("id"), None) is not None else 1
+                elif entry.get("resolved") or "id" not in entry:
+                    dead += 1
+                else:
+                    records[entry["id"]] = entry
+
+        # Only the newest records of each user make it into the rings, so
+        # tokenize just those instead of every record in the log
+        newest: Dict[Any, List[dict]] = {}
+        for record in reversed(records.values()):
+            bucket = newest.setdefault(record.get("user_id"), [])
+            if len(bucket) < self.per_user_capacity:
+                bucket.append(record)
+        for uid, bucket in newest.items():
+            self._by_user[uid] = deque(
+                ((_tokens(r.get("original_input", "")), r) for r in reversed(bucket)),
+                maxlen=self.per_user_capacity,
+            )
+        self._open = records
+        self._dead_lines = dead
@@ -0,0 +1,255 @@
+"""Apply configuration changes to a running :class:`JarvisSystem`.
+
+Changing a flag or model in the config dashboard used to need a restart,
+which rebuilt every agent and dropped whatever was in flight.  Most keys
+only touch one component, so :func:`diff_config` maps a before/after pair
+of configs onto the smallest set of actions and :class:`LiveConfigReloader`
+carries them out in place:
+
+- provider, API key or model names: build a new AI client and swap it
+  into the system's :class:`~jarvis.ai_clients.SwappableAIClient`; the
+  old one is closed once the calls started on it have finished
+- a toggleable feature flag: add the agent, or retire it once the
+  requests it is handling have finished
+- lights / Roku connection settings: rebuild that one agent
+- timeouts, coordinator and cascade: update the orchestrator directly
+
+Keys that are read once at startup (worker count, storage paths, probe
+intervals, ...) are reported back as needing a restart rather than
+silently ignored.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import copy
+import time
+from dataclasses import dataclass, field, fields
+from typing import TYPE_CHECKING, Any, Dict, List, Optional, Set
+
+from ..agents.factory import TOGGLEABLE_AGENTS
+from ..agents.lazy_agent import LazyAgent
+from ..ai_clients import AIClientFactory, BaseAIClient
+from .config import FLAG_NAMES, JarvisConfig
+
+if TYPE_CHECKING:
+    from .system import JarvisSystem
+
+AI_CLIENT_KEYS = {"ai_provider", "api_key", "strong_model", "weak_model"}
+
+# Connection settings only read when their agent is built
+REBUILD_KEYS = {
+    "lighting_backend": "enable_lights",
+    "hue_bridge_ip": "enable_lights",
+    "hue_username": "enable_lights",
+    "yeelight_bulb_ips": "enable_lights",
+    "roku_ip_address": "enable_roku",
+    "roku_ip_addresses": "enable_roku",
+    "roku_username": "enable_roku",
+    "roku_password": "enable_roku",
+}
+
+RUNTIME_KEYS = {"response_timeout", "enable_coordinator", "enable_model_cascade"}
+
+
+@dataclass
+class ReloadPlan:
+    """What a config change requires; see :func:`diff_config`."""
+
+    changed: List[str] = field(default_factory=list)
+    swap_ai_client: bool = False
+    enable: List[str] = field(default_factory=list)
+    disable: List[str] = field(default_factory=list)
+    rebuild: List[str] = field(default_factory=list)
+    runtime: List[str] = field(default_factory=list)
+    restart_required: List[str] = field(default_factory=list)
+
+    @property
+    def empty(self) -> bool:
+        return not self.changed
+
+
+def _changed_keys(old: JarvisConfig, new: JarvisConfig) -> List[str]:
+    keys = [
+        f.name
+        for f in fields(JarvisConfig)
+        if f.name != "flags" and getattr(old, f.name) != getattr(new, f.name)
+    ]
+    keys += [
+        name for name in FLAG_NAMES if getattr(old.flags, name) != getattr(new.flags, name)
+    ]
+    return keys
+
+
+def diff_config(old: JarvisConfig, new: JarvisConfig) -> ReloadPlan:
+    """Classify every key that differs between *old* and *new*."""
+    plan = ReloadPlan(changed=_changed_keys(old, new))
+    rebuild: Set[str] = set()
+    for key in plan.changed:
+        if key in AI_CLIENT_KEYS:
+            plan.swap_ai_client = True
+        elif key in TOGGLEABLE_AGENTS:
+            (plan.enable if getattr(new.flags, key) else plan.disable).append(key)
+        elif key in REBUILD_KEYS:
+            rebuild.add(REBUILD_KEYS[key])
+        elif key in RUNTIME_KEYS:
+            plan.runtime.append(key)
+        else:
+            plan.restart_required.append(key)
+    # A rebuild only matters for a feature that stays on
+    plan.rebuild = sorted(
+        flag
+        for flag in rebuild
+        if getattr(new.flags, flag) and flag not in plan.enable
+    )
+    return plan
+
+
+class LiveConfigReloader:
+    """Applies :class:`ReloadPlan` actions to one initialized system."""
+
+    def __init__(self, system: "JarvisSystem", drain_timeout: float = 10.0) -> None:
+        self.system = system
+        self.drain_timeout = drain_timeout
+        self._applied = copy.deepcopy(system.config)
+        self._lock = asyncio.Lock()
+        self._closing: Set[asyncio.Task] = set()
+
+    def pending(self) -> ReloadPlan:
+        """Changes made to ``system.config`` since the last reload."""
+        return diff_config(self._applied, self.system.config)
+
+    async def reload(self, new_config: Optional[JarvisConfig] = None) -> Dict[str, Any]:
+        """Apply *new_config* (or in-place edits to ``system.config``).
+
+        Returns what was applied, what still needs a restart and any
+        agents retired before their in-flight requests finished.
+        """
+        async with self._lock:
+            start = time.perf_counter()
+            config = self.system.config
+            if new_config is not None and new_config is not config:
+                # Update in place: the factory and agents hold this object
+                for f in fields(JarvisConfig):
+                    if f.name != "flags":
+                        setattr(config, f.name, copy.deepcopy(getattr(new_config, f.name)))
+                for name in FLAG_NAMES:
+                    setattr(config.flags, name, getattr(new_config.flags, name))
+            plan = diff_config(self._applied, config)
+            undrained: List[str] = []
+            if plan.swap_ai_client:
+                self._swap_ai_client()
+            retire = plan.disable + plan.rebuild
+            if retire:
+                results = await asyncio.gather(*(self._disable(flag) for flag in retire))
+                undrained = [name for names in results for name in names]
+            for flag in plan.enable + plan.rebuild:
+                self._enable(flag)
+            if plan.runtime:
+                self._apply_runtime()
+            self._applied = copy.deepcopy(config)
+            report = {
+                "changed": plan.changed,
+                "ai_client_swapped": plan.swap_ai_client,
+                "enabled": plan.enable,
+                "disabled": plan.disable,
+                "rebuilt": plan.rebuild,
+                "runtime": plan.runtime,
+                "restart_required": plan.restart_required,
+                "undrained": undrained,
+                "elapsed_ms": round((time.perf_counter() - start) * 1000, 2),
+            }
+            if plan.changed:
+                self.system.logger.log("INFO", "Configuration reloaded", report)
+            return report
+
+    def _swap_ai_client(self) -> None:
+        system = self.system
+        config = system.config
+        client = AIClientFactory.create(
+            config.ai_provider,
+            api_key=config.api_key,
+            strong_model=config.strong_model,
+            weak_model=config.weak_model,
+        )
+        # Every agent holds the same handle, so one swap redirects them all
+        previous = system._ai_client.swap(client)
+        task = asyncio.create_task(self._close_when_idle(previous))
+        self._closing.add(task)
+        task.add_done_callback(self._closing.discard)
+
+    async def _close_when_idle(self, client: BaseAIClient) -> None:
+        """Close a swapped-out client once the calls started on it finish."""
+        handle = self.system._ai_client
+        while handle.in_flight_on(client):
+            await asyncio.sleep(0.05)
+        try:
+            await client.close()
+        except Exception as exc:
+            self.system.logger.log("WARNING", "Error closing previous AI client", str(exc))
+
+    async def _disable(self, flag: str) -> List[str]:
+        """Retire *flag*'s agents; returns those that did not drain."""
+        network = self.system.network
+        refs = self.system._agent_refs
+        agents = []
+        for name in TOGGLEABLE_AGENTS[flag]:
+            agent = network.agents.get(name)
+            if agent is not None and agent not in agents:
+                agents.append(agent)
+        undrained = []
+        for agent in agents:
+            if not await network.retire_agent(agent, self.drain_timeout):
+                undrained.append(agent.name)
+            built = agent.agent if isinstance(agent, LazyAgent) else agent
+            if built is not None:
+                await self._stop(built)
+            factory = self.system._factory
+            if factory is not None:
+                factory.lazy_agents.pop(agent.name, None)
+            for key, value in list(refs.items()):
+                if value is agent or value is built:
+                    del refs[key]
+        return undrained
+
+    async def _stop(self, agent: Any) -> None:
+        for method in ("stop", "close"):
+            closer = getattr(agent, method, None)
+            if callable(closer):
+                try:
+                    await closer()
+                except Exception as exc:
+                    self.system.logger.log(
+                        "WARNING", f"Error stopping {agent.name}", str(exc)
+                    )
+                return
+
+    def _enable(self, flag: str) -> None:
+        system = self.system
+        added = system._factory.build_feature(
+            flag, system.network, system._ai_client, system._agent_refs
+        )
+        scheduler = added.get("scheduler_agent")
+        if scheduler is not None and system._orchestrator is not None:
+            scheduler.set_orchestrator(system._orchestrator)
+        if system.model_cascade is not None:
+            for agent in added.values():
+                if hasattr(agent, "model_cascade"):
+                    agent.model_cascade = system.model_cascade
+
+    def _apply_runtime(self) -> None:
+        system = self.system
+        config = system.config
+        orchestrator = system._orchestrator
+        system.network.dependency_health.assumed_timeout = config.response_timeout
+        if config.flags.enable_model_cascade and system.model_cascade is None:
+            system._setup_model_cascade(system._ai_client)
+        elif not config.flags.enable_model_cascade and system.model_cascade is not None:
+            for agent in system.network.agents.values():
+                if getattr(agent, "model_cascade", None) is not None:
+                    agent.model_cascade = None
+            system.model_cascade = None
+        if orchestrator is not None:
+            orchestrator.response_timeout = config.response_timeout
+            orchestrator.enable_coordinator = config.flags.enable_coordinator
+            orchestrator.model_cascade = system.model_cascade
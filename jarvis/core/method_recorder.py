@@ -73,6 +73,23 @@ class MethodRecorder(MethodRecorderBase):
             parameter_mappings=mappings or {},
         )
 
+    def compile(
+        self, arguments: Dict[str, Any] | None = None
+    ) -> InstructionProtocol | None:
+        """Return an optimized copy of the current protocol.
+
+        See :func:`jarvis.protocols.compiler.compile_protocol`: repeated
+        read-only steps are dropped, known *arguments* are bound and
+        independent steps are grouped to run concurrently.
+        """
+        protocol = self.get_protocol()
+        if not protocol:
+            return None
+        from ..protocols.compiler import compile_protocol
+
+        compiled, _report = compile_protocol(protocol, arguments)
+        return compiled
+
     async def replay_last_protocol(
         self,
         network: AgentNetwork,
@@ -80,9 +97,14 @@ class MethodRecorder(MethodRecorderBase):
         *,
         arguments: Dict[str, Any] | None = None,
         usage_logger: ProtocolUsageLogger | None = None,
+        optimized: bool = False,
     ) -> Dict[str, Any] | None:
-        """Execute the currently recorded protocol without saving it."""
-        protocol = self.get_protocol()
+        """Execute the currently recorded protocol without saving it.
+
+        With ``optimized=True`` the compiled form from :meth:`compile`
+        is run instead of the steps as recorded.
+        """
+        protocol = self.compile(arguments) if optimized else self.get_protocol()
         if not protocol:
             return None
         from ..protocols.executor import ProtocolExecutor
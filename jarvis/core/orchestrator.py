@@ -17,6 +17,7 @@ from .response_logger import ResponseLogger, RequestTimer
 from .profile import AgentProfile
 from .mission import MissionBrief, MissionBudget, MissionComplexity, MissionContext
 from ..utils.performance import PerfTracker, get_tracker
+from ..utils.serialization import Payload
 from ..logging.tracer import get_tracer, SpanKind
 
 from .feedback import FeedbackCollector
@@ -24,6 +25,7 @@ from .feedback import FeedbackCollector
 if TYPE_CHECKING:
     from ..agents.agent_network import AgentNetwork
     from ..ai_clients.base import BaseAIClient
+    from ..ai_clients.cascade import ModelCascade
     from ..protocols.runtime import ProtocolRuntime
     from ..logging import JarvisLogger
 
@@ -64,6 +66,7 @@ class RequestOrchestrator:
         ai_client: Optional["BaseAIClient"] = None,
         enable_coordinator: bool = True,
         feedback_collector: Optional[FeedbackCollector] = None,
+        model_cascade: Optional["ModelCascade"] = None,
     ):
         """Initialize request orchestrator.
 
@@ -77,6 +80,7 @@ class RequestOrchestrator:
             ai_client: AI client for coordinator triage (None disables coordinator)
             enable_coordinator: Feature flag to enable/disable coordinator
             feedback_collector: Collector for negative feedback corrections
+            model_cascade: Weak-first model cascade to credit feedback to
         """
         self.network = network
         self.protocol_runtime = protocol_runtime
@@ -87,9 +91,13 @@ class RequestOrchestrator:
         self.ai_client = ai_client
         self.enable_coordinator = enable_coordinator
         self.feedback_collector = feedback_collector
+        self.model_cascade = model_cascade
 
         # Conversation history: user_id -> list of turns
         self.conversation_history: Dict[int, List[Dict[str, str]]] = {}
+        # What served each user's last turn, for feedback attribution:
+        # user_id -> {"capability": ..., "cascade_keys": [...]}
+        self._last_turn_sources: Dict[int, Dict[str, Any]] = {}
 
         # User profiles: user_id -> AgentProfile
         self.user_profiles: Dict[int, AgentProfile] = {}
@@ -119,6 +127,25 @@ class RequestOrchestrator:
         Returns:
             Dict with response and execution details
         """
+        payload = await self.respond(
+            user_input, tz_name, metadata, allowed_agents, perf_enabled
+        )
+        return payload.value
+
+    async def respond(
+        self,
+        user_input: str,
+        tz_name: str,
+        metadata: Optional[Dict[str, Any]] = None,
+        allowed_agents: Optional[set[str]] = None,
+        perf_enabled: bool = True,
+    ) -> Payload:
+        """Like :meth:`process_request`, but returns the encoded response.
+
+        The result is encoded once here; the trace span written for it
+        and the HTTP body built from the returned :class:`Payload` reuse
+        the same bytes.
+        """
         timer = RequestTimer().start()
 
         # Extract and prepare metadata
@@ -143,50 +170,17 @@ class RequestOrchestrator:
         self._apply_user_profile(req_metadata)
 
         try:
-            # Check night mode first
-            if self.night_mode:
-                result = await self._handle_night_mode(
-                    user_input, req_metadata, timer
+            payload = Payload(
+                await self._route_request(
+                    user_input, req_metadata, allowed_agents, timer, tracker
                 )
-                if result:
-                    return result
-
-            # Intercept negative feedback before routing
-            if self.feedback_collector and self.feedback_collector.is_negative_feedback(user_input):
-                feedback_result = self._handle_feedback(user_input, req_metadata)
-                if feedback_result:
-                    return feedback_result
-
-            # Try protocol match (fast path)
-            protocol_result = await self._try_protocol_match(
-                user_input,
-                req_metadata,
-                allowed_agents,
-                timer,
-                tracker,
-            )
-            if protocol_result:
-                return protocol_result
-
-            # Try coordinator triage (complex request detection)
-            coordinator_result = await self._coordinate_request(
-                user_input,
-                req_metadata,
-                allowed_agents,
-                timer,
-                tracker,
-            )
-            if coordinator_result:
-                return coordinator_result
-
-            # Fall back to NLU routing
-            return await self._route_to_nlu(
-                user_input,
-                req_metadata,
-                allowed_agents,
-                timer,
-                tracker,
             )
+            if tracer:
+                async with tracer.span(
+                    "orchestrator.response", kind=SpanKind.ORCHESTRATOR
+                ) as span:
+                    span.record_output(payload)
+            return payload
         
         finally:
             # End trace
@@ -198,6 +192,60 @@ class RequestOrchestrator:
                 tracker.stop()
                 tracker.save()
                 self.logger.log("INFO", "Performance summary", tracker.summary())
+
+    async def _route_request(
+        self,
+        user_input: str,
+        req_metadata: RequestMetadata,
+        allowed_agents: Optional[set[str]],
+        timer: RequestTimer,
+        tracker: Optional[PerfTracker],
+    ) -> Dict[str, Any]:
+        """Night mode, feedback, protocols, coordinator, then NLU routing."""
+        # Check night mode first
+        if self.night_mode:
+            result = await self._handle_night_mode(
+                user_input, req_metadata, timer
+            )
+            if result:
+                return result
+
+        # Intercept negative feedback before routing
+        if self.feedback_collector and self.feedback_collector.is_negative_feedback(user_input):
+            feedback_result = self._handle_feedback(user_input, req_metadata)
+            if feedback_result:
+                return feedback_result
+
+        # Try protocol match (fast path)
+        protocol_result = await self._try_protocol_match(
+            user_input,
+            req_metadata,
+            allowed_agents,
+            timer,
+            tracker,
+        )
+        if protocol_result:
+            return protocol_result
+
+        # Try coordinator triage (complex request detection)
+        coordinator_result = await self._coordinate_request(
+            user_input,
+            req_metadata,
+            allowed_agents,
+            timer,
+            tracker,
+        )
+        if coordinator_result:
+            return coordinator_result
+
+        # Fall back to NLU routing
+        return await self._route_to_nlu(
+            user_input,
+            req_metadata,
+            allowed_agents,
+            timer,
+            tracker,
+        )
     
     def _extract_metadata(
         self, metadata: Optional[Dict[str, Any]]
@@ -270,6 +318,19 @@ class RequestOrchestrator:
             if hasattr(chat_agent, "current_user_id"):
                 chat_agent.current_user_id = metadata.user_id
     
+    @staticmethod
+    def _collect_cascade_keys(result: Any, depth: int = 0) -> List[Any]:
+        """Cascade keys reported in *result* and the agent results it nests."""
+        if not isinstance(result, dict) or depth > 4:
+            return []
+        metadata = result.get("metadata")
+        keys = list(metadata.get("cascade_keys", [])) if isinstance(metadata, dict) else []
+        nested = result.get("results")
+        for entry in nested if isinstance(nested, list) else []:
+            if isinstance(entry, dict):
+                keys += RequestOrchestrator._collect_cascade_keys(entry.get("result"), depth + 1)
+        return keys
+
     def _handle_feedback(
         self,
         user_input: str,
@@ -288,12 +349,17 @@ class RequestOrchestrator:
         original_input = last_turn.get("user", "")
         bad_response = last_turn.get("assistant", "")
 
+        sources = self._last_turn_sources.pop(metadata.user_id, {})
         correction_id = self.feedback_collector.log_correction(
             user_id=metadata.user_id,
             original_input=original_input,
             bad_response=bad_response,
             feedback_text=user_input,
+            capability=sources.get("capability"),
         )
+        if self.model_cascade:
+            # Only the weak calls that produced the rated turn are charged
+            self.model_cascade.record_negative_feedback(sources.get("cascade_keys", []))
 
         self.logger.log(
             "INFO",
@@ -539,7 +605,7 @@ class RequestOrchestrator:
             # Store conversation history
             if response_text:
                 self._store_conversation_turn(
-                    metadata.user_id, user_input, response_text
+                    metadata.user_id, user_input, response_text, result, capability
                 )
             
             # Log successful interaction
@@ -890,7 +956,11 @@ class RequestOrchestrator:
             # Store conversation turn
             if response_text:
                 self._store_conversation_turn(
-                    metadata.user_id, brief.user_input, response_text
+                    metadata.user_id,
+                    brief.user_input,
+                    response_text,
+                    result,
+                    brief.lead_capability,
                 )
 
             # Log interaction
@@ -933,7 +1003,12 @@ class RequestOrchestrator:
             return None
 
     def _store_conversation_turn(
-        self, user_id: int, user_input: str, response: str
+        self,
+        user_id: int,
+        user_input: str,
+        response: str,
+        result: Any = None,
+        capability: Optional[str] = None,
     ) -> None:
         """Store a conversation turn in history.
         
@@ -941,7 +1016,13 @@ class RequestOrchestrator:
             user_id: User ID
             user_input: User's input
             response: System's response
+            result: Raw agent result, scanned for weak-served cascade keys
+            capability: Capability that answered the turn
         """
+        self._last_turn_sources[user_id] = {
+            "capability": capability,
+            "cascade_keys": self._collect_cascade_keys(result),
+        }
         if user_id not in self.conversation_history:
             self.conversation_history[user_id] = []
         
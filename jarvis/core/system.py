@@ -3,23 +3,29 @@
 import asyncio
 import os
 from os import getenv
+import time
 import uuid
 from typing import Any, Dict, List, Optional, Set
 from pathlib import Path
 
 from ..agents.agent_network import AgentNetwork
 from ..night_agents import NightAgent, NightModeControllerAgent
-from ..ai_clients import AIClientFactory, BaseAIClient
+from ..ai_clients import AIClientFactory, BaseAIClient, ModelCascade, SwappableAIClient
 from ..logging import JarvisLogger
 from ..logging.trace_store import TraceStore
 from ..logging.tracer import init_tracer, get_tracer, TRACING_ENABLED, TRACE_LLM_CONTENT
 from .config import JarvisConfig
+from .container import Lifetime, ServiceContainer
 from .method_recorder import MethodRecorder
 from ..protocols.loggers import ProtocolUsageLogger, InteractionLogger
 from ..protocols.runtime import ProtocolRuntime
+from ..services.outcome_store import OutcomeStore
 from ..utils.performance import PerfTracker, get_tracker
+from ..utils.serialization import Payload
 from ..agents.factory import AgentFactory
+from ..storage import StartupSnapshot
 from .feedback import FeedbackCollector
+from .live_config import LiveConfigReloader
 from .orchestrator import RequestOrchestrator
 from .response_logger import ResponseLogger
 
@@ -32,8 +38,15 @@ class JarvisSystem:
         config: JarvisConfig | Dict[str, Any],
         record_network_methods: bool = False,
         method_recorder: MethodRecorder | None = None,
+        services: ServiceContainer | None = None,
     ):
-        """Create a new Jarvis system."""
+        """Create a new Jarvis system.
+
+        Pass a shared *services* container to reuse process-wide services
+        (ChromaDB, HTTP clients, SQLite stores, loggers) built by other
+        systems; by default the system gets a private one.
+        """
+        self._created_at = time.perf_counter()
         if isinstance(config, dict):
             self.config = JarvisConfig(**config)
         else:
@@ -42,9 +55,13 @@ class JarvisSystem:
         if not record_network_methods:
             record_network_methods = self.config.record_network_methods
 
-        # Check environment variable for verbose mode
-        verbose = getenv("JARVIS_VERBOSE", "false").lower() in ("true", "1", "yes")
-        self.logger = JarvisLogger(verbose=verbose)
+        self._owns_services = services is None
+        root = services if services is not None else ServiceContainer()
+        self._register_services(root)
+        AgentFactory.register_services(root)
+        self.services = root.scope(Lifetime.TENANT, name=f"system-{uuid.uuid4().hex[:8]}")
+
+        self.logger = self.services.resolve("logger")
 
         # Initialize tracing
         self._trace_store = TraceStore()
@@ -71,36 +88,58 @@ class JarvisSystem:
 
         # Protocol runtime and loggers
         self.protocol_runtime: ProtocolRuntime | None = None
-        self.usage_logger = ProtocolUsageLogger(
-            mongo_uri=getenv("MONGO_URI", "mongodb://localhost:27017/"),
-            db_name=getenv("MONGO_DB_NAME", "protocol"),
-        )
-        self.interaction_logger = InteractionLogger(
-            mongo_uri=getenv("MONGO_URI", "mongodb://localhost:27017/"),
-            db_name=getenv("MONGO_DB_NAME", "protocol"),
+        self._mongo = (
+            getenv("MONGO_URI", "mongodb://localhost:27017/"),
+            getenv("MONGO_DB_NAME", "protocol"),
         )
+        self.usage_logger = self.services.resolve("usage_logger", *self._mongo)
+        self.interaction_logger = self.services.resolve("interaction_logger", *self._mongo)
 
         # Request orchestrator (initialized after network setup)
         self._orchestrator: RequestOrchestrator | None = None
         self._response_logger: ResponseLogger | None = None
+        self.model_cascade: ModelCascade | None = None
+
+        # Startup accounting and deferred agent construction
+        self._factory: AgentFactory | None = None
+        self._startup_phases: Dict[str, float] = {}
+        self._first_request_ms: float | None = None
+        self._warm_up_task: asyncio.Task | None = None
+        self.live_config: LiveConfigReloader | None = None
+        self.snapshot: StartupSnapshot | None = (
+            StartupSnapshot(self.config.startup_snapshot_path)
+            if self.config.flags.enable_startup_snapshot
+            else None
+        )
 
     async def initialize(self, load_protocol_directory: bool = False) -> None:
         """Initialize all agents and start the network.
 
         Heavy I/O (MongoDB, ChromaDB, geolocation, protocol files) runs in
         parallel via asyncio.gather / to_thread so startup is bounded by
-        the single slowest operation rather than their sum.
+        the single slowest operation rather than their sum.  With
+        ``enable_lazy_agents`` device-backed agents are only stubs at this
+        point; see :meth:`start_warm_up`.
         """
+        init_start = time.perf_counter()
+        if self.snapshot is not None:
+            await self._timed_phase("snapshot", asyncio.to_thread(self.snapshot.load))
         ai_client = self._create_ai_client()
         self._ai_client = ai_client
 
-        factory = AgentFactory(self.config, self.logger)
+        factory = AgentFactory(
+            self.config, self.logger, snapshot=self.snapshot, services=self.services
+        )
+        self._factory = factory
 
         # --- Run ALL heavy I/O concurrently ---
-        mongo_task = self._connect_mongo_loggers()
-        agents_task = factory.build_all_async(self.network, ai_client, self)
-        protocol_task = asyncio.to_thread(
-            self._build_protocol_runtime, load_protocol_directory
+        mongo_task = self._timed_phase("mongo", self._connect_mongo_loggers())
+        agents_task = self._timed_phase(
+            "agents", factory.build_all_async(self.network, ai_client, self)
+        )
+        protocol_task = self._timed_phase(
+            "protocols",
+            asyncio.to_thread(self._build_protocol_runtime, load_protocol_directory),
         )
 
         results = await asyncio.gather(
@@ -133,7 +172,8 @@ class JarvisSystem:
         fast_classifier = refs.get("fast_classifier")
         if fast_classifier:
             try:
-                await fast_classifier.initialize()
+                # Seeded once per shared classifier, not once per system
+                await self.services.aresolve("fast_classifier_ready", fast_classifier)
                 self.logger.log("INFO", "Fast-path classifier ready", "")
             except Exception as exc:
                 self.logger.log(
@@ -160,6 +200,13 @@ class JarvisSystem:
             if chat_agent and hasattr(chat_agent, "feedback_collector"):
                 chat_agent.feedback_collector = feedback_collector
 
+        # Weak-first model cascade for chat, lead and NLU formatting
+        if self.config.flags.enable_model_cascade:
+            self._setup_model_cascade(self._ai_client, feedback_collector)
+
+        # Fail-fast replies save up to one response timeout each
+        self.network.dependency_health.assumed_timeout = self.config.response_timeout
+
         # Initialize orchestrator and response logger
         self._response_logger = ResponseLogger(self.interaction_logger)
         self._orchestrator = RequestOrchestrator(
@@ -172,6 +219,7 @@ class JarvisSystem:
             ai_client=self._ai_client,
             enable_coordinator=self.config.flags.enable_coordinator,
             feedback_collector=feedback_collector,
+            model_cascade=self.model_cascade,
         )
 
         # Wire scheduler agent to orchestrator
@@ -184,28 +232,178 @@ class JarvisSystem:
             if self.protocol_runtime
             else 0
         )
+        self._startup_phases["initialize"] = round(
+            (time.perf_counter() - init_start) * 1000, 2
+        )
+        self.live_config = LiveConfigReloader(self)
+        # Persist whatever this boot had to rebuild
+        await asyncio.to_thread(self._save_snapshot)
         self.logger.log(
             "INFO",
             "Jarvis system initialized",
             f"Active agents: {list(self.network.agents.keys())}, "
             f"Loaded protocols: {loaded}",
         )
+        self.logger.log("INFO", "Startup breakdown", self.startup_report())
+
+    async def _timed_phase(self, name: str, awaitable: Any) -> Any:
+        start = time.perf_counter()
+        try:
+            return await awaitable
+        finally:
+            self._startup_phases[name] = round((time.perf_counter() - start) * 1000, 2)
+
+    def start_warm_up(self) -> asyncio.Task:
+        """Build lazy agents and deferred night workers in the background.
 
-    def _create_ai_client(self) -> BaseAIClient:
-        """Instantiate the configured AI client."""
-        return AIClientFactory.create(
-            self.config.ai_provider,
-            api_key=self.config.api_key,
-            strong_model=self.config.strong_model,
-            weak_model=self.config.weak_model,
+        Call once the server is accepting traffic; requests that need an
+        agent before the warm-up reaches it build that agent on demand.
+        """
+        if self._warm_up_task is None:
+            self._warm_up_task = asyncio.create_task(self.warm_up())
+        return self._warm_up_task
+
+    async def warm_up(self) -> None:
+        """Materialize every lazy agent and build the deferred night workers."""
+        start = time.perf_counter()
+        stubs = self.network.lazy_agents()
+        if stubs:
+            await asyncio.gather(
+                *(stub.materialize() for stub in stubs), return_exceptions=True
+            )
+        self._ensure_night_agents()
+        self._startup_phases["warm_up"] = round((time.perf_counter() - start) * 1000, 2)
+
+    def _ensure_night_agents(self) -> None:
+        """Build night workers deferred by a lazy startup, if not done yet."""
+        if self._factory is not None and hasattr(self, "_agent_refs"):
+            self._factory.build_deferred(self.network, self, self._agent_refs)
+            self.night_agents = self._agent_refs.get("night_agents", [])
+
+    def _save_snapshot(self) -> None:
+        if self.snapshot is None:
+            return
+        try:
+            self.snapshot.save()
+        except OSError as exc:
+            self.logger.log("WARNING", "Startup snapshot not saved", str(exc))
+
+    def startup_report(self) -> Dict[str, Any]:
+        """Per-phase and per-agent startup timings in milliseconds."""
+        factory = self._factory
+        lazy = {}
+        if factory is not None:
+            for name, stub in factory.lazy_agents.items():
+                lazy[name] = {
+                    "materialized": stub.is_materialized,
+                    "build_ms": round(stub.build_ms, 2) if stub.build_ms is not None else None,
+                }
+        return {
+            "phases": dict(self._startup_phases),
+            "agents": dict(factory.timings) if factory is not None else {},
+            "lazy_agents": lazy,
+            "first_request_ms": self._first_request_ms,
+            "snapshot": self.snapshot.report() if self.snapshot is not None else None,
+            "services": self.services.report(),
+        }
+
+    def _create_ai_client(self) -> SwappableAIClient:
+        """Instantiate the configured AI client behind a swappable handle."""
+        return SwappableAIClient(
+            AIClientFactory.create(
+                self.config.ai_provider,
+                api_key=self.config.api_key,
+                strong_model=self.config.strong_model,
+                weak_model=self.config.weak_model,
+            )
         )
 
-    async def _connect_mongo_loggers(self) -> None:
-        """Connect both MongoDB loggers concurrently."""
-        await asyncio.gather(
-            self.usage_logger.connect(),
-            self.interaction_logger.connect(),
+    async def reload_config(self, new_config: JarvisConfig | None = None) -> Dict[str, Any]:
+        """Apply config changes without rebuilding the system.
+
+        With no argument, applies edits already made to ``self.config``.
+        See :mod:`jarvis.core.live_config` for which keys take effect
+        immediately and which still need a restart.
+        """
+        if self.live_config is None:
+            raise RuntimeError("reload_config() called before initialize()")
+        return await self.live_config.reload(new_config)
+
+    def _setup_model_cascade(
+        self,
+        ai_client: BaseAIClient,
+        feedback_collector: FeedbackCollector | None = None,
+    ) -> ModelCascade:
+        """Create the model cascade and attach it to agents that support it.
+
+        Routing priors come from the outcome store's cascade history, with
+        capability-tagged corrections filling in keys that have none.
+        """
+        try:
+            outcome_store = self.services.resolve("outcome_store")
+        except Exception as exc:
+            self.logger.log("WARNING", "Cascade outcome store unavailable", str(exc))
+            outcome_store = None
+        cascade = ModelCascade(ai_client, outcome_store=outcome_store)
+        try:
+            history = cascade.load_history()
+        except Exception as exc:
+            self.logger.log("WARNING", "Failed to load cascade history", str(exc))
+            history = 0
+        corrections = 0
+        if feedback_collector:
+            corrections = cascade.learn_from_corrections(
+                feedback_collector.get_corrections(limit=500)
+            )
+        self.logger.log(
+            "DEBUG", "Model cascade seeded", f"history_keys={history}, corrections={corrections}"
         )
+        for agent in self.network.agents.values():
+            if hasattr(agent, "model_cascade"):
+                agent.model_cascade = cascade
+        self.model_cascade = cascade
+        return cascade
+
+    async def _connect_mongo_loggers(self) -> None:
+        """Connect both MongoDB loggers (once per shared container)."""
+        await self.services.aresolve("mongo_connected", *self._mongo)
+
+    @staticmethod
+    def _register_services(container: ServiceContainer) -> None:
+        """Install the system-level service defaults on *container*."""
+        verbose = getenv("JARVIS_VERBOSE", "false").lower() in ("true", "1", "yes")
+
+        async def connect_mongo(scope: ServiceContainer, uri: str, db: str) -> bool:
+            await asyncio.gather(
+                scope.resolve("usage_logger", uri, db).connect(),
+                scope.resolve("interaction_logger", uri, db).connect(),
+            )
+            return True
+
+        async def seed_classifier(scope: ServiceContainer, classifier: Any) -> Any:
+            await classifier.initialize()
+            return classifier
+
+        def owns_nothing(_: Any) -> None:
+            return None
+
+        for key, factory, close in (
+            ("logger", lambda scope: JarvisLogger(verbose=verbose), None),
+            (
+                "usage_logger",
+                lambda scope, uri, db: ProtocolUsageLogger(mongo_uri=uri, db_name=db),
+                None,
+            ),
+            (
+                "interaction_logger",
+                lambda scope, uri, db: InteractionLogger(mongo_uri=uri, db_name=db),
+                None,
+            ),
+            ("outcome_store", lambda scope: OutcomeStore(), None),
+            ("mongo_connected", connect_mongo, owns_nothing),
+            ("fast_classifier_ready", seed_classifier, owns_nothing),
+        ):
+            container.register(key, factory, close=close, replace=False)
 
     def list_agents(self) -> Dict[str, Any]:
         """List all registered agents in the network."""
@@ -257,7 +455,10 @@ class JarvisSystem:
             skip_prefixes.append("lights_")
 
         runtime = ProtocolRuntime(
-            self.network, self.logger, usage_logger=self.usage_logger
+            self.network,
+            self.logger,
+            usage_logger=self.usage_logger,
+            snapshot=self.snapshot,
         )
         runtime.initialize(
             load_protocol_directory, definition_dir, skip_prefixes=skip_prefixes
@@ -279,6 +480,7 @@ class JarvisSystem:
 
     async def enter_night_mode(self, progress_callback=None) -> None:
         """Enable night mode and launch background tasks."""
+        self._ensure_night_agents()
         self.night_mode = True
         self._night_progress_callback = progress_callback
         if self._orchestrator:
@@ -419,6 +621,21 @@ class JarvisSystem:
 
         This method now delegates to RequestOrchestrator for clean separation of concerns.
         """
+        payload = await self.respond(user_input, tz_name, metadata, allowed_agents)
+        return payload.value
+
+    async def respond(
+        self,
+        user_input: str,
+        tz_name: str,
+        metadata: Dict[str, Any] | None = None,
+        allowed_agents: set[str] | None = None,
+    ) -> Payload:
+        """Like :meth:`process_request`, but returns the response encoded once.
+
+        The HTTP layer sends the payload's bytes as-is; the orchestrator has
+        already written the same bytes to the trace.
+        """
         if not self._orchestrator:
             raise RuntimeError("System not initialized - call initialize() first")
 
@@ -432,7 +649,7 @@ class JarvisSystem:
 
         try:
             # Delegate to orchestrator
-            return await self._orchestrator.process_request(
+            return await self._orchestrator.respond(
                 user_input=user_input,
                 tz_name=tz_name,
                 metadata=metadata,
@@ -442,6 +659,10 @@ class JarvisSystem:
         finally:
             # Stop recording
             self.network.stop_method_recording()
+            if self._first_request_ms is None:
+                self._first_request_ms = round(
+                    (time.perf_counter() - self._created_at) * 1000, 2
+                )
 
     def get_available_commands(
         self, allowed_agents: set[str] | None = None
@@ -453,6 +674,13 @@ class JarvisSystem:
 
     async def shutdown(self):
         """Shutdown the system and cleanup resources."""
+        if self._warm_up_task is not None and not self._warm_up_task.done():
+            self._warm_up_task.cancel()
+            try:
+                await self._warm_up_task
+            except (asyncio.CancelledError, Exception):
+                pass
+
         # Stop scheduler agent
         if hasattr(self, "_agent_refs"):
             scheduler_agent = self._agent_refs.get("scheduler_agent")
@@ -461,23 +689,15 @@ class JarvisSystem:
 
         await self.network.stop()
 
-        # Close services through agent refs
-        if hasattr(self, "_agent_refs"):
-            calendar_svc = self._agent_refs.get("calendar_service")
-            if calendar_svc and hasattr(calendar_svc, "close"):
-                await calendar_svc.close()
-
-        # Close loggers
-        if self._response_logger:
-            await self._response_logger.close()
-        if self.usage_logger:
-            await self.usage_logger.close()
-        if self.interaction_logger:
-            await self.interaction_logger.close()
-
         # Close trace store
         if hasattr(self, "_trace_store"):
             self._trace_store.close()
 
+        self._save_snapshot()
+
         self.logger.log("INFO", "Jarvis system shutdown complete")
-        self.logger.close()
+        # Services, loggers included, are closed by the scope that owns
+        # them: shared process-wide ones stay open for other systems
+        await self.services.aclose()
+        if self._owns_services:
+            await self.services.parent.aclose()
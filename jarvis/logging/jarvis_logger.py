@@ -1,10 +1,9 @@
 import logging
-import sqlite3
 from datetime import datetime
 from typing import Any, Optional
-import json
-import threading
-from contextlib import contextmanager
+
+from ..storage import StorageEngine
+from ..utils.serialization import dumps_str
 
 # Default SQLite database for logs.  Defined here to avoid importing
 # ``jarvis.core`` at module import time, which previously caused a
@@ -31,7 +30,9 @@ class JarvisLogger:
 
     Console output is suppressed — all logs are stored in SQLite for
     later inspection via the log viewer.  Only catastrophic logger
-    failures are printed to stderr as a last resort.
+    failures are printed to stderr as a last resort.  Every logger for
+    the same file shares one :class:`~jarvis.storage.StorageEngine`, so
+    concurrent log calls are group-committed by a single writer.
     """
 
     def __init__(
@@ -67,8 +68,7 @@ class JarvisLogger:
         self.db_path = db_path
         self.log_level = log_level
         self.verbose = verbose
-        self._lock = threading.RLock()  # Reentrant lock for thread safety
-        self._local = threading.local()  # Thread-local storage for connections
+        self._db: Optional[StorageEngine] = StorageEngine.open(db_path)
 
         # Initialize the database schema
         self._ensure_table()
@@ -81,50 +81,25 @@ class JarvisLogger:
             # NullHandler prevents "No handlers could be found" warnings
             self.logger.addHandler(logging.NullHandler())
 
-    def _get_connection(self) -> sqlite3.Connection:
-        """Get a thread-local database connection."""
-        if not hasattr(self._local, "connection") or self._local.connection is None:
-            # Create a new connection for this thread
-            # Use check_same_thread=False to allow cross-thread usage
-            # But we'll still use locks to ensure thread safety
-            self._local.connection = sqlite3.connect(
-                self.db_path,
-                check_same_thread=False,
-                timeout=10.0,  # 10 second timeout for database locks
-            )
-            # Enable WAL mode for better concurrent access
-            self._local.connection.execute("PRAGMA journal_mode=WAL")
-            self._local.connection.execute("PRAGMA synchronous=NORMAL")
-
-        return self._local.connection
-
-    @contextmanager
-    def _db_context(self):
-        """Context manager for thread-safe database operations."""
-        with self._lock:
-            conn = self._get_connection()
-            try:
-                yield conn
-            except Exception:
-                conn.rollback()
-                raise
-            else:
-                conn.commit()
+    def _engine(self) -> StorageEngine:
+        """Return the shared engine, reattaching after :meth:`close`."""
+        if self._db is None:
+            self._db = StorageEngine.open(self.db_path)
+        return self._db
 
     def _ensure_table(self) -> None:
         """Ensure the logs table exists."""
-        with self._db_context() as conn:
-            conn.execute(
-                """
-                CREATE TABLE IF NOT EXISTS logs (
-                    id INTEGER PRIMARY KEY AUTOINCREMENT,
-                    timestamp TEXT,
-                    level TEXT,
-                    action TEXT,
-                    details TEXT
-                )
-                """
+        self._engine().write(
+            """
+            CREATE TABLE IF NOT EXISTS logs (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                timestamp TEXT,
+                level TEXT,
+                action TEXT,
+                details TEXT
             )
+            """
+        )
 
     def _should_skip_db_log(self, level: str, action: str) -> bool:
         """Check if this log should be skipped for database storage."""
@@ -149,25 +124,25 @@ class JarvisLogger:
         try:
             level_name = level.upper()
 
-            # Format details
-            if details is not None and not isinstance(details, str):
-                try:
-                    details_str = json.dumps(details)
-                except Exception:
-                    details_str = str(details)
-            else:
-                details_str = details or ""
-
             # Database: always record INFO and above
             skip_db = self._should_skip_db_log(level_name, action)
             if not skip_db:
+                # Format details (a Payload reuses its encoded bytes)
+                if details is not None and not isinstance(details, str):
+                    try:
+                        details_str = dumps_str(details)
+                    except Exception:
+                        details_str = str(details)
+                else:
+                    details_str = details or ""
                 timestamp = datetime.now().isoformat()
 
-                with self._db_context() as conn:
-                    conn.execute(
-                        "INSERT INTO logs (timestamp, level, action, details) VALUES (?, ?, ?, ?)",
-                        (timestamp, level_name, action, details_str),
-                    )
+                # Fire-and-forget: the caller (often the event loop) never
+                # waits for the writer thread to commit
+                self._engine().write_nowait(
+                    "INSERT INTO logs (timestamp, level, action, details) VALUES (?, ?, ?, ?)",
+                    (timestamp, level_name, action, details_str),
+                ).add_done_callback(self._report_failed_write)
 
         except Exception as e:
             # Fallback: if database logging fails, at least log to console
@@ -179,28 +154,28 @@ class JarvisLogger:
 
                 print(f"LOGGER FAILURE: {e} - {action}", file=sys.stderr)
 
+    def _report_failed_write(self, future) -> None:
+        exc = future.exception()
+        if exc is not None:
+            try:
+                self.logger.error(f"Logger error: {exc}")
+            except Exception:
+                pass
+
+    def flush(self) -> None:
+        """Block until every log line queued so far is committed."""
+        if self._db is not None:
+            self._db.flush()
+
     def close(self) -> None:
-        """Close database connections for the current thread."""
-        with self._lock:
-            if hasattr(self._local, "connection") and self._local.connection:
-                try:
-                    self._local.connection.close()
-                except Exception:
-                    pass  # Best effort cleanup
-                finally:
-                    self._local.connection = None
+        """Release this logger's reference to the shared storage engine."""
+        db, self._db = getattr(self, "_db", None), None
+        if db is not None:
+            db.release()
 
     def close_all_connections(self) -> None:
-        """Close all database connections (call this on shutdown)."""
-        with self._lock:
-            # This is a best-effort cleanup
-            # Individual threads should call close() themselves
-            if hasattr(self._local, "connection") and self._local.connection:
-                try:
-                    self._local.connection.close()
-                    self._local.connection = None
-                except Exception:
-                    pass
+        """Alias of :meth:`close`, kept for API compatibility."""
+        self.close()
 
     def __enter__(self) -> "JarvisLogger":
         return self
@@ -7,12 +7,16 @@ Usage::
     python -m jarvis.logging.trace_cli list [--since 1h] [--status ERROR] [--limit 20]
     python -m jarvis.logging.trace_cli spans [--agent X] [--capability Y]
     python -m jarvis.logging.trace_cli last [--tree]
+    python -m jarvis.logging.trace_cli replay [--since 1d] [--save corpus.jsonl] [--max-regression-pct 20]
 
 All output is JSON (or ASCII tree) to stdout — pipe-friendly for
-coding agents and downstream tooling.
+coding agents and downstream tooling.  ``replay`` exits with status 1
+when a stage regressed beyond the threshold or a routing decision
+changed, so it can gate a change on real traffic.
 """
 
 import argparse
+import asyncio
 import json
 import sys
 
@@ -56,6 +60,22 @@ def main() -> None:
     p_last = sub.add_parser("last", help="Show most recent trace")
     p_last.add_argument("--tree", action="store_true", help="ASCII tree output")
 
+    # -- replay ------------------------------------------------------------
+    p_replay = sub.add_parser(
+        "replay", help="Replay recorded requests against the current code"
+    )
+    p_replay.add_argument("--since", help="Time window start (e.g. 1d)")
+    p_replay.add_argument("--until", help="Time window end")
+    p_replay.add_argument("--limit", type=int, default=100)
+    p_replay.add_argument("--corpus", help="Replay a saved corpus instead of the trace DB")
+    p_replay.add_argument("--save", help="Write the corpus to this JSONL file")
+    p_replay.add_argument(
+        "--no-llm-latency",
+        action="store_true",
+        help="Answer recorded LLM calls at once instead of after their recorded duration",
+    )
+    p_replay.add_argument("--max-regression-pct", type=float, default=20.0)
+
     args = parser.parse_args()
 
     if not args.command:
@@ -110,6 +130,26 @@ def main() -> None:
                 result = query.get_trace(trace_id)
                 print(json.dumps(result, indent=2))
 
+        elif args.command == "replay":
+            from .trace_replay import build_corpus, load_corpus, replay_corpus, save_corpus
+
+            if args.corpus:
+                cases = load_corpus(args.corpus)
+            else:
+                cases = build_corpus(store, args.since, args.until, args.limit)
+            if args.save:
+                save_corpus(args.save, cases)
+            report = asyncio.run(
+                replay_corpus(cases, llm_latency=not args.no_llm_latency)
+            )
+            result = report.to_dict()
+            result["regressions"] = [
+                d.name for d in report.regressions(args.max_regression_pct)
+            ]
+            print(json.dumps(result, indent=2))
+            if result["regressions"] or result["routing_changes"]:
+                sys.exit(1)
+
     finally:
         store.close()
 
@@ -0,0 +1,391 @@
+"""Replay production traces against the current code.
+
+A window of traces becomes a corpus of :class:`ReplayCase` items: the
+user input, the routing decision recorded on ``nlu.classify``, the LLM
+responses the NLU agent received (its ``llm.chat`` spans), and the
+recorded duration of every stage by span name.  When LLM content was not
+traced (``JARVIS_TRACE_LLM_CONTENT`` off), the classification call is
+answered with the recorded classification instead.
+
+:func:`replay_corpus` runs each case through a fresh
+:class:`~jarvis.agents.agent_network.AgentNetwork` with the current
+:class:`~jarvis.agents.nlu_agent.NLUAgent`:
+
+* LLM calls are served in order by a :class:`RecordedAIClient`, which
+  waits as long as the recorded call took (``llm_latency=False`` answers
+  at once);
+* every recorded capability, and ``chat`` (the NLU fallback), is answered
+  by a stub agent after the time the request spent downstream of the
+  NLU agent in production, split evenly between the capabilities.
+
+The replay is traced into a scratch store, so the same stage names
+(``nlu.classify``, ``nlu.dag``, ``orchestrator.nlu_route``, ...) can be
+compared.  :class:`ReplayReport` holds per-stage latency deltas and every
+case whose routing changed.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import json
+import tempfile
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from types import SimpleNamespace
+from typing import Any, Dict, List, Optional, Tuple
+
+from ..ai_clients.base import BaseAIClient
+from . import tracer as tracer_module
+from .jarvis_logger import JarvisLogger
+from .trace_query import TraceQuery
+from .trace_store import TraceStore
+from .tracer import SpanKind, Tracer
+
+# Recorded spans of the request path that a replay reproduces
+_NLU_ROUTE = "orchestrator.nlu_route"
+_CLASSIFY = "nlu.classify"
+_LLM = "llm.chat"
+
+
+def _load(data: Optional[str]) -> Any:
+    if not data:
+        return None
+    try:
+        return json.loads(data)
+    except (TypeError, ValueError):
+        return None
+
+
+def routing_of(classification: Any) -> List[str]:
+    """Capabilities a classification routes to (``["run_protocol"]`` for protocols)."""
+    if not isinstance(classification, dict):
+        return []
+    if classification.get("intent") == "run_protocol":
+        return ["run_protocol"]
+    dag = classification.get("dag")
+    return sorted(dag) if isinstance(dag, dict) else []
+
+
+@dataclass
+class ReplayCase:
+    """One production request, as needed to replay it."""
+
+    trace_id: str
+    user_input: str
+    classification: Optional[Dict[str, Any]] = None
+    # NLU LLM calls in order: {"content": str | None, "duration_ms": float}
+    llm_calls: List[Dict[str, Any]] = field(default_factory=list)
+    downstream_ms: float = 0.0
+    stage_ms: Dict[str, float] = field(default_factory=dict)
+
+    @property
+    def routing(self) -> List[str]:
+        return routing_of(self.classification)
+
+    def to_dict(self) -> Dict[str, Any]:
+        return asdict(self)
+
+    @classmethod
+    def from_dict(cls, data: Dict[str, Any]) -> "ReplayCase":
+        return cls(**data)
+
+
+def case_from_trace(trace: Dict[str, Any], spans: List[Dict[str, Any]]) -> Optional[ReplayCase]:
+    """Build a :class:`ReplayCase` from a trace row and its spans.
+
+    Returns ``None`` for traces that never reached the NLU agent (no
+    user input, or answered by a protocol before classification).
+    """
+    user_input = trace.get("user_input")
+    by_id = {s["span_id"]: s for s in spans}
+    classify = next((s for s in spans if s["name"] == _CLASSIFY), None)
+    if not user_input or classify is None:
+        return None
+
+    def under_nlu(span: Dict[str, Any]) -> bool:
+        parent = by_id.get(span.get("parent_span_id"))
+        while parent is not None:
+            if parent["name"].startswith("nlu."):
+                return True
+            parent = by_id.get(parent.get("parent_span_id"))
+        return False
+
+    classification = _load(classify.get("output_data"))
+    llm_calls = []
+    for span in spans:
+        if span["name"] != _LLM or not under_nlu(span):
+            continue
+        output = _load(span.get("output_data"))
+        content = output.get("content") if isinstance(output, dict) else None
+        if content is None and span.get("parent_span_id") == classify["span_id"] and classification:
+            content = json.dumps(classification)
+        llm_calls.append({"content": content, "duration_ms": span.get("duration_ms") or 0.0})
+
+    stage_ms: Dict[str, float] = {}
+    for span in spans:
+        stage_ms[span["name"]] = stage_ms.get(span["name"], 0.0) + (span.get("duration_ms") or 0.0)
+
+    nlu_own = sum(v for k, v in stage_ms.items() if k.startswith("nlu.") and k != "nlu.dag")
+    route_ms = stage_ms.get(_NLU_ROUTE, 0.0)
+    return ReplayCase(
+        trace_id=trace["trace_id"],
+        user_input=user_input,
+        classification=classification if isinstance(classification, dict) else None,
+        llm_calls=llm_calls,
+        downstream_ms=max(0.0, route_ms - nlu_own),
+        stage_ms=stage_ms,
+    )
+
+
+def build_corpus(
+    store: TraceStore,
+    since: Optional[str] = None,
+    until: Optional[str] = None,
+    limit: int = 100,
+) -> List[ReplayCase]:
+    """Replay cases for the traces in ``[since, until]``, newest first.
+
+    *since* and *until* accept ISO timestamps or relative times (``2d``).
+    """
+    cases = []
+    for trace in TraceQuery(store).list_traces(since=since, until=until, limit=limit):
+        case = case_from_trace(trace, store.get_spans(trace["trace_id"]))
+        if case is not None:
+            cases.append(case)
+    return cases
+
+
+def save_corpus(path: str | Path, cases: List[ReplayCase]) -> None:
+    with open(path, "w", encoding="utf-8") as fh:
+        for case in cases:
+            fh.write(json.dumps(case.to_dict()) + "\n")
+
+
+def load_corpus(path: str | Path) -> List[ReplayCase]:
+    with open(path, encoding="utf-8") as fh:
+        return [ReplayCase.from_dict(json.loads(line)) for line in fh if line.strip()]
+
+
+class RecordedAIClient(BaseAIClient):
+    """Answers chat calls with recorded responses, in order.
+
+    Calls beyond the recording get an empty reply, which the NLU agent
+    treats like an unparseable model answer.
+    """
+
+    def __init__(self, calls: List[Dict[str, Any]], replay_latency: bool = True) -> None:
+        self._calls = list(calls)
+        self._replay_latency = replay_latency
+        self.served = 0
+
+    async def _next(self) -> Tuple[Any, Any]:
+        call = self._calls[self.served] if self.served < len(self._calls) else {}
+        self.served += 1
+        if self._replay_latency and call.get("duration_ms"):
+            await asyncio.sleep(call["duration_ms"] / 1000)
+        return SimpleNamespace(content=call.get("content") or "", tool_calls=None), None
+
+    async def strong_chat(self, messages, tools=None):
+        return await self._next()
+
+    async def weak_chat(self, messages, tools=None):
+        return await self._next()
+
+
+def _stub_agent(capability: str, delay_ms: float, logger):
+    from ..agents.base import NetworkAgent
+
+    class StubCapabilityAgent(NetworkAgent):
+        """Answers one capability after a recorded delay."""
+
+        @property
+        def capabilities(self):
+            return {capability}
+
+        async def _handle_capability_request(self, message) -> None:
+            await asyncio.sleep(delay_ms / 1000)
+            await self.send_capability_response(
+                message.from_agent,
+                {"success": True, "response": f"[replayed {capability}]"},
+                message.request_id,
+                message.id,
+            )
+
+        async def _handle_capability_response(self, message) -> None:
+            pass
+
+    return StubCapabilityAgent(f"Replay:{capability}", logger)
+
+
+@dataclass
+class ReplayResult:
+    trace_id: str
+    user_input: str
+    routing_before: List[str]
+    routing_after: List[str]
+    stage_ms_before: Dict[str, float]
+    stage_ms_after: Dict[str, float]
+    error: Optional[str] = None
+
+    @property
+    def routing_changed(self) -> bool:
+        return self.routing_before != self.routing_after
+
+
+@dataclass
+class StageDelta:
+    name: str
+    samples: int
+    before_ms: float  # mean over cases with the stage in both runs
+    after_ms: float
+
+    @property
+    def delta_ms(self) -> float:
+        return self.after_ms - self.before_ms
+
+    @property
+    def delta_pct(self) -> float:
+        return self.delta_ms / self.before_ms * 100 if self.before_ms else 0.0
+
+
+@dataclass
+class ReplayReport:
+    results: List[ReplayResult]
+
+    def stage_deltas(self) -> List[StageDelta]:
+        totals: Dict[str, List[float]] = {}
+        for r in self.results:
+            if r.error:
+                continue
+            for name, after in r.stage_ms_after.items():
+                if name in r.stage_ms_before:
+                    t = totals.setdefault(name, [0, 0.0, 0.0])
+                    t[0] += 1
+                    t[1] += r.stage_ms_before[name]
+                    t[2] += after
+        return [
+            StageDelta(name, n, before / n, after / n)
+            for name, (n, before, after) in sorted(totals.items())
+        ]
+
+    def routing_changes(self) -> List[ReplayResult]:
+        return [r for r in self.results if not r.error and r.routing_changed]
+
+    def regressions(self, max_pct: float, min_delta_ms: float = 1.0) -> List[StageDelta]:
+        """Stages whose mean latency grew by more than *max_pct* percent."""
+        return [
+            d for d in self.stage_deltas()
+            if d.delta_pct > max_pct and d.delta_ms > min_delta_ms
+        ]
+
+    def to_dict(self) -> Dict[str, Any]:
+        return {
+            "cases": len(self.results),
+            "errors": [
+                {"trace_id": r.trace_id, "error": r.error} for r in self.results if r.error
+            ],
+            "stages": [
+                {
+                    "name": d.name,
+                    "samples": d.samples,
+                    "before_ms": round(d.before_ms, 2),
+                    "after_ms": round(d.after_ms, 2),
+                    "delta_ms": round(d.delta_ms, 2),
+                    "delta_pct": round(d.delta_pct, 1),
+                }
+                for d in self.stage_deltas()
+            ],
+            "routing_changes": [
+                {
+                    "trace_id": r.trace_id,
+                    "user_input": r.user_input,
+                    "before": r.routing_before,
+                    "after": r.routing_after,
+                }
+                for r in self.routing_changes()
+            ],
+        }
+
+
+async def replay_case(
+    case: ReplayCase,
+    tracer: Tracer,
+    store: TraceStore,
+    logger: JarvisLogger,
+    llm_latency: bool = True,
+    timeout: float = 30.0,
+) -> ReplayResult:
+    """Run *case* through the current NLU path and collect its spans."""
+    from ..agents.agent_network import AgentNetwork
+    from ..agents.nlu_agent import NLUAgent
+
+    network = AgentNetwork(logger=logger)
+    network.register_agent(
+        NLUAgent(
+            RecordedAIClient(case.llm_calls, replay_latency=llm_latency),
+            logger=logger,
+            response_timeout=timeout,
+        )
+    )
+    routing = case.routing
+    per_stub_ms = case.downstream_ms / len(routing) if routing else 0.0
+    # "chat" is where the NLU agent falls back to, so a changed route still answers
+    for capability in set(routing) | {"chat"}:
+        if capability != "run_protocol":
+            network.register_agent(_stub_agent(capability, per_stub_ms, logger))
+
+    await network.start()
+    error = None
+    trace_id = tracer.start_trace(user_input=case.user_input, source="replay")
+    try:
+        request_id = f"replay-{case.trace_id}"
+        async with tracer.span(_NLU_ROUTE, kind=SpanKind.ORCHESTRATOR):
+            await network.request_capability(
+                "ReplayHarness", "intent_matching", {"input": case.user_input}, request_id
+            )
+            await network.wait_for_response(request_id, timeout=timeout)
+    except Exception as exc:
+        error = f"{type(exc).__name__}: {exc}"
+    finally:
+        tracer.end_trace(error=error)
+        await network.stop()
+
+    spans = store.get_spans(trace_id)
+    classify = next((s for s in spans if s["name"] == _CLASSIFY), None)
+    stage_ms: Dict[str, float] = {}
+    for span in spans:
+        stage_ms[span["name"]] = stage_ms.get(span["name"], 0.0) + (span.get("duration_ms") or 0.0)
+    return ReplayResult(
+        trace_id=case.trace_id,
+        user_input=case.user_input,
+        routing_before=case.routing,
+        routing_after=routing_of(_load(classify.get("output_data")) if classify else None),
+        stage_ms_before=case.stage_ms,
+        stage_ms_after=stage_ms,
+        error=error,
+    )
+
+
+async def replay_corpus(
+    cases: List[ReplayCase], llm_latency: bool = True, timeout: float = 30.0
+) -> ReplayReport:
+    """Replay every case and compare it with its recording.
+
+    The global tracer is swapped for one writing to a scratch database
+    for the duration of the replay; logs go to a scratch database too.
+    """
+    previous = tracer_module.get_tracer()
+    with tempfile.TemporaryDirectory() as tmp:
+        store = TraceStore(db_path=str(Path(tmp) / "replay_traces.db"))
+        logger = JarvisLogger(db_path=str(Path(tmp) / "replay_logs.db"))
+        tracer = tracer_module.init_tracer(store, enabled=True, trace_llm_content=False)
+        try:
+            results = [
+                await replay_case(case, tracer, store, logger, llm_latency, timeout)
+                for case in cases
+            ]
+        finally:
+            tracer_module._tracer_instance = previous
+            logger.close()
+            store.close()
+    return ReplayReport(results)
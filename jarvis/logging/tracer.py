@@ -15,15 +15,15 @@ Feature flags
 
 import contextvars
 import functools
-import json
 import os
 import time
 import uuid
 from dataclasses import dataclass
 from datetime import UTC, datetime
 from enum import Enum
-from typing import Any, Optional, Union
+from typing import Any, Dict, Optional, Union
 
+from ..utils.serialization import dumps
 from .trace_store import TraceStore
 
 # ---------------------------------------------------------------------------
@@ -100,12 +100,21 @@ _span_stack: contextvars.ContextVar[Optional[list]] = contextvars.ContextVar(
 
 
 def _truncate_data(data: Any, max_size: int = MAX_DATA_SIZE) -> Optional[str]:
+    """Encode *data* for a span column, capped at *max_size* characters.
+
+    A :class:`~jarvis.utils.serialization.Payload` already encoded for
+    another sink is not encoded again.
+    """
     if data is None:
         return None
     try:
-        s = json.dumps(data, default=str)
-    except (TypeError, ValueError):
-        s = str(data)
+        encoded = dumps(data)
+    except Exception:
+        encoded = str(data).encode("utf-8", errors="replace")
+    if len(encoded) <= max_size:
+        # Characters never outnumber bytes
+        return encoded.decode("utf-8", errors="replace")
+    s = encoded[: max_size * 4].decode("utf-8", errors="ignore")
     if len(s) > max_size:
         return s[: max_size - 20] + "... [truncated]"
     return s
@@ -308,6 +317,43 @@ class Tracer:
             attributes=attributes,
         )
 
+    def record_span(
+        self,
+        name: str,
+        trace_id: Optional[str],
+        parent_span_id: Optional[str],
+        start_time: datetime,
+        duration_ms: float,
+        kind: SpanKind = SpanKind.INTERNAL,
+        agent_name: str = None,
+        output_data: Any = None,
+        attributes: dict = None,
+        status: str = "OK",
+    ) -> None:
+        """Save an already finished span.
+
+        For work that spans several message handlers and so cannot be
+        wrapped in a single ``async with tracer.span(...)`` block.
+        """
+        if not self._enabled or not trace_id:
+            return
+        self._save_span(
+            Span(
+                span_id=str(uuid.uuid4()),
+                trace_id=trace_id,
+                parent_span_id=parent_span_id,
+                name=name,
+                kind=kind.value if isinstance(kind, SpanKind) else kind,
+                agent_name=agent_name,
+                start_time=start_time.isoformat(),
+                end_time=datetime.now(UTC).isoformat(),
+                duration_ms=round(duration_ms, 2),
+                status=status,
+                output_data=_truncate_data(output_data) if output_data is not None else None,
+                attributes=_truncate_data(attributes) if attributes is not None else None,
+            )
+        )
+
     # -- Context inspection ------------------------------------------------
 
     def current_trace_id(self) -> Optional[str]:
@@ -363,6 +409,22 @@ def get_tracer() -> Optional[Tracer]:
 # ---------------------------------------------------------------------------
 
 
+def _llm_output(result: Any) -> Dict[str, Any]:
+    """Reply content of a ``(message, tool_calls)`` chat result, for replay."""
+    message = result[0] if isinstance(result, tuple) and result else result
+    tool_calls = []
+    for call in getattr(message, "tool_calls", None) or []:
+        function = getattr(call, "function", None)
+        tool_calls.append(
+            {
+                "id": getattr(call, "id", None),
+                "name": getattr(function, "name", None),
+                "arguments": getattr(function, "arguments", None),
+            }
+        )
+    return {"content": getattr(message, "content", None), "tool_calls": tool_calls}
+
+
 def traced(
     name: str,
     kind: SpanKind = SpanKind.INTERNAL,
@@ -408,7 +470,9 @@ def traced(
                 result = await func(*args, **kwargs)
                 if isinstance(s, ActiveSpan):
                     try:
-                        if result is not None:
+                        if kind == SpanKind.LLM and tracer.trace_llm_content:
+                            s.record_output(_llm_output(result))
+                        elif result is not None:
                             s.record_output({"type": type(result).__name__})
                     except Exception:
                         pass
@@ -0,0 +1,160 @@
+"""Compile recorded protocols into optimized execution plans.
+
+A recording captures every capability call of a session in order, so it
+repeats lookups and runs independent calls one after another.  The
+compiler rewrites it into an equivalent :class:`Protocol`:
+
+* a read-only step identical to an earlier one, with no write to the same
+  agent in between, is dropped and references to its result point at the
+  earlier step;
+* mappings to arguments known at compile time are bound into the step
+  parameters;
+* steps are grouped into ``stages``: a step runs in the first stage after
+  every step it reads a result from and every earlier step that writes to
+  the same agent.  :class:`~jarvis.protocols.executor.ProtocolExecutor`
+  runs the steps of a stage concurrently.
+
+Whether a step is read-only is decided from its function name
+(``get_*``, ``list_*``, ...); anything else is treated as a write.
+"""
+
+from __future__ import annotations
+
+import json
+import re
+from dataclasses import dataclass, field, replace
+from typing import Any, Callable, Dict, List, Optional
+
+from .models import Protocol, ProtocolStep
+
+# Function-name prefixes of capabilities without side effects
+READ_ONLY_PREFIXES = (
+    "get_",
+    "list_",
+    "search",
+    "find_",
+    "check_",
+    "read_",
+    "fetch_",
+    "lookup_",
+    "query_",
+)
+
+_STEP_REF = re.compile(r"^step_(\d+)_")
+
+
+def is_read_only(step: ProtocolStep) -> bool:
+    """Whether *step* can be repeated or reordered without side effects."""
+    return step.function.startswith(READ_ONLY_PREFIXES)
+
+
+@dataclass
+class CompileReport:
+    """What :func:`compile_protocol` changed."""
+
+    original_steps: int
+    removed_steps: List[int] = field(default_factory=list)  # original indices
+    bound_parameters: int = 0
+    stages: List[List[int]] = field(default_factory=list)
+
+    @property
+    def max_parallelism(self) -> int:
+        return max((len(stage) for stage in self.stages), default=0)
+
+
+def _step_key(step: ProtocolStep) -> str:
+    return json.dumps(
+        [step.agent, step.function, step.parameters, step.parameter_mappings],
+        sort_keys=True,
+        default=str,
+    )
+
+
+def _step_ref(mapping: str) -> Optional[int]:
+    """Index of the step whose result *mapping* (``$step_3_fn``) reads."""
+    if not mapping.startswith("$"):
+        return None
+    match = _STEP_REF.match(mapping[1:])
+    return int(match.group(1)) if match else None
+
+
+def compile_protocol(
+    protocol: Protocol,
+    arguments: Dict[str, Any] | None = None,
+    *,
+    read_only: Callable[[ProtocolStep], bool] = is_read_only,
+) -> tuple[Protocol, CompileReport]:
+    """Return an optimized copy of *protocol* and a report of the changes."""
+    arguments = arguments or {}
+    report = CompileReport(original_steps=len(protocol.steps))
+
+    # 1. Drop repeated read-only steps, remembering where each one went
+    kept: List[ProtocolStep] = []
+    new_index: Dict[int, int] = {}  # original index -> compiled index
+    seen_reads: Dict[str, int] = {}  # step key -> compiled index
+    for i, step in enumerate(protocol.steps):
+        if read_only(step):
+            key = _step_key(step)
+            if key in seen_reads:
+                new_index[i] = seen_reads[key]
+                report.removed_steps.append(i)
+                continue
+            seen_reads[key] = len(kept)
+        else:
+            # A write may change what later reads of this agent return
+            seen_reads = {
+                k: idx for k, idx in seen_reads.items() if kept[idx].agent != step.agent
+            }
+        new_index[i] = len(kept)
+        kept.append(step)
+
+    # 2. Renumber step references and bind known arguments
+    steps: List[ProtocolStep] = []
+    deps: List[set[int]] = []
+    for idx, step in enumerate(kept):
+        params = dict(step.parameters)
+        mappings: Dict[str, str] = {}
+        step_deps: set[int] = set()
+        for name, mapping in step.parameter_mappings.items():
+            ref = _step_ref(mapping)
+            if ref is not None and ref in new_index:
+                target = new_index[ref]
+                step_deps.add(target)
+                mappings[name] = f"$step_{target}_{kept[target].function}"
+            elif mapping.startswith("$") and mapping[1:] in arguments:
+                params[name] = arguments[mapping[1:]]
+                report.bound_parameters += 1
+            else:
+                mappings[name] = mapping
+        steps.append(replace(step, parameters=params, parameter_mappings=mappings))
+        deps.append(step_deps)
+
+    # 3. Stage assignment: after data dependencies and earlier writes to the agent
+    stage_of: List[int] = []
+    last_write: Dict[str, int] = {}  # agent -> compiled index of its latest write
+    last_access: Dict[str, List[int]] = {}  # agent -> steps since that write
+    for idx, step in enumerate(steps):
+        after = set(deps[idx])
+        if step.agent in last_write:
+            after.add(last_write[step.agent])
+        if not read_only(step):
+            # Writes also wait for reads of the agent issued before them
+            after.update(last_access.get(step.agent, ()))
+            last_write[step.agent] = idx
+            last_access[step.agent] = []
+        else:
+            last_access.setdefault(step.agent, []).append(idx)
+        stage_of.append(1 + max((stage_of[d] for d in after), default=-1))
+
+    stages: List[List[int]] = [[] for _ in range(max(stage_of, default=-1) + 1)]
+    for idx, stage in enumerate(stage_of):
+        stages[stage].append(idx)
+    report.stages = stages
+
+    compiled = replace(
+        protocol,
+        steps=steps,
+        arguments=dict(protocol.arguments),
+        stages=stages if len(stages) < len(steps) else [],
+    )
+    return compiled, report
@@ -1,15 +1,19 @@
 # protocols/executor.py
 from __future__ import annotations
 
-from typing import Any, Dict, Optional
+import asyncio
+from typing import TYPE_CHECKING, Any, Dict, Optional
 import time
 
 from ..logging import JarvisLogger
-from ..agents.agent_network import AgentNetwork
 from ..core.constants import ExecutionResult
 from . import Protocol
+from .models import ProtocolStep
 from .loggers import ProtocolUsageLogger, generate_protocol_log
 
+if TYPE_CHECKING:
+    from ..agents.agent_network import AgentNetwork
+
 
 class ProtocolExecutor:
     """Executes Protocol steps directly without AI reasoning."""
@@ -89,107 +93,22 @@ class ProtocolExecutor:
                 str(context),
             )
 
-        for i, step in enumerate(protocol.steps):
-            step_id = f"step_{i}_{step.function}"
-
-            if allowed_agents is not None and step.agent not in allowed_agents:
-                self.logger.log(
-                    "WARNING",
-                    f"Agent '{step.agent}' not allowed for step {step_id}",
-                )
-                results[step_id] = {"error": "agent_disallowed"}
-                continue
-
-            # Get the agent
-            agent = self.network.agents.get(step.agent)
-            if not agent:
-                self.logger.log(
-                    "ERROR",
-                    f"Agent '{step.agent}' not found",
-                )
-                results[step_id] = {"error": "agent_not_found"}
-                continue
-
-            # Prepare parameters
-            params = dict(step.parameters)
-
-            # Apply parameter mappings (enhanced to handle extracted arguments)
-            for param_name, mapping in step.parameter_mappings.items():
-                if mapping.startswith("$"):
-                    # Reference to previous result or extracted argument
-                    ref = mapping[1:]  # Remove $
-
-                    # First check extracted arguments (from voice command)
-                    if ref in context:
-                        params[param_name] = context[ref]
-                        self.logger.log(
-                            "DEBUG",
-                            f"Mapped parameter '{param_name}' from extracted argument",
-                            f"{ref} -> {context[ref]}",
-                        )
-                    # Then check previous step results
-                    elif ref in results:
-                        params[param_name] = results[ref]
-                        self.logger.log(
-                            "DEBUG",
-                            f"Mapped parameter '{param_name}' from previous result",
-                            f"{ref} -> {results[ref]}",
-                        )
-                    else:
-                        self.logger.log(
-                            "WARNING",
-                            f"Parameter mapping reference '{ref}' not found",
-                            f"Available context: {list(context.keys())}, results: {list(results.keys())}",
-                        )
-
-            # Execute the capability
-            try:
-                self.logger.log(
-                    "INFO", f"Executing {step.agent}.{step.function}", str(params)
-                )
-
-                result = await agent.run_capability(step.function, **params)
-
-                # Detect string-based failures (common pattern in agent methods)
-                if isinstance(result, str) and result.lower().startswith("failed to"):
-                    self.logger.log(
-                        "WARNING",
-                        f"Step {step_id} returned failure string",
-                        result,
+        if protocol.stages:
+            # Compiled protocol: steps of a stage only read earlier stages' results
+            for stage in protocol.stages:
+                outcomes = await asyncio.gather(
+                    *(
+                        self._run_step(i, protocol.steps[i], context, results, allowed_agents)
+                        for i in stage
                     )
-                    results[step_id] = {"error": result}
-                # Detect tuple-based errors (some methods return (None, error_message))
-                elif isinstance(result, tuple) and len(result) == 2:
-                    first, second = result
-                    # Check if first element is falsy (None, False, empty string, etc.)
-                    # and second is an error message string
-                    if not first and isinstance(second, str):
-                        error_msg = second if second else "Unknown error"
-                        self.logger.log(
-                            "WARNING",
-                            f"Step {step_id} returned error tuple",
-                            error_msg,
-                        )
-                        results[step_id] = {"error": error_msg}
-                    else:
-                        results[step_id] = result
-                else:
-                    results[step_id] = result
-                self.logger.log("INFO", f"Step {step_id} completed", str(result))
-
-            except NotImplementedError:
-                self.logger.log(
-                    "ERROR",
-                    f"Function '{step.function}' not found in {step.agent}",
                 )
-                results[step_id] = {"error": "function_not_found"}
-            except Exception as exc:
-                self.logger.log(
-                    "ERROR",
-                    f"Error executing {step.agent}.{step.function}",
-                    str(exc),
+                for i, outcome in zip(stage, outcomes):
+                    results[f"step_{i}_{protocol.steps[i].function}"] = outcome
+        else:
+            for i, step in enumerate(protocol.steps):
+                results[f"step_{i}_{step.function}"] = await self._run_step(
+                    i, step, context, results, allowed_agents
                 )
-                results[step_id] = {"error": str(exc)}
 
         # Determine overall execution result
         errors = [r for r in results.values() if isinstance(r, dict) and "error" in r]
@@ -219,3 +138,108 @@ class ProtocolExecutor:
             await self.usage_logger.log_usage(log_doc)
 
         return results
+
+    async def _run_step(
+        self,
+        i: int,
+        step: ProtocolStep,
+        context: Dict[str, Any],
+        results: Dict[str, Any],
+        allowed_agents: set[str] | None,
+    ) -> Any:
+        """Execute one step and return its result (``{"error": ...}`` on failure)."""
+        step_id = f"step_{i}_{step.function}"
+
+        if allowed_agents is not None and step.agent not in allowed_agents:
+            self.logger.log(
+                "WARNING",
+                f"Agent '{step.agent}' not allowed for step {step_id}",
+            )
+            return {"error": "agent_disallowed"}
+
+        # Get the agent
+        agent = self.network.agents.get(step.agent)
+        if not agent:
+            self.logger.log(
+                "ERROR",
+                f"Agent '{step.agent}' not found",
+            )
+            return {"error": "agent_not_found"}
+
+        # Prepare parameters
+        params = dict(step.parameters)
+
+        # Apply parameter mappings (enhanced to handle extracted arguments)
+        for param_name, mapping in step.parameter_mappings.items():
+            if mapping.startswith("$"):
+                # Reference to previous result or extracted argument
+                ref = mapping[1:]  # Remove $
+
+                # First check extracted arguments (from voice command)
+                if ref in context:
+                    params[param_name] = context[ref]
+                    self.logger.log(
+                        "DEBUG",
+                        f"Mapped parameter '{param_name}' from extracted argument",
+                        f"{ref} -> {context[ref]}",
+                    )
+                # Then check previous step results
+                elif ref in results:
+                    params[param_name] = results[ref]
+                    self.logger.log(
+                        "DEBUG",
+                        f"Mapped parameter '{param_name}' from previous result",
+                        f"{ref} -> {results[ref]}",
+                    )
+                else:
+                    self.logger.log(
+                        "WARNING",
+                        f"Parameter mapping reference '{ref}' not found",
+                        f"Available context: {list(context.keys())}, results: {list(results.keys())}",
+                    )
+
+        # Execute the capability
+        try:
+            self.logger.log(
+                "INFO", f"Executing {step.agent}.{step.function}", str(params)
+            )
+
+            result = await agent.run_capability(step.function, **params)
+
+            # Detect string-based failures (common pattern in agent methods)
+            if isinstance(result, str) and result.lower().startswith("failed to"):
+                self.logger.log(
+                    "WARNING",
+                    f"Step {step_id} returned failure string",
+                    result,
+                )
+                result = {"error": result}
+            # Detect tuple-based errors (some methods return (None, error_message))
+            elif isinstance(result, tuple) and len(result) == 2:
+                first, second = result
+                # Check if first element is falsy (None, False, empty string, etc.)
+                # and second is an error message string
+                if not first and isinstance(second, str):
+                    error_msg = second if second else "Unknown error"
+                    self.logger.log(
+                        "WARNING",
+                        f"Step {step_id} returned error tuple",
+                        error_msg,
+                    )
+                    result = {"error": error_msg}
+            self.logger.log("INFO", f"Step {step_id} completed", str(result))
+            return result
+
+        except NotImplementedError:
+            self.logger.log(
+                "ERROR",
+                f"Function '{step.function}' not found in {step.agent}",
+            )
+            return {"error": "function_not_found"}
+        except Exception as exc:
+            self.logger.log(
+                "ERROR",
+                f"Error executing {step.agent}.{step.function}",
+                str(exc),
+            )
+            return {"error": str(exc)}
@@ -23,6 +23,8 @@ class Protocol:
     steps: List[ProtocolStep] = field(default_factory=list)
     argument_definitions: List[ArgumentDefinition] = field(default_factory=list)  # NEW
     response: ProtocolResponse | None = None
+    # Indices of steps that may run concurrently, stage by stage (compiled protocols)
+    stages: List[List[int]] = field(default_factory=list)
 
     @classmethod
     def from_dict(
@@ -49,6 +51,7 @@ class Protocol:
             steps=steps,
             argument_definitions=arg_defs,  # NEW
             response=response,
+            stages=data.get("stages", []),
         )
 
     @classmethod
@@ -59,7 +62,7 @@ class Protocol:
 
     def to_dict(self) -> Dict[str, Any]:
         """Convert Protocol to dict for JSON serialization."""
-        return {
+        data = {
             "id": self.id,
             "name": self.name,
             "description": self.description,
@@ -69,3 +72,6 @@ class Protocol:
             "argument_definitions": [ad.to_dict() for ad in self.argument_definitions],
             "responses": self.response.to_dict() if self.response else None,
         }
+        if self.stages:
+            data["stages"] = self.stages
+        return data
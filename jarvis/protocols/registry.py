@@ -1,7 +1,6 @@
 from __future__ import annotations
 
 import json
-import sqlite3
 from pathlib import Path
 from typing import Dict, Iterable, Optional, List
 import os
@@ -11,21 +10,45 @@ import concurrent.futures
 
 from ..logging import JarvisLogger
 from ..core.registry import BaseRegistry
-from .models import Protocol, ProtocolStep, ProtocolResponse
+from ..storage import StartupSnapshot, StorageEngine, content_digest, schema_fingerprint
+from .models import (
+    ArgumentDefinition,
+    ArgumentType,
+    Protocol,
+    ProtocolResponse,
+    ProtocolStep,
+    ResponseMode,
+)
+
+SNAPSHOT_SECTION = "protocol_registry"
+# Part of every snapshot digest: a model change invalidates pickled protocols
+SCHEMA_FINGERPRINT = schema_fingerprint(
+    Protocol, ProtocolStep, ArgumentDefinition, ArgumentType, ProtocolResponse, ResponseMode
+)
 
 
 class ProtocolRegistry(BaseRegistry[Protocol]):
-    """Stores and retrieves Protocol definitions using SQLite."""
+    """Stores and retrieves Protocol definitions using SQLite.
+
+    ``digest`` is a content hash of the persisted rows (``None`` when the
+    registry was loaded from a directory instead).  With a
+    :class:`StartupSnapshot`, :meth:`load` reuses the previously parsed
+    protocols when the rows are unchanged.
+    """
 
     def __init__(
-        self, db_path: str | None = None, logger: JarvisLogger | None = None
+        self,
+        db_path: str | None = None,
+        logger: JarvisLogger | None = None,
+        snapshot: StartupSnapshot | None = None,
     ) -> None:
         if db_path is None:
             db_path = os.getenv("PROTOCOLS_DB_PATH", "protocols.db")
         self.db_path = Path(db_path)
         self.logger = logger or JarvisLogger()
-        self.conn: sqlite3.Connection = sqlite3.connect(self.db_path)
-        self.conn.row_factory = sqlite3.Row
+        self.snapshot = snapshot
+        self.digest: Optional[str] = None
+        self._db: Optional[StorageEngine] = StorageEngine.open(str(self.db_path))
         self._ensure_table()
         super().__init__({})
         # Alias for backward compatibility
@@ -46,8 +69,8 @@ class ProtocolRegistry(BaseRegistry[Protocol]):
             response             TEXT  -- JSON ProtocolResponse definition
         """
 
-        with self.conn:
-            self.conn.execute(
+        with self._db.transaction() as conn:
+            conn.execute(
                 """
                 CREATE TABLE IF NOT EXISTS protocols (
                     id TEXT PRIMARY KEY,
@@ -62,24 +85,23 @@ class ProtocolRegistry(BaseRegistry[Protocol]):
                 """
             )
             # Backwards-compatible upgrade:
-            cols = [r[1] for r in self.conn.execute("PRAGMA table_info(protocols)")]
+            cols = [r[1] for r in conn.execute("PRAGMA table_info(protocols)")]
             if "arguments" not in cols:
-                self.conn.execute("ALTER TABLE protocols ADD COLUMN arguments TEXT")
+                conn.execute("ALTER TABLE protocols ADD COLUMN arguments TEXT")
             if "trigger_phrases" not in cols:
-                self.conn.execute(
+                conn.execute(
                     "ALTER TABLE protocols ADD COLUMN trigger_phrases TEXT"
                 )
             if "argument_definitions" not in cols:  # NEW
-                self.conn.execute(
+                conn.execute(
                     "ALTER TABLE protocols ADD COLUMN argument_definitions TEXT"
                 )
             if "response" not in cols:
-                self.conn.execute("ALTER TABLE protocols ADD COLUMN response TEXT")
+                conn.execute("ALTER TABLE protocols ADD COLUMN response TEXT")
 
     def load(self, directory: Path | None = None) -> None:
-        from .models import ArgumentDefinition  # Import here to avoid circular imports
-
         self.protocols.clear()
+        self.digest = None
         if directory is not None:
             directory = Path(directory)
             if not directory.exists():
@@ -94,10 +116,17 @@ class ProtocolRegistry(BaseRegistry[Protocol]):
                     self.logger.log("ERROR", f"Failed to load protocol from {json_file}", {"error": str(e)})
             return
 
-        rows = self.conn.execute(
+        rows = self._db.fetchall(
             """SELECT id, name, description, arguments, steps, 
             trigger_phrases, argument_definitions, response FROM protocols"""
-        ).fetchall()
+        )
+        self.digest = self._rows_digest(tuple(row) for row in rows)
+
+        if self.snapshot is not None:
+            cached = self.snapshot.get(SNAPSHOT_SECTION, self.digest)
+            if cached is not None:
+                self.protocols.update(cached)
+                return
 
         for row in rows:
             # parse steps & args exactly as before…
@@ -127,38 +156,60 @@ class ProtocolRegistry(BaseRegistry[Protocol]):
                 "Protocol loaded",
                 f"{proto.id} - {proto.name}",
             )
+        self.refresh_snapshot()
 
-    def save(self) -> None:
-        with self.conn:
-            for proto in self.protocols.values():
-                steps_json = json.dumps([s.__dict__ for s in proto.steps])
-                args_json = json.dumps(proto.arguments)
-                triggers_json = json.dumps(proto.trigger_phrases)
-                arg_defs_json = json.dumps(
-                    [ad.to_dict() for ad in proto.argument_definitions]
-                )  # NEW
-
-                response_json = (
-                    json.dumps(proto.response.to_dict()) if proto.response else "null"
-                )
+    @staticmethod
+    def _rows_digest(rows: Iterable[tuple]) -> str:
+        return content_digest(SCHEMA_FINGERPRINT, *sorted(rows))
+
+    def refresh_snapshot(self) -> None:
+        """Record the current protocols in the snapshot under ``digest``.
+
+        Not done on every :meth:`save` to keep bulk registration linear;
+        a registration the snapshot missed is a miss on the next boot.
+        """
+        if self.snapshot is not None and self.digest is not None:
+            self.snapshot.put(SNAPSHOT_SECTION, self.digest, dict(self.protocols))
 
-                self.conn.execute(
+    @staticmethod
+    def _to_row(proto: Protocol) -> tuple:
+        steps_json = json.dumps([s.__dict__ for s in proto.steps])
+        args_json = json.dumps(proto.arguments)
+        triggers_json = json.dumps(proto.trigger_phrases)
+        arg_defs_json = json.dumps(
+            [ad.to_dict() for ad in proto.argument_definitions]
+        )  # NEW
+
+        response_json = (
+            json.dumps(proto.response.to_dict()) if proto.response else "null"
+        )
+        return (
+            proto.id,
+            proto.name,
+            proto.description,
+            args_json,
+            steps_json,
+            triggers_json,
+            arg_defs_json,  # NEW
+            response_json,
+        )
+
+    def save(self) -> None:
+        rows = [self._to_row(proto) for proto in self.protocols.values()]
+        with self._db.transaction() as conn:
+            for row in rows:
+                conn.execute(
                     """
                     INSERT OR REPLACE INTO protocols
                     (id, name, description, arguments, steps, trigger_phrases, argument_definitions, response)
                     VALUES (?, ?, ?, ?, ?, ?, ?, ?)
                     """,
-                    (
-                        proto.id,
-                        proto.name,
-                        proto.description,
-                        args_json,
-                        steps_json,
-                        triggers_json,
-                        arg_defs_json,  # NEW
-                        response_json,
-                    ),
+                    row,
                 )
+            stored = conn.execute("SELECT COUNT(*) FROM protocols").fetchone()[0]
+        # Every in-memory row was just written, so equal counts mean the
+        # table holds exactly what is in memory and the digest describes it
+        self.digest = self._rows_digest(rows) if stored == len(rows) else None
 
     @staticmethod
     def normalize_trigger_phrases(phrases: List[str]) -> List[str]:
@@ -207,8 +258,7 @@ class ProtocolRegistry(BaseRegistry[Protocol]):
         if duplicate_id is not None:
             del self.protocols[duplicate_id]
             # Also remove from database
-            with self.conn:
-                self.conn.execute("DELETE FROM protocols WHERE id = ?", (duplicate_id,))
+            self._db.write("DELETE FROM protocols WHERE id = ?", (duplicate_id,))
 
         self.protocols[protocol.id] = protocol
         self.save()
@@ -292,5 +342,6 @@ class ProtocolRegistry(BaseRegistry[Protocol]):
         return list(self.protocols.keys())
 
     def close(self) -> None:
-        if self.conn:
-            self.conn.close()
+        db, self._db = self._db, None
+        if db is not None:
+            db.release()
@@ -6,6 +6,7 @@ from typing import Any, Dict
 
 from ..logging import JarvisLogger
 from ..agents.agent_network import AgentNetwork
+from ..storage import StartupSnapshot, content_digest
 from .loggers import ProtocolUsageLogger
 from .models import Protocol, ResponseMode
 from .executor import ProtocolExecutor
@@ -13,6 +14,9 @@ from .registry import ProtocolRegistry
 from .voice_trigger import VoiceTriggerMatcher
 from .loader import ProtocolLoader
 
+SNAPSHOT_DEFINITIONS = "protocol_definitions"
+SNAPSHOT_TRIGGERS = "voice_triggers"
+
 
 class ProtocolRuntime:
     """Facade responsible for protocol matching, execution and formatting."""
@@ -23,10 +27,12 @@ class ProtocolRuntime:
         logger: JarvisLogger,
         *,
         usage_logger: ProtocolUsageLogger | None = None,
+        snapshot: StartupSnapshot | None = None,
     ) -> None:
         self.network = network
         self.logger = logger
-        self.registry = ProtocolRegistry(logger=logger)
+        self.snapshot = snapshot
+        self.registry = ProtocolRegistry(logger=logger, snapshot=snapshot)
         self.executor = ProtocolExecutor(network, logger, usage_logger=usage_logger)
         self.voice_matcher: VoiceTriggerMatcher | None = None
         self.loader = ProtocolLoader(self.registry, logger)
@@ -40,12 +46,50 @@ class ProtocolRuntime:
         definitions_dir: Path | None = None,
         skip_prefixes: list[str] | None = None,
     ) -> None:
-        """Load protocol definitions and prepare matcher."""
+        """Load protocol definitions and prepare matcher.
+
+        With a startup snapshot, re-registering an unchanged definitions
+        directory into an unchanged registry is skipped, and the trigger
+        map is restored instead of re-derived.
+        """
         if load_directory:
             if definitions_dir is None:
                 definitions_dir = Path(__file__).parent / "defaults" / "definitions"
-            self.loader.load_directory(definitions_dir, skip_prefixes=skip_prefixes)
-        self.voice_matcher = VoiceTriggerMatcher(self.registry.protocols)
+            self._load_definitions(Path(definitions_dir), skip_prefixes)
+        self.voice_matcher = self._build_voice_matcher()
+
+    def _load_definitions(
+        self, definitions_dir: Path, skip_prefixes: list[str] | None
+    ) -> None:
+        files_digest = None
+        if self.snapshot is not None and self.registry.digest is not None:
+            files = sorted(definitions_dir.glob("*.json"))
+            files_digest = content_digest(
+                sorted(skip_prefixes or []),
+                *((f.name, f.read_bytes()) for f in files),
+            )
+            loaded_into = self.snapshot.get(SNAPSHOT_DEFINITIONS, files_digest)
+            if loaded_into is not None and loaded_into == self.registry.digest:
+                return
+        self.loader.load_directory(definitions_dir, skip_prefixes=skip_prefixes)
+        if files_digest is not None and self.registry.digest is not None:
+            self.registry.refresh_snapshot()
+            self.snapshot.put(SNAPSHOT_DEFINITIONS, files_digest, self.registry.digest)
+
+    def _build_voice_matcher(self) -> VoiceTriggerMatcher:
+        protocols = self.registry.protocols
+        digest = self.registry.digest
+        if self.snapshot is None or digest is None:
+            return VoiceTriggerMatcher(protocols)
+        state = self.snapshot.get(SNAPSHOT_TRIGGERS, digest)
+        if state is not None:
+            try:
+                return VoiceTriggerMatcher.from_state(protocols, state)
+            except (KeyError, TypeError, ValueError):
+                pass  # fall through to a full rebuild
+        matcher = VoiceTriggerMatcher(protocols)
+        self.snapshot.put(SNAPSHOT_TRIGGERS, digest, matcher.export_state())
+        return matcher
 
     # ------------------------------------------------------------------
     # Matching
@@ -2,16 +2,27 @@
 """Enhanced voice trigger detection for protocols with arguments"""
 
 import re
-from typing import Dict, Optional, Any, List
+from typing import Dict, Optional, Any, List, Tuple
 from .models import Protocol, ArgumentDefinition, ArgumentType
 
 
 class ParameterizedProtocol:
     """Enhanced protocol that can handle arguments in trigger phrases."""
 
-    def __init__(self, protocol: Protocol):
+    def __init__(
+        self,
+        protocol: Protocol,
+        patterns: Optional[List[Tuple[str, List[str], str]]] = None,
+    ):
         self.protocol = protocol
-        self._compile_patterns()
+        if patterns is None:
+            self._compile_patterns()
+        else:
+            # Pattern sources derived on an earlier run (startup snapshot)
+            self.patterns = [
+                (re.compile(source, re.IGNORECASE), placeholders, phrase)
+                for source, placeholders, phrase in patterns
+            ]
 
     def _compile_patterns(self):
         """Compile regex patterns for each trigger phrase with placeholders."""
@@ -152,6 +163,37 @@ class VoiceTriggerMatcher:
                     normalized = phrase.lower().strip()
                     self.simple_triggers[normalized] = protocol
 
+    def export_state(self) -> Dict[str, Any]:
+        """Derived trigger map as plain data, keyed by protocol id."""
+        return {
+            "simple": {
+                phrase: protocol.id for phrase, protocol in self.simple_triggers.items()
+            },
+            "parameterized": [
+                (
+                    param.protocol.id,
+                    [(p.pattern, placeholders, phrase) for p, placeholders, phrase in param.patterns],
+                )
+                for param in self.parameterized_protocols
+            ],
+        }
+
+    @classmethod
+    def from_state(
+        cls, protocols: Dict[str, Protocol], state: Dict[str, Any]
+    ) -> "VoiceTriggerMatcher":
+        """Rebuild a matcher from :meth:`export_state` output for *protocols*."""
+        matcher = cls.__new__(cls)
+        matcher.protocols = protocols
+        matcher.simple_triggers = {
+            phrase: protocols[pid] for phrase, pid in state["simple"].items()
+        }
+        matcher.parameterized_protocols = [
+            ParameterizedProtocol(protocols[pid], patterns)
+            for pid, patterns in state["parameterized"]
+        ]
+        return matcher
+
     def match_command(self, voice_command: str) -> Optional[Dict[str, Any]]:
         """Match command and return protocol with extracted arguments."""
         normalized = voice_command.lower().strip()
@@ -12,13 +12,14 @@ import hashlib
 import os
 import re
 import time
-from dataclasses import dataclass
+from dataclasses import dataclass, field
 from fnmatch import fnmatch
 from pathlib import Path
 from typing import Optional
 
 from ..core.errors import SafetyViolationError, WorktreeError
 from ..logging import JarvisLogger
+from .test_sharding import ShardedTestRunner
 
 INIT_MD_PATH = ".claude/INIT.md"
 _MAX_LOG_ENTRIES = 20
@@ -37,6 +38,7 @@ class ExecutionResult:
     branch_name: Optional[str] = None
     files_changed: int = 0
     duration_seconds: float = 0.0
+    changed_files: list[str] = field(default_factory=list)
 
 
 class ClaudeCodeRunner:
@@ -68,6 +70,10 @@ class ClaudeCodeRunner:
         self.project_root = project_root
         self.claude_binary = claude_binary
         self.logger = logger
+        self.test_runner = ShardedTestRunner(run_subprocess=self._run_subprocess)
+        # Night tasks run concurrently; worktree bookkeeping, branch
+        # deletion and merges all touch the main checkout, one at a time
+        self._repo_lock = asyncio.Lock()
 
     # ------------------------------------------------------------------
     # Public API
@@ -123,14 +129,15 @@ class ClaudeCodeRunner:
                 f"{worktree_path} on branch {branch_name}",
             )
 
-        # Clean up stale branch/worktree from a previous failed run
-        await self._cleanup_stale_worktree(worktree_path, branch_name)
+        async with self._repo_lock:
+            # Clean up stale branch/worktree from a previous failed run
+            await self._cleanup_stale_worktree(worktree_path, branch_name)
 
-        result = await self._run_subprocess(
-            ["git", "worktree", "add", worktree_path, "-b", branch_name],
-            cwd=self.project_root,
-            timeout=30,
-        )
+            result = await self._run_subprocess(
+                ["git", "worktree", "add", worktree_path, "-b", branch_name],
+                cwd=self.project_root,
+                timeout=30,
+            )
 
         if result.exit_code != 0:
             raise WorktreeError(
@@ -240,6 +247,7 @@ class ClaudeCodeRunner:
 
         result.worktree_path = worktree_path
         result.files_changed = len(all_changed)
+        result.changed_files = sorted(all_changed)
         return result
 
     async def run_tests(
@@ -249,52 +257,79 @@ class ClaudeCodeRunner:
     ) -> ExecutionResult:
         """Run pytest inside *worktree_path*.
 
-        If *test_files* are given they are appended to the pytest command,
-        otherwise the full suite is executed.
+        If *test_files* are given only those are run, otherwise the full
+        suite is executed. Either way the files are split into shards run
+        concurrently (see :class:`ShardedTestRunner`).
         """
         cmd: list[str] = ["pytest", "-x", "-q"]
-        if test_files:
-            cmd.extend(test_files)
 
         if self.logger:
-            self.logger.log("INFO", "Running tests", f"{worktree_path}: {' '.join(cmd)}")
+            self.logger.log(
+                "INFO",
+                "Running tests",
+                f"{worktree_path}: {' '.join(cmd)} "
+                f"({len(test_files) if test_files is not None else 'all'} files)",
+            )
 
-        return await self._run_subprocess(
-            cmd, cwd=worktree_path, timeout=self.MAX_EXECUTION_TIMEOUT
+        run = await self.test_runner.run(
+            worktree_path, cmd, test_files, timeout=self.MAX_EXECUTION_TIMEOUT
+        )
+        if self.logger and len(run.shards) > 1:
+            self.logger.log(
+                "INFO",
+                "Sharded test run",
+                f"{len(run.shards)} shards, {run.duration_seconds}s, "
+                f"{run.tests_recorded} durations recorded",
+            )
+        return ExecutionResult(
+            success=run.success,
+            stdout=run.stdout,
+            stderr=run.stderr,
+            exit_code=run.exit_code,
+            worktree_path=worktree_path,
+            duration_seconds=run.duration_seconds,
         )
 
     async def merge_to_main(self, worktree_path: str, branch_name: str) -> bool:
         """Merge *branch_name* into the current branch from *project_root*.
 
         Returns ``True`` on success. On merge conflict the merge is aborted
-        and ``False`` is returned.
+        and ``False`` is returned. Merges are serialized, so a branch whose
+        base has moved on (another task merged first) is merged against
+        the latest main and its conflicts are detected here.
         """
-        if self.logger:
-            self.logger.log("INFO", "Merging branch", f"{branch_name} into main")
-
-        result = await self._run_subprocess(
-            ["git", "merge", branch_name, "--no-edit"],
-            cwd=self.project_root,
-            timeout=30,
-        )
-
-        if result.exit_code != 0:
+        async with self._repo_lock:
             if self.logger:
-                self.logger.log(
-                    "WARNING",
-                    "Merge conflict detected, aborting",
-                    result.stderr,
-                )
-            await self._run_subprocess(
-                ["git", "merge", "--abort"],
+                self.logger.log("INFO", "Merging branch", f"{branch_name} into main")
+
+            result = await self._run_subprocess(
+                ["git", "merge", branch_name, "--no-edit"],
                 cwd=self.project_root,
-                timeout=15,
+                timeout=30,
             )
-            return False
 
-        # Keep the implementation briefing current after every merge.
-        await self.update_init_md()
-        return True
+            if result.exit_code != 0:
+                conflicts = await self._run_subprocess(
+                    ["git", "diff", "--name-only", "--diff-filter=U"],
+                    cwd=self.project_root,
+                    timeout=15,
+                )
+                if self.logger:
+                    self.logger.log(
+                        "WARNING",
+                        "Merge conflict detected, aborting",
+                        f"{branch_name}: {' '.join(conflicts.stdout.split()) or result.stderr}",
+                    )
+                await self._run_subprocess(
+                    ["git", "merge", "--abort"],
+                    cwd=self.project_root,
+                    timeout=15,
+                )
+                return False
+
+            # Keep the implementation briefing current after every merge.
+            await self.update_init_md()
+            return True
 
     async def check_gh_available(self) -> bool:
         """Return True if the GitHub CLI is authenticated and runnable."""
@@ -354,27 +389,28 @@ class ClaudeCodeRunner:
         When *keep_branch* is True the branch is preserved for an open PR.
         Errors are logged but never raised so cleanup is best-effort.
         """
-        remove_result = await self._run_subprocess(
-            ["git", "worktree", "remove", "--force", worktree_path],
-            cwd=self.project_root,
-            timeout=15,
-        )
-        if remove_result.exit_code != 0 and self.logger:
-            self.logger.log(
-                "WARNING", "Worktree removal failed", remove_result.stderr
-            )
-
-        if not keep_branch:
-            branch_result = await self._run_subprocess(
-                ["git", "branch", "-D", branch_name],
+        async with self._repo_lock:
+            remove_result = await self._run_subprocess(
+                ["git", "worktree", "remove", "--force", worktree_path],
                 cwd=self.project_root,
                 timeout=15,
             )
-            if branch_result.exit_code != 0 and self.logger:
+            if remove_result.exit_code != 0 and self.logger:
                 self.logger.log(
-                    "WARNING", "Branch deletion failed", branch_result.stderr
+                    "WARNING", "Worktree removal failed", remove_result.stderr
                 )
 
+            if not keep_branch:
+                branch_result = await self._run_subprocess(
+                    ["git", "branch", "-D", branch_name],
+                    cwd=self.project_root,
+                    timeout=15,
+                )
+                if branch_result.exit_code != 0 and self.logger:
+                    self.logger.log(
+                        "WARNING", "Branch deletion failed", branch_result.stderr
+                    )
+
     # ------------------------------------------------------------------
     # INIT.md — implementation briefing for future sessions
     # ------------------------------------------------------------------
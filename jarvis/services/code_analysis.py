@@ -0,0 +1,221 @@
+"""Shared single-pass source analysis for SystemAnalyzer and TestMapper.
+
+Every file is read once per run and, when its content changed, parsed
+once; a single ``ast.walk`` feeds all collectors and the results are
+stored as plain :class:`FileFacts`.  Facts are a pure function of the file
+contents, so they are cached by content digest in a small SQLite table
+and unchanged files are neither parsed nor walked on later runs.  Cache
+misses are spread over a forkserver process pool when there are enough
+of them and more than one CPU to use; the collectors live in
+:mod:`.code_facts`, which is all the pool workers need.
+"""
+
+from __future__ import annotations
+
+import hashlib
+import multiprocessing
+import os
+import pickle
+import time
+from concurrent.futures import ProcessPoolExecutor
+from dataclasses import dataclass
+from datetime import datetime, timedelta, timezone
+from pathlib import Path
+from typing import Dict, Iterable, List, Optional, Tuple
+
+from ..storage import StorageEngine
+from .code_facts import FileFacts, collect_facts, collect_many
+
+# Bump when collectors change so cached facts are recomputed
+ANALYSIS_VERSION = 2
+
+DEFAULT_CACHE_PATH = os.path.join(str(Path.home()), ".jarvis", "analysis_cache.db")
+PARALLEL_MIN_FILES = 32
+CACHE_RETENTION_DAYS = 30
+
+
+@dataclass
+class SourceFile:
+    """A file read during a run, with its facts (``None`` if unreadable)."""
+
+    rel_path: str
+    source: str
+    facts: Optional[FileFacts]
+
+
+@dataclass
+class AnalysisRun:
+    files: Dict[str, SourceFile]
+    elapsed_ms: float
+    parsed: int
+    cache_hits: int
+    workers: int
+
+    def stats(self) -> Dict[str, float]:
+        return {
+            "files": len(self.files),
+            "parsed": self.parsed,
+            "cache_hits": self.cache_hits,
+            "workers": self.workers,
+            "elapsed_ms": round(self.elapsed_ms, 2),
+        }
+
+
+class CodeAnalysisEngine:
+    """Reads, digests and analyzes source files with a persistent cache.
+
+    ``cache_path=None`` uses ``~/.jarvis/analysis_cache.db``; pass
+    ``cache=False`` to keep the cache in memory only.
+    """
+
+    def __init__(
+        self,
+        cache_path: Optional[str] = None,
+        *,
+        cache: bool = True,
+        max_workers: Optional[int] = None,
+    ) -> None:
+        self._memory: Dict[str, FileFacts] = {}
+        self._db: Optional[StorageEngine] = None
+        if cache:
+            path = Path(cache_path or DEFAULT_CACHE_PATH)
+            path.parent.mkdir(parents=True, exist_ok=True)
+            self._db = StorageEngine.open(str(path))
+            self._db.write(
+                """
+                CREATE TABLE IF NOT EXISTS file_facts (
+                    digest TEXT PRIMARY KEY,
+                    version INTEGER NOT NULL,
+                    facts BLOB NOT NULL,
+                    last_seen TEXT NOT NULL
+                )
+                """
+            )
+        self.max_workers = max_workers or os.cpu_count() or 1
+        self.last_run: Optional[AnalysisRun] = None
+
+    # ------------------------------------------------------------------
+
+    def analyze(self, root: Path, paths: Iterable[Path]) -> AnalysisRun:
+        """Return facts for *paths*, keyed by path relative to *root*."""
+        start = time.perf_counter()
+        files: Dict[str, SourceFile] = {}
+        digests: Dict[str, str] = {}
+        for path in paths:
+            rel_path = str(path.relative_to(root))
+            try:
+                raw = path.read_bytes()
+                source = raw.decode("utf-8")
+            except Exception:
+                continue
+            digests[rel_path] = hashlib.blake2b(raw, digest_size=16).hexdigest()
+            files[rel_path] = SourceFile(rel_path, source, None)
+
+        cached = self._lookup(set(digests.values()))
+        missing: Dict[str, List[str]] = {}
+        for rel_path, digest in digests.items():
+            facts = cached.get(digest)
+            if facts is not None:
+                files[rel_path].facts = facts
+            else:
+                missing.setdefault(digest, []).append(rel_path)
+
+        workers = 1
+        if missing:
+            order = list(missing)
+            sources = [files[missing[d][0]].source for d in order]
+            results, workers = self._collect(sources)
+            fresh = dict(zip(order, results))
+            for digest, facts in fresh.items():
+                for rel_path in missing[digest]:
+                    files[rel_path].facts = facts
+            self._store(fresh)
+        self._touch(set(digests.values()) - set(missing))
+
+        run = AnalysisRun(
+            files=files,
+            elapsed_ms=(time.perf_counter() - start) * 1000,
+            parsed=len(missing),
+            cache_hits=len(digests) - sum(len(v) for v in missing.values()),
+            workers=workers,
+        )
+        self.last_run = run
+        return run
+
+    def close(self) -> None:
+        db, self._db = self._db, None
+        if db is not None:
+            cutoff = (
+                datetime.now(timezone.utc) - timedelta(days=CACHE_RETENTION_DAYS)
+            ).isoformat()
+            db.write(
+                "DELETE FROM file_facts WHERE version != ? OR last_seen < ?",
+                (ANALYSIS_VERSION, cutoff),
+            )
+            db.release()
+
+    # ------------------------------------------------------------------
+
+    def _collect(self, sources: List[str]) -> Tuple[List[FileFacts], int]:
+        workers = min(self.max_workers, len(sources) // (PARALLEL_MIN_FILES // 2) or 1)
+        if (
+            workers < 2
+            or len(sources) < PARALLEL_MIN_FILES
+            or "forkserver" not in multiprocessing.get_all_start_methods()
+        ):
+            return collect_many(sources), 1
+        # Forking this process directly would copy the storage writer and
+        # read-pool threads mid-lock; the forkserver is single-threaded and
+        # has imported the collectors once, so workers start cheaply.
+        ctx = multiprocessing.get_context("forkserver")
+        ctx.set_forkserver_preload([collect_many.__module__])
+        chunks = [sources[i::workers] for i in range(workers)]
+        with ProcessPoolExecutor(max_workers=workers, mp_context=ctx) as pool:
+            parts = list(pool.map(collect_many, chunks))
+        results: List[FileFacts] = [None] * len(sources)  # type: ignore[list-item]
+        for i, part in enumerate(parts):
+            results[i::workers] = part
+        return results, workers
+
+    def _lookup(self, digests: set) -> Dict[str, FileFacts]:
+        found = {d: self._memory[d] for d in digests if d in self._memory}
+        wanted = [d for d in digests if d not in found]
+        if self._db is None or not wanted:
+            return found
+        for i in range(0, len(wanted), 500):
+            chunk = wanted[i:i + 500]
+            rows = self._db.fetchall(
+                f"SELECT digest, facts FROM file_facts WHERE version = ? "
+                f"AND digest IN ({','.join('?' * len(chunk))})",
+                (ANALYSIS_VERSION, *chunk),
+            )
+            for row in rows:
+                try:
+                    facts = pickle.loads(row["facts"])
+                except Exception:
+                    continue
+                found[row["digest"]] = self._memory[row["digest"]] = facts
+        return found
+
+    def _store(self, fresh: Dict[str, FileFacts]) -> None:
+        self._memory.update(fresh)
+        if self._db is None:
+            return
+        now = datetime.now(timezone.utc).isoformat()
+        self._db.write_many(
+            "INSERT OR REPLACE INTO file_facts (digest, version, facts, last_seen) "
+            "VALUES (?, ?, ?, ?)",
+            [
+                (digest, ANALYSIS_VERSION, pickle.dumps(facts, protocol=pickle.HIGHEST_PROTOCOL), now)
+                for digest, facts in fresh.items()
+            ],
+        )
+
+    def _touch(self, digests: set) -> None:
+        if self._db is None or not digests:
+            return
+        now = datetime.now(timezone.utc).isoformat()
+        self._db.write_many(
+            "UPDATE file_facts SET last_seen = ? WHERE digest = ?",
+            [(now, d) for d in digests],
+        )
@@ -0,0 +1,134 @@
+"""Per-file fact collection, kept apart from the engine for worker processes.
+
+:class:`~jarvis.services.code_analysis.CodeAnalysisEngine` runs
+:func:`collect_many` in a forkserver pool.  Nothing here touches storage
+or starts threads, so preloading this module in the forkserver gives
+workers the collectors without the writer threads, sockets or SQLite
+handles of the process that asked for the analysis.  The ``jarvis``
+package resolves its public names lazily, so the preload imports only
+this module and the standard library.
+"""
+
+from __future__ import annotations
+
+import ast
+import re
+from collections import Counter
+from dataclasses import dataclass, field
+from typing import Dict, List, Tuple
+
+_MARKER_RE = re.compile(r"#\s*(TODO|FIXME|HACK|XXX)\b", re.IGNORECASE)
+_WORD_RE = re.compile(r"\w+")
+
+
+@dataclass
+class FileFacts:
+    """Everything the analyzers need from one file, as plain data."""
+
+    parsed: bool
+    # (class name, undocumented public methods) for classes with any
+    undocumented: List[Tuple[str, List[str]]] = field(default_factory=list)
+    unused_imports: List[Tuple[str, int]] = field(default_factory=list)
+    exception_antipatterns: List[Tuple[str, int]] = field(default_factory=list)
+    # (name, first line, length in lines) for every function
+    functions: List[Tuple[str, int, int]] = field(default_factory=list)
+    # (name, line) for public function definitions
+    public_defs: List[Tuple[str, int]] = field(default_factory=list)
+    # (name, start, end) for every function/class, in walk order
+    scopes: List[Tuple[str, int, int]] = field(default_factory=list)
+    # TODO/FIXME/HACK/XXX markers; collected even when parsing fails
+    markers: List[Tuple[str, int]] = field(default_factory=list)
+    # Every import as (level, module, imported names); ``import a.b`` is
+    # (0, "a.b", []) and ``from ..x import y`` is (2, "x", ["y"])
+    imports: List[Tuple[int, str, List[str]]] = field(default_factory=list)
+    # identifier occurrence counts, for cross-file reference checks
+    words: Dict[str, int] = field(default_factory=dict)
+
+    def scope_at(self, lineno: int) -> str:
+        """Name of the innermost function/class containing *lineno*."""
+        best_name = ""
+        best_start = 0
+        for name, start, end in self.scopes:
+            if start <= lineno <= end and start >= best_start:
+                best_start = start
+                best_name = name
+        return best_name
+
+
+def collect_facts(source: str) -> FileFacts:
+    """Parse *source* once and run every collector over a single walk."""
+    markers = []
+    for i, line in enumerate(source.splitlines(), 1):
+        m = _MARKER_RE.search(line)
+        if m:
+            markers.append((f"{m.group(1).upper()} at line {i}", i))
+
+    try:
+        tree = ast.parse(source)
+    except Exception:
+        return FileFacts(parsed=False, markers=markers)
+
+    facts = FileFacts(parsed=True, markers=markers)
+    imported: List[Tuple[str, int]] = []
+
+    for node in ast.walk(tree):
+        if isinstance(node, (ast.FunctionDef, ast.AsyncFunctionDef)):
+            end_line = getattr(node, "end_lineno", None)
+            facts.scopes.append((node.name, node.lineno, end_line or 9999))
+            if end_line is not None:
+                facts.functions.append((node.name, node.lineno, end_line - node.lineno + 1))
+            if not node.name.startswith("_"):
+                facts.public_defs.append((node.name, node.lineno))
+        elif isinstance(node, ast.ClassDef):
+            facts.scopes.append(
+                (node.name, node.lineno, getattr(node, "end_lineno", None) or 9999)
+            )
+            undocumented = [
+                item.name
+                for item in node.body
+                if isinstance(item, (ast.FunctionDef, ast.AsyncFunctionDef))
+                and not item.name.startswith("_")
+                and not ast.get_docstring(item)
+            ]
+            if undocumented:
+                facts.undocumented.append((node.name, undocumented))
+        elif isinstance(node, ast.Import):
+            for alias in node.names:
+                imported.append((alias.asname or alias.name.split(".")[0], node.lineno))
+                facts.imports.append((0, alias.name, []))
+        elif isinstance(node, ast.ImportFrom):
+            for alias in node.names:
+                imported.append((alias.asname or alias.name, node.lineno))
+            facts.imports.append(
+                (node.level, node.module or "", [a.name for a in node.names])
+            )
+        elif isinstance(node, ast.ExceptHandler):
+            if node.type is None:
+                facts.exception_antipatterns.append(
+                    (f"Bare except: at line {node.lineno}", node.lineno)
+                )
+            elif len(node.body) == 1 and isinstance(node.body[0], ast.Pass):
+                facts.exception_antipatterns.append(
+                    (f"Swallowed exception at line {node.lineno}", node.lineno)
+                )
+
+    if imported:
+        # Names never referenced outside import lines
+        import_lines = {ln for _, ln in imported}
+        non_import_source = "\n".join(
+            line for i, line in enumerate(source.splitlines(), 1)
+            if i not in import_lines
+        )
+        facts.unused_imports = [
+            (name, ln)
+            for name, ln in imported
+            if name != "*"
+            and not re.search(rf"\b{re.escape(name)}\b", non_import_source)
+        ]
+
+    facts.words = dict(Counter(_WORD_RE.findall(source)))
+    return facts
+
+
+def collect_many(sources: List[str]) -> List[FileFacts]:
+    return [collect_facts(s) for s in sources]
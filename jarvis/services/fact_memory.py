@@ -6,6 +6,8 @@ import datetime
 from typing import Any, Dict, List, Optional
 from dataclasses import dataclass, asdict
 
+from ..storage import StorageEngine
+
 
 @dataclass
 class UserFact:
@@ -35,12 +37,12 @@ class FactMemoryService:
 
             db_path = os.getenv("AUTH_DB_PATH", "auth.db")
         self.db_path = db_path
+        self._db: Optional[StorageEngine] = StorageEngine.open(db_path)
         self._init_schema()
 
     def _init_schema(self) -> None:
         """Initialize the database schema."""
-        conn = sqlite3.connect(self.db_path, check_same_thread=False)
-        conn.execute(
+        self._db.write_script([
             """
             CREATE TABLE IF NOT EXISTS user_facts (
                 id INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -58,26 +60,31 @@ class FactMemoryService:
                 FOREIGN KEY (user_id)
                     REFERENCES users(id) ON DELETE CASCADE
             )
-            """
-        )
-        conn.execute(
-            "CREATE INDEX IF NOT EXISTS idx_user_facts_user_id ON user_facts(user_id)"
-        )
-        conn.execute(
-            "CREATE INDEX IF NOT EXISTS idx_user_facts_category ON user_facts(category)"
-        )
-        conn.execute(
-            "CREATE INDEX IF NOT EXISTS idx_user_facts_entity ON user_facts(entity)"
-        )
-        conn.execute(
-            "CREATE INDEX IF NOT EXISTS idx_user_facts_active ON user_facts(user_id, is_active)"
-        )
-        conn.commit()
-        conn.close()
+            """,
+            "CREATE INDEX IF NOT EXISTS idx_user_facts_user_id ON user_facts(user_id)",
+            "CREATE INDEX IF NOT EXISTS idx_user_facts_category ON user_facts(category)",
+            "CREATE INDEX IF NOT EXISTS idx_user_facts_entity ON user_facts(entity)",
+            "CREATE INDEX IF NOT EXISTS idx_user_facts_active ON user_facts(user_id, is_active)",
+        ])
+
+    @staticmethod
+    def _row_to_fact(row: sqlite3.Row) -> UserFact:
+        fact_dict = dict(row)
+        if fact_dict.get("related_fact_ids"):
+            try:
+                fact_dict["related_fact_ids"] = json.loads(fact_dict["related_fact_ids"])
+            except Exception:
+                fact_dict["related_fact_ids"] = None
+        else:
+            fact_dict["related_fact_ids"] = None
+        fact_dict["is_active"] = bool(fact_dict["is_active"])
+        return UserFact(**fact_dict)
 
-    def _get_connection(self) -> sqlite3.Connection:
-        """Get a database connection."""
-        return sqlite3.connect(self.db_path, check_same_thread=False)
+    def close(self) -> None:
+        """Release the shared storage engine reference."""
+        db, self._db = self._db, None
+        if db is not None:
+            db.release()
 
     def add_fact(
         self,
@@ -91,12 +98,11 @@ class FactMemoryService:
         related_fact_ids: Optional[List[int]] = None,
     ) -> int:
         """Add a new fact about a user."""
-        conn = self._get_connection()
         now = datetime.datetime.now().isoformat()
 
         related_ids_json = json.dumps(related_fact_ids) if related_fact_ids else None
 
-        cursor = conn.execute(
+        return self._db.write(
             """
             INSERT INTO user_facts 
             (user_id, fact_text, category, entity, confidence, source, context,
@@ -116,11 +122,7 @@ class FactMemoryService:
                 1,
                 related_ids_json,
             ),
-        )
-        fact_id = cursor.lastrowid
-        conn.commit()
-        conn.close()
-        return fact_id
+        ).lastrowid
 
     def get_facts(
         self,
@@ -132,7 +134,6 @@ class FactMemoryService:
         limit: Optional[int] = None,
     ) -> List[UserFact]:
         """Retrieve facts for a user with optional filtering."""
-        conn = self._get_connection()
 
         query = "SELECT * FROM user_facts WHERE user_id = ?"
         params: List[Any] = [user_id]
@@ -152,27 +153,7 @@ class FactMemoryService:
             query += " LIMIT ?"
             params.append(limit)
 
-        cursor = conn.execute(query, params)
-        rows = cursor.fetchall()
-
-        facts = []
-        columns = [desc[0] for desc in cursor.description]
-        for row in rows:
-            fact_dict = dict(zip(columns, row))
-            if fact_dict.get("related_fact_ids"):
-                try:
-                    fact_dict["related_fact_ids"] = json.loads(
-                        fact_dict["related_fact_ids"]
-                    )
-                except Exception:
-                    fact_dict["related_fact_ids"] = None
-            else:
-                fact_dict["related_fact_ids"] = None
-            fact_dict["is_active"] = bool(fact_dict["is_active"])
-            facts.append(UserFact(**fact_dict))
-
-        conn.close()
-        return facts
+        return [self._row_to_fact(row) for row in self._db.fetchall(query, params)]
 
     def search_facts(
         self,
@@ -182,7 +163,6 @@ class FactMemoryService:
         limit: int = 10,
     ) -> List[UserFact]:
         """Search facts by text content."""
-        conn = self._get_connection()
 
         sql_query = """
             SELECT * FROM user_facts 
@@ -199,25 +179,7 @@ class FactMemoryService:
         sql_query += " ORDER BY confidence DESC, created_at DESC LIMIT ?"
         params.append(limit)
 
-        cursor = conn.execute(sql_query, params)
-        rows = cursor.fetchall()
-
-        facts = []
-        columns = [desc[0] for desc in cursor.description]
-        for row in rows:
-            fact_dict = dict(zip(columns, row))
-            if fact_dict.get("related_fact_ids"):
-                try:
-                    fact_dict["related_fact_ids"] = json.loads(
-                        fact_dict["related_fact_ids"]
-                    )
-                except Exception:
-                    fact_dict["related_fact_ids"] = None
-            fact_dict["is_active"] = bool(fact_dict["is_active"])
-            facts.append(UserFact(**fact_dict))
-
-        conn.close()
-        return facts
+        return [self._row_to_fact(row) for row in self._db.fetchall(sql_query, params)]
 
     def update_fact(
         self,
@@ -228,7 +190,6 @@ class FactMemoryService:
         context: Optional[str] = None,
     ) -> bool:
         """Update an existing fact."""
-        conn = self._get_connection()
 
         updates = []
         params = []
@@ -251,23 +212,18 @@ class FactMemoryService:
             params.append(datetime.datetime.now().isoformat())
             params.append(fact_id)
 
-            conn.execute(
+            self._db.write(
                 f"UPDATE user_facts SET {', '.join(updates)} WHERE id = ?", params
             )
-            conn.commit()
 
-        conn.close()
         return len(updates) > 0
 
     def deactivate_fact(self, fact_id: int) -> bool:
         """Mark a fact as inactive (soft delete)."""
-        conn = self._get_connection()
-        conn.execute(
+        self._db.write(
             "UPDATE user_facts SET is_active = 0, updated_at = ? WHERE id = ?",
             (datetime.datetime.now().isoformat(), fact_id),
         )
-        conn.commit()
-        conn.close()
         return True
 
     def check_conflicts(
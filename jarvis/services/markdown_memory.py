@@ -18,6 +18,8 @@ from pathlib import Path
 from typing import Any, Dict, List, Optional, Tuple
 from uuid import uuid4
 
+from ..storage import StartupSnapshot, content_digest
+
 
 # ---------------------------------------------------------------------------
 # Constants
@@ -25,6 +27,7 @@ from uuid import uuid4
 
 DEFAULT_VAULT_DIR = os.path.join(str(Path.home()), ".jarvis", "memory")
 SHORT_TERM_TTL_DAYS = 7
+INDEX_SNAPSHOT_SECTION = "vault_indexes"
 
 BUILTIN_CATEGORIES = [
     "personal",
@@ -144,6 +147,7 @@ class MarkdownMemoryService:
         short_term_ttl_days: int = SHORT_TERM_TTL_DAYS,
         auto_promote: bool = True,
         ai_client: Optional[Any] = None,
+        snapshot: Optional[StartupSnapshot] = None,
     ) -> None:
         self.vault_dir = Path(vault_dir or DEFAULT_VAULT_DIR)
         self.short_term_dir = self.vault_dir / "short_term"
@@ -155,6 +159,7 @@ class MarkdownMemoryService:
         self.short_term_ttl_days = short_term_ttl_days
         self.auto_promote = auto_promote
         self.ai_client = ai_client
+        self._snapshot = snapshot
 
         # In-memory index cache
         self._index = VaultIndex()
@@ -646,14 +651,39 @@ class MarkdownMemoryService:
     # ------------------------------------------------------------------
 
     def _load_indexes(self) -> None:
-        """Load index files into the in-memory cache on startup."""
-        topic_file = self.index_dir / "topic_index.md"
-        if topic_file.exists():
-            self._parse_index_file(topic_file.read_text(), self._index.topic_map)
+        """Load index files into the in-memory cache on startup.
 
+        The parsed maps are kept in the startup snapshot keyed by the raw
+        index file contents, so an unchanged vault skips the line parse.
+        """
+        topic_file = self.index_dir / "topic_index.md"
         entity_file = self.index_dir / "entity_index.md"
-        if entity_file.exists():
-            self._parse_index_file(entity_file.read_text(), self._index.entity_map)
+        topic_raw = topic_file.read_bytes() if topic_file.exists() else None
+        entity_raw = entity_file.read_bytes() if entity_file.exists() else None
+
+        digest = None
+        if self._snapshot is not None:
+            digest = content_digest(str(self.vault_dir), topic_raw, entity_raw)
+            cached = self._snapshot.get(INDEX_SNAPSHOT_SECTION, digest)
+            if cached is not None:
+                self._index.topic_map.update(cached["topic_map"])
+                self._index.entity_map.update(cached["entity_map"])
+                return
+
+        if topic_raw is not None:
+            self._parse_index_file(topic_raw.decode(), self._index.topic_map)
+        if entity_raw is not None:
+            self._parse_index_file(entity_raw.decode(), self._index.entity_map)
+
+        if digest is not None:
+            self._snapshot.put(
+                INDEX_SNAPSHOT_SECTION,
+                digest,
+                {
+                    "topic_map": dict(self._index.topic_map),
+                    "entity_map": dict(self._index.entity_map),
+                },
+            )
 
     def _parse_index_file(
         self, content: str, target_map: Dict[str, List[Tuple[str, str]]]
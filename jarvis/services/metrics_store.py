@@ -1,7 +1,13 @@
 """SQLite-backed time-series metrics store for device monitoring.
 
-Stores raw metrics at full resolution (24h retention) and hourly rollups
-(30-day retention). WAL mode for concurrent reads, thread-safe via RLock.
+Stores raw metrics at full resolution (24h retention) plus minute (7-day),
+hourly (30-day) and daily (1-year) rollups.  The rollups are kept up as
+samples arrive, in the same write as the raw rows, so reads never have to
+aggregate.  :meth:`MetricsStore.history` serves a time range from the
+coarsest tier that still yields ``limit`` points and LTTB-downsamples
+what is left over, narrowing very long ranges to per-bin min/max
+candidates in SQL first.  Storage goes through the shared
+:class:`~jarvis.storage.StorageEngine` (single writer, WAL read pool).
 All data persisted locally in ~/.jarvis/device_metrics.db.
 """
 
@@ -9,12 +15,14 @@ from __future__ import annotations
 
 import json
 import sqlite3
-import threading
+from collections import defaultdict
+from dataclasses import dataclass
 from datetime import datetime, timedelta, timezone
 from pathlib import Path
-from typing import Any, Dict, List, Optional
+from typing import Any, Callable, Dict, List, Optional, Sequence, Tuple, TypeVar
 
 from ..logging import JarvisLogger
+from ..storage import StorageEngine
 
 DB_DIR = Path.home() / ".jarvis"
 DB_PATH = DB_DIR / "device_metrics.db"
@@ -56,6 +64,126 @@ CREATE TABLE IF NOT EXISTS metrics_hourly (
 );
 """
 
+_CREATE_MINUTE = """
+CREATE TABLE IF NOT EXISTS metrics_minute (
+    minute       TEXT NOT NULL,
+    component    TEXT NOT NULL,
+    metric_name  TEXT NOT NULL,
+    min_value    REAL,
+    max_value    REAL,
+    avg_value    REAL,
+    sample_count INTEGER,
+    PRIMARY KEY(component, metric_name, minute)
+) WITHOUT ROWID;
+"""
+
+_CREATE_DAILY = """
+CREATE TABLE IF NOT EXISTS metrics_daily (
+    day          TEXT NOT NULL,
+    component    TEXT NOT NULL,
+    metric_name  TEXT NOT NULL,
+    min_value    REAL,
+    max_value    REAL,
+    avg_value    REAL,
+    sample_count INTEGER,
+    PRIMARY KEY(component, metric_name, day)
+) WITHOUT ROWID;
+"""
+
+# Covering index so history reads never visit the rowid table
+_CREATE_HOURLY_IDX = """
+CREATE INDEX IF NOT EXISTS idx_metrics_hourly_series
+ON metrics_hourly(component, metric_name, hour, avg_value, min_value, max_value, sample_count);
+"""
+
+RAW_RETENTION = timedelta(hours=24)
+
+# Ranges with more than this many buckets per requested point are
+# narrowed down in SQL before LTTB
+PRESELECT_RATIO = 2
+
+# ISO timestamp prefix lengths and the width in seconds of the bins they
+# make: minute, 10 minutes, hour, 10 hours, day, 10 days, month
+_PREFIX_BINS: Tuple[Tuple[int, int], ...] = (
+    (16, 60), (15, 600), (13, 3600), (12, 36000), (10, 86400), (9, 864000), (7, 2678400),
+)
+
+T = TypeVar("T")
+
+
+@dataclass(frozen=True)
+class RollupTier:
+    """One rollup table: bucket width, key format and retention."""
+
+    name: str
+    table: str
+    column: str
+    seconds: int
+    prefix_len: int  # characters of an ISO timestamp that identify the bucket
+    suffix: str
+    retention: timedelta
+
+    def bucket(self, timestamp: str) -> str:
+        return timestamp[: self.prefix_len] + self.suffix
+
+    @property
+    def upsert_sql(self) -> str:
+        return f"""INSERT INTO {self.table}
+           ({self.column}, component, metric_name, min_value, max_value, avg_value, sample_count)
+           VALUES (?, ?, ?, ?, ?, ?, ?)
+           ON CONFLICT({self.column}, component, metric_name) DO UPDATE SET
+               min_value    = MIN(excluded.min_value, {self.table}.min_value),
+               max_value    = MAX(excluded.max_value, {self.table}.max_value),
+               avg_value    = (excluded.avg_value * excluded.sample_count
+                              + {self.table}.avg_value * {self.table}.sample_count)
+                             / (excluded.sample_count + {self.table}.sample_count),
+               sample_count = excluded.sample_count + {self.table}.sample_count"""
+
+
+TIERS: Tuple[RollupTier, ...] = (
+    RollupTier("minute", "metrics_minute", "minute", 60, 16, ":00", timedelta(days=7)),
+    RollupTier("hour", "metrics_hourly", "hour", 3600, 13, ":00:00", timedelta(days=30)),
+    RollupTier("day", "metrics_daily", "day", 86400, 10, "T00:00:00", timedelta(days=365)),
+)
+
+
+# Seconds since the epoch, computed by SQLite so reads skip Python date parsing
+_EPOCH_SQL = "(julianday({}) - 2440587.5) * 86400.0"
+
+
+def lttb_indices(xs: Sequence[float], ys: Sequence[float], threshold: int) -> List[int]:
+    """Largest-Triangle-Three-Buckets downsampling.
+
+    Returns the indices of *threshold* points that best preserve the
+    visual shape of the series; the first and last points are always kept.
+    """
+    n = len(xs)
+    if threshold >= n:
+        return list(range(n))
+    if threshold < 3:
+        return [0, n - 1][: max(threshold, 0)]
+
+    every = (n - 2) / (threshold - 2)
+    selected = [0]
+    a = 0
+    for i in range(threshold - 2):
+        avg_start = int((i + 1) * every) + 1
+        avg_end = min(int((i + 2) * every) + 1, n)
+        span = avg_end - avg_start
+        avg_x = sum(xs[avg_start:avg_end]) / span
+        avg_y = sum(ys[avg_start:avg_end]) / span
+
+        ax, ay = xs[a], ys[a]
+        best, best_area = -1, -1.0
+        for j in range(int(i * every) + 1, int((i + 1) * every) + 1):
+            area = abs((ax - avg_x) * (ys[j] - ay) - (ax - xs[j]) * (avg_y - ay))
+            if area > best_area:
+                best, best_area = j, area
+        selected.append(best)
+        a = best
+    selected.append(n - 1)
+    return selected
+
 
 class MetricsStore:
     """Thread-safe SQLite store for device metrics with automatic rollup."""
@@ -68,46 +196,64 @@ class MetricsStore:
         self.logger = logger or JarvisLogger()
         self._db_path = Path(db_path) if db_path else DB_PATH
         self._db_path.parent.mkdir(parents=True, exist_ok=True)
-        self._lock = threading.RLock()
-        self._conn = sqlite3.connect(str(self._db_path), check_same_thread=False)
-        self._conn.row_factory = sqlite3.Row
-        self._conn.execute("PRAGMA journal_mode=WAL")
-        self._conn.execute(_CREATE_METRICS)
-        self._conn.execute(_CREATE_METRICS_IDX_COMPONENT)
-        self._conn.execute(_CREATE_METRICS_IDX_NAME)
-        self._conn.execute(_CREATE_HOURLY)
-        self._conn.commit()
+        self._db = StorageEngine.open(self._db_path)
+        needs_backfill = self._db.fetchone(
+            "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'metrics_daily'"
+        ) is None
+        self._db.write_script([
+            _CREATE_METRICS,
+            _CREATE_METRICS_IDX_COMPONENT,
+            _CREATE_METRICS_IDX_NAME,
+            _CREATE_HOURLY,
+            _CREATE_HOURLY_IDX,
+            _CREATE_MINUTE,
+            _CREATE_DAILY,
+        ])
+        if needs_backfill:
+            self._db.call(self._backfill_tiers)
+
+    async def run(self, fn: Callable[..., T], *args: Any, **kwargs: Any) -> T:
+        """Await a store method off the event loop, on the read pool."""
+        return await self._db.arun(fn, *args, **kwargs)
 
     # ------------------------------------------------------------------
     # Write
     # ------------------------------------------------------------------
 
     def record_batch(self, rows: List[Dict[str, Any]]) -> int:
-        """Bulk-insert metric rows. Returns count inserted."""
+        """Bulk-insert metric rows and fold them into every rollup tier.
+
+        Returns count inserted.
+        """
         if not rows:
             return 0
 
-        with self._lock:
-            values = [
-                (
-                    row["timestamp"],
-                    row["component"],
-                    row["metric_name"],
-                    row["value"],
-                    row.get("unit", ""),
-                    row.get("severity", "ok"),
-                    json.dumps(row.get("metadata", {})),
-                )
-                for row in rows
-            ]
-            self._conn.executemany(
+        values = [
+            (
+                row["timestamp"],
+                row["component"],
+                row["metric_name"],
+                row["value"],
+                row.get("unit", ""),
+                row.get("severity", "ok"),
+                json.dumps(row.get("metadata", {})),
+            )
+            for row in rows
+        ]
+        rollups = [(tier.upsert_sql, self._rollup(tier, values)) for tier in TIERS]
+
+        def run(conn: sqlite3.Connection) -> None:
+            conn.executemany(
                 """INSERT INTO metrics
                    (timestamp, component, metric_name, value, unit, severity, metadata)
                    VALUES (?, ?, ?, ?, ?, ?, ?)""",
                 values,
             )
-            self._conn.commit()
-            count = len(values)
+            for sql, buckets in rollups:
+                conn.executemany(sql, buckets)
+
+        self._db.call(run)
+        count = len(values)
 
         self.logger.log("DEBUG", "MetricsStore", f"Recorded {count} metric(s)")
         return count
@@ -141,8 +287,7 @@ class MetricsStore:
         sql += " ORDER BY timestamp DESC LIMIT ?"
         params.append(limit)
 
-        with self._lock:
-            rows = self._conn.execute(sql, params).fetchall()
+        rows = self._db.fetchall(sql, params)
 
         return [self._row_to_dict(r) for r in rows]
 
@@ -161,8 +306,7 @@ class MetricsStore:
 
         sql += " ORDER BY timestamp DESC LIMIT 1"
 
-        with self._lock:
-            row = self._conn.execute(sql, params).fetchone()
+        row = self._db.fetchone(sql, params)
 
         return self._row_to_dict(row) if row else None
 
@@ -193,8 +337,7 @@ class MetricsStore:
 
         sql += " ORDER BY hour DESC"
 
-        with self._lock:
-            rows = self._conn.execute(sql, params).fetchall()
+        rows = self._db.fetchall(sql, params)
 
         return [
             {
@@ -209,76 +352,181 @@ class MetricsStore:
             for r in rows
         ]
 
+    # ------------------------------------------------------------------
+    # Read — tiered history
+    # ------------------------------------------------------------------
+
+    @staticmethod
+    def pick_tier(
+        start: datetime,
+        end: datetime,
+        limit: int,
+        raw: bool = True,
+        now: Optional[datetime] = None,
+    ) -> Optional[RollupTier]:
+        """Choose the tier to serve ``[start, end]`` with about *limit* points.
+
+        Only tiers whose retention still reaches *start* are considered;
+        of those the coarsest one that still has at least *limit* buckets
+        in the range wins, falling back to the finest.  ``None`` means
+        raw samples.
+        """
+        now = now or datetime.now(timezone.utc)
+        span = max((end - start).total_seconds(), 0.0)
+        # A bucket of slack so "the last 30 days" still counts as covered by
+        # a 30-day tier
+        candidates: List[Tuple[Optional[RollupTier], timedelta]] = (
+            [(None, RAW_RETENTION + timedelta(minutes=1))] if raw else []
+        )
+        candidates += [(tier, tier.retention + timedelta(seconds=tier.seconds)) for tier in TIERS]
+        covering = [tier for tier, horizon in candidates if start >= now - horizon]
+        if not covering:
+            return TIERS[-1]
+
+        chosen = covering[0]
+        for tier in covering[1:]:
+            if span / tier.seconds < limit:
+                break
+            chosen = tier
+        return chosen
+
+    def history(
+        self,
+        component: str,
+        metric_name: Optional[str] = None,
+        start: Optional[str] = None,
+        end: Optional[str] = None,
+        limit: int = 1000,
+        raw: bool = True,
+    ) -> Dict[str, Any]:
+        """Time-ordered history for a component, at most *limit* points per metric.
+
+        Each point carries ``value`` (the bucket average for rollups) plus
+        ``min``/``max``/``count``.  Set *raw* to False to serve rollups only.
+        """
+        now = datetime.now(timezone.utc)
+        end_dt = datetime.fromisoformat(end) if end else now
+        start_dt = datetime.fromisoformat(start) if start else end_dt - timedelta(hours=24)
+        if end_dt.tzinfo is None:
+            end_dt = end_dt.replace(tzinfo=timezone.utc)
+        if start_dt.tzinfo is None:
+            start_dt = start_dt.replace(tzinfo=timezone.utc)
+        tier = self.pick_tier(start_dt, end_dt, limit, raw=raw, now=now)
+
+        if tier is None:
+            column, table = "timestamp", "metrics"
+            fields = "value AS v, value AS lo, value AS hi, 1 AS n"
+            bounds = [start_dt.isoformat(), end_dt.isoformat()]
+        else:
+            column, table = tier.column, tier.table
+            fields = "avg_value AS v, min_value AS lo, max_value AS hi, sample_count AS n"
+            # Bucket keys are naive UTC, so compare against the same format
+            bounds = [
+                tier.bucket(start_dt.astimezone(timezone.utc).isoformat()),
+                end_dt.astimezone(timezone.utc).isoformat()[:19],
+            ]
+        where = f"WHERE component = ? AND {column} >= ? AND {column} <= ?"
+        params: List[Any] = [component, *bounds]
+        if metric_name is not None:
+            where += " AND metric_name = ?"
+            params.append(metric_name)
+
+        span = (end_dt - start_dt).total_seconds()
+        if tier is not None and span / tier.seconds > PRESELECT_RATIO * limit:
+            # MinMax preselection: keep only the lowest and highest bucket
+            # of each bin in SQL, so LTTB runs on about 2 * limit candidates
+            # instead of every bucket in the range.  Bins are timestamp
+            # prefixes, which SQLite can group on without parsing dates.
+            prefix = _PREFIX_BINS[0][0]
+            for n, width in _PREFIX_BINS:
+                if width > span / limit:
+                    break
+                prefix = n
+            # SQLite fills bare columns from the row holding the MIN()/MAX()
+            picks = [
+                f"SELECT {column} AS ts, metric_name, {agg}(avg_value) AS v, min_value AS lo, "
+                f"max_value AS hi, sample_count AS n "
+                f"FROM {table} {where} GROUP BY metric_name, substr({column}, 1, {prefix})"
+                for agg in ("MIN", "MAX")
+            ]
+            sql = (
+                f"SELECT ts, {_EPOCH_SQL.format('ts')} AS x, metric_name, v, lo, hi, n "
+                f"FROM ({' UNION '.join(picks)})"
+            )
+            params += params
+        else:
+            sql = (
+                f"SELECT {column} AS ts, {_EPOCH_SQL.format(column)} AS x, metric_name, {fields} "
+                f"FROM {table} {where}"
+            )
+        # Metric-major order follows the tier primary keys
+        sql += " ORDER BY metric_name, ts"
+
+        series: Dict[str, List[sqlite3.Row]] = defaultdict(list)
+        for row in self._db.fetchall(sql, params):
+            series[row["metric_name"]].append(row)
+
+        data: List[Dict[str, Any]] = []
+        downsampled = False
+        for name, rows in series.items():
+            if len(rows) > limit:
+                keep = lttb_indices([r["x"] for r in rows], [r["v"] for r in rows], limit)
+                rows = [rows[i] for i in keep]
+                downsampled = True
+            data.extend(
+                {
+                    "timestamp": r["ts"],
+                    "metric_name": name,
+                    "value": r["v"],
+                    "min": r["lo"],
+                    "max": r["hi"],
+                    "count": r["n"],
+                }
+                for r in rows
+            )
+        if len(series) > 1:
+            data.sort(key=lambda p: p["timestamp"])
+
+        return {
+            "resolution": tier.name if tier else "raw",
+            "start": start_dt.isoformat(),
+            "end": end_dt.isoformat(),
+            "downsampled": downsampled,
+            "data": data,
+        }
+
     # ------------------------------------------------------------------
     # Maintenance
     # ------------------------------------------------------------------
 
     def compact(self, retention_hours: int = 24) -> Dict[str, int]:
-        """Aggregate raw metrics older than *retention_hours* into hourly
-        rollups, then delete those raw rows.
+        """Purge raw metrics older than *retention_hours* and rollups past
+        their tier's retention.
 
-        Returns ``{"aggregated": N, "deleted": M}``.
+        The rollups already cover every raw row, so nothing has to be
+        aggregated here.  Returns ``{"deleted": N, "pruned": M}`` with the
+        raw and rollup row counts removed.
         """
-        cutoff = (
-            datetime.now(timezone.utc) - timedelta(hours=retention_hours)
-        ).isoformat()
-
-        with self._lock:
-            # Build hourly aggregates from raw rows older than the cutoff
-            agg_rows = self._conn.execute(
-                """SELECT
-                       strftime('%%Y-%%m-%%dT%%H:00:00', timestamp) AS hour,
-                       component,
-                       metric_name,
-                       MIN(value)   AS min_value,
-                       MAX(value)   AS max_value,
-                       AVG(value)   AS avg_value,
-                       COUNT(*)     AS sample_count
-                   FROM metrics
-                   WHERE timestamp < ?
-                   GROUP BY hour, component, metric_name""",
-                (cutoff,),
-            ).fetchall()
-
-            aggregated = 0
-            for row in agg_rows:
-                self._conn.execute(
-                    """INSERT INTO metrics_hourly
-                       (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
-                       VALUES (?, ?, ?, ?, ?, ?, ?)
-                       ON CONFLICT(hour, component, metric_name) DO UPDATE SET
-                           min_value    = MIN(excluded.min_value, metrics_hourly.min_value),
-                           max_value    = MAX(excluded.max_value, metrics_hourly.max_value),
-                           avg_value    = (excluded.avg_value * excluded.sample_count
-                                          + metrics_hourly.avg_value * metrics_hourly.sample_count)
-                                         / (excluded.sample_count + metrics_hourly.sample_count),
-                           sample_count = excluded.sample_count + metrics_hourly.sample_count
-                    """,
-                    (
-                        row["hour"],
-                        row["component"],
-                        row["metric_name"],
-                        row["min_value"],
-                        row["max_value"],
-                        row["avg_value"],
-                        row["sample_count"],
-                    ),
-                )
-                aggregated += 1
+        now = datetime.now(timezone.utc)
+        cutoff = (now - timedelta(hours=retention_hours)).isoformat()
 
-            # Delete the raw rows we just aggregated
-            cursor = self._conn.execute(
+        with self._db.transaction() as conn:
+            deleted = conn.execute(
                 "DELETE FROM metrics WHERE timestamp < ?", (cutoff,)
-            )
-            deleted = cursor.rowcount
-            self._conn.commit()
+            ).rowcount
+            pruned = 0
+            for tier in TIERS:
+                horizon = tier.bucket((now - tier.retention).isoformat())
+                pruned += conn.execute(
+                    f"DELETE FROM {tier.table} WHERE {tier.column} < ?", (horizon,)
+                ).rowcount
 
         self.logger.log(
             "INFO",
             "MetricsStore",
-            f"Compact: {aggregated} rollup(s), {deleted} raw row(s) purged",
+            f"Compact: {deleted} raw row(s) purged, {pruned} expired rollup(s)",
         )
-        return {"aggregated": aggregated, "deleted": deleted}
+        return {"deleted": deleted, "pruned": pruned}
 
     def cleanup(self, retention_days: int = 30) -> int:
         """Delete hourly rollup rows older than *retention_days*. Returns count deleted."""
@@ -286,12 +534,9 @@ class MetricsStore:
             datetime.now(timezone.utc) - timedelta(days=retention_days)
         ).isoformat()
 
-        with self._lock:
-            cursor = self._conn.execute(
-                "DELETE FROM metrics_hourly WHERE hour < ?", (cutoff,)
-            )
-            deleted = cursor.rowcount
-            self._conn.commit()
+        deleted = self._db.write(
+            "DELETE FROM metrics_hourly WHERE hour < ?", (cutoff,)
+        ).rowcount
 
         self.logger.log(
             "INFO",
@@ -306,16 +551,63 @@ class MetricsStore:
 
     def close(self) -> None:
         """Close the database connection. Safe to call multiple times."""
-        with self._lock:
-            try:
-                self._conn.close()
-            except Exception:
-                pass
+        db, self._db = self._db, None
+        if db is not None:
+            db.release()
 
     # ------------------------------------------------------------------
     # Internal helpers
     # ------------------------------------------------------------------
 
+    @staticmethod
+    def _rollup(tier: RollupTier, values: List[Tuple[Any, ...]]) -> List[Tuple[Any, ...]]:
+        """Aggregate raw insert tuples into upsert rows for one tier."""
+        buckets: Dict[Tuple[str, str, str], List[float]] = {}
+        for timestamp, component, metric_name, value, *_ in values:
+            key = (tier.bucket(timestamp), component, metric_name)
+            agg = buckets.get(key)
+            if agg is None:
+                buckets[key] = [value, value, value, 1]
+            else:
+                agg[0] = min(agg[0], value)
+                agg[1] = max(agg[1], value)
+                agg[2] += value
+                agg[3] += 1
+        return [
+            (*key, lo, hi, total / n, n)
+            for key, (lo, hi, total, n) in buckets.items()
+        ]
+
+    @staticmethod
+    def _backfill_tiers(conn: sqlite3.Connection) -> None:
+        """Build the minute and daily tiers for a database that predates them.
+
+        Raw rows were only folded into ``metrics_hourly`` when compacted, so
+        the daily tier first takes the existing hourly rollups, then every
+        tier takes the raw rows still present.
+        """
+        daily = TIERS[-1]
+        conn.execute(
+            daily.upsert_sql.replace(
+                "VALUES (?, ?, ?, ?, ?, ?, ?)",
+                f"""SELECT substr(hour, 1, {daily.prefix_len}) || '{daily.suffix}',
+                          component, metric_name, MIN(min_value), MAX(max_value),
+                          SUM(avg_value * sample_count) / SUM(sample_count), SUM(sample_count)
+                   FROM metrics_hourly WHERE true
+                   GROUP BY 1, component, metric_name""",
+            )
+        )
+        for tier in TIERS:
+            conn.execute(
+                tier.upsert_sql.replace(
+                    "VALUES (?, ?, ?, ?, ?, ?, ?)",
+                    f"""SELECT substr(timestamp, 1, {tier.prefix_len}) || '{tier.suffix}',
+                              component, metric_name, MIN(value), MAX(value), AVG(value), COUNT(*)
+                       FROM metrics WHERE true
+                       GROUP BY 1, component, metric_name""",
+                )
+            )
+
     @staticmethod
     def _row_to_dict(row: sqlite3.Row) -> Dict[str, Any]:
         """Convert a raw metrics Row to a plain dict, parsing metadata JSON."""
@@ -0,0 +1,113 @@
+"""Bounded-concurrency scheduling of night-cycle improvement tasks.
+
+Every task runs in its own git worktree, so independent tasks can run
+side by side.  The scheduler admits tasks in priority order while they
+fit the slot budget: a task occupies as many slots as its estimated size
+weighs, and the budget is capped by CPU cores and available memory.  Two
+tasks whose relevant files overlap never run together, so their branches
+do not race for the same lines when they are merged.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import os
+from dataclasses import dataclass, field
+from typing import Any, Awaitable, Callable, Dict, List, Optional
+
+# Slots taken by a task of each estimated size ('large' tasks are skipped)
+TASK_WEIGHTS: Dict[str, int] = {"small": 1, "medium": 2}
+
+# A coding CLI session plus a pytest run in its worktree
+MEMORY_PER_SLOT_MB = 1536
+
+
+@dataclass
+class ScheduledTask:
+    """One unit of work for :class:`NightTaskScheduler`."""
+
+    index: int
+    weight: int = 1
+    files: frozenset[str] = field(default_factory=frozenset)
+
+
+def available_memory_mb() -> Optional[int]:
+    """Available system memory in MB, or ``None`` when it cannot be read."""
+    try:
+        import psutil
+
+        return int(psutil.virtual_memory().available // (1024 ** 2))
+    except ImportError:
+        pass
+    except Exception:
+        return None
+    try:
+        with open("/proc/meminfo") as fh:
+            for line in fh:
+                if line.startswith("MemAvailable:"):
+                    return int(line.split()[1]) // 1024
+    except (OSError, ValueError, IndexError):
+        pass
+    return None
+
+
+def slot_capacity(max_slots: int) -> int:
+    """Slots this host can run at once, at most *max_slots* and at least 1."""
+    slots = min(max_slots, os.cpu_count() or 1)
+    memory = available_memory_mb()
+    if memory is not None:
+        slots = min(slots, memory // MEMORY_PER_SLOT_MB)
+    return max(1, slots)
+
+
+class NightTaskScheduler:
+    """Runs :class:`ScheduledTask` items through a worker within a slot budget.
+
+    Tasks are started in the order given; a task that does not fit yet is
+    passed over for later ones that do, so a medium task waiting for two
+    free slots does not hold back small ones.  A task heavier than the
+    whole budget runs alone.
+    """
+
+    def __init__(self, capacity: int) -> None:
+        self.capacity = max(1, capacity)
+        self.peak_running = 0
+
+    async def run(
+        self,
+        tasks: List[ScheduledTask],
+        worker: Callable[[ScheduledTask], Awaitable[Any]],
+    ) -> Dict[int, Any]:
+        """Run every task and return ``{task.index: worker result}``.
+
+        If the scheduler is cancelled, or a worker raises, the tasks still
+        running are cancelled and awaited before the error propagates.
+        """
+        pending = list(tasks)
+        running: Dict[asyncio.Task, ScheduledTask] = {}
+        results: Dict[int, Any] = {}
+        try:
+            while pending or running:
+                free = self.capacity - sum(
+                    min(t.weight, self.capacity) for t in running.values()
+                )
+                busy_files = frozenset().union(*(t.files for t in running.values()))
+                for task in list(pending):
+                    if min(task.weight, self.capacity) > free or task.files & busy_files:
+                        continue
+                    pending.remove(task)
+                    running[asyncio.create_task(worker(task))] = task
+                    free -= min(task.weight, self.capacity)
+                    busy_files |= task.files
+                self.peak_running = max(self.peak_running, len(running))
+
+                done, _ = await asyncio.wait(running, return_when=asyncio.FIRST_COMPLETED)
+                for future in done:
+                    task = running.pop(future)
+                    results[task.index] = future.result()
+        finally:
+            for future in running:
+                future.cancel()
+            if running:
+                await asyncio.gather(*running, return_exceptions=True)
+        return results
@@ -1,24 +1,32 @@
 """SQLite-backed outcome history for night agent fix attempts.
 
 Records every fix attempt with its result, enabling the intelligence
-layer to learn from past successes and failures. WAL mode for
-concurrent reads, thread-safe via RLock.
+layer to learn from past successes and failures. Storage goes through
+the shared :class:`~jarvis.storage.StorageEngine`.
+
+The same store keeps the weak-model outcomes of the
+:class:`~jarvis.ai_clients.cascade.ModelCascade` per ``(site,
+capability)``, so its routing survives restarts.
 """
 
 from __future__ import annotations
 
 import sqlite3
-import threading
 from dataclasses import dataclass
 from datetime import datetime, timedelta, timezone
 from pathlib import Path
-from typing import Optional
+from typing import Dict, Optional, Tuple
 
 from ..logging import JarvisLogger
+from ..storage import StorageEngine
 
 DB_DIR = Path.home() / ".jarvis"
 DB_PATH = DB_DIR / "outcome_store.db"
 
+# Cascade outcomes older than this are dropped on open; matches the
+# default ``cascade_history`` lookback so nothing read is ever pruned.
+CASCADE_RETENTION_DAYS = 30
+
 _CREATE_TABLE = """
 CREATE TABLE IF NOT EXISTS fix_attempts (
     id               INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -40,6 +48,21 @@ CREATE INDEX IF NOT EXISTS idx_fix_type_time ON fix_attempts(discovery_type, tim
 """
 
 
+_CREATE_CASCADE_TABLE = """
+CREATE TABLE IF NOT EXISTS cascade_outcomes (
+    id          INTEGER PRIMARY KEY AUTOINCREMENT,
+    timestamp   TEXT NOT NULL,
+    site        TEXT NOT NULL,
+    capability  TEXT NOT NULL,
+    outcome     TEXT NOT NULL  -- accepted | escalated | feedback
+);
+"""
+
+_CREATE_CASCADE_INDEX = """
+CREATE INDEX IF NOT EXISTS idx_cascade_time ON cascade_outcomes(timestamp);
+"""
+
+
 @dataclass
 class FixAttempt:
     timestamp: str
@@ -62,65 +85,58 @@ class OutcomeStore:
         self.logger = logger or JarvisLogger()
         self._db_path = Path(db_path) if db_path else DB_PATH
         self._db_path.parent.mkdir(parents=True, exist_ok=True)
-        self._lock = threading.RLock()
-        self._conn = sqlite3.connect(str(self._db_path), check_same_thread=False)
-        self._conn.row_factory = sqlite3.Row
-        self._conn.execute("PRAGMA journal_mode=WAL")
-        self._conn.execute(_CREATE_TABLE)
-        self._conn.execute(_CREATE_INDEX)
-        self._conn.commit()
+        self._db = StorageEngine.open(self._db_path)
+        self._db.write_script(
+            [_CREATE_TABLE, _CREATE_INDEX, _CREATE_CASCADE_TABLE, _CREATE_CASCADE_INDEX]
+        )
+        self.prune_cascade_outcomes()
 
     def record(self, attempt: FixAttempt) -> int:
         """Record a fix attempt. Returns the row ID."""
-        with self._lock:
-            cursor = self._conn.execute(
-                """INSERT INTO fix_attempts
-                   (timestamp, discovery_type, title, file_pattern, diff_summary,
-                    success, error_message, triage_notes, confidence_score, duration_seconds)
-                   VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)""",
-                (
-                    attempt.timestamp,
-                    attempt.discovery_type,
-                    attempt.title,
-                    attempt.file_pattern,
-                    attempt.diff_summary[:2000],  # cap diff summary
-                    int(attempt.success),
-                    attempt.error_message,
-                    attempt.triage_notes,
-                    attempt.confidence_score,
-                    attempt.duration_seconds,
-                ),
-            )
-            self._conn.commit()
-            row_id = cursor.lastrowid
+        row_id = self._db.write(
+            """INSERT INTO fix_attempts
+               (timestamp, discovery_type, title, file_pattern, diff_summary,
+                success, error_message, triage_notes, confidence_score, duration_seconds)
+               VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)""",
+            (
+                attempt.timestamp,
+                attempt.discovery_type,
+                attempt.title,
+                attempt.file_pattern,
+                attempt.diff_summary[:2000],  # cap diff summary
+                int(attempt.success),
+                attempt.error_message,
+                attempt.triage_notes,
+                attempt.confidence_score,
+                attempt.duration_seconds,
+            ),
+        ).lastrowid
         self.logger.log("DEBUG", "OutcomeStore", f"Recorded attempt #{row_id}: {attempt.title}")
         return row_id
 
     def query_similar(self, discovery_type: str, file_patterns: list[str], limit: int = 5) -> list[FixAttempt]:
         """Find past attempts with matching type and overlapping file patterns."""
-        with self._lock:
-            if not file_patterns:
-                rows = self._conn.execute(
-                    "SELECT * FROM fix_attempts WHERE discovery_type = ? ORDER BY timestamp DESC LIMIT ?",
-                    (discovery_type, limit),
-                ).fetchall()
-            else:
-                like_clauses = " OR ".join("file_pattern LIKE ?" for _ in file_patterns)
-                sql = f"SELECT * FROM fix_attempts WHERE discovery_type = ? AND ({like_clauses}) ORDER BY timestamp DESC LIMIT ?"
-                params = [discovery_type] + [f"%{fp}%" for fp in file_patterns] + [limit]
-                rows = self._conn.execute(sql, params).fetchall()
+        if not file_patterns:
+            rows = self._db.fetchall(
+                "SELECT * FROM fix_attempts WHERE discovery_type = ? ORDER BY timestamp DESC LIMIT ?",
+                (discovery_type, limit),
+            )
+        else:
+            like_clauses = " OR ".join("file_pattern LIKE ?" for _ in file_patterns)
+            sql = f"SELECT * FROM fix_attempts WHERE discovery_type = ? AND ({like_clauses}) ORDER BY timestamp DESC LIMIT ?"
+            params = [discovery_type] + [f"%{fp}%" for fp in file_patterns] + [limit]
+            rows = self._db.fetchall(sql, params)
         return [self._row_to_attempt(r) for r in rows]
 
     def success_rate(self, discovery_type: str, lookback_days: int = 30) -> float:
         """Return success rate (0.0 - 1.0) for a discovery type over lookback window. Returns 0.0 if no data."""
         cutoff = (datetime.now(timezone.utc) - timedelta(days=lookback_days)).isoformat()
-        with self._lock:
-            row = self._conn.execute(
-                """SELECT COUNT(*) as total, SUM(success) as wins
-                   FROM fix_attempts
-                   WHERE discovery_type = ? AND timestamp >= ?""",
-                (discovery_type, cutoff),
-            ).fetchone()
+        row = self._db.fetchone(
+            """SELECT COUNT(*) as total, SUM(success) as wins
+               FROM fix_attempts
+               WHERE discovery_type = ? AND timestamp >= ?""",
+            (discovery_type, cutoff),
+        )
         total = row["total"] if row else 0
         if total == 0:
             return 0.0
@@ -129,20 +145,50 @@ class OutcomeStore:
 
     def recent_failures(self, n: int = 10) -> list[FixAttempt]:
         """Return the N most recent failed attempts."""
-        with self._lock:
-            rows = self._conn.execute(
-                "SELECT * FROM fix_attempts WHERE success = 0 ORDER BY timestamp DESC LIMIT ?",
-                (n,),
-            ).fetchall()
+        rows = self._db.fetchall(
+            "SELECT * FROM fix_attempts WHERE success = 0 ORDER BY timestamp DESC LIMIT ?",
+            (n,),
+        )
         return [self._row_to_attempt(r) for r in rows]
 
+    def record_cascade_outcome(self, site: str, capability: str, outcome: str) -> None:
+        """Queue one cascade outcome; does not wait for the commit."""
+        self._db.write_nowait(
+            "INSERT INTO cascade_outcomes (timestamp, site, capability, outcome) VALUES (?, ?, ?, ?)",
+            (datetime.now(timezone.utc).isoformat(), site, capability, outcome),
+        )
+
+    def prune_cascade_outcomes(self, retention_days: int = CASCADE_RETENTION_DAYS) -> int:
+        """Delete cascade outcomes older than the retention window; returns rows removed."""
+        cutoff = (datetime.now(timezone.utc) - timedelta(days=retention_days)).isoformat()
+        return self._db.write(
+            "DELETE FROM cascade_outcomes WHERE timestamp < ?", (cutoff,)
+        ).rowcount
+
+    def cascade_history(self, lookback_days: int = CASCADE_RETENTION_DAYS) -> Dict[Tuple[str, str], Tuple[int, int]]:
+        """Return ``{(site, capability): (weak attempts, failures)}`` in the window.
+
+        Failures are escalations plus negative feedback on weak answers.
+        """
+        cutoff = (datetime.now(timezone.utc) - timedelta(days=lookback_days)).isoformat()
+        rows = self._db.fetchall(
+            """SELECT site, capability,
+                      SUM(outcome != 'feedback') AS attempts,
+                      SUM(outcome != 'accepted') AS failures
+               FROM cascade_outcomes
+               WHERE timestamp >= ?
+               GROUP BY site, capability""",
+            (cutoff,),
+        )
+        return {
+            (r["site"], r["capability"]): (r["attempts"] or 0, r["failures"] or 0) for r in rows
+        }
+
     def close(self) -> None:
         """Close the database connection. Safe to call multiple times."""
-        with self._lock:
-            try:
-                self._conn.close()
-            except Exception:
-                pass
+        db, self._db = self._db, None
+        if db is not None:
+            db.release()
 
     @staticmethod
     def _row_to_attempt(row: sqlite3.Row) -> FixAttempt:
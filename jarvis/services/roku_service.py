@@ -77,7 +77,11 @@ class RokuService:
                 "raw_info": info,
             }
         except Exception as e:
-            return {"success": False, "error": f"Failed to get device info: {str(e)}"}
+            return {
+                "success": False,
+                "error": f"Failed to get device info: {str(e)}",
+                "error_type": type(e).__name__,
+            }
 
     async def get_active_app(self) -> Dict[str, Any]:
         """Get the currently active app/channel."""
@@ -98,7 +102,11 @@ class RokuService:
             else:
                 return {"success": True, "app_name": "Home Screen"}
         except Exception as e:
-            return {"success": False, "error": f"Failed to get active app: {str(e)}"}
+            return {
+                "success": False,
+                "error": f"Failed to get active app: {str(e)}",
+                "error_type": type(e).__name__,
+            }
 
     async def list_apps(self) -> Dict[str, Any]:
         """List all installed apps/channels."""
@@ -121,7 +129,11 @@ class RokuService:
 
             return {"success": True, "count": len(apps), "apps": apps}
         except Exception as e:
-            return {"success": False, "error": f"Failed to list apps: {str(e)}"}
+            return {
+                "success": False,
+                "error": f"Failed to list apps: {str(e)}",
+                "error_type": type(e).__name__,
+            }
 
     async def search_app(self, app_name: str) -> Optional[str]:
         """Search for an app by name and return its ID."""
@@ -144,7 +156,11 @@ class RokuService:
             response.raise_for_status()
             return {"success": True, "message": f"Launched app {app_id}"}
         except Exception as e:
-            return {"success": False, "error": f"Failed to launch app: {str(e)}"}
+            return {
+                "success": False,
+                "error": f"Failed to launch app: {str(e)}",
+                "error_type": type(e).__name__,
+            }
 
     async def launch_app_by_name(self, app_name: str) -> Dict[str, Any]:
         """Launch an app by its name."""
@@ -169,7 +185,11 @@ class RokuService:
             response.raise_for_status()
             return {"success": True, "message": f"Pressed key: {key}"}
         except Exception as e:
-            return {"success": False, "error": f"Failed to press key: {str(e)}"}
+            return {
+                "success": False,
+                "error": f"Failed to press key: {str(e)}",
+                "error_type": type(e).__name__,
+            }
 
     async def press_multiple_keys(
         self, keys: List[str], delay_ms: int = 100
@@ -286,7 +306,11 @@ class RokuService:
 
             return {"success": True, "message": f"Searched for: {query}"}
         except Exception as e:
-            return {"success": False, "error": f"Failed to search: {str(e)}"}
+            return {
+                "success": False,
+                "error": f"Failed to search: {str(e)}",
+                "error_type": type(e).__name__,
+            }
 
     async def type_character(self, char: str) -> Dict[str, Any]:
         """Type a single character using the keyboard."""
@@ -301,7 +325,11 @@ class RokuService:
             response.raise_for_status()
             return {"success": True}
         except Exception as e:
-            return {"success": False, "error": str(e)}
+            return {
+                "success": False,
+                "error": str(e),
+                "error_type": type(e).__name__,
+            }
 
     # ==================== PLAYER INFORMATION ====================
 
@@ -352,4 +380,8 @@ class RokuService:
 
             return info
         except Exception as e:
-            return {"success": False, "error": f"Failed to get player info: {str(e)}"}
+            return {
+                "success": False,
+                "error": f"Failed to get player info: {str(e)}",
+                "error_type": type(e).__name__,
+            }
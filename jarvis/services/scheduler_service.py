@@ -6,22 +6,37 @@ schedules. All timestamps stored in UTC; timezone field used only for
 cron local-time computation.
 
 Persistence lives at ~/.jarvis/schedules.db.
+
+Enabled schedules are mirrored in an in-memory min-heap of next-run times,
+loaded at startup and kept in sync by every mutating method, so due-time
+checks never scan the table. Listeners registered with ``add_listener``
+are called whenever the heap changes.
+
+SQLite access goes through the shared :class:`~jarvis.storage.StorageEngine`
+(single writer thread, read pool); async callers should use ``run`` so
+queries never execute on the event loop.
 """
 
 from __future__ import annotations
 
+import heapq
+import itertools
 import sqlite3
+import threading
 import uuid
 from dataclasses import dataclass
 from datetime import datetime, timedelta, timezone
 from enum import Enum
 from pathlib import Path
-from typing import Any, Dict, List, Optional
+from typing import Any, Callable, Dict, List, Optional, Tuple, TypeVar
 from zoneinfo import ZoneInfo
 
 from croniter import croniter
 
 from ..logging import JarvisLogger
+from ..storage import StorageEngine
+
+T = TypeVar("T")
 
 # Module-level UTC reference so methods whose ``timezone`` parameter shadows
 # the stdlib import can still reach UTC without gymnastics.
@@ -117,6 +132,14 @@ CREATE TABLE IF NOT EXISTS schedules (
 );
 """
 
+# (enabled, next_run, id) covers the due-heap load; the others serve the
+# source_agent filter and the default created_at ordering of ``list``.
+_CREATE_INDEXES = (
+    "CREATE INDEX IF NOT EXISTS idx_schedules_enabled_next ON schedules(enabled, next_run, id)",
+    "CREATE INDEX IF NOT EXISTS idx_schedules_source_created ON schedules(source_agent, created_at)",
+    "CREATE INDEX IF NOT EXISTS idx_schedules_created ON schedules(created_at)",
+)
+
 _CREATE_WAKE_ROUTINE_TABLE = """
 CREATE TABLE IF NOT EXISTS wake_routine (
     id           INTEGER PRIMARY KEY DEFAULT 1,
@@ -130,6 +153,14 @@ _DEFAULT_WAKE_ROUTINE = (
 )
 
 
+def _to_timestamp(iso: str) -> float:
+    """Parse an ISO-8601 string to a UTC epoch timestamp (naive = UTC)."""
+    dt = datetime.fromisoformat(iso)
+    if dt.tzinfo is None:
+        dt = dt.replace(tzinfo=_UTC)
+    return dt.timestamp()
+
+
 def _compute_next_cron_run(cron_expression: str, tz_name: str) -> str:
     """Compute the next cron run time and return as ISO-8601 UTC string."""
     tz = ZoneInfo(tz_name)
@@ -151,11 +182,82 @@ class SchedulerService:
         self.logger = logger or JarvisLogger()
         self._db_path = Path(db_path) if db_path else DB_PATH
         self._db_path.parent.mkdir(parents=True, exist_ok=True)
-        self._conn = sqlite3.connect(str(self._db_path))
-        self._conn.row_factory = sqlite3.Row
-        self._conn.execute(_CREATE_TABLE)
-        self._conn.execute(_CREATE_WAKE_ROUTINE_TABLE)
-        self._conn.commit()
+        self._db = StorageEngine.open(self._db_path)
+        self._db.write_script([_CREATE_TABLE, _CREATE_WAKE_ROUTINE_TABLE, *_CREATE_INDEXES])
+
+        # Min-heap of (next_run_ts, seq, id) with lazy deletion: an entry is
+        # live only while _heap_times[id] still equals its timestamp.
+        self._heap: List[Tuple[float, int, str]] = []
+        self._heap_times: Dict[str, float] = {}
+        self._heap_seq = itertools.count()
+        self._heap_lock = threading.Lock()
+        self._listeners: List[Callable[[], None]] = []
+        self._load_heap()
+
+    async def run(self, fn: Callable[..., T], *args: Any, **kwargs: Any) -> T:
+        """Await a service method (or any callable using it) on the DB thread."""
+        return await self._db.arun(fn, *args, **kwargs)
+
+    def batch(self):
+        """Context manager committing all writes inside it as one transaction."""
+        return self._db.transaction()
+
+    def get_db_stats(self) -> Dict[str, Any]:
+        """Statement timings, including time spent blocking an event loop."""
+        return self._db.get_stats()
+
+    # ------------------------------------------------------------------
+    # Due-time heap
+    # ------------------------------------------------------------------
+
+    def _load_heap(self) -> None:
+        rows = self._db.fetchall(
+            "SELECT id, next_run FROM schedules WHERE enabled = 1"
+        )
+        with self._heap_lock:
+            self._heap.clear()
+            self._heap_times.clear()
+            for row in rows:
+                self._push_locked(row["id"], row["next_run"])
+
+    def _push_locked(self, schedule_id: str, next_run: str) -> None:
+        try:
+            ts = _to_timestamp(next_run)
+        except (TypeError, ValueError):
+            self.logger.log("WARNING", "Unparseable next_run", f"{schedule_id}: {next_run}")
+            self._heap_times.pop(schedule_id, None)
+            return
+        if self._heap_times.get(schedule_id) == ts:
+            return  # already live at this time
+        self._heap_times[schedule_id] = ts
+        heapq.heappush(self._heap, (ts, next(self._heap_seq), schedule_id))
+
+    def _sync_heap(self, schedule_id: str, item: Optional[ScheduleItem]) -> None:
+        """Reflect *item*'s current state in the heap and notify listeners."""
+        with self._heap_lock:
+            if item is not None and item.enabled:
+                self._push_locked(item.id, item.next_run)
+            else:
+                self._heap_times.pop(schedule_id, None)
+        for listener in list(self._listeners):
+            try:
+                listener()
+            except Exception as exc:
+                self.logger.log("WARNING", "Schedule listener failed", str(exc))
+
+    def add_listener(self, callback: Callable[[], None]) -> None:
+        """Register *callback* to be invoked whenever due times change."""
+        self._listeners.append(callback)
+
+    def next_due_at(self) -> Optional[float]:
+        """Return the earliest enabled next-run as a UTC epoch timestamp."""
+        with self._heap_lock:
+            while self._heap:
+                ts, _, schedule_id = self._heap[0]
+                if self._heap_times.get(schedule_id) == ts:
+                    return ts
+                heapq.heappop(self._heap)  # stale entry
+        return None
 
     # ------------------------------------------------------------------
     # CRUD
@@ -212,7 +314,7 @@ class SchedulerService:
             updated_at=now,
             created_by=created_by,
         )
-        self._conn.execute(
+        self._db.write(
             """INSERT INTO schedules
                (id, name, schedule_type, cron_expression, interval_seconds,
                 next_run, last_run, request_text, timezone, user_id,
@@ -236,16 +338,16 @@ class SchedulerService:
                 item.created_by,
             ),
         )
-        self._conn.commit()
+        self._sync_heap(item.id, item)
         self.logger.log("INFO", "Schedule created", f"{item.id}: {item.name}")
         return item
 
     def get(self, schedule_id: str) -> Optional[ScheduleItem]:
         """Fetch a single schedule by ID (or partial ID prefix)."""
-        row = self._conn.execute(
+        row = self._db.fetchone(
             "SELECT * FROM schedules WHERE id = ? OR id LIKE ?",
             (schedule_id, f"{schedule_id}%"),
-        ).fetchone()
+        )
         return ScheduleItem.from_row(row) if row else None
 
     def list(
@@ -267,14 +369,23 @@ class SchedulerService:
             query += " AND source_agent = ?"
             params.append(source_agent)
         query += " ORDER BY created_at DESC"
-        rows = self._conn.execute(query, params).fetchall()
+        rows = self._db.fetchall(query, params)
         return [ScheduleItem.from_row(r) for r in rows]
 
     def update(self, schedule_id: str, **fields: Any) -> Optional[ScheduleItem]:
         """Update fields on an existing schedule. Returns the updated item."""
+        with self._db.transaction():
+            item, updated = self._update_locked(schedule_id, fields)
+        if item is not None and updated is not item:
+            self._sync_heap(item.id, updated)
+        return updated
+
+    def _update_locked(
+        self, schedule_id: str, fields: Dict[str, Any]
+    ) -> Tuple[Optional[ScheduleItem], Optional[ScheduleItem]]:
         item = self.get(schedule_id)
         if not item:
-            return None
+            return None, None
 
         allowed = {
             "name", "schedule_type", "cron_expression", "interval_seconds",
@@ -292,25 +403,23 @@ class SchedulerService:
                 updates[key] = value
 
         if not updates:
-            return item
+            return item, item
 
         updates["updated_at"] = datetime.now(tz=_UTC).isoformat()
         set_clause = ", ".join(f"{k} = ?" for k in updates)
         values = list(updates.values()) + [item.id]
-        self._conn.execute(
-            f"UPDATE schedules SET {set_clause} WHERE id = ?", values
-        )
-        self._conn.commit()
+        self._db.write(f"UPDATE schedules SET {set_clause} WHERE id = ?", values)
         self.logger.log("INFO", "Schedule updated", f"{item.id}")
-        return self.get(item.id)
+        return item, self.get(item.id)
 
     def delete(self, schedule_id: str) -> bool:
         """Delete a schedule. Returns True if a row was removed."""
-        item = self.get(schedule_id)
-        if not item:
-            return False
-        self._conn.execute("DELETE FROM schedules WHERE id = ?", (item.id,))
-        self._conn.commit()
+        with self._db.transaction():
+            item = self.get(schedule_id)
+            if not item:
+                return False
+            self._db.write("DELETE FROM schedules WHERE id = ?", (item.id,))
+        self._sync_heap(item.id, None)
         self.logger.log("INFO", "Schedule deleted", f"{item.id}: {item.name}")
         return True
 
@@ -327,12 +436,30 @@ class SchedulerService:
     # ------------------------------------------------------------------
 
     def get_due_schedules(self) -> List[ScheduleItem]:
-        """Return all enabled schedules whose next_run is at or before now UTC."""
-        now = datetime.now(tz=_UTC).isoformat()
-        rows = self._conn.execute(
-            "SELECT * FROM schedules WHERE enabled = 1 AND next_run <= ?",
-            (now,),
-        ).fetchall()
+        """Return all enabled schedules whose next_run is at or before now UTC.
+
+        Reads the due-time heap, so only due rows are fetched from SQLite.
+        Entries stay in the heap until ``mark_fired`` (or another update)
+        moves them.
+        """
+        now = datetime.now(tz=_UTC).timestamp()
+        due_ids: List[str] = []
+        with self._heap_lock:
+            popped: List[Tuple[float, int, str]] = []
+            while self._heap and self._heap[0][0] <= now:
+                entry = heapq.heappop(self._heap)
+                if self._heap_times.get(entry[2]) == entry[0]:
+                    popped.append(entry)
+                    due_ids.append(entry[2])
+            for entry in popped:
+                heapq.heappush(self._heap, entry)
+        if not due_ids:
+            return []
+        placeholders = ", ".join("?" for _ in due_ids)
+        rows = self._db.fetchall(
+            f"SELECT * FROM schedules WHERE id IN ({placeholders}) AND enabled = 1",
+            due_ids,
+        )
         return [ScheduleItem.from_row(r) for r in rows]
 
     def mark_fired(self, schedule_id: str) -> Optional[ScheduleItem]:
@@ -343,6 +470,22 @@ class SchedulerService:
         - INTERVAL: next_run = now + interval_seconds.
         Always sets last_run to now.
         """
+        with self._db.transaction():
+            fired = self._mark_fired_locked(schedule_id)
+        if fired is not None:
+            self._sync_heap(fired.id, fired)
+        return fired
+
+    def mark_fired_many(self, schedule_ids: List[str]) -> List[ScheduleItem]:
+        """``mark_fired`` for several schedules, committed as one transaction."""
+        with self._db.transaction():
+            fired = [self._mark_fired_locked(schedule_id) for schedule_id in schedule_ids]
+        fired = [item for item in fired if item is not None]
+        for item in fired:
+            self._sync_heap(item.id, item)
+        return fired
+
+    def _mark_fired_locked(self, schedule_id: str) -> Optional[ScheduleItem]:
         item = self.get(schedule_id)
         if not item:
             return None
@@ -351,24 +494,29 @@ class SchedulerService:
         now_iso = now.isoformat()
 
         if item.schedule_type == ScheduleType.ONCE:
-            self._conn.execute(
+            self._db.write(
                 "UPDATE schedules SET enabled = 0, last_run = ?, updated_at = ? WHERE id = ?",
                 (now_iso, now_iso, item.id),
             )
         elif item.schedule_type == ScheduleType.CRON and item.cron_expression:
             next_run = _compute_next_cron_run(item.cron_expression, item.timezone)
-            self._conn.execute(
+            self._db.write(
                 "UPDATE schedules SET next_run = ?, last_run = ?, updated_at = ? WHERE id = ?",
                 (next_run, now_iso, now_iso, item.id),
             )
         elif item.schedule_type == ScheduleType.INTERVAL and item.interval_seconds:
             next_run = (now + timedelta(seconds=item.interval_seconds)).isoformat()
-            self._conn.execute(
+            self._db.write(
                 "UPDATE schedules SET next_run = ?, last_run = ?, updated_at = ? WHERE id = ?",
                 (next_run, now_iso, now_iso, item.id),
             )
+        else:
+            # No way to compute a next run; disable rather than re-fire forever
+            self._db.write(
+                "UPDATE schedules SET enabled = 0, last_run = ?, updated_at = ? WHERE id = ?",
+                (now_iso, now_iso, item.id),
+            )
 
-        self._conn.commit()
         self.logger.log("INFO", "Schedule fired", f"{item.id}: {item.name}")
         return self.get(item.id)
 
@@ -378,21 +526,20 @@ class SchedulerService:
 
     def get_wake_routine(self) -> str:
         """Return the current wake routine text, or the default if none set."""
-        row = self._conn.execute(
+        row = self._db.fetchone(
             "SELECT routine_text FROM wake_routine WHERE id = 1"
-        ).fetchone()
+        )
         return row["routine_text"] if row else _DEFAULT_WAKE_ROUTINE
 
     def set_wake_routine(self, routine_text: str) -> str:
         """Store a new wake routine text. Returns the saved text."""
         now = datetime.now(tz=_UTC).isoformat()
-        self._conn.execute(
+        self._db.write(
             """INSERT INTO wake_routine (id, routine_text, updated_at)
                VALUES (1, ?, ?)
                ON CONFLICT(id) DO UPDATE SET routine_text = ?, updated_at = ?""",
             (routine_text, now, routine_text, now),
         )
-        self._conn.commit()
         self.logger.log("INFO", "Wake routine updated", routine_text[:80])
         return routine_text
 
@@ -401,4 +548,7 @@ class SchedulerService:
     # ------------------------------------------------------------------
 
     def close(self) -> None:
-        self._conn.close()
+        """Close the database connection. Safe to call multiple times."""
+        db, self._db = self._db, None
+        if db is not None:
+            db.release()
@@ -1,8 +1,12 @@
 from __future__ import annotations
 
+import asyncio
 import os
+import re
+import time
+from collections import OrderedDict
 from pathlib import Path
-from typing import Any, Dict, Optional
+from typing import Any, Dict, Optional, Set, Tuple
 import httpx
 
 from ..logging import JarvisLogger
@@ -10,6 +14,69 @@ from ..logging import JarvisLogger
 # Scopes required for Custom Search API
 _SEARCH_SCOPES = ["https://www.googleapis.com/auth/cse"]
 
+# Queries whose answers go out of date within minutes
+_VOLATILE_RE = re.compile(
+    r"\b(weather|forecast|news|headlines?|today|tonight|now|latest|current|live"
+    r"|score|scores|stocks?|price|traffic)\b"
+)
+
+
+class SearchResultCache:
+    """LRU cache of successful search results keyed by normalized query.
+
+    An entry is fresh for ``ttl`` seconds and may then be served stale for
+    up to ``stale_ttl`` more while the caller refreshes it in the
+    background.  Time-sensitive queries use ``volatile_ttl`` for both.
+    """
+
+    def __init__(
+        self,
+        ttl: float = 3600.0,
+        stale_ttl: float = 86400.0,
+        volatile_ttl: float = 300.0,
+        max_size: int = 256,
+    ) -> None:
+        self._entries: OrderedDict[Tuple[str, int], Tuple[Dict[str, Any], float, float]] = OrderedDict()
+        self._ttl = ttl
+        self._stale_ttl = stale_ttl
+        self._volatile_ttl = volatile_ttl
+        self._max_size = max_size
+
+    @staticmethod
+    def normalize(query: str) -> str:
+        return " ".join(re.sub(r"[^\w\s]", " ", query.lower()).split())
+
+    def get(self, key: Tuple[str, int]) -> Tuple[Optional[Dict[str, Any]], Optional[str]]:
+        """Return ``(result, "fresh" | "stale")`` or ``(None, None)``."""
+        entry = self._entries.get(key)
+        if entry is None:
+            return None, None
+        result, fresh_until, stale_until = entry
+        now = time.time()
+        if now >= stale_until:
+            del self._entries[key]
+            return None, None
+        self._entries.move_to_end(key)
+        return result, ("fresh" if now < fresh_until else "stale")
+
+    def put(self, key: Tuple[str, int], result: Dict[str, Any]) -> None:
+        if _VOLATILE_RE.search(key[0]):
+            ttl, stale = self._volatile_ttl, self._volatile_ttl
+        else:
+            ttl, stale = self._ttl, self._stale_ttl
+        now = time.time()
+        self._entries[key] = (result, now + ttl, now + ttl + stale)
+        self._entries.move_to_end(key)
+        while len(self._entries) > self._max_size:
+            self._entries.popitem(last=False)
+
+    def clear(self) -> None:
+        self._entries.clear()
+
+    @property
+    def size(self) -> int:
+        return len(self._entries)
+
 
 class GoogleSearchService:
     """Service for performing Google Custom Search API queries.
@@ -25,10 +92,20 @@ class GoogleSearchService:
         search_engine_id: Optional[str] = None,
         service_account_file: Optional[str] = None,
         logger: Optional[JarvisLogger] = None,
+        base_url: Optional[str] = None,
+        cache: Optional[SearchResultCache] = None,
+        timeout: float = 10.0,
     ) -> None:
         self.logger = logger or JarvisLogger()
         self.search_engine_id = search_engine_id or os.getenv("GOOGLE_SEARCH_ENGINE_ID")
-        self.base_url = "https://www.googleapis.com/customsearch/v1"
+        self.base_url = base_url or "https://www.googleapis.com/customsearch/v1"
+        self.cache = cache or SearchResultCache()
+        self._timeout = timeout
+        # One pooled client for the service's lifetime (keep-alive, TLS reuse)
+        self._client: Optional[httpx.AsyncClient] = None
+        self._inflight: Dict[Tuple[str, int], asyncio.Future] = {}
+        self._refreshing: Set[asyncio.Task] = set()
+        self._cache_stats = {"hits": 0, "stale_hits": 0, "misses": 0, "coalesced": 0, "refreshes": 0}
 
         # Prefer service account OAuth, fall back to API key
         sa_file = service_account_file or os.getenv("GOOGLE_SERVICE_ACCOUNT_FILE")
@@ -57,8 +134,81 @@ class GoogleSearchService:
             },
         )
 
+    def _http(self) -> httpx.AsyncClient:
+        if self._client is None:
+            self._client = httpx.AsyncClient(timeout=self._timeout)
+        return self._client
+
+    async def close(self) -> None:
+        """Cancel background refreshes and close the HTTP client."""
+        for task in list(self._refreshing):
+            task.cancel()
+        if self._refreshing:
+            await asyncio.gather(*self._refreshing, return_exceptions=True)
+        if self._client is not None:
+            await self._client.aclose()
+            self._client = None
+
+    def cache_stats(self) -> Dict[str, int]:
+        return {**self._cache_stats, "size": self.cache.size}
+
     async def search(
         self, query: str, num_results: int = 5
+    ) -> Dict[str, Any]:
+        """Search, answering repeated queries from the result cache.
+
+        Fresh hits return immediately; stale hits return immediately and
+        trigger one background refresh.  Concurrent misses for the same
+        query share a single API call.  Only successful results are cached.
+        """
+        num_results = min(num_results, 10)
+        key = (SearchResultCache.normalize(query), num_results)
+        cached, state = self.cache.get(key)
+        if state == "fresh":
+            self._cache_stats["hits"] += 1
+            return {**cached, "results": list(cached["results"])}
+        if state == "stale":
+            self._cache_stats["stale_hits"] += 1
+            if key not in self._inflight:
+                self._cache_stats["refreshes"] += 1
+                task = asyncio.create_task(self._fetch_shared(key, query, num_results))
+                self._refreshing.add(task)
+                task.add_done_callback(self._refreshing.discard)
+            return {**cached, "results": list(cached["results"])}
+
+        pending = self._inflight.get(key)
+        if pending is not None:
+            self._cache_stats["coalesced"] += 1
+            result = await asyncio.shield(pending)
+        else:
+            self._cache_stats["misses"] += 1
+            result = await self._fetch_shared(key, query, num_results)
+        return {**result, "results": list(result["results"])}
+
+    async def _fetch_shared(
+        self, key: Tuple[str, int], query: str, num_results: int
+    ) -> Dict[str, Any]:
+        future = asyncio.get_running_loop().create_future()
+        self._inflight[key] = future
+        try:
+            result = await self._fetch(query, num_results)
+            if result["success"]:
+                self.cache.put(key, result)
+            future.set_result(result)
+            return result
+        except asyncio.CancelledError:
+            future.cancel()
+            raise
+        except Exception as exc:
+            future.set_exception(exc)
+            # Nobody else may be waiting; don't warn about an unread exception
+            future.exception()
+            raise
+        finally:
+            self._inflight.pop(key, None)
+
+    async def _fetch(
+        self, query: str, num_results: int = 5
     ) -> Dict[str, Any]:
         """
         Perform a Google Custom Search query.
@@ -116,37 +266,36 @@ class GoogleSearchService:
 
             self.logger.log("DEBUG", "Performing Google search", f"query: {query}")
 
-            async with httpx.AsyncClient(timeout=10.0) as client:
-                response = await client.get(self.base_url, params=params, headers=headers)
-                response.raise_for_status()
-
-                data = response.json()
-
-                # Extract search results
-                items = data.get("items", [])
-                results = [
-                    {
-                        "title": item.get("title", ""),
-                        "snippet": item.get("snippet", ""),
-                        "link": item.get("link", ""),
-                    }
-                    for item in items
-                ]
-
-                total_results = int(data.get("searchInformation", {}).get("totalResults", 0))
-
-                self.logger.log(
-                    "INFO",
-                    "Google search completed",
-                    f"query: {query}, results: {len(results)}, total: {total_results}",
-                )
+            response = await self._http().get(self.base_url, params=params, headers=headers)
+            response.raise_for_status()
 
-                return {
-                    "success": True,
-                    "results": results,
-                    "total_results": total_results,
-                    "error": None,
+            data = response.json()
+
+            # Extract search results
+            items = data.get("items", [])
+            results = [
+                {
+                    "title": item.get("title", ""),
+                    "snippet": item.get("snippet", ""),
+                    "link": item.get("link", ""),
                 }
+                for item in items
+            ]
+
+            total_results = int(data.get("searchInformation", {}).get("totalResults", 0))
+
+            self.logger.log(
+                "INFO",
+                "Google search completed",
+                f"query: {query}, results: {len(results)}, total: {total_results}",
+            )
+
+            return {
+                "success": True,
+                "results": results,
+                "total_results": total_results,
+                "error": None,
+            }
 
         except httpx.HTTPStatusError as e:
             error_msg = f"Google Search API error: {e.response.status_code} - {e.response.text}"
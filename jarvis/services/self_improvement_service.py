@@ -1,8 +1,8 @@
 """Autonomous self-improvement orchestration service.
 
 Discovers issues via SystemAnalyzer, prioritizes them, executes fixes
-via ClaudeCodeRunner (worktree-per-task), runs tests, and merges
-successful changes back to main.  Produces a NightReport summarizing
+via ClaudeCodeRunner (worktree-per-task, several tasks at a time), runs
+tests, and merges successful changes back to main one at a time.  Produces a NightReport summarizing
 what was attempted, what succeeded, and what failed.
 """
 
@@ -23,6 +23,8 @@ from ..logging import JarvisLogger
 from ..services.todo_service import TaskStatus, TodoService
 from .system_analyzer import SystemAnalyzer, Discovery, DiscoveryType
 from .claude_code_runner import ClaudeCodeRunner
+from .night_scheduler import TASK_WEIGHTS, NightTaskScheduler, ScheduledTask, slot_capacity
+from .test_mapper import TestMapper
 
 
 # ---------------------------------------------------------------------------
@@ -72,6 +74,10 @@ class ImprovementTaskResult:
     pr_url: Optional[str] = None
     branch_name: Optional[str] = None
     discovery: Optional[dict] = None
+    # Seconds per phase (worktree, execute, impacted_tests, full_suite, ...)
+    timings: dict[str, float] = field(default_factory=dict)
+    # Tests picked by impact selection; None when it was not applicable
+    tests_selected: Optional[int] = None
 
 
 @dataclass
@@ -85,10 +91,40 @@ class NightCycleState:
     completed_results: list[dict]
     current_task_index: int
     skipped_count: int
+    # Discovery indices being worked on, and those completed or skipped.
+    # Tasks run concurrently, so work past current_task_index may be done.
+    running_tasks: list[int] = field(default_factory=list)
+    finished_tasks: Optional[list[int]] = None
 
     STATE_FILE: ClassVar[Path] = Path.home() / ".jarvis" / "night_state.json"
     STALE_HOURS: ClassVar[int] = 24
 
+    def __post_init__(self) -> None:
+        # States written before concurrent execution finished tasks in order
+        if self.finished_tasks is None:
+            self.finished_tasks = list(range(self.current_task_index))
+
+    @property
+    def remaining(self) -> int:
+        """Tasks not yet completed or skipped."""
+        return len(self.discoveries) - len(self.finished_tasks or [])
+
+    def mark_running(self, index: int) -> None:
+        if index not in self.running_tasks:
+            self.running_tasks.append(index)
+        self.save()
+
+    def mark_finished(self, index: int) -> None:
+        """Record *index* as done and advance ``current_task_index``."""
+        if index in self.running_tasks:
+            self.running_tasks.remove(index)
+        if index not in self.finished_tasks:
+            self.finished_tasks.append(index)
+        finished = set(self.finished_tasks)
+        while self.current_task_index in finished:
+            self.current_task_index += 1
+        self.save()
+
     def save(self) -> None:
         """Atomic write to disk."""
         self.STATE_FILE.parent.mkdir(parents=True, exist_ok=True)
@@ -101,6 +137,8 @@ class NightCycleState:
             "completed_results": self.completed_results,
             "current_task_index": self.current_task_index,
             "skipped_count": self.skipped_count,
+            "running_tasks": self.running_tasks,
+            "finished_tasks": self.finished_tasks,
         }, indent=2))
         os.replace(str(tmp), str(self.STATE_FILE))
 
@@ -119,6 +157,8 @@ class NightCycleState:
                 completed_results=data["completed_results"],
                 current_task_index=data["current_task_index"],
                 skipped_count=data["skipped_count"],
+                running_tasks=data.get("running_tasks", []),
+                finished_tasks=data.get("finished_tasks"),
             )
             if state.is_stale():
                 cls.clear()
@@ -184,6 +224,8 @@ class NightReport:
                     "pr_url": r.pr_url,
                     "branch_name": r.branch_name,
                     "discovery": r.discovery,
+                    "timings": r.timings,
+                    "tests_selected": r.tests_selected,
                 }
                 for r in self.results
             ],
@@ -203,7 +245,13 @@ class NightReport:
             lines.append("Results:")
             for r in self.results:
                 status = "OK" if r.success else "FAIL"
-                lines.append(f"  [{status}] {r.task_title} ({r.discovery_type})")
+                lines.append(
+                    f"  [{status}] {r.task_title} ({r.discovery_type}) "
+                    f"in {r.duration_seconds:.1f}s"
+                )
+                if r.timings:
+                    phases = ", ".join(f"{k} {v:.1f}s" for k, v in r.timings.items())
+                    lines.append(f"         Time: {phases}")
                 if r.pr_url:
                     lines.append(f"         PR: {r.pr_url}")
                 if r.error_message:
@@ -221,11 +269,14 @@ class SelfImprovementService:
 
     1. Discover issues (test failures, log errors, todos, code quality).
     2. Prioritize them.
-    3. Execute each fix in an isolated worktree via Claude Code CLI.
+    3. Execute the fixes in isolated worktrees via Claude Code CLI,
+       several at a time within a CPU/memory-bounded slot budget.
     4. Run tests, merge successes, report results.
     """
 
     MAX_TASKS_PER_NIGHT: int = 5
+    # Worktree slots in use at once; a small task takes one, a medium two
+    MAX_PARALLEL_TASKS: int = 3
     REPORT_DIR: Path = Path.home() / ".jarvis" / "night_reports"
 
     def __init__(
@@ -315,64 +366,9 @@ class SelfImprovementService:
                 "count": discoveries_count, "executing": len(prioritized)
             })
 
-        # Step 3: Execute each task
-        results: list[ImprovementTaskResult] = []
-        skipped = 0
-        for i, discovery in enumerate(prioritized):
-            size = self._estimate_task_size(discovery)
-            if size == "large":
-                self._logger.log(
-                    "INFO",
-                    "Task skipped (too large)",
-                    discovery.title,
-                )
-                skipped += 1
-                state.skipped_count = skipped
-                state.current_task_index = i + 1
-                state.save()
-                self._emit(progress_callback, "task_skip", f"Skipped: {discovery.title}", {"title": discovery.title})
-                continue
-
-            self._emit(progress_callback, "task_start", f"Working on: {discovery.title}", {
-                "index": i, "total": len(prioritized), "title": discovery.title
-            })
-            state.current_task_index = i
-            state.save()
-
-            result = await self._execute_task(discovery)
-            results.append(result)
-
-            state.completed_results.append({
-                "task_title": result.task_title,
-                "discovery_type": result.discovery_type,
-                "success": result.success,
-                "files_changed": result.files_changed,
-                "test_passed": result.test_passed,
-                "merged": result.merged,
-                "error_message": result.error_message,
-                "duration_seconds": result.duration_seconds,
-                "todo_id": result.todo_id,
-                "pr_url": result.pr_url,
-                "branch_name": result.branch_name,
-                "discovery": discovery.to_dict(),
-            })
-            state.current_task_index = i + 1
-            state.save()
-
-            if result.success:
-                self._emit(progress_callback, "task_success", "Done.", {
-                    "title": result.task_title, "pr_url": result.pr_url
-                })
-            else:
-                self._emit(progress_callback, "task_failure", f"Failed: {result.error_message}", {
-                    "title": result.task_title, "error": result.error_message
-                })
-                # Push to backlog so the user can review and we skip it next cycle.
-                self._push_to_backlog(discovery, result.error_message or "Unknown")
-
-            # Update todo status if linked
-            if discovery.todo_id and self._todo_service:
-                await self._update_todo_status(discovery.todo_id, result.success)
+        # Step 3: Execute the tasks, several at a time
+        results = await self._run_tasks(state, prioritized, progress_callback)
+        skipped = state.skipped_count
 
         # Step 4: Build report
         completed_at = datetime.now(timezone.utc).isoformat()
@@ -406,10 +402,10 @@ class SelfImprovementService:
         if state and state.status == "in_progress":
             state.status = "paused"
             state.save()
-            remaining = len(state.discoveries) - state.current_task_index
+            remaining = state.remaining
             self._emit(progress_callback, "cycle_paused",
                 f"Pausing — {remaining} tasks remaining", {
-                    "completed": state.current_task_index, "remaining": remaining
+                    "completed": len(state.finished_tasks), "remaining": remaining
                 })
 
     async def _resume_cycle(self, state: NightCycleState, progress_callback: NightProgressCallback = None) -> NightReport:
@@ -422,7 +418,7 @@ class SelfImprovementService:
             ImprovementTaskResult(**r) for r in state.completed_results
         ]
 
-        remaining = len(discoveries) - state.current_task_index
+        remaining = state.remaining
         self._emit(progress_callback, "cycle_resumed", f"Resuming — {remaining} tasks remaining", {
             "cycle_id": state.cycle_id, "from_task": state.current_task_index
         })
@@ -431,59 +427,9 @@ class SelfImprovementService:
         state.status = "in_progress"
         state.save()
 
-        skipped = state.skipped_count
         results = list(completed_results)
-
-        for i, discovery in enumerate(discoveries[state.current_task_index:], start=state.current_task_index):
-            size = self._estimate_task_size(discovery)
-            if size == "large":
-                skipped += 1
-                state.skipped_count = skipped
-                state.current_task_index = i + 1
-                state.save()
-                self._emit(progress_callback, "task_skip", f"Skipped: {discovery.title}", {"title": discovery.title})
-                continue
-
-            total = len(discoveries)
-            self._emit(progress_callback, "task_start", f"Working on: {discovery.title}", {
-                "index": i, "total": total, "title": discovery.title
-            })
-
-            state.current_task_index = i
-            state.save()
-
-            result = await self._execute_task(discovery)
-            results.append(result)
-
-            state.completed_results.append({
-                "task_title": result.task_title,
-                "discovery_type": result.discovery_type,
-                "success": result.success,
-                "files_changed": result.files_changed,
-                "test_passed": result.test_passed,
-                "merged": result.merged,
-                "error_message": result.error_message,
-                "duration_seconds": result.duration_seconds,
-                "todo_id": result.todo_id,
-                "pr_url": result.pr_url,
-                "branch_name": result.branch_name,
-                "discovery": discovery.to_dict(),
-            })
-            state.current_task_index = i + 1
-            state.save()
-
-            if result.success:
-                self._emit(progress_callback, "task_success", "Done.", {
-                    "title": result.task_title, "pr_url": result.pr_url
-                })
-            else:
-                self._emit(progress_callback, "task_failure", f"Failed: {result.error_message}", {
-                    "title": result.task_title, "error": result.error_message
-                })
-                self._push_to_backlog(discovery, result.error_message or "Unknown")
-
-            if discovery.todo_id and self._todo_service:
-                await self._update_todo_status(discovery.todo_id, result.success)
+        results.extend(await self._run_tasks(state, discoveries, progress_callback))
+        skipped = state.skipped_count
 
         completed_at = datetime.now(timezone.utc).isoformat()
         total_duration = time.monotonic() - cycle_start
@@ -516,6 +462,107 @@ class SelfImprovementService:
 
         return report
 
+    async def _run_tasks(
+        self,
+        state: NightCycleState,
+        discoveries: list[Discovery],
+        progress_callback: NightProgressCallback = None,
+    ) -> list[ImprovementTaskResult]:
+        """Execute every unfinished task of *state*, several at a time.
+
+        Large tasks are skipped up front. The rest go through a
+        :class:`NightTaskScheduler` whose slot budget is
+        ``MAX_PARALLEL_TASKS`` capped by the host's CPU and memory. The
+        state is saved as each task starts and finishes, so a paused cycle
+        resumes with exactly the tasks that had not completed. Results are
+        returned in priority order.
+        """
+        total = len(discoveries)
+        finished = set(state.finished_tasks)
+        # Tasks that were running when the cycle paused start over
+        state.running_tasks = []
+        scheduled: list[ScheduledTask] = []
+        for i, discovery in enumerate(discoveries):
+            if i in finished:
+                continue
+            size = self._estimate_task_size(discovery)
+            if size == "large":
+                self._logger.log(
+                    "INFO",
+                    "Task skipped (too large)",
+                    discovery.title,
+                )
+                state.skipped_count += 1
+                state.mark_finished(i)
+                self._emit(progress_callback, "task_skip", f"Skipped: {discovery.title}", {"title": discovery.title})
+                continue
+            scheduled.append(ScheduledTask(
+                index=i,
+                weight=TASK_WEIGHTS.get(size, 1),
+                files=frozenset(discovery.relevant_files),
+            ))
+
+        async def work(task: ScheduledTask) -> ImprovementTaskResult:
+            discovery = discoveries[task.index]
+            self._emit(progress_callback, "task_start", f"Working on: {discovery.title}", {
+                "index": task.index, "total": total, "title": discovery.title
+            })
+            state.mark_running(task.index)
+
+            result = await self._execute_task(discovery)
+
+            state.completed_results.append(self._result_state(result, discovery))
+            state.mark_finished(task.index)
+
+            if result.success:
+                self._emit(progress_callback, "task_success", "Done.", {
+                    "title": result.task_title, "pr_url": result.pr_url,
+                    "duration_seconds": result.duration_seconds, "timings": result.timings,
+                })
+            else:
+                self._emit(progress_callback, "task_failure", f"Failed: {result.error_message}", {
+                    "title": result.task_title, "error": result.error_message,
+                    "duration_seconds": result.duration_seconds, "timings": result.timings,
+                })
+                # Push to backlog so the user can review and we skip it next cycle.
+                self._push_to_backlog(discovery, result.error_message or "Unknown")
+
+            # Update todo status if linked
+            if discovery.todo_id and self._todo_service:
+                await self._update_todo_status(discovery.todo_id, result.success)
+            return result
+
+        scheduler = NightTaskScheduler(slot_capacity(self.MAX_PARALLEL_TASKS))
+        results = await scheduler.run(scheduled, work)
+        if scheduled:
+            self._logger.log(
+                "INFO",
+                "Night tasks finished",
+                f"{len(scheduled)} tasks, {scheduler.capacity} slots, "
+                f"up to {scheduler.peak_running} at once",
+            )
+        return [results[task.index] for task in scheduled]
+
+    @staticmethod
+    def _result_state(result: ImprovementTaskResult, discovery: Discovery) -> dict:
+        """Serialize *result* for ``NightCycleState.completed_results``."""
+        return {
+            "task_title": result.task_title,
+            "discovery_type": result.discovery_type,
+            "success": result.success,
+            "files_changed": result.files_changed,
+            "test_passed": result.test_passed,
+            "merged": result.merged,
+            "error_message": result.error_message,
+            "duration_seconds": result.duration_seconds,
+            "todo_id": result.todo_id,
+            "pr_url": result.pr_url,
+            "branch_name": result.branch_name,
+            "discovery": discovery.to_dict(),
+            "timings": result.timings,
+            "tests_selected": result.tests_selected,
+        }
+
     # ------------------------------------------------------------------
     # Discovery
     # ------------------------------------------------------------------
@@ -627,18 +674,40 @@ class SelfImprovementService:
     async def _execute_task(self, discovery: Discovery) -> ImprovementTaskResult:
         """Execute a single improvement task in an isolated worktree.
 
-        Creates a worktree, runs the fix, tests, then either pushes a PR
-        (when ``use_prs`` is enabled) or merges directly to main.
+        Creates a worktree, runs the fix, runs the tests affected by the
+        change and then the full suite, then either pushes a PR (when
+        ``use_prs`` is enabled) or merges directly to main. The result
+        carries the time spent in each phase.
         """
+        timings: dict[str, float] = {}
+        result = await self._run_task(discovery, timings)
+        result.timings = timings
+        self._logger.log(
+            "INFO",
+            "Night task timings",
+            f"{discovery.title}: {result.duration_seconds:.1f}s {timings}",
+        )
+        return result
+
+    async def _run_task(
+        self, discovery: Discovery, timings: dict[str, float]
+    ) -> ImprovementTaskResult:
         task_start = time.monotonic()
         worktree_path: Optional[str] = None
         branch_name: Optional[str] = None
         keep_branch = False
 
+        def mark(phase: str, since: float) -> float:
+            now = time.monotonic()
+            timings[phase] = round(now - since, 2)
+            return now
+
         try:
+            phase_start = time.monotonic()
             worktree_path, branch_name = await self._runner.create_worktree(
                 discovery.title
             )
+            phase_start = mark("worktree", phase_start)
 
             exec_result = await self._runner.execute_task(
                 discovery.description,
@@ -649,6 +718,7 @@ class SelfImprovementService:
                 else str(discovery.discovery_type),
                 confidence=getattr(discovery, "confidence", "medium"),
             )
+            phase_start = mark("execute", phase_start)
 
             if not exec_result.success:
                 return ImprovementTaskResult(
@@ -664,7 +734,32 @@ class SelfImprovementService:
                     branch_name=branch_name,
                 )
 
+            # Tests affected by the change first, so a broken fix fails
+            # fast; the full suite still gates every merge and PR.
+            selection = await self._select_tests(
+                worktree_path, getattr(exec_result, "changed_files", None) or []
+            )
+            phase_start = mark("test_selection", phase_start)
+            if selection:
+                impacted = await self._runner.run_tests(worktree_path, selection)
+                phase_start = mark("impacted_tests", phase_start)
+                if not impacted.success:
+                    return ImprovementTaskResult(
+                        task_title=discovery.title,
+                        discovery_type=str(discovery.discovery_type),
+                        success=False,
+                        files_changed=exec_result.files_changed,
+                        test_passed=False,
+                        merged=False,
+                        error_message=impacted.stderr or "Affected tests failed",
+                        duration_seconds=time.monotonic() - task_start,
+                        todo_id=discovery.todo_id,
+                        branch_name=branch_name,
+                        tests_selected=len(selection),
+                    )
+
             test_result = await self._runner.run_tests(worktree_path)
+            phase_start = mark("full_suite", phase_start)
 
             if not test_result.success:
                 return ImprovementTaskResult(
@@ -678,6 +773,7 @@ class SelfImprovementService:
                     duration_seconds=time.monotonic() - task_start,
                     todo_id=discovery.todo_id,
                     branch_name=branch_name,
+                    tests_selected=len(selection) if selection is not None else None,
                 )
 
             # --- Confidence-based routing ---
@@ -685,23 +781,29 @@ class SelfImprovementService:
             # Otherwise: low confidence -> PR, high/medium -> auto-merge.
             confidence = getattr(discovery, "confidence", "medium")
             if self._use_prs or confidence == "low":
-                return await self._finish_with_pr(
+                result = await self._finish_with_pr(
                     discovery, exec_result, worktree_path, branch_name, task_start
                 )
-
-            merged = await self._runner.merge_to_main(worktree_path, branch_name)
-            return ImprovementTaskResult(
-                task_title=discovery.title,
-                discovery_type=str(discovery.discovery_type),
-                success=merged,
-                files_changed=exec_result.files_changed,
-                test_passed=True,
-                merged=merged,
-                error_message="" if merged else "Merge failed",
-                duration_seconds=time.monotonic() - task_start,
-                todo_id=discovery.todo_id,
-                branch_name=branch_name,
-            )
+                # Once pushed, the branch backs the (possibly failed) PR
+                keep_branch = result.success
+                mark("publish", phase_start)
+            else:
+                merged = await self._runner.merge_to_main(worktree_path, branch_name)
+                mark("merge", phase_start)
+                result = ImprovementTaskResult(
+                    task_title=discovery.title,
+                    discovery_type=str(discovery.discovery_type),
+                    success=merged,
+                    files_changed=exec_result.files_changed,
+                    test_passed=True,
+                    merged=merged,
+                    error_message="" if merged else "Merge failed",
+                    duration_seconds=time.monotonic() - task_start,
+                    todo_id=discovery.todo_id,
+                    branch_name=branch_name,
+                )
+            result.tests_selected = len(selection) if selection is not None else None
+            return result
 
         except asyncio.CancelledError:
             raise
@@ -719,10 +821,8 @@ class SelfImprovementService:
                 branch_name=branch_name,
             )
         finally:
-            # _finish_with_pr sets this when the branch has been pushed
-            keep_branch = getattr(self, "_keep_branch_hint", False)
-            self._keep_branch_hint = False
             if worktree_path and branch_name:
+                cleanup_start = time.monotonic()
                 try:
                     await self._runner.cleanup_worktree(
                         worktree_path, branch_name, keep_branch=keep_branch
@@ -733,6 +833,24 @@ class SelfImprovementService:
                         "Worktree cleanup failed",
                         f"{worktree_path}: {cleanup_err}",
                     )
+                mark("cleanup", cleanup_start)
+
+    async def _select_tests(
+        self, worktree_path: str, changed_files: list[str]
+    ) -> Optional[list[str]]:
+        """Tests in *worktree_path* affected by *changed_files*.
+
+        ``None`` means the change could not be mapped and only the full
+        suite is meaningful.
+        """
+        if not changed_files:
+            return None
+        mapper = TestMapper(worktree_path, engine=self._analyzer.engine)
+        try:
+            return await asyncio.to_thread(mapper.affected_tests, changed_files)
+        except Exception as exc:
+            self._logger.log("WARNING", "Test impact selection failed", str(exc))
+            return None
 
     async def _finish_with_pr(
         self,
@@ -744,8 +862,8 @@ class SelfImprovementService:
     ) -> ImprovementTaskResult:
         """Push the branch and create a pull request.
 
-        Sets ``keep_branch`` on the enclosing ``_execute_task`` frame
-        so the finally block preserves the branch for the open PR.
+        The result is successful once the branch is pushed, even if
+        the PR itself could not be created.
         """
         push_result = await self._runner.push_branch(worktree_path, branch_name)
 
@@ -773,12 +891,6 @@ class SelfImprovementService:
 
         pr_url = pr_result.stdout.strip() if pr_result.success else None
 
-        # Whether or not the PR was created, the branch is on the remote
-        # so we keep it locally too.
-        # Mutate the keep_branch flag in the caller's finally block
-        # by storing it on the instance temporarily.
-        self._keep_branch_hint = True
-
         return ImprovementTaskResult(
             task_title=discovery.title,
             discovery_type=str(discovery.discovery_type),
@@ -848,16 +960,7 @@ class SelfImprovementService:
             return
 
         try:
-            if success:
-                self._todo_service.complete(todo_id)
-            else:
-                todo = self._todo_service.get(todo_id)
-                if todo is None:
-                    return
-                tags = list(todo.tags)
-                if "retry-night-agent" not in tags:
-                    tags.append("retry-night-agent")
-                self._todo_service.update(todo_id, tags=tags)
+            await self._todo_service.run(self._apply_todo_status, todo_id, success)
         except Exception as exc:
             self._logger.log(
                 "WARNING",
@@ -865,6 +968,20 @@ class SelfImprovementService:
                 f"{todo_id}: {exc}",
             )
 
+    def _apply_todo_status(self, todo_id: str, success: bool) -> None:
+        """Blocking half of ``_update_todo_status``; runs on the todo DB thread."""
+        with self._todo_service.batch():
+            if success:
+                self._todo_service.complete(todo_id)
+                return
+            todo = self._todo_service.get(todo_id)
+            if todo is None:
+                return
+            tags = list(todo.tags)
+            if "retry-night-agent" not in tags:
+                tags.append("retry-night-agent")
+            self._todo_service.update(todo_id, tags=tags)
+
     # ------------------------------------------------------------------
     # Report persistence
     # ------------------------------------------------------------------
@@ -900,6 +1017,8 @@ class SelfImprovementService:
                 todo_id=r.get("todo_id"),
                 pr_url=r.get("pr_url"),
                 branch_name=r.get("branch_name"),
+                timings=r.get("timings", {}),
+                tests_selected=r.get("tests_selected"),
             )
             for r in data.get("results", [])
         ]
@@ -1,4 +1,11 @@
-"""ServerManagerService — process lifecycle, health checks, auto-restart."""
+"""ServerManagerService — process lifecycle, health checks, auto-restart.
+
+Boot and shutdown follow ``ServerConfig.depends_on``: independent servers
+start (and stop) concurrently, and a server only starts once everything it
+depends on passes a readiness probe.  Every spawned process is watched via
+``wait()`` so an exit is handled — and ``maybe_auto_restart`` scheduled —
+the moment it happens rather than on the next monitor tick.
+"""
 
 from __future__ import annotations
 
@@ -9,7 +16,7 @@ import signal
 import time
 from datetime import datetime, timezone
 from pathlib import Path
-from typing import Any, Dict, List, Optional, TYPE_CHECKING
+from typing import Any, Awaitable, Callable, Dict, List, Optional, Set, TYPE_CHECKING
 
 if TYPE_CHECKING:
     from jarvis.agents.health_agent.models import ProbeResult
@@ -46,6 +53,8 @@ class ServerManagerService:
         self._servers: Dict[str, ServerState] = {}
         self._processes: Dict[str, asyncio.subprocess.Process] = {}
         self._restart_timers: Dict[str, asyncio.Task] = {}
+        self._watchers: Dict[str, asyncio.Task] = {}
+        self._crash_callbacks: List[Callable[[str], Awaitable[None]]] = []
 
     # ------------------------------------------------------------------
     # Registry I/O
@@ -98,6 +107,9 @@ class ServerManagerService:
         timer = self._restart_timers.pop(name, None)
         if timer and not timer.done():
             timer.cancel()
+        watcher = self._watchers.pop(name, None)
+        if watcher and not watcher.done():
+            watcher.cancel()
         del self._servers[name]
         self._processes.pop(name, None)
         self._save_registry()
@@ -153,6 +165,7 @@ class ServerManagerService:
             state.status = ServerStatus.RUNNING
             state.started_at = datetime.now(timezone.utc)
             state.error_message = None
+            self._watchers[name] = asyncio.create_task(self._watch_process(name, proc))
             self.logger.log("INFO", f"Started server '{name}'", f"PID {proc.pid}")
         except Exception as exc:
             state.status = ServerStatus.CRASHED
@@ -178,6 +191,10 @@ class ServerManagerService:
             return state
 
         state.status = ServerStatus.STOPPING
+        # This exit is expected: the watcher must not treat it as a crash
+        watcher = self._watchers.pop(name, None)
+        if watcher and not watcher.done():
+            watcher.cancel()
 
         try:
             proc.terminate()
@@ -203,25 +220,141 @@ class ServerManagerService:
         return await self.start_server(name)
 
     async def start_boot_servers(self) -> List[str]:
-        """Start all servers with start_on_boot=True. Returns names started."""
-        started: List[str] = []
-        for name, state in self._servers.items():
-            if state.config.start_on_boot and state.config.mode == ServerMode.MANAGED:
-                try:
-                    await self.start_server(name)
-                    started.append(name)
-                except Exception as exc:
-                    self.logger.log("WARNING", f"Boot start failed for '{name}'", str(exc))
-        return started
+        """Start all servers with start_on_boot=True. Returns names started.
+
+        Servers start as soon as their dependencies are ready, so
+        independent ones start concurrently.  A server whose dependency
+        failed, is unknown, or is part of a cycle is skipped.
+        """
+        boot = [
+            name for name, state in self._servers.items()
+            if state.config.start_on_boot and state.config.mode == ServerMode.MANAGED
+        ]
+        if not boot:
+            return []
+
+        # Dependents wait on this: started (if booting) and passing a readiness probe
+        ready: Dict[str, "asyncio.Future[bool]"] = {}
+        has_dependents = {dep for name in boot for dep in self._servers[name].config.depends_on}
+        cyclic = self._cyclic(boot)
+
+        def readiness(dep: str) -> "asyncio.Future[bool]":
+            if dep not in ready:
+                if dep in boot:
+                    ready[dep] = asyncio.get_running_loop().create_future()
+                else:
+                    # Not ours to start (external or not on boot): just probe it
+                    ready[dep] = asyncio.ensure_future(self.wait_ready(dep))
+            return ready[dep]
+
+        async def boot_one(name: str) -> bool:
+            state = self._servers[name]
+            ok = False
+            try:
+                if name in cyclic:
+                    raise ValueError(f"dependency cycle involving {', '.join(sorted(cyclic))}")
+                for dep in state.config.depends_on:
+                    if dep not in self._servers:
+                        raise ValueError(f"unknown dependency '{dep}'")
+                    if not await readiness(dep):
+                        raise ValueError(f"dependency '{dep}' is not ready")
+                await self.start_server(name)
+                ok = True
+                if name in has_dependents:
+                    ok = await self.wait_ready(name)
+                    if not ok:
+                        self.logger.log(
+                            "WARNING",
+                            f"'{name}' not ready after {state.config.ready_timeout:.0f}s",
+                            "dependents will not start",
+                        )
+                return True
+            except Exception as exc:
+                state.error_message = state.error_message or str(exc)
+                self.logger.log("WARNING", f"Boot start failed for '{name}'", str(exc))
+                return False
+            finally:
+                future = readiness(name)
+                if not future.done():
+                    future.set_result(ok)
+
+        for name in boot:
+            readiness(name)
+        results = await asyncio.gather(*(boot_one(name) for name in boot))
+        for future in ready.values():
+            if not future.done():
+                future.cancel()
+        return [name for name, ok in zip(boot, results) if ok]
+
+    async def wait_ready(self, name: str, timeout: Optional[float] = None) -> bool:
+        """Probe *name* until healthy or *timeout* (default its ready_timeout)."""
+        state = self._servers.get(name)
+        if not state:
+            return False
+        deadline = time.monotonic() + (state.config.ready_timeout if timeout is None else timeout)
+        delay = 0.05
+        while True:
+            probe = await self.check_health(name)
+            if probe.status.value == "healthy":
+                return True
+            if state.status == ServerStatus.CRASHED or time.monotonic() + delay > deadline:
+                return False
+            await asyncio.sleep(delay)
+            delay = min(delay * 2, 1.0)
+
+    def _cyclic(self, names: List[str]) -> Set[str]:
+        """Names among *names* that sit on (or behind) a depends_on cycle."""
+        done: Set[str] = set()
+        bad: Set[str] = set()
+
+        def visit(name: str, path: List[str]) -> bool:
+            if name in path:
+                bad.update(path[path.index(name):])
+                return False
+            if name in done or name not in self._servers:
+                return name not in bad
+            ok = all(visit(dep, path + [name]) for dep in self._servers[name].config.depends_on)
+            done.add(name)
+            if not ok:
+                bad.add(name)
+            return ok
+
+        for name in names:
+            visit(name, [])
+        return bad & set(names)
 
     async def stop_all(self) -> None:
-        """Gracefully stop all managed servers."""
-        for name, state in list(self._servers.items()):
-            if state.config.mode == ServerMode.MANAGED and state.status == ServerStatus.RUNNING:
-                try:
-                    await self.stop_server(name)
-                except Exception as exc:
-                    self.logger.log("WARNING", f"Failed to stop '{name}'", str(exc))
+        """Gracefully stop all managed servers, dependents before dependencies."""
+        for timer in self._restart_timers.values():
+            if not timer.done():
+                timer.cancel()
+        self._restart_timers.clear()
+
+        running = [
+            name for name, state in self._servers.items()
+            if state.config.mode == ServerMode.MANAGED and state.status == ServerStatus.RUNNING
+        ]
+        stopped = {name: asyncio.Event() for name in running}
+
+        async def stop_one(name: str) -> None:
+            for other in running:
+                if other != name and name in self._servers[other].config.depends_on:
+                    await stopped[other].wait()
+            try:
+                await self.stop_server(name)
+            except Exception as exc:
+                self.logger.log("WARNING", f"Failed to stop '{name}'", str(exc))
+            finally:
+                stopped[name].set()
+
+        cyclic = self._cyclic(running)
+        # Servers on (or behind) a cycle cannot be ordered among themselves,
+        # but no other server depends on them: stop them first, together,
+        # so the dependencies they share with the rest are not left waiting
+        await asyncio.gather(*(self.stop_server(n) for n in cyclic), return_exceptions=True)
+        for name in cyclic:
+            stopped[name].set()
+        await asyncio.gather(*(stop_one(n) for n in running if n not in cyclic))
 
     # ------------------------------------------------------------------
     # Health checks
@@ -247,7 +380,7 @@ class ServerManagerService:
         if url:
             try:
                 import httpx
-                async with httpx.AsyncClient(timeout=5.0) as client:
+                async with httpx.AsyncClient(timeout=state.config.health_timeout) as client:
                     resp = await client.get(url)
                 latency = (time.monotonic() - start) * 1000
                 state.last_health_check = datetime.now(timezone.utc)
@@ -295,7 +428,7 @@ class ServerManagerService:
             try:
                 _, writer = await asyncio.wait_for(
                     asyncio.open_connection(state.config.host, state.config.port),
-                    timeout=5.0,
+                    timeout=state.config.health_timeout,
                 )
                 writer.close()
                 await writer.wait_closed()
@@ -358,11 +491,32 @@ class ServerManagerService:
         )
 
     async def check_all_health(self) -> List["ProbeResult"]:
-        """Check health of all registered servers."""
-        results = []
-        for name in self._servers:
-            results.append(await self.check_health(name))
-        return results
+        """Check health of all registered servers concurrently.
+
+        Each check is bounded by its server's ``health_timeout`` (plus a
+        small grace), so one hung server cannot delay the rest.
+        """
+        names = list(self._servers)
+        return list(await asyncio.gather(*(self._check_with_deadline(n) for n in names)))
+
+    async def _check_with_deadline(self, name: str) -> "ProbeResult":
+        state = self._servers[name]
+        deadline = state.config.health_timeout + 1.0
+        try:
+            return await asyncio.wait_for(self.check_health(name), timeout=deadline)
+        except asyncio.TimeoutError:
+            ProbeResult, ComponentStatus = _health_models()
+            state.last_health_check = datetime.now(timezone.utc)
+            state.last_health_latency_ms = deadline * 1000
+            state.consecutive_failures += 1
+            state.status = ServerStatus.UNHEALTHY
+            return ProbeResult(
+                component=f"server:{name}",
+                component_type="service",
+                status=ComponentStatus.UNHEALTHY,
+                latency_ms=deadline * 1000,
+                message=f"Health check timed out after {deadline:.1f}s",
+            )
 
     # ------------------------------------------------------------------
     # Auto-restart
@@ -428,8 +582,48 @@ class ServerManagerService:
         self._restart_timers[name] = asyncio.create_task(_delayed_restart())
         return True
 
+    def on_crash(self, callback: Callable[[str], Awaitable[None]]) -> None:
+        """Register ``callback(name)`` to run when a watched process exits unexpectedly."""
+        self._crash_callbacks.append(callback)
+
+    async def _watch_process(self, name: str, proc: asyncio.subprocess.Process) -> None:
+        """Wait for *proc* to exit; if nobody asked it to, handle the crash now."""
+        try:
+            await proc.wait()
+        except asyncio.CancelledError:
+            raise
+        except Exception as exc:
+            self.logger.log("DEBUG", f"Cannot watch '{name}'", str(exc))
+            return
+        state = self._servers.get(name)
+        if (
+            proc.returncode is None
+            or state is None
+            or self._processes.get(name) is not proc
+            or state.status not in (ServerStatus.RUNNING, ServerStatus.STARTING, ServerStatus.UNHEALTHY)
+        ):
+            return  # stopped on purpose, replaced, or unregistered
+
+        self._mark_crashed(name, state, proc.returncode)
+        for callback in list(self._crash_callbacks):
+            try:
+                await callback(name)
+            except Exception as exc:
+                self.logger.log("WARNING", f"Crash callback failed for '{name}'", str(exc))
+        await self.maybe_auto_restart(name)
+
+    def _mark_crashed(self, name: str, state: ServerState, returncode: int) -> None:
+        state.status = ServerStatus.CRASHED
+        state.last_exit_code = returncode
+        state.error_message = f"Process exited unexpectedly with code {returncode}"
+        self.logger.log("WARNING", f"Detected crash: '{name}'", f"exit={returncode}")
+
     async def detect_crashes(self) -> List[str]:
-        """Check managed processes for unexpected exits. Returns names of crashed servers."""
+        """Check managed processes for unexpected exits. Returns names of crashed servers.
+
+        Watched processes are handled as they exit; this sweep only catches
+        processes that were not spawned through ``start_server``.
+        """
         crashed: List[str] = []
         for name, state in self._servers.items():
             if state.config.mode != ServerMode.MANAGED:
@@ -438,13 +632,6 @@ class ServerManagerService:
                 continue
             proc = self._processes.get(name)
             if proc and proc.returncode is not None:
-                state.status = ServerStatus.CRASHED
-                state.last_exit_code = proc.returncode
-                state.error_message = f"Process exited unexpectedly with code {proc.returncode}"
+                self._mark_crashed(name, state, proc.returncode)
                 crashed.append(name)
-                self.logger.log(
-                    "WARNING",
-                    f"Detected crash: '{name}'",
-                    f"exit={proc.returncode}",
-                )
         return crashed
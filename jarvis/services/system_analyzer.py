@@ -10,6 +10,7 @@ import ast
 import asyncio
 import re
 import sqlite3
+from collections import Counter
 from dataclasses import dataclass, field
 from datetime import datetime, timedelta, timezone
 from enum import Enum
@@ -17,6 +18,8 @@ from pathlib import Path
 from typing import Optional
 
 from ..logging import JarvisLogger
+from ..services.code_analysis import AnalysisRun, CodeAnalysisEngine, SourceFile
+from ..services.test_sharding import ShardedTestRunner
 from ..services.todo_service import TodoService, TodoItem, TaskStatus
 
 
@@ -302,12 +305,24 @@ class SystemAnalyzer:
         todo_service: Optional[TodoService] = None,
         logger: Optional[JarvisLogger] = None,
         trace_db_path: str = "jarvis_traces.db",
+        engine: Optional[CodeAnalysisEngine] = None,
+        test_runner: Optional[ShardedTestRunner] = None,
     ) -> None:
         self.project_root = project_root
         self.log_db_path = log_db_path
         self.todo_service = todo_service
         self.logger = logger or JarvisLogger()
         self.trace_db_path = trace_db_path
+        self._engine = engine
+        self.test_runner = test_runner or ShardedTestRunner()
+        # Shared source scan while run_full_analysis is in progress
+        self._active_run: Optional[AnalysisRun] = None
+
+    @property
+    def engine(self) -> CodeAnalysisEngine:
+        if self._engine is None:
+            self._engine = CodeAnalysisEngine()
+        return self._engine
 
     # ------------------------------------------------------------------
     # Public API
@@ -317,6 +332,15 @@ class SystemAnalyzer:
         """Run all analyzers and return deduplicated results."""
         all_discoveries: list[Discovery] = []
 
+        # Read and parse the source tree once for all code analyzers
+        try:
+            self._active_run = await asyncio.to_thread(self._scan)
+            self.logger.log(
+                "INFO", "SystemAnalyzer source scan", self._active_run.stats()
+            )
+        except Exception as exc:
+            self.logger.log("ERROR", "SystemAnalyzer source scan failed", str(exc))
+
         analyzers = [
             ("logs", self.analyze_logs),
             ("tests", self.analyze_tests),
@@ -331,16 +355,19 @@ class SystemAnalyzer:
             ("traces", self.analyze_traces),
         ]
 
-        for name, analyzer in analyzers:
-            try:
-                results = await analyzer()
-                all_discoveries.extend(results)
-            except Exception as exc:
-                self.logger.log(
-                    "ERROR",
-                    f"SystemAnalyzer.{name} failed",
-                    str(exc),
-                )
+        try:
+            for name, analyzer in analyzers:
+                try:
+                    results = await analyzer()
+                    all_discoveries.extend(results)
+                except Exception as exc:
+                    self.logger.log(
+                        "ERROR",
+                        f"SystemAnalyzer.{name} failed",
+                        str(exc),
+                    )
+        finally:
+            self._active_run = None
 
         # Deduplicate by title — keep first occurrence
         seen_titles: set[str] = set()
@@ -414,24 +441,17 @@ class SystemAnalyzer:
     # ------------------------------------------------------------------
 
     async def analyze_tests(self, timeout: int = 120) -> list[Discovery]:
-        """Run pytest and parse failures into discoveries."""
+        """Run pytest (sharded across cores) and parse failures into discoveries."""
         try:
-            proc = await asyncio.create_subprocess_exec(
-                "pytest",
-                "--tb=short",
-                "-q",
-                "--timeout=30",
-                cwd=self.project_root,
-                stdout=asyncio.subprocess.PIPE,
-                stderr=asyncio.subprocess.PIPE,
-            )
-            stdout, _ = await asyncio.wait_for(
-                proc.communicate(), timeout=timeout
+            run = await self.test_runner.run(
+                self.project_root,
+                ["pytest", "--tb=short", "-q", "--timeout=30"],
+                timeout=timeout,
             )
         except Exception:
             return []
 
-        output = stdout.decode(errors="replace")
+        output = run.stdout
         discoveries: list[Discovery] = []
 
         for line in output.splitlines():
@@ -480,10 +500,7 @@ class SystemAnalyzer:
 
         tag_set = set(tags)
 
-        # Call synchronously — TodoService uses sqlite3 with
-        # check_same_thread=True, so it must run on the creating thread.
-        # The call is fast (in-process SQLite) so no need for to_thread.
-        all_items: list[TodoItem] = self.todo_service.list()
+        all_items: list[TodoItem] = await self.todo_service.run(self.todo_service.list)
 
         discoveries: list[Discovery] = []
         for item in all_items:
@@ -515,57 +532,54 @@ class SystemAnalyzer:
         return await asyncio.to_thread(self._analyze_code_quality_sync)
 
     def _analyze_code_quality_sync(self) -> list[Discovery]:
-        root = Path(self.project_root)
-        scan_dirs = [
-            root / "jarvis" / "agents",
-            root / "jarvis" / "services",
-        ]
-
         discoveries: list[Discovery] = []
 
-        for scan_dir in scan_dirs:
-            if not scan_dir.is_dir():
-                continue
-            for py_file in scan_dir.rglob("*.py"):
-                try:
-                    source = py_file.read_text(encoding="utf-8")
-                    tree = ast.parse(source, filename=str(py_file))
-                except Exception:
-                    continue
-
-                for node in ast.walk(tree):
-                    if not isinstance(node, ast.ClassDef):
-                        continue
-
-                    undocumented: list[str] = []
-                    for item in node.body:
-                        if not isinstance(item, (ast.FunctionDef, ast.AsyncFunctionDef)):
-                            continue
-                        if item.name.startswith("_"):
-                            continue
-                        if not ast.get_docstring(item):
-                            undocumented.append(item.name)
-
-                    if len(undocumented) >= 3:
-                        rel_path = str(py_file.relative_to(root))
-                        methods_str = ", ".join(undocumented)
-                        discoveries.append(
-                            Discovery(
-                                discovery_type=DiscoveryType.CODE_QUALITY,
-                                title=f"Undocumented methods in {rel_path}::{node.name}",
-                                description=(
-                                    f"Class {node.name} in {rel_path} has "
-                                    f"{len(undocumented)} undocumented public "
-                                    f"methods: {methods_str}"
-                                ),
-                                priority="low",
-                                relevant_files=[rel_path],
-                                source_detail=methods_str,
-                            )
+        for sf in self._parsed_files():
+            for class_name, undocumented in sf.facts.undocumented:
+                if len(undocumented) >= 3:
+                    methods_str = ", ".join(undocumented)
+                    discoveries.append(
+                        Discovery(
+                            discovery_type=DiscoveryType.CODE_QUALITY,
+                            title=f"Undocumented methods in {sf.rel_path}::{class_name}",
+                            description=(
+                                f"Class {class_name} in {sf.rel_path} has "
+                                f"{len(undocumented)} undocumented public "
+                                f"methods: {methods_str}"
+                            ),
+                            priority="low",
+                            relevant_files=[sf.rel_path],
+                            source_detail=methods_str,
                         )
+                    )
 
         return discoveries
 
+    # ------------------------------------------------------------------
+    # Shared source scan
+    # ------------------------------------------------------------------
+
+    def _scan(self) -> AnalysisRun:
+        """Facts for every module under the scanned packages.
+
+        Reuses the scan made by :meth:`run_full_analysis` when one is in
+        progress, so each file is read and parsed at most once per run.
+        """
+        if self._active_run is not None:
+            return self._active_run
+        root = Path(self.project_root)
+        paths: list[Path] = []
+        for scan_dir in (root / "jarvis" / "agents", root / "jarvis" / "services"):
+            if scan_dir.is_dir():
+                paths.extend(scan_dir.rglob("*.py"))
+        return self.engine.analyze(root, paths)
+
+    def _parsed_files(self) -> list[SourceFile]:
+        return [
+            sf for sf in self._scan().files.values()
+            if sf.facts is not None and sf.facts.parsed
+        ]
+
     # ------------------------------------------------------------------
     # Context enrichment helpers
     # ------------------------------------------------------------------
@@ -605,73 +619,26 @@ class SystemAnalyzer:
         return await asyncio.to_thread(self._analyze_unused_imports_sync)
 
     def _analyze_unused_imports_sync(self) -> list[Discovery]:
-        root = Path(self.project_root)
-        scan_dirs = [
-            root / "jarvis" / "agents",
-            root / "jarvis" / "services",
-        ]
-
         discoveries: list[Discovery] = []
 
-        for scan_dir in scan_dirs:
-            if not scan_dir.is_dir():
-                continue
-            for py_file in scan_dir.rglob("*.py"):
-                try:
-                    source = py_file.read_text(encoding="utf-8")
-                    tree = ast.parse(source, filename=str(py_file))
-                except Exception:
-                    continue
-
-                # Collect imported names with their line numbers
-                imported: list[tuple[str, int]] = []
-                for node in ast.walk(tree):
-                    if isinstance(node, ast.Import):
-                        for alias in node.names:
-                            name = alias.asname or alias.name.split(".")[0]
-                            imported.append((name, node.lineno))
-                    elif isinstance(node, ast.ImportFrom):
-                        for alias in node.names:
-                            name = alias.asname or alias.name
-                            imported.append((name, node.lineno))
-
-                if not imported:
-                    continue
-
-                # Check which names are never referenced outside import lines
-                import_lines = {ln for _, ln in imported}
-                non_import_source = "\n".join(
-                    line for i, line in enumerate(source.splitlines(), 1)
-                    if i not in import_lines
-                )
-
-                unused: list[tuple[str, int]] = []
-                for name, ln in imported:
-                    if name == "*":
-                        continue
-                    # Simple word-boundary check in non-import lines
-                    if not re.search(rf"\b{re.escape(name)}\b", non_import_source):
-                        unused.append((name, ln))
-
-                if unused:
-                    rel_path = str(py_file.relative_to(root))
-                    names_str = ", ".join(f"{n} (line {ln})" for n, ln in unused)
-                    # Extract context around first unused import
-                    first_lineno = unused[0][1]
-                    ctx = self._extract_context(source, first_lineno)
-                    scope = self._find_enclosing_scope(tree, first_lineno)
-                    discoveries.append(
-                        Discovery(
-                            discovery_type=DiscoveryType.UNUSED_IMPORT,
-                            title=f"Unused imports in {rel_path}",
-                            description=f"Unused imports in {rel_path}: {names_str}",
-                            priority="low",
-                            relevant_files=[rel_path],
-                            source_detail=names_str,
-                            code_context=ctx,
-                            function_scope=scope,
-                        )
+        for sf in self._parsed_files():
+            unused = sf.facts.unused_imports
+            if unused:
+                names_str = ", ".join(f"{n} (line {ln})" for n, ln in unused)
+                # Extract context around first unused import
+                first_lineno = unused[0][1]
+                discoveries.append(
+                    Discovery(
+                        discovery_type=DiscoveryType.UNUSED_IMPORT,
+                        title=f"Unused imports in {sf.rel_path}",
+                        description=f"Unused imports in {sf.rel_path}: {names_str}",
+                        priority="low",
+                        relevant_files=[sf.rel_path],
+                        source_detail=names_str,
+                        code_context=self._extract_context(sf.source, first_lineno),
+                        function_scope=sf.facts.scope_at(first_lineno),
                     )
+                )
 
         return discoveries
 
@@ -684,58 +651,25 @@ class SystemAnalyzer:
         return await asyncio.to_thread(self._analyze_exception_antipatterns_sync)
 
     def _analyze_exception_antipatterns_sync(self) -> list[Discovery]:
-        root = Path(self.project_root)
-        scan_dirs = [
-            root / "jarvis" / "agents",
-            root / "jarvis" / "services",
-        ]
-
         discoveries: list[Discovery] = []
 
-        for scan_dir in scan_dirs:
-            if not scan_dir.is_dir():
-                continue
-            for py_file in scan_dir.rglob("*.py"):
-                try:
-                    source = py_file.read_text(encoding="utf-8")
-                    tree = ast.parse(source, filename=str(py_file))
-                except Exception:
-                    continue
-
-                antipatterns: list[tuple[str, int]] = []
-                for node in ast.walk(tree):
-                    if isinstance(node, ast.ExceptHandler):
-                        if node.type is None:
-                            antipatterns.append(
-                                (f"Bare except: at line {node.lineno}", node.lineno)
-                            )
-                        # Check for swallowed exceptions (except with only pass)
-                        elif (
-                            len(node.body) == 1
-                            and isinstance(node.body[0], ast.Pass)
-                        ):
-                            antipatterns.append(
-                                (f"Swallowed exception at line {node.lineno}", node.lineno)
-                            )
-
-                if antipatterns:
-                    rel_path = str(py_file.relative_to(root))
-                    details_str = "; ".join(desc for desc, _ in antipatterns)
-                    first_lineno = antipatterns[0][1]
-                    ctx = self._extract_context(source, first_lineno)
-                    scope = self._find_enclosing_scope(tree, first_lineno)
-                    discoveries.append(
-                        Discovery(
-                            discovery_type=DiscoveryType.EXCEPTION_ANTIPATTERN,
-                            title=f"Exception antipatterns in {rel_path}",
-                            description=f"Found {len(antipatterns)} antipattern(s) in {rel_path}: {details_str}",
-                            priority="medium",
-                            relevant_files=[rel_path],
-                            source_detail=details_str,
-                            code_context=ctx,
-                            function_scope=scope,
-                        )
+        for sf in self._parsed_files():
+            antipatterns = sf.facts.exception_antipatterns
+            if antipatterns:
+                details_str = "; ".join(desc for desc, _ in antipatterns)
+                first_lineno = antipatterns[0][1]
+                discoveries.append(
+                    Discovery(
+                        discovery_type=DiscoveryType.EXCEPTION_ANTIPATTERN,
+                        title=f"Exception antipatterns in {sf.rel_path}",
+                        description=f"Found {len(antipatterns)} antipattern(s) in {sf.rel_path}: {details_str}",
+                        priority="medium",
+                        relevant_files=[sf.rel_path],
+                        source_detail=details_str,
+                        code_context=self._extract_context(sf.source, first_lineno),
+                        function_scope=sf.facts.scope_at(first_lineno),
                     )
+                )
 
         return discoveries
 
@@ -748,54 +682,29 @@ class SystemAnalyzer:
         return await asyncio.to_thread(self._analyze_complexity_hotspots_sync)
 
     def _analyze_complexity_hotspots_sync(self, threshold: int = 50) -> list[Discovery]:
-        root = Path(self.project_root)
-        scan_dirs = [
-            root / "jarvis" / "agents",
-            root / "jarvis" / "services",
-        ]
-
         discoveries: list[Discovery] = []
 
-        for scan_dir in scan_dirs:
-            if not scan_dir.is_dir():
-                continue
-            for py_file in scan_dir.rglob("*.py"):
-                try:
-                    source = py_file.read_text(encoding="utf-8")
-                    tree = ast.parse(source, filename=str(py_file))
-                except Exception:
-                    continue
-
-                hotspots: list[tuple[str, int]] = []
-                for node in ast.walk(tree):
-                    if isinstance(node, (ast.FunctionDef, ast.AsyncFunctionDef)):
-                        end_line = getattr(node, "end_lineno", None)
-                        if end_line is None:
-                            continue
-                        func_lines = end_line - node.lineno + 1
-                        if func_lines >= threshold:
-                            hotspots.append(
-                                (f"{node.name} ({func_lines} lines, line {node.lineno})", node.lineno)
-                            )
-
-                if hotspots:
-                    rel_path = str(py_file.relative_to(root))
-                    details_str = "; ".join(desc for desc, _ in hotspots)
-                    first_lineno = hotspots[0][1]
-                    ctx = self._extract_context(source, first_lineno)
-                    scope = self._find_enclosing_scope(tree, first_lineno)
-                    discoveries.append(
-                        Discovery(
-                            discovery_type=DiscoveryType.COMPLEXITY_HOTSPOT,
-                            title=f"Complexity hotspots in {rel_path}",
-                            description=f"Long functions in {rel_path}: {details_str}",
-                            priority="medium",
-                            relevant_files=[rel_path],
-                            source_detail=details_str,
-                            code_context=ctx,
-                            function_scope=scope,
-                        )
+        for sf in self._parsed_files():
+            hotspots = [
+                (f"{name} ({func_lines} lines, line {lineno})", lineno)
+                for name, lineno, func_lines in sf.facts.functions
+                if func_lines >= threshold
+            ]
+            if hotspots:
+                details_str = "; ".join(desc for desc, _ in hotspots)
+                first_lineno = hotspots[0][1]
+                discoveries.append(
+                    Discovery(
+                        discovery_type=DiscoveryType.COMPLEXITY_HOTSPOT,
+                        title=f"Complexity hotspots in {sf.rel_path}",
+                        description=f"Long functions in {sf.rel_path}: {details_str}",
+                        priority="medium",
+                        relevant_files=[sf.rel_path],
+                        source_detail=details_str,
+                        code_context=self._extract_context(sf.source, first_lineno),
+                        function_scope=sf.facts.scope_at(first_lineno),
                     )
+                )
 
         return discoveries
 
@@ -808,63 +717,30 @@ class SystemAnalyzer:
         return await asyncio.to_thread(self._analyze_dead_code_sync)
 
     def _analyze_dead_code_sync(self) -> list[Discovery]:
-        root = Path(self.project_root)
-        scan_dirs = [
-            root / "jarvis" / "agents",
-            root / "jarvis" / "services",
-        ]
-
-        # Phase 1: collect all function/method definitions
-        all_defs: list[tuple[str, str, int]] = []  # (name, file_path, lineno)
-        all_sources: list[tuple[str, str]] = []     # (file_path, source)
-
-        for scan_dir in scan_dirs:
-            if not scan_dir.is_dir():
-                continue
-            for py_file in scan_dir.rglob("*.py"):
-                try:
-                    source = py_file.read_text(encoding="utf-8")
-                    tree = ast.parse(source, filename=str(py_file))
-                except Exception:
-                    continue
-
-                rel_path = str(py_file.relative_to(root))
-                all_sources.append((rel_path, source))
+        files = self._parsed_files()
 
-                for node in ast.walk(tree):
-                    if isinstance(node, (ast.FunctionDef, ast.AsyncFunctionDef)):
-                        # Skip private/dunder methods and common framework hooks
-                        if node.name.startswith("_"):
-                            continue
-                        all_defs.append((node.name, rel_path, node.lineno))
+        # Identifier counts across all files — at least 2 means
+        # definition + usage
+        references: Counter[str] = Counter()
+        for sf in files:
+            references.update(sf.facts.words)
 
-        # Phase 2: count references across all sources
         discoveries: list[Discovery] = []
-        combined_source = "\n".join(src for _, src in all_sources)
-
-        for name, def_path, lineno in all_defs:
-            # Count occurrences — at least 2 means definition + usage
-            ref_count = len(re.findall(rf"\b{re.escape(name)}\b", combined_source))
-            if ref_count <= 1:
-                # Find the source text for this file
-                file_source = ""
-                for src_path, src_text in all_sources:
-                    if src_path == def_path:
-                        file_source = src_text
-                        break
-                ctx = self._extract_context(file_source, lineno) if file_source else ""
-                discoveries.append(
-                    Discovery(
-                        discovery_type=DiscoveryType.DEAD_CODE,
-                        title=f"Potentially dead: {name} in {def_path}",
-                        description=f"Function '{name}' at line {lineno} in {def_path} appears unreferenced.",
-                        priority="low",
-                        relevant_files=[def_path],
-                        source_detail=f"{name} (line {lineno})",
-                        code_context=ctx,
-                        function_scope=name,
+        for sf in files:
+            for name, lineno in sf.facts.public_defs:
+                if references[name] <= 1:
+                    discoveries.append(
+                        Discovery(
+                            discovery_type=DiscoveryType.DEAD_CODE,
+                            title=f"Potentially dead: {name} in {sf.rel_path}",
+                            description=f"Function '{name}' at line {lineno} in {sf.rel_path} appears unreferenced.",
+                            priority="low",
+                            relevant_files=[sf.rel_path],
+                            source_detail=f"{name} (line {lineno})",
+                            code_context=self._extract_context(sf.source, lineno),
+                            function_scope=name,
+                        )
                     )
-                )
 
         return discoveries
 
@@ -877,54 +753,26 @@ class SystemAnalyzer:
         return await asyncio.to_thread(self._analyze_stale_comments_sync)
 
     def _analyze_stale_comments_sync(self) -> list[Discovery]:
-        root = Path(self.project_root)
-        scan_dirs = [
-            root / "jarvis" / "agents",
-            root / "jarvis" / "services",
-        ]
-
-        pattern = re.compile(r"#\s*(TODO|FIXME|HACK|XXX)\b", re.IGNORECASE)
         discoveries: list[Discovery] = []
 
-        for scan_dir in scan_dirs:
-            if not scan_dir.is_dir():
-                continue
-            for py_file in scan_dir.rglob("*.py"):
-                try:
-                    source = py_file.read_text(encoding="utf-8")
-                except Exception:
-                    continue
-
-                matches: list[tuple[str, int]] = []
-                for i, line in enumerate(source.splitlines(), 1):
-                    m = pattern.search(line)
-                    if m:
-                        marker = m.group(1).upper()
-                        matches.append((f"{marker} at line {i}", i))
-
-                if matches:
-                    rel_path = str(py_file.relative_to(root))
-                    details_str = "; ".join(desc for desc, _ in matches)
-                    first_lineno = matches[0][1]
-                    ctx = self._extract_context(source, first_lineno)
-                    # Parse source to get enclosing scope
-                    try:
-                        tree_for_scope = ast.parse(source)
-                        scope = self._find_enclosing_scope(tree_for_scope, first_lineno)
-                    except Exception:
-                        scope = ""
-                    discoveries.append(
-                        Discovery(
-                            discovery_type=DiscoveryType.STALE_COMMENT,
-                            title=f"Stale comments in {rel_path}",
-                            description=f"Found {len(matches)} marker comment(s) in {rel_path}: {details_str}",
-                            priority="low",
-                            relevant_files=[rel_path],
-                            source_detail=details_str,
-                            code_context=ctx,
-                            function_scope=scope,
-                        )
+        for sf in self._scan().files.values():
+            matches = sf.facts.markers if sf.facts is not None else []
+            if matches:
+                details_str = "; ".join(desc for desc, _ in matches)
+                first_lineno = matches[0][1]
+                discoveries.append(
+                    Discovery(
+                        discovery_type=DiscoveryType.STALE_COMMENT,
+                        title=f"Stale comments in {sf.rel_path}",
+                        description=f"Found {len(matches)} marker comment(s) in {sf.rel_path}: {details_str}",
+                        priority="low",
+                        relevant_files=[sf.rel_path],
+                        source_detail=details_str,
+                        code_context=self._extract_context(sf.source, first_lineno),
+                        # Scope stays empty for files that do not parse
+                        function_scope=sf.facts.scope_at(first_lineno),
                     )
+                )
 
         return discoveries
 
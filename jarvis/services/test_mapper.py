@@ -1,14 +1,25 @@
 """Maps source modules to their test files via import scanning.
 
 Enables targeted test runs by identifying which test files exercise
-a given source module. Uses AST parsing to extract imports from test
-files and builds a reverse mapping from source path to test paths.
+a given source module. Imports are taken from the shared
+:class:`CodeAnalysisEngine`, so test files already analyzed (by an
+earlier build or by SystemAnalyzer using the same engine) are not parsed
+again, and a reverse mapping from source path to test paths is built.
+
+:meth:`TestMapper.affected_tests` extends the mapping through the
+source import graph, so a change to a module also selects the tests of
+every module that imports it, directly or not.
 """
 
 from __future__ import annotations
 
-import ast
 from pathlib import Path
+from typing import Optional
+
+from .code_analysis import CodeAnalysisEngine, FileFacts
+
+# Changes to these never affect test outcomes
+_DOC_SUFFIXES = (".md", ".rst", ".txt")
 
 
 class TestMapper:
@@ -16,9 +27,18 @@ class TestMapper:
 
     __test__ = False
 
-    def __init__(self, project_root: str) -> None:
+    def __init__(self, project_root: str, engine: Optional[CodeAnalysisEngine] = None) -> None:
         self._project_root = Path(project_root)
+        self._engine = engine
         self._mapping: dict[str, set[str]] | None = None  # source_path -> set of test paths
+        self._importers: dict[str, set[str]] | None = None  # source_path -> sources importing it
+        self._resolved: dict[str, str | None] = {}
+
+    @property
+    def engine(self) -> CodeAnalysisEngine:
+        if self._engine is None:
+            self._engine = CodeAnalysisEngine()
+        return self._engine
 
     def build_mapping(self) -> None:
         """Scan all test files and build the import-to-test mapping."""
@@ -27,30 +47,15 @@ class TestMapper:
         if not tests_dir.is_dir():
             return
 
-        for test_file in tests_dir.glob("test_*.py"):
-            rel_test = str(test_file.relative_to(self._project_root))
-            try:
-                source = test_file.read_text(encoding="utf-8")
-                tree = ast.parse(source, filename=str(test_file))
-            except Exception:
+        run = self.engine.analyze(self._project_root, tests_dir.glob("test_*.py"))
+        for rel_test, sf in run.files.items():
+            if sf.facts is None or not sf.facts.parsed:
                 continue
-
-            imported_modules: set[str] = set()
-
-            for node in ast.walk(tree):
-                if isinstance(node, ast.Import):
-                    for alias in node.names:
-                        if alias.name.startswith("jarvis."):
-                            imported_modules.add(alias.name)
-                elif isinstance(node, ast.ImportFrom):
-                    if node.module and node.module.startswith("jarvis."):
-                        imported_modules.add(node.module)
+            test_file = self._project_root / rel_test
 
             # Resolve import paths to file paths
-            for mod in imported_modules:
-                source_path = self._resolve_module(mod)
-                if source_path:
-                    self._mapping.setdefault(source_path, set()).add(rel_test)
+            for source_path in self._resolve_imports(rel_test, sf.facts):
+                self._mapping.setdefault(source_path, set()).add(rel_test)
 
             # Also apply naming convention: test_foo_service.py -> jarvis/services/foo_service.py
             stem = test_file.stem  # e.g. "test_foo_service"
@@ -79,9 +84,107 @@ class TestMapper:
 
         return sorted(result)
 
+    def affected_tests(self, changed_files: list[str]) -> list[str] | None:
+        """Return the tests that can be affected by *changed_files*.
+
+        Follows imports transitively: a test is selected when it imports
+        a changed module or any module that (indirectly) imports one.
+        Changed test files select themselves and documentation changes
+        select nothing. Returns ``None`` when a change cannot be mapped
+        (``conftest.py``, configuration, deleted modules, ...) and the
+        caller should run the full suite.
+        """
+        if self._mapping is None:
+            self.build_mapping()
+        if self._importers is None:
+            self._build_import_graph()
+
+        selected: set[str] = set()
+        pending: list[str] = []
+        for f in changed_files:
+            rel = f.replace(str(self._project_root) + "/", "")
+            path = self._project_root / rel
+            if rel.endswith(_DOC_SUFFIXES):
+                continue
+            if rel.startswith("tests/"):
+                if Path(rel).parent == Path("tests") and Path(rel).name.startswith("test_"):
+                    if path.exists():
+                        selected.add(rel)
+                    continue
+                return None
+            if rel.startswith("jarvis/") and rel.endswith(".py") and path.exists():
+                pending.append(rel)
+                continue
+            return None
+
+        seen = set(pending)
+        while pending:
+            source = pending.pop()
+            selected.update(self._mapping.get(source, ()))
+            for importer in self._importers.get(source, ()):
+                if importer not in seen:
+                    seen.add(importer)
+                    pending.append(importer)
+        return sorted(selected)
+
     def invalidate(self) -> None:
         """Force the mapping to be rebuilt on next call."""
         self._mapping = None
+        self._importers = None
+        self._resolved = {}
+
+    def _build_import_graph(self) -> None:
+        """Reverse import graph of every module under ``jarvis/``."""
+        self._importers = {}
+        package_dir = self._project_root / "jarvis"
+        if not package_dir.is_dir():
+            return
+        run = self.engine.analyze(self._project_root, package_dir.rglob("*.py"))
+        for rel_path, sf in run.files.items():
+            if sf.facts is None or not sf.facts.parsed:
+                continue
+            for target in self._resolve_imports(rel_path, sf.facts):
+                self._importers.setdefault(target, set()).add(rel_path)
+
+    def _resolve_imports(self, rel_path: str, facts: FileFacts) -> set[str]:
+        """Project files imported by *rel_path*, relative imports included.
+
+        Only explicit imports count: ``from pkg import mod`` depends on
+        ``mod`` alone, not on ``pkg/__init__.py`` running first. The
+        top-level package imports nearly everything, so following those
+        implicit edges would select the whole suite for any change; import
+        breakage is left to the full-suite run.
+        """
+        package = Path(rel_path).parent.parts
+        targets: set[str] = set()
+        for level, module, names in facts.imports:
+            if level:
+                if level - 1 > len(package):
+                    continue
+                base = list(package[: len(package) - level + 1])
+                dotted = ".".join(base + (module.split(".") if module else []))
+            else:
+                dotted = module
+            if dotted != "jarvis" and not dotted.startswith("jarvis."):
+                continue
+            module_file = self._resolve_cached(dotted)
+            # ``from pkg import name`` may name a submodule
+            names_in_module = not names
+            for name in names:
+                sub = self._resolve_cached(f"{dotted}.{name}") if name != "*" else None
+                if sub and sub != module_file:
+                    targets.add(sub)
+                else:
+                    names_in_module = True
+            if names_in_module and module_file:
+                targets.add(module_file)
+        targets.discard(rel_path)
+        return targets
+
+    def _resolve_cached(self, module_path: str) -> str | None:
+        if module_path not in self._resolved:
+            self._resolved[module_path] = self._resolve_module(module_path)
+        return self._resolved[module_path]
 
     def _resolve_module(self, module_path: str) -> str | None:
         """Convert a dotted import path to a relative file path.
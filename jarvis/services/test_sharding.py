@@ -0,0 +1,321 @@
+"""Sharded pytest runs balanced by recorded per-test durations.
+
+A run is split into file-level shards that execute as concurrent pytest
+subprocesses, one per CPU core by default.  Every shard writes a JUnit
+XML report; per-test durations from those reports are kept in a small
+SQLite store (through the shared :class:`~jarvis.storage.StorageEngine`)
+and summed per file to balance the next run's shards (longest first,
+each onto the currently lightest shard).
+
+Files listed explicitly on the pytest command line bypass the
+``--ignore`` options in the project's ``addopts``, so they are
+filtered here before planning.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import heapq
+import os
+import shlex
+import statistics
+import tempfile
+import time
+import tomllib
+import xml.etree.ElementTree as ET
+from dataclasses import dataclass, field
+from datetime import datetime, timezone
+from pathlib import Path
+from typing import Any, Awaitable, Callable, Dict, List, Optional
+
+from ..storage import StorageEngine
+
+DB_PATH = Path.home() / ".jarvis" / "test_durations.db"
+
+# Weight of the newest measurement in the moving average
+_SMOOTHING = 0.5
+_DEFAULT_FILE_SECONDS = 1.0
+# Pytest exit code for "no tests collected"
+_NO_TESTS = 5
+
+_CREATE_TABLE = """
+CREATE TABLE IF NOT EXISTS test_durations (
+    test_id  TEXT PRIMARY KEY,
+    file     TEXT NOT NULL,
+    seconds  REAL NOT NULL,
+    runs     INTEGER NOT NULL DEFAULT 1,
+    updated  TEXT NOT NULL
+);
+"""
+
+_CREATE_INDEX = """
+CREATE INDEX IF NOT EXISTS idx_test_durations_file ON test_durations(file);
+"""
+
+RunSubprocess = Callable[..., Awaitable[Any]]
+
+
+@dataclass
+class ShardedRun:
+    """Combined outcome of all shards of one test run."""
+
+    success: bool
+    exit_code: int
+    stdout: str
+    stderr: str
+    duration_seconds: float
+    shards: List[List[str]] = field(default_factory=list)
+    tests_recorded: int = 0
+
+
+class TestDurationStore:
+    """Per-test durations, smoothed across runs."""
+
+    __test__ = False
+
+    def __init__(self, db_path: str | None = None) -> None:
+        self._db_path = Path(db_path) if db_path else DB_PATH
+        self._db_path.parent.mkdir(parents=True, exist_ok=True)
+        self._db = StorageEngine.open(self._db_path)
+        self._db.write_script([_CREATE_TABLE, _CREATE_INDEX])
+
+    def record(self, durations: Dict[str, tuple[str, float]]) -> int:
+        """Record ``{test_id: (file, seconds)}``; returns the number stored."""
+        if not durations:
+            return 0
+        now = datetime.now(timezone.utc).isoformat()
+        self._db.write_many(
+            f"""INSERT INTO test_durations (test_id, file, seconds, runs, updated)
+               VALUES (?, ?, ?, 1, ?)
+               ON CONFLICT(test_id) DO UPDATE SET
+                   file = excluded.file,
+                   seconds = {1 - _SMOOTHING} * seconds + {_SMOOTHING} * excluded.seconds,
+                   runs = runs + 1,
+                   updated = excluded.updated""",
+            [(test_id, file, seconds, now) for test_id, (file, seconds) in durations.items()],
+        )
+        return len(durations)
+
+    def file_costs(self, files: List[str]) -> Dict[str, float]:
+        """Summed test durations for the *files* that have any recorded."""
+        costs: Dict[str, float] = {}
+        for i in range(0, len(files), 500):
+            chunk = files[i:i + 500]
+            rows = self._db.fetchall(
+                f"SELECT file, SUM(seconds) AS total FROM test_durations "
+                f"WHERE file IN ({','.join('?' * len(chunk))}) GROUP BY file",
+                chunk,
+            )
+            costs.update({row["file"]: row["total"] for row in rows})
+        return costs
+
+    def close(self) -> None:
+        self._db.release()
+
+
+def plan_shards(files: List[str], costs: Dict[str, float], shards: int) -> List[List[str]]:
+    """Split *files* into at most *shards* groups of similar total cost.
+
+    Files without a recorded cost are assumed to take the median of the
+    known ones.
+    """
+    shards = max(1, min(shards, len(files)))
+    known = [costs[f] for f in files if f in costs]
+    default = statistics.median(known) if known else _DEFAULT_FILE_SECONDS
+    ordered = sorted(files, key=lambda f: (-costs.get(f, default), f))
+
+    heap = [(0.0, i) for i in range(shards)]
+    groups: List[List[str]] = [[] for _ in range(shards)]
+    for f in ordered:
+        total, i = heapq.heappop(heap)
+        groups[i].append(f)
+        heapq.heappush(heap, (total + costs.get(f, default), i))
+    return [sorted(g) for g in groups if g]
+
+
+def parse_junit(path: Path) -> Dict[str, tuple[str, float]]:
+    """Read ``{test_id: (file, seconds)}`` from an xunit1 JUnit report."""
+    durations: Dict[str, tuple[str, float]] = {}
+    try:
+        root = ET.parse(path).getroot()
+    except (OSError, ET.ParseError):
+        return durations
+    for case in root.iter("testcase"):
+        file = case.get("file")
+        if not file:
+            continue
+        try:
+            seconds = float(case.get("time", "0"))
+        except ValueError:
+            continue
+        test_id = f"{case.get('classname', '')}::{case.get('name', '')}"
+        durations[test_id] = (file, seconds)
+    return durations
+
+
+def ignored_paths(root: Path) -> List[str]:
+    """``--ignore`` entries from the pytest ``addopts`` in *root*/pyproject.toml."""
+    try:
+        with open(root / "pyproject.toml", "rb") as fh:
+            options = tomllib.load(fh)["tool"]["pytest"]["ini_options"]
+    except (OSError, KeyError, tomllib.TOMLDecodeError):
+        return []
+    addopts = options.get("addopts", "")
+    args = shlex.split(addopts) if isinstance(addopts, str) else list(addopts)
+    ignored = []
+    for i, arg in enumerate(args):
+        if arg.startswith("--ignore="):
+            ignored.append(arg.split("=", 1)[1])
+        elif arg == "--ignore" and i + 1 < len(args):
+            ignored.append(args[i + 1])
+    return [p.rstrip("/") for p in ignored]
+
+
+def _is_ignored(file: str, ignored: List[str]) -> bool:
+    return any(file == p or file.startswith(p + "/") for p in ignored)
+
+
+@dataclass
+class _Outcome:
+    exit_code: int
+    stdout: str
+    stderr: str
+    duration_seconds: float
+
+
+async def _run_subprocess(
+    cmd: List[str], cwd: str | None = None, timeout: float | None = None
+) -> Any:
+    """Minimal subprocess runner used when no other runner is supplied."""
+    start = time.monotonic()
+    process = await asyncio.create_subprocess_exec(
+        *cmd,
+        cwd=cwd,
+        stdout=asyncio.subprocess.PIPE,
+        stderr=asyncio.subprocess.PIPE,
+    )
+    try:
+        stdout, stderr = await asyncio.wait_for(process.communicate(), timeout=timeout)
+    except asyncio.TimeoutError:
+        try:
+            process.kill()
+            await process.wait()
+        except Exception:
+            pass
+        return _Outcome(-1, "", f"Process timed out after {timeout}s", time.monotonic() - start)
+    return _Outcome(
+        process.returncode or 0,
+        stdout.decode(errors="replace"),
+        stderr.decode(errors="replace"),
+        time.monotonic() - start,
+    )
+
+
+class ShardedTestRunner:
+    """Runs pytest across concurrent, duration-balanced shards.
+
+    *run_subprocess* is awaited as ``run_subprocess(cmd, cwd=..., timeout=...)``
+    and must return an object with ``exit_code``, ``stdout`` and ``stderr``.
+    """
+
+    def __init__(
+        self,
+        durations: Optional[TestDurationStore] = None,
+        max_shards: Optional[int] = None,
+        run_subprocess: Optional[RunSubprocess] = None,
+    ) -> None:
+        self._durations = durations
+        self.max_shards = max_shards or os.cpu_count() or 1
+        self._run = run_subprocess or _run_subprocess
+
+    @property
+    def durations(self) -> TestDurationStore:
+        if self._durations is None:
+            self._durations = TestDurationStore()
+        return self._durations
+
+    def plan(self, cwd: str, test_files: Optional[List[str]]) -> List[List[str]]:
+        """File groups for one run; ``[[]]`` means one unsharded pytest call."""
+        root = Path(cwd)
+        ignored = ignored_paths(root)
+        if test_files is None:
+            if self.max_shards < 2:
+                return [[]]
+            test_files = sorted(
+                str(p.relative_to(root)) for p in (root / "tests").glob("test_*.py")
+            )
+            if not test_files:
+                return [[]]
+        files = [f for f in test_files if not _is_ignored(f, ignored)]
+        if not files:
+            return []
+        if self.max_shards < 2 or len(files) < 2:
+            return [files]
+        try:
+            costs = self.durations.file_costs(files)
+        except Exception:
+            costs = {}
+        return plan_shards(files, costs, self.max_shards)
+
+    async def run(
+        self,
+        cwd: str,
+        pytest_args: List[str],
+        test_files: Optional[List[str]] = None,
+        timeout: Optional[float] = None,
+    ) -> ShardedRun:
+        """Run ``pytest_args`` over *test_files* (the whole suite if ``None``)."""
+        start = time.monotonic()
+        shards = await asyncio.to_thread(self.plan, cwd, test_files)
+        if not shards:
+            return ShardedRun(True, 0, "No tests selected", "", 0.0)
+
+        with tempfile.TemporaryDirectory(prefix="jarvis-shards-") as tmp:
+            reports = [Path(tmp) / f"shard-{i}.xml" for i in range(len(shards))]
+            results = await asyncio.gather(*(
+                self._run(
+                    [
+                        *pytest_args,
+                        f"--junitxml={report}",
+                        "-o", "junit_family=xunit1",
+                        *files,
+                    ],
+                    cwd=cwd,
+                    timeout=timeout,
+                )
+                for files, report in zip(shards, reports)
+            ))
+            durations: Dict[str, tuple[str, float]] = {}
+            for report in reports:
+                durations.update(parse_junit(report))
+
+        recorded = 0
+        if durations:
+            try:
+                recorded = await asyncio.to_thread(self.durations.record, durations)
+            except Exception:
+                recorded = 0
+
+        codes = [r.exit_code for r in results]
+        failed = [c for c in codes if c not in (0, _NO_TESTS)]
+        success = not failed and 0 in codes
+        multi = len(shards) > 1
+
+        def joined(attr: str) -> str:
+            parts = [getattr(r, attr) for r in results]
+            if not multi:
+                return parts[0]
+            return "\n".join(
+                f"=== shard {i + 1}/{len(shards)} ===\n{text}"
+                for i, text in enumerate(parts) if text
+            )
+
+        return ShardedRun(
+            success=success,
+            exit_code=0 if success else (failed[0] if failed else codes[0]),
+            stdout=joined("stdout"),
+            stderr=joined("stderr"),
+            duration_seconds=round(time.monotonic() - start, 2),
+            shards=shards,
+            tests_recorded=recorded,
+        )
@@ -2,6 +2,10 @@
 
 Provides a Linear-style taskboard with statuses, priorities, tags, and
 due dates. All data is persisted locally in ~/.jarvis/todos.db.
+
+SQLite access goes through the shared :class:`~jarvis.storage.StorageEngine`
+(single writer thread, read pool); async callers should use ``run`` so
+queries never execute on the event loop.
 """
 
 from __future__ import annotations
@@ -12,9 +16,12 @@ from dataclasses import dataclass, field
 from datetime import datetime, timezone
 from enum import Enum
 from pathlib import Path
-from typing import Any, Dict, List, Optional
+from typing import Any, Callable, Dict, List, Optional, TypeVar
 
 from ..logging import JarvisLogger
+from ..storage import StorageEngine
+
+T = TypeVar("T")
 
 
 class TaskStatus(str, Enum):
@@ -100,6 +107,17 @@ CREATE TABLE IF NOT EXISTS todos (
 );
 """
 
+# (status, created_at) covers counts_by_status and status-filtered listing;
+# the others serve the priority filter and the default created_at ordering.
+_CREATE_INDEXES = (
+    "CREATE INDEX IF NOT EXISTS idx_todos_status_created ON todos(status, created_at)",
+    "CREATE INDEX IF NOT EXISTS idx_todos_priority_created ON todos(priority, created_at)",
+    "CREATE INDEX IF NOT EXISTS idx_todos_created ON todos(created_at)",
+)
+
+_INSERT = """INSERT INTO todos (id, title, description, status, priority, tags, due_date, created_at, updated_at)
+               VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)"""
+
 
 class TodoService:
     """CRUD service for todo items backed by SQLite."""
@@ -112,10 +130,20 @@ class TodoService:
         self.logger = logger or JarvisLogger()
         self._db_path = Path(db_path) if db_path else DB_PATH
         self._db_path.parent.mkdir(parents=True, exist_ok=True)
-        self._conn = sqlite3.connect(str(self._db_path))
-        self._conn.row_factory = sqlite3.Row
-        self._conn.execute(_CREATE_TABLE)
-        self._conn.commit()
+        self._db = StorageEngine.open(self._db_path)
+        self._db.write_script([_CREATE_TABLE, *_CREATE_INDEXES])
+
+    async def run(self, fn: Callable[..., T], *args: Any, **kwargs: Any) -> T:
+        """Await a service method (or any callable using it) on the DB thread."""
+        return await self._db.arun(fn, *args, **kwargs)
+
+    def batch(self):
+        """Context manager committing all writes inside it as one transaction."""
+        return self._db.transaction()
+
+    def get_db_stats(self) -> Dict[str, Any]:
+        """Statement timings, including time spent blocking an event loop."""
+        return self._db.get_stats()
 
     # ------------------------------------------------------------------
     # CRUD
@@ -130,8 +158,38 @@ class TodoService:
         due_date: Optional[str] = None,
     ) -> TodoItem:
         """Create a new task and return it."""
+        item = self._new_item(title, description, priority, tags, due_date)
+        self._db.write(_INSERT, self._insert_params(item))
+        self.logger.log("INFO", "Todo created", f"{item.id}: {item.title}")
+        return item
+
+    def create_many(self, specs: List[Dict[str, Any]]) -> List[TodoItem]:
+        """Create several tasks in one transaction. Each spec takes ``create`` kwargs."""
+        items = [
+            self._new_item(
+                spec["title"],
+                spec.get("description", ""),
+                spec.get("priority", "medium"),
+                spec.get("tags"),
+                spec.get("due_date"),
+            )
+            for spec in specs
+        ]
+        if items:
+            self._db.write_many(_INSERT, [self._insert_params(i) for i in items])
+            self.logger.log("INFO", "Todos created", f"{len(items)} tasks")
+        return items
+
+    @staticmethod
+    def _new_item(
+        title: str,
+        description: str,
+        priority: str,
+        tags: Optional[List[str]],
+        due_date: Optional[str],
+    ) -> TodoItem:
         now = datetime.now(timezone.utc).isoformat()
-        item = TodoItem(
+        return TodoItem(
             id=str(uuid.uuid4())[:8],
             title=title,
             description=description,
@@ -142,31 +200,27 @@ class TodoService:
             created_at=now,
             updated_at=now,
         )
-        self._conn.execute(
-            """INSERT INTO todos (id, title, description, status, priority, tags, due_date, created_at, updated_at)
-               VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)""",
-            (
-                item.id,
-                item.title,
-                item.description,
-                item.status.value,
-                item.priority.value,
-                ",".join(item.tags),
-                item.due_date,
-                item.created_at,
-                item.updated_at,
-            ),
+
+    @staticmethod
+    def _insert_params(item: TodoItem) -> tuple:
+        return (
+            item.id,
+            item.title,
+            item.description,
+            item.status.value,
+            item.priority.value,
+            ",".join(item.tags),
+            item.due_date,
+            item.created_at,
+            item.updated_at,
         )
-        self._conn.commit()
-        self.logger.log("INFO", "Todo created", f"{item.id}: {item.title}")
-        return item
 
     def get(self, todo_id: str) -> Optional[TodoItem]:
         """Fetch a single task by ID (or partial ID prefix)."""
-        row = self._conn.execute(
+        row = self._db.fetchone(
             "SELECT * FROM todos WHERE id = ? OR id LIKE ?",
             (todo_id, f"{todo_id}%"),
-        ).fetchone()
+        )
         return TodoItem.from_row(row) if row else None
 
     def list(
@@ -188,11 +242,15 @@ class TodoService:
             query += " AND (',' || tags || ',') LIKE ?"
             params.append(f"%,{tag},%")
         query += " ORDER BY created_at DESC"
-        rows = self._conn.execute(query, params).fetchall()
+        rows = self._db.fetchall(query, params)
         return [TodoItem.from_row(r) for r in rows]
 
     def update(self, todo_id: str, **fields: Any) -> Optional[TodoItem]:
         """Update fields on an existing task. Returns the updated item."""
+        with self._db.transaction():
+            return self._update_locked(todo_id, fields)
+
+    def _update_locked(self, todo_id: str, fields: Dict[str, Any]) -> Optional[TodoItem]:
         item = self.get(todo_id)
         if not item:
             return None
@@ -217,20 +275,17 @@ class TodoService:
         updates["updated_at"] = datetime.now(timezone.utc).isoformat()
         set_clause = ", ".join(f"{k} = ?" for k in updates)
         values = list(updates.values()) + [item.id]
-        self._conn.execute(
-            f"UPDATE todos SET {set_clause} WHERE id = ?", values
-        )
-        self._conn.commit()
+        self._db.write(f"UPDATE todos SET {set_clause} WHERE id = ?", values)
         self.logger.log("INFO", "Todo updated", f"{item.id}")
         return self.get(item.id)
 
     def delete(self, todo_id: str) -> bool:
         """Delete a task. Returns True if a row was removed."""
-        item = self.get(todo_id)
-        if not item:
-            return False
-        self._conn.execute("DELETE FROM todos WHERE id = ?", (item.id,))
-        self._conn.commit()
+        with self._db.transaction():
+            item = self.get(todo_id)
+            if not item:
+                return False
+            self._db.write("DELETE FROM todos WHERE id = ?", (item.id,))
         self.logger.log("INFO", "Todo deleted", f"{item.id}: {item.title}")
         return True
 
@@ -248,13 +303,16 @@ class TodoService:
 
     def counts_by_status(self) -> Dict[str, int]:
         """Return {status: count} for all statuses."""
-        rows = self._conn.execute(
+        rows = self._db.fetchall(
             "SELECT status, COUNT(*) as cnt FROM todos GROUP BY status"
-        ).fetchall()
+        )
         counts = {s.value: 0 for s in TaskStatus}
         for row in rows:
             counts[row["status"]] = row["cnt"]
         return counts
 
     def close(self) -> None:
-        self._conn.close()
+        """Close the database connection. Safe to call multiple times."""
+        db, self._db = self._db, None
+        if db is not None:
+            db.release()
@@ -52,6 +52,7 @@ class VectorMemoryService:
     ) -> None:
         # Version-agnostic client creation
         persist_dir = persist_directory or "./chroma"
+        self.persist_directory = os.path.abspath(persist_dir)
 
         if hasattr(chromadb, "PersistentClient"):
             self.client = chromadb.PersistentClient(path=persist_dir)
@@ -0,0 +1,6 @@
+"""Shared SQLite storage engine and startup snapshot for Jarvis' local stores."""
+
+from .engine import StorageEngine, WriteResult
+from .snapshot import StartupSnapshot, content_digest, schema_fingerprint
+
+__all__ = ["StartupSnapshot", "StorageEngine", "WriteResult", "content_digest", "schema_fingerprint"]
@@ -0,0 +1,496 @@
+"""Single-writer SQLite storage engine shared by all local stores.
+
+Every database file gets one :class:`StorageEngine` (see :meth:`open`):
+
+* one writer thread owning the only write connection.  Writes queued by
+  any number of callers are coalesced into a single transaction (group
+  commit), each isolated by a savepoint so one bad statement fails only
+  its own caller.
+* a small pool of read connections.  WAL lets reads run concurrently
+  with the writer and always see the last committed group.
+* identical pragmas on every connection (WAL, ``synchronous=NORMAL``,
+  mmap, busy timeout).
+* an awaitable API: ``awrite`` resolves on commit without occupying an
+  executor thread; ``afetch*`` and ``arun`` use the read pool threads.
+
+``transaction()`` leases the write connection to the calling thread for
+read-modify-write sequences; engine calls made on that thread while the
+lease is held run directly on the leased connection.
+
+Statement time spent on a thread that is running an event loop is
+reported as ``loop_blocking_ms`` in :meth:`get_stats`.
+"""
+
+from __future__ import annotations
+
+import asyncio
+import functools
+import os
+import queue
+import sqlite3
+import threading
+import time
+from concurrent.futures import Future, ThreadPoolExecutor
+from contextlib import contextmanager
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, Callable, Dict, Iterable, Iterator, List, Optional, Sequence, TypeVar, Union
+
+T = TypeVar("T")
+
+DEFAULT_READ_POOL_SIZE = 4
+DEFAULT_MAX_GROUP = 256
+DEFAULT_MMAP_BYTES = 64 * 1024 * 1024
+DEFAULT_BUSY_TIMEOUT_MS = 10_000
+
+
+@dataclass
+class WriteResult:
+    """Outcome of a single queued write."""
+
+    rowcount: int
+    lastrowid: Optional[int]
+
+
+class _Lease:
+    """Writer-thread handoff for :meth:`StorageEngine.transaction`."""
+
+    def __init__(self) -> None:
+        self.granted: Future = Future()
+        self.done = threading.Event()
+
+
+class _Job:
+    __slots__ = ("fn", "future")
+
+    def __init__(self, fn: Callable[[sqlite3.Connection], Any]) -> None:
+        self.fn = fn
+        self.future: Future = Future()
+
+
+_STOP = object()
+
+
+def _on_event_loop_thread() -> bool:
+    try:
+        asyncio.get_running_loop()
+    except RuntimeError:
+        return False
+    return True
+
+
+class StorageEngine:
+    """One writer thread plus a read pool for a single SQLite file."""
+
+    _engines: Dict[str, "StorageEngine"] = {}
+    # Re-entrant: a finalizer releasing another engine may run inside open().
+    _engines_lock = threading.RLock()
+
+    # ------------------------------------------------------------------
+    # Construction / registry
+    # ------------------------------------------------------------------
+
+    @classmethod
+    def open(cls, db_path: Union[str, Path], **kwargs: Any) -> "StorageEngine":
+        """Return the shared engine for *db_path*, creating it on first use.
+
+        Each call takes a reference; pair it with :meth:`release`.
+        """
+        key = os.path.abspath(str(db_path))
+        with cls._engines_lock:
+            engine = cls._engines.get(key)
+            if engine is not None:
+                engine._refs += 1
+                return engine
+        # Built outside the lock: starting the writer thread can run
+        # finalizers on that thread which release() another engine.
+        fresh: Optional[StorageEngine] = cls(key, **kwargs)
+        with cls._engines_lock:
+            engine = cls._engines.get(key)
+            if engine is None:
+                engine = cls._engines[key] = fresh
+                fresh = None
+            engine._refs += 1
+        if fresh is not None:  # another thread opened it first
+            fresh._refs = 1
+            fresh.release()
+        return engine
+
+    def __init__(
+        self,
+        db_path: str,
+        read_pool_size: int = DEFAULT_READ_POOL_SIZE,
+        max_group: int = DEFAULT_MAX_GROUP,
+        mmap_bytes: int = DEFAULT_MMAP_BYTES,
+    ) -> None:
+        self.db_path = db_path
+        self.name = Path(db_path).stem
+        self.max_group = max_group
+        self._mmap_bytes = mmap_bytes
+        self._refs = 0
+        self._closed = False
+
+        self._writer_conn = self._connect()
+        self._writer_conn.execute("PRAGMA journal_mode=WAL")
+        self._queue: "queue.Queue[Any]" = queue.Queue()
+        self._local = threading.local()
+
+        self._read_pool_size = max(1, read_pool_size)
+        self._readers: "queue.LifoQueue[sqlite3.Connection]" = queue.LifoQueue()
+        self._all_readers: List[sqlite3.Connection] = []
+        self._readers_lock = threading.Lock()
+        self._read_executor = ThreadPoolExecutor(
+            max_workers=self._read_pool_size, thread_name_prefix=f"{self.name}-read"
+        )
+
+        self._stats_lock = threading.Lock()
+        self._stats: Dict[str, float] = {
+            "writes": 0,
+            "commits": 0,
+            "max_group_size": 0,
+            "commit_ms": 0.0,
+            "reads": 0,
+            "read_ms": 0.0,
+            "loop_blocking_calls": 0,
+            "loop_blocking_ms": 0.0,
+            "max_loop_blocking_ms": 0.0,
+        }
+
+        self._writer_thread = threading.Thread(
+            target=self._writer_loop, name=f"{self.name}-writer", daemon=True
+        )
+        self._writer_thread.start()
+
+    def _connect(self) -> sqlite3.Connection:
+        conn = sqlite3.connect(
+            self.db_path,
+            check_same_thread=False,
+            isolation_level=None,  # explicit BEGIN/COMMIT only
+            cached_statements=256,
+        )
+        conn.row_factory = sqlite3.Row
+        conn.execute("PRAGMA synchronous=NORMAL")
+        conn.execute(f"PRAGMA busy_timeout={DEFAULT_BUSY_TIMEOUT_MS}")
+        conn.execute(f"PRAGMA mmap_size={self._mmap_bytes}")
+        conn.execute("PRAGMA temp_store=MEMORY")
+        return conn
+
+    # ------------------------------------------------------------------
+    # Writer thread
+    # ------------------------------------------------------------------
+
+    def _writer_loop(self) -> None:
+        conn = self._writer_conn
+        pending: Any = None
+        while True:
+            job = pending if pending is not None else self._queue.get()
+            pending = None
+            if job is _STOP:
+                break
+            if isinstance(job, _Lease):
+                self._serve_lease(job)
+                continue
+            group = [job]
+            while len(group) < self.max_group:
+                try:
+                    nxt = self._queue.get_nowait()
+                except queue.Empty:
+                    break
+                if nxt is _STOP or isinstance(nxt, _Lease):
+                    pending = nxt
+                    break
+                group.append(nxt)
+            self._commit_group(conn, group)
+        self._shutdown_connections()
+
+    def _commit_group(self, conn: sqlite3.Connection, group: List[_Job]) -> None:
+        start = time.perf_counter()
+        outcomes: List[tuple] = []
+        try:
+            conn.execute("BEGIN IMMEDIATE")
+            for job in group:
+                conn.execute("SAVEPOINT job")
+                try:
+                    result = job.fn(conn)
+                except BaseException as exc:  # isolate the failing caller
+                    conn.execute("ROLLBACK TO job")
+                    conn.execute("RELEASE job")
+                    outcomes.append((job, None, exc))
+                else:
+                    conn.execute("RELEASE job")
+                    outcomes.append((job, result, None))
+            conn.execute("COMMIT")
+        except BaseException as exc:
+            if conn.in_transaction:
+                conn.execute("ROLLBACK")
+            for job in group:
+                if not job.future.done():
+                    job.future.set_exception(exc)
+            return
+
+        elapsed_ms = (time.perf_counter() - start) * 1000
+        with self._stats_lock:
+            self._stats["writes"] += len(group)
+            self._stats["commits"] += 1
+            self._stats["commit_ms"] += elapsed_ms
+            self._stats["max_group_size"] = max(self._stats["max_group_size"], len(group))
+        for job, result, exc in outcomes:
+            if exc is not None:
+                job.future.set_exception(exc)
+            else:
+                job.future.set_result(result)
+
+    def _serve_lease(self, lease: _Lease) -> None:
+        conn = self._writer_conn
+        try:
+            conn.execute("BEGIN IMMEDIATE")
+        except BaseException as exc:
+            lease.granted.set_exception(exc)
+            return
+        lease.granted.set_result(conn)
+        lease.done.wait()
+        if conn.in_transaction:  # holder exited without finishing
+            conn.execute("ROLLBACK")
+
+    def _shutdown_connections(self) -> None:
+        try:
+            self._writer_conn.close()
+        except Exception:
+            pass
+        self._read_executor.shutdown(wait=False)
+        with self._readers_lock:
+            for conn in self._all_readers:
+                try:
+                    conn.close()
+                except Exception:
+                    pass
+            self._all_readers.clear()
+
+    # ------------------------------------------------------------------
+    # Measurement
+    # ------------------------------------------------------------------
+
+    def _measured(self, fn: Callable[[], T], kind: Optional[str] = None) -> T:
+        start = time.perf_counter()
+        try:
+            return fn()
+        finally:
+            elapsed_ms = (time.perf_counter() - start) * 1000
+            with self._stats_lock:
+                stats = self._stats
+                if kind == "read":
+                    stats["reads"] += 1
+                    stats["read_ms"] += elapsed_ms
+                if _on_event_loop_thread():
+                    stats["loop_blocking_calls"] += 1
+                    stats["loop_blocking_ms"] += elapsed_ms
+                    stats["max_loop_blocking_ms"] = max(stats["max_loop_blocking_ms"], elapsed_ms)
+
+    # ------------------------------------------------------------------
+    # Writes
+    # ------------------------------------------------------------------
+
+    def _leased_conn(self) -> Optional[sqlite3.Connection]:
+        return getattr(self._local, "conn", None)
+
+    def submit(self, fn: Callable[[sqlite3.Connection], T]) -> "Future[T]":
+        """Queue ``fn(conn)`` for the writer thread; resolves after commit."""
+        if self._closed:
+            raise RuntimeError(f"StorageEngine for {self.db_path} is closed")
+        job = _Job(fn)
+        self._queue.put(job)
+        return job.future
+
+    def call(self, fn: Callable[[sqlite3.Connection], T]) -> T:
+        """Run ``fn(conn)`` as a write and wait for it to be committed."""
+        leased = self._leased_conn()
+        if leased is not None:
+            return fn(leased)
+        return self._measured(lambda: self.submit(fn).result())
+
+    def write(self, sql: str, params: Sequence[Any] = ()) -> WriteResult:
+        return self.call(functools.partial(_execute, sql, params))
+
+    def write_many(self, sql: str, rows: Iterable[Sequence[Any]]) -> WriteResult:
+        rows = list(rows)
+        return self.call(functools.partial(_executemany, sql, rows))
+
+    def write_nowait(self, sql: str, params: Sequence[Any] = ()) -> "Future[WriteResult]":
+        """Queue a write without waiting for it to commit.
+
+        For high-volume, non-critical rows (log lines, outcome counters):
+        the caller never blocks on the writer, and the write joins the next
+        group commit.  Inside a :meth:`transaction` lease it runs directly.
+        """
+        leased = self._leased_conn()
+        if leased is not None:
+            future: Future = Future()
+            future.set_result(_execute(sql, params, leased))
+            return future
+        return self.submit(functools.partial(_execute, sql, params))
+
+    def write_script(self, statements: Iterable[str]) -> None:
+        """Run several parameterless statements (e.g. schema) in one job."""
+        statements = list(statements)
+
+        def run(conn: sqlite3.Connection) -> None:
+            for statement in statements:
+                conn.execute(statement)
+
+        self.call(run)
+
+    @contextmanager
+    def transaction(self) -> Iterator[sqlite3.Connection]:
+        """Lease the write connection to this thread for the block.
+
+        Reads and writes issued through the engine on this thread use the
+        lease; everything commits together on exit (rolled back on error).
+        Nested blocks join the outer transaction.
+        """
+        local = self._local
+        leased = getattr(local, "conn", None)
+        if leased is not None:
+            local.depth += 1
+            try:
+                yield leased
+            finally:
+                local.depth -= 1
+            return
+        if threading.current_thread() is self._writer_thread:
+            raise RuntimeError("transaction() cannot be opened from the writer thread")
+
+        lease = _Lease()
+        self._queue.put(lease)
+        conn = self._measured(lease.granted.result)
+        local.conn = conn
+        local.depth = 1
+        start = time.perf_counter()
+        try:
+            yield conn
+        except BaseException:
+            conn.execute("ROLLBACK")
+            raise
+        else:
+            try:
+                conn.execute("COMMIT")
+            except BaseException:
+                conn.execute("ROLLBACK")
+                raise
+            with self._stats_lock:
+                self._stats["commits"] += 1
+                self._stats["commit_ms"] += (time.perf_counter() - start) * 1000
+        finally:
+            local.conn = None
+            local.depth = 0
+            lease.done.set()
+
+    def flush(self) -> None:
+        """Block until every write queued so far is committed."""
+        if self._leased_conn() is None:
+            self.submit(lambda conn: None).result()
+
+    # ------------------------------------------------------------------
+    # Reads
+    # ------------------------------------------------------------------
+
+    @contextmanager
+    def _reader(self) -> Iterator[sqlite3.Connection]:
+        leased = self._leased_conn()
+        if leased is not None:
+            yield leased
+            return
+        try:
+            conn = self._readers.get_nowait()
+        except queue.Empty:
+            with self._readers_lock:
+                if len(self._all_readers) < self._read_pool_size:
+                    conn = self._connect()
+                    self._all_readers.append(conn)
+                else:
+                    conn = None
+            if conn is None:
+                conn = self._readers.get()
+        try:
+            yield conn
+        finally:
+            if conn.in_transaction:
+                conn.execute("ROLLBACK")
+            self._readers.put(conn)
+
+    def fetchone(self, sql: str, params: Sequence[Any] = ()) -> Optional[sqlite3.Row]:
+        def run() -> Optional[sqlite3.Row]:
+            with self._reader() as conn:
+                return conn.execute(sql, params).fetchone()
+
+        return self._measured(run, "read")
+
+    def fetchall(self, sql: str, params: Sequence[Any] = ()) -> List[sqlite3.Row]:
+        def run() -> List[sqlite3.Row]:
+            with self._reader() as conn:
+                return conn.execute(sql, params).fetchall()
+
+        return self._measured(run, "read")
+
+    # ------------------------------------------------------------------
+    # Async API
+    # ------------------------------------------------------------------
+
+    async def acall(self, fn: Callable[[sqlite3.Connection], T]) -> T:
+        return await asyncio.wrap_future(self.submit(fn))
+
+    async def awrite(self, sql: str, params: Sequence[Any] = ()) -> WriteResult:
+        return await self.acall(functools.partial(_execute, sql, params))
+
+    async def awrite_many(self, sql: str, rows: Iterable[Sequence[Any]]) -> WriteResult:
+        return await self.acall(functools.partial(_executemany, sql, list(rows)))
+
+    async def arun(self, fn: Callable[..., T], *args: Any, **kwargs: Any) -> T:
+        """Run a blocking callable (typically a store method) on a pool thread."""
+        loop = asyncio.get_running_loop()
+        return await loop.run_in_executor(
+            self._read_executor, functools.partial(fn, *args, **kwargs)
+        )
+
+    async def afetchone(self, sql: str, params: Sequence[Any] = ()) -> Optional[sqlite3.Row]:
+        return await self.arun(self.fetchone, sql, params)
+
+    async def afetchall(self, sql: str, params: Sequence[Any] = ()) -> List[sqlite3.Row]:
+        return await self.arun(self.fetchall, sql, params)
+
+    # ------------------------------------------------------------------
+    # Reporting / lifecycle
+    # ------------------------------------------------------------------
+
+    def get_stats(self) -> Dict[str, Any]:
+        with self._stats_lock:
+            stats = dict(self._stats)
+        commits = stats["commits"]
+        stats["avg_group_size"] = round(stats["writes"] / commits, 2) if commits else 0.0
+        for key in ("commit_ms", "read_ms", "loop_blocking_ms", "max_loop_blocking_ms"):
+            stats[key] = round(stats[key], 3)
+        return stats
+
+    def release(self) -> None:
+        """Drop one reference; the last one stops the writer thread."""
+        with StorageEngine._engines_lock:
+            if self._closed:
+                return
+            self._refs -= 1
+            if self._refs > 0:
+                return
+            self._closed = True
+            if StorageEngine._engines.get(self.db_path) is self:
+                del StorageEngine._engines[self.db_path]
+        self._queue.put(_STOP)
+        if threading.current_thread() is not self._writer_thread:
+            self._writer_thread.join(timeout=5)
+
+
+def _execute(sql: str, params: Sequence[Any], conn: sqlite3.Connection) -> WriteResult:
+    cursor = conn.execute(sql, params)
+    return WriteResult(cursor.rowcount, cursor.lastrowid)
+
+
+def _executemany(sql: str, rows: List[Sequence[Any]], conn: sqlite3.Connection) -> WriteResult:
+    cursor = conn.executemany(sql, rows)
+    return WriteResult(cursor.rowcount, cursor.lastrowid)
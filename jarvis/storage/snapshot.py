@@ -0,0 +1,156 @@
+"""Versioned on-disk snapshot of state Jarvis derives at every boot.
+
+Each section is stored next to the content digest of the inputs it was
+derived from.  :meth:`StartupSnapshot.get` only returns a section when the
+caller's freshly computed digest matches, so a stale section is simply a
+miss: the caller rebuilds it and stores the result with :meth:`put`.
+Sections are pickled when they are put, so later in-place changes to the
+caller's objects never leak into the snapshot, and every ``get`` hands out
+fresh objects.  The file is a short header followed by a pickle of the section
+blobs; a header mismatch or unreadable file discards the whole snapshot,
+an unreadable section is treated as a miss.
+
+Pickled sections hold instances of the caller's classes, so a digest
+must cover their shape as well as the input data: callers mix in
+:func:`schema_fingerprint` of the classes they store, and a build that
+adds or renames a field misses instead of unpickling objects without it.
+
+Sections are recorded in memory as they change and written atomically by
+:meth:`save` (temp file + rename), normally after startup rebuilt
+something and again at shutdown.
+"""
+
+from __future__ import annotations
+
+import dataclasses
+import enum
+import hashlib
+import os
+import pickle
+import threading
+import time
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Tuple, Union
+
+MAGIC = b"JSNAP"
+FORMAT_VERSION = 1
+_HEADER = MAGIC + FORMAT_VERSION.to_bytes(2, "big")
+
+DEFAULT_SNAPSHOT_PATH = os.path.join(str(Path.home()), ".jarvis", "startup_snapshot.bin")
+
+
+def content_digest(*parts: Any) -> str:
+    """Stable digest of *parts* (bytes are hashed raw, anything else by ``repr``)."""
+    h = hashlib.blake2b(digest_size=16)
+    for part in parts:
+        data = part if isinstance(part, bytes) else repr(part).encode()
+        h.update(len(data).to_bytes(8, "big"))
+        h.update(data)
+    return h.hexdigest()
+
+
+def schema_fingerprint(*types: type) -> str:
+    """Digest of the shape of *types*: dataclass fields and enum members."""
+    parts: List[Any] = []
+    for cls in types:
+        if dataclasses.is_dataclass(cls):
+            shape: Any = [(f.name, str(f.type)) for f in dataclasses.fields(cls)]
+        elif isinstance(cls, type) and issubclass(cls, enum.Enum):
+            shape = [(m.name, m.value) for m in cls]
+        else:
+            shape = None
+        parts.append((f"{cls.__module__}.{cls.__qualname__}", shape))
+    return content_digest(*parts)
+
+
+class StartupSnapshot:
+    """Digest-validated cache of derived startup state."""
+
+    def __init__(self, path: Union[str, Path, None] = None) -> None:
+        self.path = Path(path or DEFAULT_SNAPSHOT_PATH)
+        self._sections: Dict[str, Tuple[str, bytes]] = {}
+        self._lock = threading.Lock()
+        self._dirty = False
+        self.loaded = False
+        self.load_ms: Optional[float] = None
+        self.hits: List[str] = []
+        self.misses: List[str] = []
+
+    def load(self) -> bool:
+        """Read the snapshot file; returns ``False`` when absent or unusable."""
+        start = time.perf_counter()
+        sections: Dict[str, Tuple[str, bytes]] = {}
+        try:
+            raw = self.path.read_bytes()
+            if raw.startswith(_HEADER):
+                loaded = pickle.loads(raw[len(_HEADER):])
+                if isinstance(loaded, dict):
+                    sections = loaded
+        except FileNotFoundError:
+            pass
+        except Exception:
+            sections = {}  # corrupt or written by an incompatible build
+        with self._lock:
+            self._sections = sections
+            self.loaded = bool(sections)
+        self.load_ms = round((time.perf_counter() - start) * 1000, 2)
+        return self.loaded
+
+    def get(self, section: str, digest: str) -> Optional[Any]:
+        """Return *section* if it was derived from inputs with *digest*."""
+        with self._lock:
+            entry = self._sections.get(section)
+        if entry is not None and entry[0] == digest:
+            try:
+                data = pickle.loads(entry[1])
+            except Exception:
+                self.invalidate(section)
+            else:
+                with self._lock:
+                    self.hits.append(section)
+                return data
+        with self._lock:
+            self.misses.append(section)
+        return None
+
+    def put(self, section: str, digest: str, data: Any) -> None:
+        blob = pickle.dumps(data, protocol=pickle.HIGHEST_PROTOCOL)
+        with self._lock:
+            if self._sections.get(section) == (digest, blob):
+                return
+            self._sections[section] = (digest, blob)
+            self._dirty = True
+
+    def invalidate(self, section: str) -> None:
+        with self._lock:
+            if self._sections.pop(section, None) is not None:
+                self._dirty = True
+
+    @property
+    def dirty(self) -> bool:
+        return self._dirty
+
+    def save(self) -> bool:
+        """Write the snapshot if anything changed since the last load/save."""
+        with self._lock:
+            if not self._dirty:
+                return False
+            payload = _HEADER + pickle.dumps(self._sections, protocol=pickle.HIGHEST_PROTOCOL)
+            self._dirty = False
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        tmp = self.path.with_name(f"{self.path.name}.{os.getpid()}.tmp")
+        tmp.write_bytes(payload)
+        os.replace(tmp, self.path)
+        return True
+
+    def report(self) -> Dict[str, Any]:
+        with self._lock:
+            return {
+                "path": str(self.path),
+                "loaded": self.loaded,
+                "load_ms": self.load_ms,
+                "hits": sorted(set(self.hits)),
+                "misses": sorted(set(self.misses)),
+                # Warm: every section asked for so far came from the file
+                "warm": self.loaded and not self.misses,
+            }
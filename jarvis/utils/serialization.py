@@ -0,0 +1,137 @@
+"""Canonical JSON serialization for responses, logs and traces.
+
+One encoder is shared by the HTTP layer, :class:`JarvisLogger` and the
+tracer.  ``orjson`` is used when installed; otherwise the standard
+library encoder produces the same compact output.  Objects with a
+``to_dict()`` (``AgentResponse``, ``ErrorInfo``, ...) are encoded in
+that shape, other dataclasses field by field.
+
+A :class:`Payload` wraps a value that several sinks will write: it is
+encoded on first use and every later sink reuses the same bytes instead
+of walking and encoding the structure again, including when the payload
+is nested inside a larger document.
+"""
+
+from __future__ import annotations
+
+import dataclasses
+import json
+from datetime import date, datetime, time
+from enum import Enum
+from typing import Any, Optional
+from uuid import UUID
+
+try:  # Soft dependency: the standard library encoder is the fallback
+    import orjson
+except ImportError:  # pragma: no cover - exercised when orjson is absent
+    orjson = None
+
+
+def _default(obj: Any) -> Any:
+    """Encode values neither encoder handles natively."""
+    if isinstance(obj, Payload):
+        if orjson is not None:
+            # Splice the cached bytes in instead of encoding the value again
+            return orjson.Fragment(obj.json)
+        return obj.value
+    for method, kwargs in (("to_dict", {}), ("model_dump", {"mode": "json"})):
+        convert = getattr(obj, method, None)
+        if callable(convert):
+            try:
+                result = convert(**kwargs)
+            except Exception:
+                break
+            if isinstance(result, (dict, list)):
+                return result
+            break
+    if isinstance(obj, (set, frozenset, tuple)):
+        return list(obj)
+    if isinstance(obj, Enum):
+        return obj.value
+    if isinstance(obj, (datetime, date, time)):
+        return obj.isoformat()
+    if isinstance(obj, UUID):
+        return str(obj)
+    if dataclasses.is_dataclass(obj) and not isinstance(obj, type):
+        # Shallow: nested values come back through this hook as needed
+        return {f.name: getattr(obj, f.name) for f in dataclasses.fields(obj)}
+    if isinstance(obj, bytes):
+        return obj.decode("utf-8", errors="replace")
+    return str(obj)
+
+
+if orjson is not None:
+    # Dataclasses go through _default so their to_dict() shape is kept
+    _OPTIONS = orjson.OPT_NON_STR_KEYS | orjson.OPT_PASSTHROUGH_DATACLASS
+
+    def dumps(obj: Any) -> bytes:
+        """Encode *obj* as compact UTF-8 JSON bytes."""
+        if isinstance(obj, Payload):
+            return obj.json
+        try:
+            return orjson.dumps(obj, default=_default, option=_OPTIONS)
+        except TypeError:
+            # Integers beyond 64 bits, non-finite keys, ...
+            return _stdlib_dumps(obj)
+
+    def loads(data: bytes | str) -> Any:
+        """Decode JSON produced by :func:`dumps` (or any JSON text)."""
+        return orjson.loads(data)
+
+else:
+
+    def dumps(obj: Any) -> bytes:
+        """Encode *obj* as compact UTF-8 JSON bytes."""
+        if isinstance(obj, Payload):
+            return obj.json
+        return _stdlib_dumps(obj)
+
+    def loads(data: bytes | str) -> Any:
+        """Decode JSON produced by :func:`dumps` (or any JSON text)."""
+        return json.loads(data)
+
+
+def _stdlib_default(obj: Any) -> Any:
+    # The stdlib encoder cannot splice an orjson Fragment in
+    if isinstance(obj, Payload):
+        return obj.value
+    return _default(obj)
+
+
+def _stdlib_dumps(obj: Any) -> bytes:
+    return json.dumps(
+        obj, default=_stdlib_default, separators=(",", ":"), ensure_ascii=False
+    ).encode("utf-8")
+
+
+def dumps_str(obj: Any) -> str:
+    """Like :func:`dumps` but returns text."""
+    if isinstance(obj, Payload):
+        return obj.text
+    return dumps(obj).decode("utf-8")
+
+
+class Payload:
+    """A value whose JSON encoding is computed once and shared by sinks.
+
+    The wrapped value must not be mutated after the first encoding.
+    """
+
+    __slots__ = ("value", "_json")
+
+    def __init__(self, value: Any) -> None:
+        self.value = value
+        self._json: Optional[bytes] = None
+
+    @property
+    def json(self) -> bytes:
+        if self._json is None:
+            self._json = dumps(self.value)
+        return self._json
+
+    @property
+    def text(self) -> str:
+        return self.json.decode("utf-8")
+
+    def __repr__(self) -> str:
+        return f"Payload({self.value!r})"
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Benchmark ResponseAggregator overhead with many concurrent requests.
+
+Registers N requests, answers half of them and lets the rest time out,
+then reports the cost per request, the asyncio tasks created, and the
+trackers left behind.  ``--legacy`` adds the previous pattern for
+comparison: one sleeping task per request plus a scan over all trackers
+to remove completed ones.
+
+Usage:
+    python scripts/bench_aggregator.py [--requests 10000] [--timeout 0.5]
+"""
+
+import argparse
+import asyncio
+import sys
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from jarvis.agents.response_aggregator import ResponseAggregator  # noqa: E402
+
+
+class _QuietLogger:
+    def log(self, *args, **kwargs) -> None:
+        pass
+
+
+class LegacyAggregator(ResponseAggregator):
+    """Per-request timeout tasks and a full scan, as before the timer heap."""
+
+    def register_request(self, request_id, capability, expected_providers, strategy=None, timeout=None, **kw):
+        kwargs = {"strategy": strategy} if strategy else {}
+        fut = super().register_request(request_id, capability, expected_providers, timeout=timeout, **kwargs)
+        # Undo the heap entry and mimic `asyncio.create_task(_handle_timeout(...))`
+        self._deadlines.clear()
+        self._cancel_timer()
+        asyncio.create_task(self._sleep_then_timeout(request_id, timeout or self.default_timeout))
+        return fut
+
+    async def _sleep_then_timeout(self, request_id, timeout):
+        await asyncio.sleep(timeout)
+        tracker = self._trackers.get(request_id)
+        if tracker and not tracker.future.done():
+            self._finish(tracker)
+
+    def sweep(self):
+        for request_id in [r for r, t in self._trackers.items() if t.future.done()]:
+            del self._trackers[request_id]
+
+
+async def run(agg_cls, requests: int, timeout: float) -> dict:
+    agg = agg_cls(logger=_QuietLogger(), default_timeout=timeout)
+    await agg.start()
+    tasks_before = len(asyncio.all_tasks())
+
+    start = time.perf_counter()
+    futures = [agg.register_request(f"req-{i}", "cap", ["a", "b"]) for i in range(requests)]
+    register_s = time.perf_counter() - start
+    tasks_spawned = len(asyncio.all_tasks()) - tasks_before
+
+    start = time.perf_counter()
+    for i in range(0, requests, 2):
+        agg.add_response(f"req-{i}", "a", "answer")
+    respond_s = time.perf_counter() - start
+
+    if isinstance(agg, LegacyAggregator):
+        sweep_start = time.perf_counter()
+        agg.sweep()
+        sweep_s = time.perf_counter() - sweep_start
+    else:
+        sweep_s = 0.0
+    trackers_after_answers = len(agg._trackers)
+
+    start = time.perf_counter()
+    await asyncio.gather(*futures)
+    drain_s = time.perf_counter() - start
+    stats = agg.get_stats()
+    await agg.stop()
+    return {
+        "register_us": register_s / requests * 1e6,
+        "respond_us": respond_s / (requests // 2) * 1e6,
+        "sweep_ms": sweep_s * 1000,
+        "drain_overrun_ms": max(0.0, drain_s - timeout) * 1000,
+        "tasks_spawned": tasks_spawned,
+        "trackers_after_answers": trackers_after_answers,
+        "trackers_left": stats["active_trackers"],
+    }
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--requests", type=int, default=10000)
+    parser.add_argument("--timeout", type=float, default=0.5)
+    parser.add_argument("--legacy", action="store_true", help="also run the per-task baseline")
+    args = parser.parse_args()
+
+    variants = [("timer heap", ResponseAggregator)]
+    if args.legacy:
+        variants.append(("task per request", LegacyAggregator))
+    print(f"{args.requests} concurrent requests, half answered, half timing out after {args.timeout}s")
+    for name, cls in variants:
+        r = asyncio.run(run(cls, args.requests, args.timeout))
+        print(
+            f"  {name:17s} register {r['register_us']:6.1f} us/req  "
+            f"respond {r['respond_us']:6.1f} us/req  sweep {r['sweep_ms']:6.1f} ms  "
+            f"timeout overrun {r['drain_overrun_ms']:7.1f} ms  tasks {r['tasks_spawned']:6d}  "
+            f"trackers after answers {r['trackers_after_answers']:6d}  left {r['trackers_left']}"
+        )
+
+
+if __name__ == "__main__":
+    main()
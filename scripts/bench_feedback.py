@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Measure the per-turn cost of picking corrections for the chat prompt.
+
+For each log size a corrections log is generated in a scratch directory
+and a chat turn's lookup (``limit=10`` for one user, ranked against the
+turn's input) is timed against a fresh collector.  The "scan" column is
+the previous behaviour of re-reading and parsing the whole log on every
+turn; "indexed" is the steady-state cost once the log has been loaded.
+
+Usage:
+    python scripts/bench_feedback.py [--sizes 1000 10000 100000] [--turns 200]
+"""
+
+import argparse
+import json
+import random
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from jarvis.core.feedback import FeedbackCollector  # noqa: E402
+
+TOPICS = ["weather", "lights", "music", "calendar", "timer", "news", "roku", "todo"]
+WORDS = ["today", "tomorrow", "kitchen", "bedroom", "loud", "quiet", "red", "blue", "morning"]
+
+
+def write_log(path: Path, size: int, users: int) -> None:
+    rng = random.Random(size)
+    with open(path, "w", encoding="utf-8") as fh:
+        for i in range(size):
+            text = f"{rng.choice(TOPICS)} {rng.choice(WORDS)} {rng.choice(WORDS)}"
+            fh.write(json.dumps({
+                "id": f"c{i}",
+                "timestamp": "2026-01-01T00:00:00+00:00",
+                "user_id": i % users,
+                "original_input": text,
+                "bad_response": "nope",
+                "feedback_text": "bad!",
+                "intent": None,
+                "capability": None,
+                "resolved": False,
+            }) + "\n")
+
+
+def scan(path: Path, limit: int, user_id: int) -> list:
+    records = []
+    with open(path, "r", encoding="utf-8") as fh:
+        for line in fh:
+            record = json.loads(line)
+            if not record.get("resolved") and record.get("user_id") == user_id:
+                records.append(record)
+    return records[-limit:]
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--sizes", type=int, nargs="+", default=[1_000, 10_000, 100_000])
+    parser.add_argument("--turns", type=int, default=200)
+    parser.add_argument("--users", type=int, default=4)
+    args = parser.parse_args()
+
+    print(f"{'records':>8}  {'load ms':>8}  {'scan µs/turn':>13}  {'indexed µs/turn':>16}")
+    for size in args.sizes:
+        with tempfile.TemporaryDirectory() as tmp:
+            collector = FeedbackCollector(feedback_dir=tmp)
+            write_log(collector.corrections_file, size, args.users)
+
+            start = time.perf_counter()
+            collector.get_corrections(limit=1)
+            load_ms = (time.perf_counter() - start) * 1000
+
+            scan_turns = max(1, min(args.turns, 2_000_000 // size))
+            start = time.perf_counter()
+            for _ in range(scan_turns):
+                scan(collector.corrections_file, 10, 1)
+            scan_us = (time.perf_counter() - start) / scan_turns * 1e6
+
+            start = time.perf_counter()
+            for turn in range(args.turns):
+                collector.get_corrections(limit=10, user_id=1, query=f"{TOPICS[turn % 8]} kitchen")
+            indexed_us = (time.perf_counter() - start) / args.turns * 1e6
+
+        print(f"{size:>8}  {load_ms:>8.1f}  {scan_us:>13.0f}  {indexed_us:>16.0f}")
+
+
+if __name__ == "__main__":
+    main()
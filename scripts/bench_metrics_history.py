@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""Time /device/history reads against a month of generated device metrics.
+
+A scratch MetricsStore is filled with one sample per metric per probe
+interval for the requested number of days (rollups are built as the
+samples are written, just as the monitor loop does), compacted to the
+24h raw retention, and then queried over ranges from one hour to the
+whole month.
+
+Usage:
+    python scripts/bench_metrics_history.py [--days 30] [--metrics 5] [--interval 60]
+"""
+
+import argparse
+import math
+import sys
+import tempfile
+import time
+from datetime import datetime, timedelta, timezone
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from jarvis.services.metrics_store import MetricsStore  # noqa: E402
+
+
+class _QuietLogger:
+    def log(self, *args, **kwargs) -> None:
+        pass
+
+
+def fill(store: MetricsStore, days: int, metrics: int, interval: int) -> float:
+    end = datetime.now(timezone.utc)
+    ticks = days * 86400 // interval
+    start = end - timedelta(seconds=ticks * interval)
+    began = time.perf_counter()
+    batch = []
+    for tick in range(ticks):
+        ts = (start + timedelta(seconds=tick * interval)).isoformat()
+        for m in range(metrics):
+            value = 50 + 30 * math.sin(tick / (60 + m * 17)) + (tick * 7919 % 13)
+            batch.append({"timestamp": ts, "component": "cpu", "metric_name": f"m{m}", "value": value})
+        # The monitor writes one snapshot per tick; group ticks so the
+        # fill finishes quickly while keeping the same rollup path
+        if len(batch) >= metrics * 60:
+            store.record_batch(batch)
+            batch = []
+    store.record_batch(batch)
+    return (time.perf_counter() - began) / ticks * 1e6
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--days", type=int, default=30)
+    parser.add_argument("--metrics", type=int, default=5)
+    parser.add_argument("--interval", type=int, default=60, help="seconds between samples")
+    parser.add_argument("--limit", type=int, default=1000)
+    parser.add_argument("--repeat", type=int, default=20)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        store = MetricsStore(db_path=str(Path(tmp) / "metrics.db"), logger=_QuietLogger())
+        per_tick = fill(store, args.days, args.metrics, args.interval)
+        store.compact()
+        print(f"{args.days} days x {args.metrics} metrics every {args.interval}s "
+              f"({per_tick:.0f} µs per tick written)")
+
+        now = datetime.now(timezone.utc)
+        print(f"{'range':>8}  {'tier':>7}  {'points':>7}  {'ms':>7}")
+        for hours in (1, 6, 24, 24 * 7, 24 * 30):
+            if hours > args.days * 24:
+                break
+            start = (now - timedelta(hours=hours)).isoformat()
+            began = time.perf_counter()
+            for _ in range(args.repeat):
+                result = store.history("cpu", start=start, end=now.isoformat(), limit=args.limit)
+            ms = (time.perf_counter() - began) / args.repeat * 1000
+            print(f"{hours:>7}h  {result['resolution']:>7}  {len(result['data']):>7}  {ms:>7.2f}")
+        store.close()
+
+
+if __name__ == "__main__":
+    main()
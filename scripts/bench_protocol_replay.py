@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""Replay recorded sessions as recorded and compiled, against local stand-ins.
+
+Every agent named in a session is replaced by a stand-in that answers
+after a fixed latency, so the comparison measures the execution plan
+only: repeated lookups removed by the compiler and independent steps run
+in the same stage.  A built-in evening-routine session is always
+included, since most real recordings hold a single step.
+
+Usage:
+    python scripts/bench_protocol_replay.py [PATH ...] [--latency-ms 50]
+
+PATH may be a recorded protocol JSON file or a directory of them
+(default: jarvis/protocols/recorded).
+"""
+
+import argparse
+import asyncio
+import json
+import sys
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from jarvis.protocols import Protocol  # noqa: E402
+from jarvis.protocols.compiler import compile_protocol  # noqa: E402
+from jarvis.protocols.executor import ProtocolExecutor  # noqa: E402
+
+DEFAULT_DIR = Path(__file__).resolve().parent.parent / "jarvis" / "protocols" / "recorded"
+
+SAMPLE_SESSION = {
+    "name": "evening routine (built-in)",
+    "steps": [
+        {"agent": "CalendarAgent", "function": "get_tomorrow_events", "parameters": {}},
+        {"agent": "WeatherAgent", "function": "get_forecast", "parameters": {"days": 1}},
+        {"agent": "CalendarAgent", "function": "get_tomorrow_events", "parameters": {}},
+        {"agent": "LightsAgent", "function": "lights_dim_all", "parameters": {"level": 30}},
+        {"agent": "RokuAgent", "function": "power_off", "parameters": {}},
+        {"agent": "TodoAgent", "function": "list_tasks", "parameters": {"due": "tomorrow"}},
+        {
+            "agent": "ChatAgent",
+            "function": "summarize",
+            "parameters": {},
+            "parameter_mappings": {
+                "events": "$step_2_get_tomorrow_events",
+                "tasks": "$step_5_list_tasks",
+            },
+        },
+    ],
+}
+
+
+class StandInAgent:
+    def __init__(self, name: str, latency: float) -> None:
+        self.name = name
+        self.latency = latency
+
+    async def run_capability(self, function: str, **params):
+        await asyncio.sleep(self.latency)
+        return {"agent": self.name, "function": function}
+
+
+class StandInNetwork:
+    def __init__(self, protocol: Protocol, latency: float) -> None:
+        self.agents = {s.agent: StandInAgent(s.agent, latency) for s in protocol.steps}
+
+
+class QuietLogger:
+    def log(self, *args, **kwargs) -> None:
+        pass
+
+
+def load_sessions(paths):
+    sessions = [Protocol.from_dict(SAMPLE_SESSION)]
+    for path in paths:
+        files = sorted(path.glob("*.json")) if path.is_dir() else [path]
+        for file in files:
+            try:
+                protocol = Protocol.from_dict(json.loads(file.read_text()))
+            except (ValueError, KeyError) as exc:
+                print(f"  skipping {file.name}: {exc}")
+                continue
+            if protocol.steps:
+                sessions.append(protocol)
+    return sessions
+
+
+async def timed_run(protocol: Protocol, latency: float) -> float:
+    executor = ProtocolExecutor(StandInNetwork(protocol, latency), QuietLogger())
+    start = time.perf_counter()
+    await executor.run_protocol(protocol)
+    return (time.perf_counter() - start) * 1000
+
+
+async def main_async(args) -> None:
+    latency = args.latency_ms / 1000
+    sessions = load_sessions(args.paths or [DEFAULT_DIR])
+    total_orig = total_opt = 0.0
+    print(f"{len(sessions)} sessions, stand-in latency {args.latency_ms:.0f} ms per call")
+    for protocol in sessions:
+        compiled, report = compile_protocol(protocol)
+        orig_ms = await timed_run(protocol, latency)
+        opt_ms = await timed_run(compiled, latency)
+        total_orig += orig_ms
+        total_opt += opt_ms
+        print(
+            f"  {protocol.name[:40]:40s} steps {report.original_steps:2d} -> {len(compiled.steps):2d}  "
+            f"stages {len(report.stages):2d}  {orig_ms:7.1f} ms -> {opt_ms:7.1f} ms"
+        )
+    print(f"  {'total':40s} {total_orig:31.1f} ms -> {total_opt:7.1f} ms")
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("paths", nargs="*", type=Path)
+    parser.add_argument("--latency-ms", type=float, default=50.0)
+    asyncio.run(main_async(parser.parse_args()))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""Benchmark per-request JSON serialization of an agent response.
+
+A response is written twice per request: to the HTTP client and to the
+trace span.  The legacy path runs FastAPI's ``jsonable_encoder`` plus
+``json.dumps`` for the HTTP body and another ``json.dumps`` for the
+span.  The shared path is what ``RequestOrchestrator.respond`` and the
+``/jarvis`` route do: encode a :class:`Payload` once, record it on the
+``orchestrator.response`` span and render it as the HTTP body.
+
+Usage:
+    python scripts/bench_serialization.py [--requests 5000] [--actions 20]
+"""
+
+import argparse
+import json
+import sys
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from fastapi.encoders import jsonable_encoder  # noqa: E402
+from fastapi.responses import JSONResponse  # noqa: E402
+
+from jarvis.agents.response import AgentResponse  # noqa: E402
+from jarvis.logging.tracer import _truncate_data  # noqa: E402
+from jarvis.utils.serialization import Payload, dumps, orjson  # noqa: E402
+
+
+def make_response(actions: int) -> AgentResponse:
+    return AgentResponse.success_response(
+        "You have three meetings tomorrow; the first is at 9:00 with the design team.",
+        actions=[
+            {
+                "function": "get_events",
+                "arguments": {"date": "2024-05-02", "calendar": "work"},
+                "result": {
+                    "events": [
+                        {"id": f"evt-{i}-{j}", "title": f"Meeting {j}", "start": "2024-05-02T09:00:00",
+                         "attendees": ["a@example.com", "b@example.com"], "all_day": False}
+                        for j in range(3)
+                    ]
+                },
+            }
+            for i in range(actions)
+        ],
+        metadata={"agent": "CalendarAgent", "llm_ms": 812.4, "tool_calls": actions},
+    )
+
+
+def legacy(resp: AgentResponse) -> int:
+    body = JSONResponse(jsonable_encoder(resp.to_dict())).body
+    span = json.dumps(resp.to_dict(), default=str)[:10000]
+    return len(body) + len(span)
+
+
+def shared(resp: AgentResponse) -> int:
+    payload = Payload(resp.to_dict())  # RequestOrchestrator.respond
+    span = _truncate_data(payload)  # orchestrator.response span output
+    body = dumps(payload)  # JarvisJSONResponse.render on the /jarvis route
+    return len(body) + len(span)
+
+
+def bench(fn, resp, requests: int) -> float:
+    start = time.perf_counter()
+    for _ in range(requests):
+        fn(resp)
+    return (time.perf_counter() - start) / requests * 1e6
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--requests", type=int, default=5000)
+    parser.add_argument("--actions", type=int, default=20)
+    args = parser.parse_args()
+
+    resp = make_response(args.actions)
+    size = len(dumps(resp))
+    encoder = "orjson" if orjson is not None else "json (stdlib fallback)"
+    print(f"{args.requests} requests, {args.actions} actions, {size} byte response, encoder {encoder}")
+    for name, fn in (("legacy", legacy), ("shared payload", shared)):
+        fn(resp)  # warm up
+        print(f"  {name:15s} {bench(fn, resp, args.requests):8.1f} us/request")
+
+
+if __name__ == "__main__":
+    main()
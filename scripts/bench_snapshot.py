@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Benchmark cold vs warm startup of state covered by the startup snapshot.
+
+Builds a throwaway protocol database, definitions directory, Markdown
+vault and ChromaDB collection, then times the startup work that derives
+state from them twice: once without a snapshot file (cold) and once with
+the snapshot the cold run wrote (warm).
+
+Embeddings come from a local hashing function, so no API key is needed.
+
+Usage:
+    python scripts/bench_snapshot.py [--protocols 200] [--tags 2000] [--runs 5]
+"""
+
+import argparse
+import asyncio
+import hashlib
+import json
+import os
+import statistics
+import sys
+import tempfile
+import time
+from pathlib import Path
+from types import SimpleNamespace
+from unittest.mock import MagicMock
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+import chromadb  # noqa: E402
+from chromadb.api.types import EmbeddingFunction  # noqa: E402
+
+from jarvis.agents.nlu_agent.fast_classifier import FastPathClassifier  # noqa: E402
+from jarvis.protocols.runtime import ProtocolRuntime  # noqa: E402
+from jarvis.services.markdown_memory import MarkdownMemoryService  # noqa: E402
+from jarvis.storage import StartupSnapshot  # noqa: E402
+
+
+class HashEmbedding(EmbeddingFunction):
+    def __init__(self) -> None:
+        pass
+
+    def __call__(self, input):
+        return [
+            [b / 255 for b in hashlib.sha256(text.encode()).digest()[:16]]
+            for text in input
+        ]
+
+    @staticmethod
+    def name() -> str:
+        return "bench-hash"
+
+
+def _write_definitions(directory: Path, count: int) -> None:
+    directory.mkdir()
+    for i in range(count):
+        proto = {
+            "id": f"p{i}",
+            "name": f"protocol_{i}",
+            "description": "benchmark protocol",
+            "trigger_phrases": [f"run protocol {i} at {{level}}", f"protocol {i} {{level}}"],
+            "argument_definitions": [
+                {"name": "level", "type": "range", "min_val": 0, "max_val": 100}
+            ],
+            "steps": [{"agent": "ChatAgent", "function": "chat", "parameters": {}}],
+        }
+        (directory / f"p{i}.json").write_text(json.dumps(proto))
+
+
+def _write_vault(vault: Path, tags: int) -> None:
+    MarkdownMemoryService(vault_dir=str(vault))
+    lines = ["# Topic Index\n"]
+    for i in range(tags):
+        refs = ", ".join(f"short_term/2024-01-{d:02d}.md#m{i}_{d}" for d in range(1, 6))
+        lines.append(f"- **tag{i}**: {refs}")
+    (vault / "indexes" / "topic_index.md").write_text("\n".join(lines) + "\n")
+    (vault / "indexes" / "entity_index.md").write_text(
+        "\n".join(lines).replace("Topic Index", "Entity Index").replace("tag", "entity") + "\n"
+    )
+
+
+def _boot(snapshot_path: Path, defs: Path, vault: Path, vector) -> dict:
+    snapshot = StartupSnapshot(snapshot_path)
+    timings = {}
+
+    start = time.perf_counter()
+    snapshot.load()
+    timings["snapshot_load"] = time.perf_counter() - start
+
+    start = time.perf_counter()
+    runtime = ProtocolRuntime(MagicMock(), MagicMock(), snapshot=snapshot)
+    runtime.initialize(True, defs)
+    timings["protocols"] = time.perf_counter() - start
+
+    start = time.perf_counter()
+    MarkdownMemoryService(vault_dir=str(vault), snapshot=snapshot)
+    timings["vault_indexes"] = time.perf_counter() - start
+
+    start = time.perf_counter()
+    classifier = FastPathClassifier(vector, MagicMock(), snapshot=snapshot)
+    asyncio.run(classifier.initialize())
+    timings["fast_classifier"] = time.perf_counter() - start
+
+    start = time.perf_counter()
+    snapshot.save()
+    timings["snapshot_save"] = time.perf_counter() - start
+
+    runtime.registry.close()
+    timings["total"] = sum(timings.values())
+    timings["warm"] = snapshot.report()["warm"]
+    return timings
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--protocols", type=int, default=200)
+    parser.add_argument("--tags", type=int, default=2000, help="entries per vault index")
+    parser.add_argument("--runs", type=int, default=5)
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        tmp = Path(tmp)
+        os.environ["PROTOCOLS_DB_PATH"] = str(tmp / "protocols.db")
+        defs = tmp / "definitions"
+        vault = tmp / "vault"
+        _write_definitions(defs, args.protocols)
+        _write_vault(vault, args.tags)
+        client = chromadb.PersistentClient(path=str(tmp / "chroma"))
+        vector = SimpleNamespace(
+            client=client,
+            embedding_function=HashEmbedding(),
+            persist_directory=str(tmp / "chroma"),
+        )
+        snapshot_path = tmp / "snapshot.bin"
+
+        # First boot populates the database and collection; not measured
+        _boot(tmp / "unused.bin", defs, vault, vector)
+
+        cold, warm = [], []
+        for _ in range(args.runs):
+            snapshot_path.unlink(missing_ok=True)
+            cold.append(_boot(snapshot_path, defs, vault, vector))
+            warm.append(_boot(snapshot_path, defs, vault, vector))
+        size = snapshot_path.stat().st_size
+
+    assert all(r["warm"] for r in warm) and not any(r["warm"] for r in cold)
+    print(
+        f"{args.protocols} protocols, {args.tags} entries per vault index, "
+        f"snapshot {size / 1024:.0f} KiB (median of {args.runs})"
+    )
+    for key in ("snapshot_load", "protocols", "vault_indexes", "fast_classifier", "snapshot_save", "total"):
+        c = statistics.median(r[key] for r in cold) * 1000
+        w = statistics.median(r[key] for r in warm) * 1000
+        print(f"  {key:16s} cold {c:8.1f} ms   warm {w:8.1f} ms")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Benchmark JarvisSystem startup with eager vs lazy device-backed agents.
+
+Device builders (lights, device monitor, server manager) are
+replaced with fakes that sleep ``--device-latency`` ms to stand in for
+bridge discovery / network round trips, and the Mongo connection is
+skipped so the numbers reflect agent construction only.  For each mode the
+script reports ``initialize()`` wall time, the per-phase breakdown from
+:meth:`JarvisSystem.startup_report`, and the latency of the first request
+that has to reach a device-backed agent (time until the agent is usable).
+
+Usage:
+    python scripts/bench_startup.py [--device-latency 300] [--runs 3]
+"""
+
+import argparse
+import asyncio
+import os
+import statistics
+import sys
+import time
+from pathlib import Path
+from unittest.mock import MagicMock, patch
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+os.environ.setdefault("OPENAI_API_KEY", "bench")
+
+from jarvis.agents.factory import AgentFactory  # noqa: E402
+from jarvis.agents.lights_agent.lighting_agent import LightingAgent  # noqa: E402
+from jarvis.core.config import FeatureFlags, JarvisConfig  # noqa: E402
+from jarvis.core.system import JarvisSystem  # noqa: E402
+
+
+def _fake_lights(latency: float):
+    def create(self, ai_client, backend):
+        time.sleep(latency)
+        agent = LightingAgent(backend=MagicMock(), ai_client=ai_client, logger=self.logger)
+        return {"lights_agent": agent}
+
+    return create
+
+
+def _slow(original, latency: float):
+    def create(self, *args, **kwargs):
+        time.sleep(latency)
+        return original(self, *args, **kwargs)
+
+    return create
+
+
+async def _run_once(lazy: bool, latency: float) -> dict:
+    config = JarvisConfig(
+        api_key=None,
+        flags=FeatureFlags(
+            enable_lazy_agents=lazy,
+            enable_lights=True,
+            enable_canvas=False,
+            enable_roku=False,
+        ),
+    )
+    system = JarvisSystem(config)
+    start = time.perf_counter()
+    await system.initialize()
+    init_ms = (time.perf_counter() - start) * 1000
+
+    start = time.perf_counter()
+    assert await system.network.get_agent("LightingAgent") is not None
+    first_ms = (time.perf_counter() - start) * 1000
+
+    report = system.startup_report()
+    await system.shutdown()
+    return {"init_ms": init_ms, "first_device_ms": first_ms, "phases": report["phases"]}
+
+
+def bench(lazy: bool, latency: float, runs: int) -> dict:
+    patches = [
+        patch.object(AgentFactory, "_lights_backend", lambda self: ("phillips_hue", {})),
+        patch.object(AgentFactory, "_create_lights", _fake_lights(latency)),
+        patch.object(
+            AgentFactory,
+            "_create_device_monitor",
+            _slow(AgentFactory._create_device_monitor, latency),
+        ),
+        patch.object(
+            AgentFactory,
+            "_create_server_manager",
+            _slow(AgentFactory._create_server_manager, latency),
+        ),
+        patch.object(JarvisSystem, "_connect_mongo_loggers", lambda self: asyncio.sleep(0)),
+    ]
+    for p in patches:
+        p.start()
+    try:
+        results = [asyncio.run(_run_once(lazy, latency)) for _ in range(runs)]
+    finally:
+        for p in patches:
+            p.stop()
+    return {
+        "init_ms": statistics.median(r["init_ms"] for r in results),
+        "first_device_ms": statistics.median(r["first_device_ms"] for r in results),
+        "phases": results[-1]["phases"],
+    }
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--device-latency", type=float, default=300, help="ms per device builder")
+    parser.add_argument("--runs", type=int, default=3)
+    args = parser.parse_args()
+    latency = args.device_latency / 1000
+
+    eager = bench(False, latency, args.runs)
+    lazy = bench(True, latency, args.runs)
+
+    print(f"3 device-backed agents, {args.device_latency:.0f} ms simulated build each")
+    for label, res in (("eager", eager), ("lazy ", lazy)):
+        print(
+            f"  {label}: initialize {res['init_ms']:8.1f} ms  "
+            f"first device request {res['first_device_ms']:8.1f} ms"
+        )
+        phases = ", ".join(f"{k} {v:.0f}" for k, v in sorted(res["phases"].items()))
+        print(f"         phases (ms): {phases}")
+    print(f"  startup speedup: {eager['init_ms'] / lazy['init_ms']:.1f}x")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
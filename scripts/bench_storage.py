@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""Benchmark commit throughput and event-loop blocking of the storage engine.
+
+Compares the previous per-store pattern (one shared connection behind a
+lock, commit after every write) with :class:`jarvis.storage.StorageEngine`
+group commit, both driven by the same number of concurrent writers.
+
+Usage:
+    python scripts/bench_storage.py [--writers 16] [--writes 200]
+"""
+
+import argparse
+import asyncio
+import os
+import sqlite3
+import sys
+import tempfile
+import threading
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+
+from jarvis.storage import StorageEngine  # noqa: E402
+
+SCHEMA = "CREATE TABLE IF NOT EXISTS logs (id INTEGER PRIMARY KEY, level TEXT, message TEXT)"
+INSERT = "INSERT INTO logs (level, message) VALUES (?, ?)"
+
+
+def _run_threads(writers: int, target) -> float:
+    barrier = threading.Barrier(writers)
+
+    def worker(n: int) -> None:
+        barrier.wait()
+        target(n)
+
+    threads = [threading.Thread(target=worker, args=(n,)) for n in range(writers)]
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return time.perf_counter() - start
+
+
+def bench_per_write_commit(path: str, writers: int, writes: int) -> float:
+    conn = sqlite3.connect(path, check_same_thread=False)
+    conn.execute("PRAGMA journal_mode=WAL")
+    conn.execute(SCHEMA)
+    conn.commit()
+    lock = threading.RLock()
+
+    def target(n: int) -> None:
+        for i in range(writes):
+            with lock:
+                conn.execute(INSERT, ("INFO", f"{n}-{i}"))
+                conn.commit()
+
+    elapsed = _run_threads(writers, target)
+    conn.close()
+    return elapsed
+
+
+def bench_engine(path: str, writers: int, writes: int) -> tuple:
+    db = StorageEngine.open(path)
+    db.write(SCHEMA)
+
+    def target(n: int) -> None:
+        for i in range(writes):
+            db.write(INSERT, ("INFO", f"{n}-{i}"))
+
+    elapsed = _run_threads(writers, target)
+    stats = db.get_stats()
+    db.release()
+    return elapsed, stats
+
+
+async def _loop_lag(work) -> float:
+    """Run *work* on the loop and return the worst scheduling delay seen."""
+    worst = 0.0
+    stop = asyncio.Event()
+
+    async def probe() -> None:
+        nonlocal worst
+        while not stop.is_set():
+            start = time.perf_counter()
+            await asyncio.sleep(0.001)
+            worst = max(worst, time.perf_counter() - start - 0.001)
+
+    task = asyncio.create_task(probe())
+    await work()
+    stop.set()
+    await task
+    return worst * 1000
+
+
+def bench_loop_blocking(path: str, writes: int) -> dict:
+    db = StorageEngine.open(path)
+    db.write(SCHEMA)
+
+    async def sync_on_loop() -> None:
+        for i in range(writes):
+            db.write(INSERT, ("INFO", str(i)))
+            await asyncio.sleep(0)
+
+    async def awaitable() -> None:
+        await asyncio.gather(*(db.awrite(INSERT, ("INFO", str(i))) for i in range(writes)))
+
+    sync_lag = asyncio.run(_loop_lag(sync_on_loop))
+    blocking = db.get_stats()["loop_blocking_ms"]
+    async_lag = asyncio.run(_loop_lag(awaitable))
+    async_blocking = db.get_stats()["loop_blocking_ms"] - blocking
+    db.release()
+    return {
+        "sync_max_lag_ms": sync_lag,
+        "sync_loop_blocking_ms": blocking,
+        "async_max_lag_ms": async_lag,
+        "async_loop_blocking_ms": async_blocking,
+    }
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--writers", type=int, default=16)
+    parser.add_argument("--writes", type=int, default=200, help="writes per writer")
+    args = parser.parse_args()
+    total = args.writers * args.writes
+
+    with tempfile.TemporaryDirectory() as tmp:
+        baseline = bench_per_write_commit(os.path.join(tmp, "baseline.db"), args.writers, args.writes)
+        engine, stats = bench_engine(os.path.join(tmp, "engine.db"), args.writers, args.writes)
+        loop = bench_loop_blocking(os.path.join(tmp, "loop.db"), args.writes)
+
+    print(f"{args.writers} writers x {args.writes} writes ({total} rows)")
+    print(f"  commit per write : {total / baseline:10.0f} writes/s  ({total} commits)")
+    print(
+        f"  group commit     : {total / engine:10.0f} writes/s  "
+        f"({int(stats['commits'])} commits, avg group {stats['avg_group_size']}, "
+        f"max group {int(stats['max_group_size'])})"
+    )
+    print(f"  speedup          : {baseline / engine:10.1f}x")
+    print(f"{args.writes} writes issued from the event loop")
+    print(
+        f"  sync write()     : max loop lag {loop['sync_max_lag_ms']:.2f} ms, "
+        f"blocking total {loop['sync_loop_blocking_ms']:.1f} ms"
+    )
+    print(
+        f"  awrite()         : max loop lag {loop['async_max_lag_ms']:.2f} ms, "
+        f"blocking total {loop['async_loop_blocking_ms']:.1f} ms"
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
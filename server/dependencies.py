@@ -95,7 +95,7 @@ async def get_user_jarvis(
         hue_username=user_conf.get("hue_username") or base.config.hue_username,
     )
 
-    jarvis = JarvisSystem(config)
+    jarvis = JarvisSystem(config, services=getattr(request.app.state, "services", None))
     await jarvis.initialize()
     systems[current_user["id"]] = jarvis
     return jarvis
@@ -16,8 +16,9 @@ from dotenv import load_dotenv
 load_dotenv()
 
 from jarvis import JarvisLogger, JarvisSystem, JarvisConfig
-from jarvis.core import DEFAULT_PORT
+from jarvis.core import DEFAULT_PORT, ServiceContainer
 from server.database import init_database, close_database
+from server.responses import JarvisJSONResponse
 from server.routers.jarvis import router as jarvis_router
 from server.routers.auth import router as auth_router
 from server.routers.protocols import router as protocol_router
@@ -58,7 +59,9 @@ async def lifespan(app: FastAPI) -> AsyncIterator[None]:
         yeelight_bulb_ips=yeelight_bulb_ips,
     )
 
-    jarvis_system = JarvisSystem(config)
+    # Per-user systems share ChromaDB, HTTP clients and stores with this one
+    app.state.services = ServiceContainer()
+    jarvis_system = JarvisSystem(config, services=app.state.services)
     await jarvis_system.initialize()
     app.state.jarvis_system = jarvis_system
     app.state.user_systems = {}
@@ -66,6 +69,9 @@ async def lifespan(app: FastAPI) -> AsyncIterator[None]:
     # Initialize database
     app.state.auth_db = init_database()
 
+    # Lazy agents are built once the server is accepting traffic
+    jarvis_system.start_warm_up()
+
     yield
 
     # -- Shutdown --------------------------------------------------------------
@@ -77,6 +83,10 @@ async def lifespan(app: FastAPI) -> AsyncIterator[None]:
             except asyncio.TimeoutError:
                 pass  # Continue shutdown even if jarvis hangs
 
+        services: ServiceContainer | None = getattr(app.state, "services", None)
+        if services is not None:
+            await services.aclose()
+
         logger_ref: JarvisLogger | None = getattr(app.state, "logger", None)
         if logger_ref:
             try:
@@ -91,7 +101,11 @@ async def lifespan(app: FastAPI) -> AsyncIterator[None]:
 
 def create_app() -> FastAPI:
     """Create and configure the FastAPI application."""
-    app = FastAPI(title="Jarvis API", lifespan=lifespan)
+    app = FastAPI(
+        title="Jarvis API",
+        lifespan=lifespan,
+        default_response_class=JarvisJSONResponse,
+    )
     cors_env = os.getenv("CORS_ORIGINS")
     if cors_env:
         origins = [o.strip() for o in cors_env.split(",") if o.strip()]
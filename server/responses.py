@@ -0,0 +1,21 @@
+"""HTTP response classes for the Jarvis API."""
+
+from __future__ import annotations
+
+from typing import Any
+
+from fastapi.responses import JSONResponse
+
+from jarvis.utils.serialization import dumps
+
+
+class JarvisJSONResponse(JSONResponse):
+    """JSON response encoded with the shared serializer.
+
+    Routes that return one of these directly skip FastAPI's
+    ``jsonable_encoder`` pass; ``AgentResponse`` objects, dataclasses and
+    :class:`~jarvis.utils.serialization.Payload` values are encoded as-is.
+    """
+
+    def render(self, content: Any) -> bytes:
+        return dumps(content)
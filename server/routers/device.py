@@ -1,6 +1,7 @@
 """Device monitoring HTTP endpoints."""
 from __future__ import annotations
 
+from datetime import datetime, timedelta, timezone
 from typing import TYPE_CHECKING, Optional
 
 from fastapi import APIRouter, Depends, HTTPException, Query
@@ -13,7 +14,7 @@ if TYPE_CHECKING:
 router = APIRouter()
 
 
-def _get_device_agent(jarvis_system: JarvisSystem) -> DeviceMonitorAgent:
+async def _get_device_agent(jarvis_system: JarvisSystem) -> DeviceMonitorAgent:
     """Get the DeviceMonitorAgent from the system, or raise 503."""
     agent = jarvis_system.network.agents.get("DeviceMonitorAgent")
     if not agent:
@@ -23,6 +24,16 @@ def _get_device_agent(jarvis_system: JarvisSystem) -> DeviceMonitorAgent:
         )
     # Import at runtime to avoid circular import issues
     from jarvis.agents.device_monitor_agent import DeviceMonitorAgent
+    from jarvis.agents.lazy_agent import LazyAgent
+
+    if isinstance(agent, LazyAgent):
+        try:
+            agent = await agent.materialize()
+        except RuntimeError:
+            raise HTTPException(
+                status_code=503,
+                detail="Device monitoring not available",
+            )
 
     if not isinstance(agent, DeviceMonitorAgent):
         raise HTTPException(
@@ -35,7 +46,7 @@ def _get_device_agent(jarvis_system: JarvisSystem) -> DeviceMonitorAgent:
 @router.get("/")
 async def device_status(jarvis_system: JarvisSystem = Depends(get_jarvis)):
     """Quick device status summary."""
-    agent = _get_device_agent(jarvis_system)
+    agent = await _get_device_agent(jarvis_system)
     snap = agent.device_service.snapshot()
     return {
         "hostname": snap.hostname,
@@ -52,52 +63,71 @@ async def device_status(jarvis_system: JarvisSystem = Depends(get_jarvis)):
 @router.get("/snapshot")
 async def device_snapshot(jarvis_system: JarvisSystem = Depends(get_jarvis)):
     """Full current hardware snapshot."""
-    agent = _get_device_agent(jarvis_system)
+    agent = await _get_device_agent(jarvis_system)
     snap = agent.device_service.snapshot()
     return snap.to_dict()
 
 
+async def _history(
+    jarvis_system: JarvisSystem,
+    component: str,
+    metric: Optional[str],
+    hours: int,
+    limit: int,
+    raw: bool,
+) -> dict:
+    agent = await _get_device_agent(jarvis_system)
+    result = {"component": component, "metric": metric, "hours": hours}
+    store = getattr(agent, "metrics_store", None)
+    if store is None:
+        return {
+            **result,
+            "message": "Historical data available when MetricsStore is connected",
+            "data": [],
+        }
+
+    end = datetime.now(timezone.utc)
+    start = end - timedelta(hours=hours)
+    history = await store.run(
+        store.history,
+        component,
+        metric_name=metric,
+        start=start.isoformat(),
+        end=end.isoformat(),
+        limit=limit,
+        raw=raw,
+    )
+    return {**result, **history}
+
+
 @router.get("/history/{component}")
 async def device_history(
     component: str,
     metric: Optional[str] = Query(None, description="Specific metric name"),
-    hours: int = Query(24, description="Hours of history to retrieve"),
-    limit: int = Query(1000, description="Maximum data points"),
+    hours: int = Query(24, ge=1, description="Hours of history to retrieve"),
+    limit: int = Query(1000, ge=1, description="Maximum data points per metric"),
     jarvis_system: JarvisSystem = Depends(get_jarvis),
 ):
-    """Raw historical metrics for a component."""
-    _get_device_agent(jarvis_system)  # Ensure agent is available
-    return {
-        "component": component,
-        "metric": metric,
-        "hours": hours,
-        "message": "Historical data available when MetricsStore is connected",
-        "data": [],
-    }
+    """Historical metrics for a component at the finest resolution that fits *limit*."""
+    return await _history(jarvis_system, component, metric, hours, limit, raw=True)
 
 
 @router.get("/history/{component}/aggregated")
 async def device_history_aggregated(
     component: str,
     metric: Optional[str] = Query(None, description="Specific metric name"),
-    hours: int = Query(24, description="Hours of history to retrieve"),
+    hours: int = Query(24, ge=1, description="Hours of history to retrieve"),
+    limit: int = Query(1000, ge=1, description="Maximum data points per metric"),
     jarvis_system: JarvisSystem = Depends(get_jarvis),
 ):
-    """Hourly rollups of historical metrics for a component."""
-    _get_device_agent(jarvis_system)  # Ensure agent is available
-    return {
-        "component": component,
-        "metric": metric,
-        "hours": hours,
-        "message": "Aggregated data available when MetricsStore is connected",
-        "data": [],
-    }
+    """Minute, hourly or daily rollups (min/max/avg) of historical metrics."""
+    return await _history(jarvis_system, component, metric, hours, limit, raw=False)
 
 
 @router.get("/diagnostics")
 async def device_diagnostics(jarvis_system: JarvisSystem = Depends(get_jarvis)):
     """Deep diagnostics with process analysis."""
-    agent = _get_device_agent(jarvis_system)
+    agent = await _get_device_agent(jarvis_system)
     result = await agent._handle_device_diagnostics({})
     return result.to_dict()
 
@@ -105,7 +135,7 @@ async def device_diagnostics(jarvis_system: JarvisSystem = Depends(get_jarvis)):
 @router.get("/battery")
 async def device_battery(jarvis_system: JarvisSystem = Depends(get_jarvis)):
     """Battery health details (macOS / laptops)."""
-    agent = _get_device_agent(jarvis_system)
+    agent = await _get_device_agent(jarvis_system)
     snap = agent.device_service.snapshot()
     if snap.battery is None:
         return {
@@ -125,7 +155,7 @@ async def device_battery(jarvis_system: JarvisSystem = Depends(get_jarvis)):
 @router.get("/thermals")
 async def device_thermals(jarvis_system: JarvisSystem = Depends(get_jarvis)):
     """Current thermal status."""
-    agent = _get_device_agent(jarvis_system)
+    agent = await _get_device_agent(jarvis_system)
     snap = agent.device_service.snapshot()
     if not snap.thermals:
         return {
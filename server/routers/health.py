@@ -3,7 +3,7 @@ from __future__ import annotations
 
 from typing import TYPE_CHECKING
 
-from fastapi import APIRouter, Depends, HTTPException, Query
+from fastapi import APIRouter, Depends, HTTPException, Query, Request, Response
 from jarvis import JarvisSystem
 from ..dependencies import get_jarvis
 
@@ -58,6 +58,32 @@ async def health_check(jarvis_system: JarvisSystem = Depends(get_jarvis)):
     }
 
 
+@router.get("/snapshot")
+async def health_snapshot(
+    request: Request,
+    jarvis_system: JarvisSystem = Depends(get_jarvis),
+):
+    """Latest monitor snapshot from memory; answers 304 to a matching If-None-Match."""
+    agent = _get_health_agent(jarvis_system)
+    store = agent.store
+    if store.snapshot is None:
+        await agent._system_health_check()
+    headers = {
+        "ETag": store.etag,
+        "Cache-Control": "no-cache",
+        "X-Health-Version": str(store.version),
+    }
+    if store.matches(request.headers.get("if-none-match")):
+        return Response(status_code=304, headers=headers)
+    return Response(content=store.body, media_type="application/json", headers=headers)
+
+
+@router.get("/startup")
+async def health_startup(jarvis_system: JarvisSystem = Depends(get_jarvis)):
+    """Startup time breakdown per phase and per agent (milliseconds)."""
+    return jarvis_system.startup_report()
+
+
 @router.get("/detailed")
 async def health_detailed(jarvis_system: JarvisSystem = Depends(get_jarvis)):
     """Full system health snapshot."""
@@ -9,6 +9,7 @@ from .agents import (
 )
 
 from ..models import JarvisRequest
+from ..responses import JarvisJSONResponse
 from ..dependencies import (
     get_jarvis,
     get_user_jarvis,
@@ -42,10 +43,11 @@ async def jarvis(
         "user_id": current_user["id"],
         "profile": profile,
     }
-    response = await jarvis_system.process_request(
+    # Encoded once by the orchestrator; the trace and log hold the same bytes
+    payload = await jarvis_system.respond(
         req.command, tz_name, metadata, allowed_agents=allowed
     )
-    return response
+    return JarvisJSONResponse(payload)
 
 
 @router.get("/agents")
@@ -298,6 +298,7 @@ async def get_live_state(request: Request):
             "completed_results": raw_state.completed_results,
             "discoveries": raw_state.discoveries,
             "skipped_count": raw_state.skipped_count,
+            "running_tasks": raw_state.running_tasks,
         }
 
     # Latest report
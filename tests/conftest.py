@@ -0,0 +1,19 @@
+"""Fixtures shared across the test suite."""
+
+import pytest_asyncio
+
+from jarvis.core.container import ServiceContainer
+
+
+@pytest_asyncio.fixture
+async def shared_services():
+    """Service container for every system a test builds.
+
+    Pass it as ``JarvisSystem(config, services=shared_services)`` or
+    ``JarvisBuilder(config).services(shared_services)`` so systems reuse
+    loggers, stores and HTTP clients instead of each building their own.
+    Closed once the test finishes.
+    """
+    container = ServiceContainer()
+    yield container
+    await container.aclose()
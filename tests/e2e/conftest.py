@@ -176,7 +176,7 @@ def _mock_calendar_service(system: JarvisSystem) -> None:
 # The main fixture
 # ---------------------------------------------------------------------------
 @pytest_asyncio.fixture
-async def jarvis_system(tmp_path):
+async def jarvis_system(tmp_path, shared_services):
     """Boot a real Jarvis system with ScriptedAIClient and mocked externals.
 
     Yields a running JarvisSystem ready for process_request() calls.
@@ -186,6 +186,7 @@ async def jarvis_system(tmp_path):
         config = _make_e2e_config(tmp_path)
         builder = (
             JarvisBuilder(config)
+            .services(shared_services)
             .memory(True)
             .nlu(True)
             .calendar(True)
@@ -216,13 +217,14 @@ async def jarvis_system(tmp_path):
 
 
 @pytest_asyncio.fixture
-async def jarvis_system_search_fail(tmp_path):
+async def jarvis_system_search_fail(tmp_path, shared_services):
     """Same as jarvis_system but search service returns errors."""
     _start_mongo_patches()
     try:
         config = _make_e2e_config(tmp_path)
         builder = (
             JarvisBuilder(config)
+            .services(shared_services)
             .memory(True)
             .nlu(True)
             .calendar(True)
@@ -285,7 +287,7 @@ def _make_real_llm_config(tmp_path) -> JarvisConfig:
 
 
 @pytest_asyncio.fixture
-async def real_jarvis_system(tmp_path):
+async def real_jarvis_system(tmp_path, shared_services):
     """Boot a real Jarvis system with actual OpenAI calls.
 
     LLM classification and agent responses are real.
@@ -296,6 +298,7 @@ async def real_jarvis_system(tmp_path):
         config = _make_real_llm_config(tmp_path)
         builder = (
             JarvisBuilder(config)
+            .services(shared_services)
             .memory(True)
             .nlu(True)
             .calendar(True)
@@ -325,13 +328,14 @@ async def real_jarvis_system(tmp_path):
 
 
 @pytest_asyncio.fixture
-async def real_jarvis_system_search_fail(tmp_path):
+async def real_jarvis_system_search_fail(tmp_path, shared_services):
     """Real LLM system where search service returns errors."""
     _start_mongo_patches()
     try:
         config = _make_real_llm_config(tmp_path)
         builder = (
             JarvisBuilder(config)
+            .services(shared_services)
             .memory(True)
             .nlu(True)
             .calendar(True)
@@ -214,7 +214,7 @@ class TestCalendarFunctionRegistry:
 class TestCalendarCommandProcessor:
     """Tests for CalendarCommandProcessor."""
 
-    def _make_processor(self, ai_client=None, calendar_service=None):
+    def _make_processor(self, ai_client=None, calendar_service=None, fast_path=True):
         service = calendar_service or _make_calendar_service()
         client = ai_client or _make_ai_client()
         registry = CalendarFunctionRegistry(service)
@@ -224,6 +224,7 @@ class TestCalendarCommandProcessor:
             calendar_service=service,
             function_registry=registry,
             tools=tools,
+            fast_path=fast_path,
         )
 
     # --- execute_function ---
@@ -310,7 +311,7 @@ class TestCalendarCommandProcessor:
             ]
         )
 
-        proc = self._make_processor(ai_client=client, calendar_service=service)
+        proc = self._make_processor(ai_client=client, calendar_service=service, fast_path=False)
         result = await proc.process_command("Show today's events")
 
         assert result["success"] is True
@@ -536,3 +536,130 @@ class TestChatAgentEdgeCases:
         result = await agent._process_chat("loop forever")
         # Should stop after 5 iterations (the while loop limit)
         assert call_count <= 6  # 5 iterations + 1 initial call
+
+
+# ---------------------------------------------------------------------------
+# Tests: concurrent tool execution
+# ---------------------------------------------------------------------------
+
+class MultiToolAIClient(BaseAIClient):
+    """AI client that issues a fixed batch of tool calls once, then text."""
+
+    def __init__(self, calls):
+        self._calls = calls
+        self._call_count = 0
+        self.tool_messages = []
+
+    async def strong_chat(self, messages, tools=None):
+        import json
+
+        self._call_count += 1
+        if self._call_count == 1:
+            batch = []
+            for i, (name, args) in enumerate(self._calls):
+                func = type("Function", (), {
+                    "name": name,
+                    "arguments": json.dumps(args),
+                })()
+                batch.append(type("ToolCall", (), {"id": f"call_{i}", "function": func})())
+            msg = type("Message", (), {"content": None})()
+            return msg, batch
+        self.tool_messages = [m for m in messages if m.get("role") == "tool"]
+        msg = type("Message", (), {"content": "Done"})()
+        return msg, None
+
+    async def weak_chat(self, messages, tools=None):
+        return await self.strong_chat(messages, tools)
+
+
+class TestConcurrentToolExecution:
+    """Tests for concurrent tool execution within one chat iteration."""
+
+    @pytest.mark.asyncio
+    async def test_read_only_calls_run_concurrently(self):
+        import asyncio
+        import time
+
+        client = MultiToolAIClient([
+            ("get_facts", {"query": "a"}),
+            ("get_facts", {"query": "b"}),
+            ("get_facts", {"query": "c"}),
+        ])
+        agent = ChatAgent(ai_client=client)
+
+        async def slow_get_facts(query, top_k=3):
+            await asyncio.sleep(0.2)
+            return f"fact {query}"
+
+        agent.intent_map["get_facts"] = slow_get_facts
+        start = time.perf_counter()
+        result = await agent._process_chat("tell me three things")
+        elapsed = time.perf_counter() - start
+
+        assert elapsed < 0.5
+        assert [a["result"] for a in result["actions"]] == ["fact a", "fact b", "fact c"]
+        assert [m["tool_call_id"] for m in client.tool_messages] == [
+            "call_0", "call_1", "call_2"
+        ]
+
+    @pytest.mark.asyncio
+    async def test_results_keep_call_order_when_completion_differs(self):
+        import asyncio
+
+        client = MultiToolAIClient([
+            ("get_facts", {"query": "slow"}),
+            ("get_facts", {"query": "fast"}),
+        ])
+        agent = ChatAgent(ai_client=client)
+
+        async def get_facts(query, top_k=3):
+            await asyncio.sleep(0.1 if query == "slow" else 0)
+            return query
+
+        agent.intent_map["get_facts"] = get_facts
+        result = await agent._process_chat("order")
+        assert [a["result"] for a in result["actions"]] == ["slow", "fast"]
+
+    @pytest.mark.asyncio
+    async def test_tool_timeout_returns_error(self):
+        import asyncio
+
+        client = MultiToolAIClient([("get_facts", {"query": "hang"})])
+        agent = ChatAgent(ai_client=client)
+        agent.tool_timeout = 0.05
+
+        async def hanging(query, top_k=3):
+            await asyncio.sleep(5)
+
+        agent.intent_map["get_facts"] = hanging
+        result = await agent._process_chat("hang")
+        assert result["success"] is False
+        assert "timed out" in result["actions"][0]["result"]["error"]
+
+    @pytest.mark.asyncio
+    async def test_duplicate_read_only_calls_are_memoized(self):
+        client = MultiToolAIClient([
+            ("get_facts", {"query": "color"}),
+            ("store_fact", {"fact": "likes blue"}),
+            ("get_facts", {"query": "color"}),
+            ("get_facts", {"query": "color"}),
+        ])
+        agent = ChatAgent(ai_client=client)
+        calls = []
+
+        async def get_facts(query, top_k=3):
+            calls.append(query)
+            return f"facts v{len(calls)}"
+
+        async def store_fact(fact):
+            return "fact stored"
+
+        agent.intent_map["get_facts"] = get_facts
+        agent.intent_map["store_fact"] = store_fact
+        result = await agent._process_chat("memo")
+
+        # Write invalidates the first read; the last two share one lookup
+        assert len(calls) == 2
+        assert [a["result"] for a in result["actions"]] == [
+            "facts v1", "fact stored", "facts v2", "facts v2"
+        ]
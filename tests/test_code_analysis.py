@@ -0,0 +1,166 @@
+"""Tests for the shared single-pass source analysis engine."""
+
+import subprocess
+import sys
+from unittest.mock import patch
+
+import pytest
+
+from jarvis.services import code_analysis
+from jarvis.services.code_analysis import CodeAnalysisEngine, collect_facts
+from jarvis.services.system_analyzer import SystemAnalyzer
+from jarvis.services.test_mapper import TestMapper
+
+SAMPLE = '''\
+import os
+import json
+from jarvis.services.todo_service import TodoService
+
+
+class Widget:
+    def spin(self):
+        try:
+            pass
+        except:
+            pass
+
+    def stop(self):
+        """Stop."""
+        return json.dumps({})
+
+
+def helper():
+    # TODO: remove
+    return TodoService
+'''
+
+
+def write_tree(root, files):
+    for rel, text in files.items():
+        path = root / rel
+        path.parent.mkdir(parents=True, exist_ok=True)
+        path.write_text(text)
+    return [root / rel for rel in files]
+
+
+class TestCollectFacts:
+    def test_single_pass_collects_everything(self):
+        facts = collect_facts(SAMPLE)
+        assert facts.parsed
+        assert facts.undocumented == [("Widget", ["spin"])]
+        assert facts.unused_imports == [("os", 1)]
+        assert facts.exception_antipatterns == [("Bare except: at line 10", 10)]
+        assert ("helper", 18, 3) in facts.functions
+        assert ("helper", 18) in facts.public_defs
+        assert facts.markers == [("TODO at line 19", 19)]
+        assert facts.imports == [
+            (0, "os", []),
+            (0, "json", []),
+            (0, "jarvis.services.todo_service", ["TodoService"]),
+        ]
+        assert facts.words["TodoService"] == 2
+        assert facts.scope_at(9) == "spin"
+        assert facts.scope_at(19) == "helper"
+        assert facts.scope_at(1) == ""
+
+    def test_markers_survive_syntax_errors(self):
+        facts = collect_facts("def broken(:\n    # FIXME later\n")
+        assert not facts.parsed
+        assert facts.markers == [("FIXME at line 2", 2)]
+        assert facts.functions == [] and facts.scope_at(2) == ""
+
+
+class TestCodeAnalysisEngine:
+    def test_unchanged_files_are_not_parsed_again(self, tmp_path):
+        paths = write_tree(tmp_path, {"a.py": SAMPLE, "b.py": "x = 1\n"})
+        cache = str(tmp_path / "cache.db")
+        engine = CodeAnalysisEngine(cache)
+        first = engine.analyze(tmp_path, paths)
+        assert (first.parsed, first.cache_hits) == (2, 0)
+        engine.close()
+
+        # A fresh engine picks the facts up from the persistent cache
+        engine = CodeAnalysisEngine(cache)
+        with patch.object(code_analysis, "collect_facts") as collect:
+            run = engine.analyze(tmp_path, paths)
+        collect.assert_not_called()
+        assert (run.parsed, run.cache_hits) == (0, 2)
+        assert run.files["a.py"].facts == first.files["a.py"].facts
+
+        # Only the edited file is parsed
+        (tmp_path / "b.py").write_text("y = 2\n")
+        run = engine.analyze(tmp_path, paths)
+        assert (run.parsed, run.cache_hits) == (1, 1)
+        assert run.files["b.py"].facts.words == {"y": 1, "2": 1}
+        engine.close()
+
+    def test_undecodable_files_are_skipped(self, tmp_path):
+        (tmp_path / "bad.py").write_bytes(b"\xff\xfe\x00")
+        engine = CodeAnalysisEngine(cache=False)
+        assert engine.analyze(tmp_path, [tmp_path / "bad.py"]).files == {}
+
+    def test_process_pool_matches_serial(self, tmp_path, monkeypatch):
+        files = {f"m{i}.py": f"def f{i}():\n    return {i}\n" for i in range(8)}
+        paths = write_tree(tmp_path, files)
+        serial = CodeAnalysisEngine(cache=False, max_workers=1).analyze(tmp_path, paths)
+
+        monkeypatch.setattr(code_analysis, "PARALLEL_MIN_FILES", 4)
+        real_pool = code_analysis.ProcessPoolExecutor
+        methods = []
+
+        def recording_pool(*args, mp_context=None, **kwargs):
+            methods.append(mp_context.get_start_method())
+            return real_pool(*args, mp_context=mp_context, **kwargs)
+
+        monkeypatch.setattr(code_analysis, "ProcessPoolExecutor", recording_pool)
+        pooled = CodeAnalysisEngine(cache=False, max_workers=2).analyze(tmp_path, paths)
+        assert pooled.workers == 2
+        # Never fork the threaded server process directly
+        assert methods == ["forkserver"]
+        assert {k: v.facts for k, v in pooled.files.items()} == {
+            k: v.facts for k, v in serial.files.items()
+        }
+
+
+    def test_worker_module_imports_light(self):
+        # What the forkserver preloads: no agents, SDKs or storage
+        probe = (
+            "import sys, jarvis.services.code_facts; "
+            "print(sorted(m for m in sys.modules if m.startswith('jarvis')))"
+        )
+        out = subprocess.run(
+            [sys.executable, "-c", probe], capture_output=True, text=True, check=True
+        ).stdout
+        assert out.strip() == "['jarvis', 'jarvis.services', 'jarvis.services.code_facts']"
+
+
+class TestSharedScan:
+    @pytest.mark.asyncio
+    async def test_full_analysis_reads_tree_once(self, tmp_path):
+        write_tree(tmp_path, {"jarvis/services/widget.py": SAMPLE})
+        engine = CodeAnalysisEngine(cache=False)
+        analyzer = SystemAnalyzer(
+            str(tmp_path), str(tmp_path / "logs.db"), trace_db_path=str(tmp_path / "t.db"), engine=engine
+        )
+        with patch.object(engine, "analyze", wraps=engine.analyze) as analyze:
+            discoveries = await analyzer.run_full_analysis()
+        assert analyze.call_count == 1
+        titles = {d.title for d in discoveries}
+        assert "Unused imports in jarvis/services/widget.py" in titles
+        assert "Stale comments in jarvis/services/widget.py" in titles
+
+    def test_mapper_reuses_analyzer_engine(self, tmp_path):
+        write_tree(
+            tmp_path,
+            {
+                "jarvis/services/todo_service.py": "class TodoService:\n    pass\n",
+                "tests/test_widget.py": SAMPLE,
+            },
+        )
+        engine = CodeAnalysisEngine(cache=False)
+        engine.analyze(tmp_path, [tmp_path / "tests" / "test_widget.py"])
+        mapper = TestMapper(str(tmp_path), engine=engine)
+        with patch.object(code_analysis, "collect_facts") as collect:
+            mapper.build_mapping()
+        collect.assert_not_called()
+        assert mapper.tests_for_files(["jarvis/services/todo_service.py"]) == ["tests/test_widget.py"]
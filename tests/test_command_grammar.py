@@ -0,0 +1,254 @@
+"""Tests for the deterministic command fast path (Roku and calendar)."""
+
+from unittest.mock import AsyncMock, MagicMock
+
+import pytest
+
+from jarvis.agents.calendar_agent import CalendarCommandProcessor, CalendarFunctionRegistry
+from jarvis.agents.calendar_agent.grammar import build_grammar as calendar_grammar
+from jarvis.agents.calendar_agent.tools.tools import tools as calendar_tools
+from jarvis.agents.command_grammar import CommandGrammar, FastPathStats, Rule, normalize_command
+from jarvis.agents.roku_agent.command_processor import RokuCommandProcessor
+from jarvis.agents.roku_agent.grammar import build_grammar as roku_grammar
+from jarvis.ai_clients.base import BaseAIClient
+from jarvis.services.calendar_service import CalendarService
+from jarvis.services.roku_discovery import RokuDeviceInfo, RokuDeviceRegistry
+
+TOOLS = [
+    {
+        "type": "function",
+        "function": {
+            "name": "volume_up",
+            "parameters": {
+                "type": "object",
+                "properties": {"count": {"type": "integer"}, "device": {"type": "string"}},
+                "required": [],
+            },
+        },
+    },
+    {
+        "type": "function",
+        "function": {
+            "name": "switch_input",
+            "parameters": {
+                "type": "object",
+                "properties": {"input_name": {"type": "string", "enum": ["HDMI1", "HDMI2"]}},
+                "required": ["input_name"],
+            },
+        },
+    },
+]
+
+
+def _reply(args, result):
+    return "ok"
+
+
+# ---------------------------------------------------------------------------
+# Grammar
+# ---------------------------------------------------------------------------
+
+
+def test_normalize_strips_politeness_and_wake_word():
+    assert normalize_command("Hey Jarvis, could you please pause the TV?") == "pause the tv"
+    assert normalize_command("Volume up, thanks!") == "volume up"
+
+
+def test_slots_are_typed_from_schema():
+    grammar = CommandGrammar(
+        TOOLS,
+        [
+            Rule("volume_up", (r"volume up(?: {count} times)?",), _reply),
+            Rule("switch_input", (r"switch to {input_name}",), _reply),
+        ],
+        aliases={"input_name": {"hdmi 2": "HDMI2"}},
+    )
+    assert grammar.match("volume up three times").arguments == {"count": 3}
+    assert grammar.match("volume up 4 times").arguments == {"count": 4}
+    assert grammar.match("volume up").arguments == {}
+    assert grammar.match("switch to HDMI 2").arguments == {"input_name": "HDMI2"}
+    assert grammar.match("switch to hdmi9") is None
+    assert grammar.match("volume up and open netflix") is None
+
+
+def test_rules_are_validated_against_schema():
+    with pytest.raises(ValueError, match="unknown tool"):
+        CommandGrammar(TOOLS, [Rule("volume_sideways", ("sideways",), _reply)])
+    with pytest.raises(ValueError, match="unknown parameter"):
+        CommandGrammar(TOOLS, [Rule("volume_up", ("up by {amount}",), _reply)])
+    with pytest.raises(ValueError, match="unfilled"):
+        CommandGrammar(TOOLS, [Rule("switch_input", ("switch input",), _reply)])
+
+
+def test_shipped_grammars_compile_and_route():
+    roku = roku_grammar()
+    assert roku.match("pause").tool == "pause"
+    match = roku.match("turn it up three times")
+    assert (match.tool, match.arguments) == ("volume_up", {"count": 3})
+    assert roku.match("switch to HDMI 2").arguments == {"input_name": "HDMI2"}
+    match = roku.match("open netflix on the bedroom tv")
+    assert match.arguments == {"app_name": "netflix", "device": "bedroom tv"}
+    assert roku.match("play stranger things") is None
+    assert roku.match("start watching the office on netflix") is None
+
+    calendar = calendar_grammar()
+    assert calendar.match("What's on today?").tool == "get_today_events"
+    assert calendar.match("what's my next meeting").tool == "get_next_event"
+    assert calendar.match("move my 3pm to tomorrow") is None
+
+
+def test_stats_hit_rate_and_savings():
+    stats = FastPathStats()
+    stats.record_llm("pause", 1200.0)
+    stats.record_fast("pause", 200.0)
+    stats.record_fast("pause", 200.0)
+    stats.record_fast("home", 100.0)  # no LLM sample: uses the overall mean
+    snap = stats.snapshot()
+    assert snap["classes"]["pause"]["hit_rate"] == pytest.approx(0.667)
+    assert snap["classes"]["pause"]["saved_ms"] == 2000.0
+    assert snap["classes"]["home"]["saved_ms"] == 1100.0
+    assert snap["saved_ms"] == 3100.0
+    assert snap["fast"] == 3 and snap["llm"] == 1
+
+
+# ---------------------------------------------------------------------------
+# Roku processor
+# ---------------------------------------------------------------------------
+
+
+def _roku_processor():
+    registry = RokuDeviceRegistry()
+    registry.save = MagicMock()
+    for serial, name in (("SER001", "Living Room"), ("SER002", "Bedroom")):
+        registry.devices[serial] = RokuDeviceInfo(
+            serial_number=serial, ip_address="10.0.0.1", device_name=f"{name} Roku",
+            friendly_name=name, model="Roku Ultra", is_online=True, last_seen=1.0,
+        )
+    registry.default_serial = "SER001"
+    ai = MagicMock(spec=BaseAIClient)
+    msg = MagicMock(content="Done.")
+    msg.model_dump = MagicMock(return_value={"role": "assistant", "content": "Done."})
+    ai.strong_chat = AsyncMock(return_value=(msg, None))
+    functions = {"volume_up": AsyncMock(return_value={"success": True}),
+                 "launch_app_by_name": AsyncMock(return_value={"success": True})}
+    func_registry = MagicMock()
+    func_registry.get_function.side_effect = functions.get
+    return RokuCommandProcessor(ai, func_registry, device_registry=registry), ai, functions
+
+
+@pytest.mark.asyncio
+async def test_roku_fast_path_skips_the_model():
+    proc, ai, functions = _roku_processor()
+    result = await proc.process_command("Turn it up three times please")
+
+    ai.strong_chat.assert_not_called()
+    functions["volume_up"].assert_awaited_once_with(count=3)
+    assert result["success"] is True
+    assert result["response"] == "Volume up 3 steps."
+    assert result["metadata"] == {"fast_path": True, "command_class": "volume_up"}
+    assert proc._history[-1]["assistant"] == "Volume up 3 steps."
+    assert proc.fast_path_stats.snapshot()["classes"]["volume_up"]["fast"] == 1
+
+
+@pytest.mark.asyncio
+async def test_roku_fast_path_resolves_known_device_only():
+    proc, ai, functions = _roku_processor()
+    await proc.process_command("open netflix on the bedroom tv")
+    functions["launch_app_by_name"].assert_awaited_once_with(app_name="netflix", device="Bedroom")
+    ai.strong_chat.assert_not_called()
+
+    # Unknown device: defer to the model, which knows how to ask
+    await proc.process_command("open netflix on the garage tv")
+    ai.strong_chat.assert_awaited()
+    assert proc.fast_path_stats.snapshot()["llm"] == 1
+
+
+def test_roku_device_hint_must_be_unambiguous():
+    proc, _, _ = _roku_processor()
+    for serial, name in (("SER003", "Kitchen TV"), ("SER004", "Kitchen TV 2")):
+        proc.device_registry.devices[serial] = RokuDeviceInfo(
+            serial_number=serial, ip_address="10.0.0.2", device_name=f"{name} Roku",
+            friendly_name=name, model="Roku Express", is_online=True, last_seen=1.0,
+        )
+    # An exact name beats a longer one that contains it
+    assert proc._known_device("kitchen tv") == "Kitchen TV"
+    assert proc._known_device("kitchen tv 2") == "Kitchen TV 2"
+    # A partial hint naming several devices is left to the model
+    assert proc._known_device("room") is None
+    assert proc._known_device("living") == "Living Room"
+
+
+@pytest.mark.asyncio
+async def test_roku_falls_back_when_tool_not_registered():
+    proc, ai, _ = _roku_processor()
+    result = await proc.process_command("pause")  # grammar matches, registry lacks it
+    ai.strong_chat.assert_awaited()
+    assert result["response"] == "Done."
+    assert "fast_path" not in (result.get("metadata") or {})
+
+
+@pytest.mark.asyncio
+async def test_roku_fast_path_can_be_disabled():
+    proc, ai, _ = _roku_processor()
+    proc.grammar = None
+    await proc.process_command("turn it up")
+    ai.strong_chat.assert_awaited()
+
+
+# ---------------------------------------------------------------------------
+# Calendar processor
+# ---------------------------------------------------------------------------
+
+
+def _calendar_processor(**service_methods):
+    service = MagicMock(spec=CalendarService)
+    service.current_date.return_value = "2026-03-17"
+    for name, value in service_methods.items():
+        mock = value if isinstance(value, AsyncMock) else AsyncMock(return_value=value)
+        setattr(service, name, mock)
+    ai = MagicMock(spec=BaseAIClient)
+    msg = MagicMock(content="Let me check.")
+    msg.model_dump = MagicMock(return_value={"role": "assistant", "content": "Let me check."})
+    ai.weak_chat = AsyncMock(return_value=(msg, None))
+    proc = CalendarCommandProcessor(
+        ai_client=ai,
+        calendar_service=service,
+        function_registry=CalendarFunctionRegistry(service),
+        tools=calendar_tools,
+    )
+    return proc, ai
+
+
+@pytest.mark.asyncio
+async def test_calendar_fast_path_reads_todays_events():
+    proc, ai = _calendar_processor(get_today_events=[
+        {"title": "Lunch", "time": "2026-03-17T12:30:00"},
+        {"title": "Standup", "time": "2026-03-17T09:00:00"},
+    ])
+    result = await proc.process_command("What's on my calendar today?")
+
+    ai.weak_chat.assert_not_called()
+    assert result["success"] is True
+    assert result["response"] == "You have 2 events today: Standup at 9:00 AM and Lunch at 12:30 PM."
+    assert result["actions"][0]["function"] == "get_today_events"
+    assert result["metadata"]["fast_path"] is True
+
+
+@pytest.mark.asyncio
+async def test_calendar_fast_path_surfaces_service_errors():
+    proc, ai = _calendar_processor(
+        get_tomorrow_events=AsyncMock(side_effect=RuntimeError("HTTP 503"))
+    )
+    result = await proc.process_command("what do I have tomorrow")
+    ai.weak_chat.assert_not_called()
+    assert result["success"] is False
+    assert "HTTP 503" in result["error"]["message"]
+
+
+@pytest.mark.asyncio
+async def test_calendar_open_questions_go_to_the_model():
+    proc, ai = _calendar_processor()
+    result = await proc.process_command("What's on my calendar?")
+    ai.weak_chat.assert_awaited()
+    assert result["response"] == "Let me check."
+    assert proc.fast_path_stats.snapshot()["classes"]["conversation"]["llm"] == 1
@@ -17,6 +17,7 @@ from unittest.mock import AsyncMock
 
 from jarvis.agents.agent_network import AgentNetwork
 from jarvis.agents.nlu_agent import NLUAgent
+from jarvis.agents.nlu_agent.dag_executor import DagExecution
 from jarvis.agents.base import NetworkAgent
 from jarvis.ai_clients.base import BaseAIClient
 from jarvis.logging import JarvisLogger
@@ -827,6 +828,92 @@ async def test_dag_execution_with_results_tracking():
         await network.stop()
 
 
+class TestDagExecution:
+    """Unit tests for the per-request DAG state."""
+
+    def test_completion_releases_only_ready_successors(self):
+        execution = DagExecution({"a": [], "b": [], "c": ["a", "b"], "d": ["a"]}, {})
+        assert execution.roots() == ["a", "b"]
+        execution.start("a")
+        execution.start("b")
+        assert execution.complete("a", {"capability": "a"}) == ["d"]
+        assert execution.complete("b", {"capability": "b"}) == ["c"]
+        assert not execution.done
+
+    def test_context_shared_for_roots_and_ancestors_for_dependents(self):
+        context = {"conversation_history": []}
+        execution = DagExecution({"a": [], "x": [], "b": ["a"], "c": ["b"]}, context)
+        assert execution.context_for("a") is context
+        for cap in ("a", "x"):
+            execution.start(cap)
+            execution.complete(cap, {"capability": cap})
+        execution.start("b")
+        execution.complete("b", {"capability": "b"})
+        previous = execution.context_for("c")["previous_results"]
+        assert [r["capability"] for r in previous] == ["a", "b"]
+        assert "previous_results" not in context
+
+    def test_dependencies_outside_dag_are_ignored(self):
+        execution = DagExecution({"a": ["missing"], "b": ["a"]}, {})
+        assert execution.roots() == ["a"]
+
+    def test_duplicate_response_kept_but_releases_nothing(self):
+        execution = DagExecution({"a": [], "b": ["a"]}, {})
+        execution.start("a")
+        assert execution.complete("a", {"capability": "a"}) == ["b"]
+        assert execution.complete("a", {"capability": "a"}) == []
+        assert len(execution.results) == 2
+
+    def test_critical_path(self):
+        now = [0.0]
+        execution = DagExecution(
+            {"a": [], "b": [], "c": ["a", "b"]}, {}, clock=lambda: now[0]
+        )
+        for cap, finish in (("a", 0.1), ("b", 0.3)):
+            execution.start(cap)
+            now[0] = finish
+            execution.complete(cap, {"capability": cap})
+        execution.start("c")
+        now[0] = 0.5
+        execution.complete("c", {"capability": "c"})
+        assert execution.done
+        path, ms = execution.critical_path()
+        assert path == ["b", "c"]
+        assert ms == pytest.approx(500.0)
+        assert execution.summary()["node_ms"]["c"] == pytest.approx(200.0)
+
+
+@pytest.mark.asyncio
+async def test_dag_deadline_answers_with_partial_results():
+    """A straggler does not hold the request past the NLU deadline."""
+    network = AgentNetwork()
+    dag = {"dag": {"fast_task": [], "slow_task": [], "after_slow": ["slow_task"]}}
+    nlu = NLUAgent(MockAIClient(dag), logger=JarvisLogger(), response_timeout=0.3)
+    fast = MockAgent("FastAgent", "fast_task", delay=0.01)
+    slow = MockAgent("SlowAgent", "slow_task", delay=5.0)
+    after = MockAgent("AfterAgent", "after_slow", delay=0.01)
+    for agent in (nlu, fast, slow, after):
+        network.register_agent(agent)
+    await network.start()
+
+    try:
+        request_id = "test_deadline_001"
+        await network.request_capability(
+            from_agent="TestSystem",
+            capability="intent_matching",
+            data={"input": "Do fast and slow things"},
+            request_id=request_id,
+        )
+        result = await network.wait_for_response(request_id, timeout=3.0)
+
+        assert sorted(result["timed_out"]) == ["after_slow", "slow_task"]
+        assert [r["capability"] for r in result["results"]] == ["fast_task"]
+        assert not after.execution_order
+        assert request_id not in nlu.active_requests
+    finally:
+        await network.stop()
+
+
 if __name__ == "__main__":
     # Run with: python -m pytest tests/test_dag_execution.py -v -s
     pytest.main([__file__, "-v", "-s"])
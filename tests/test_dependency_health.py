@@ -0,0 +1,221 @@
+"""Tests for failing fast on agents whose hard dependencies are down."""
+
+import asyncio
+
+import pytest
+import pytest_asyncio
+
+from jarvis.agents.agent_network import AgentNetwork
+from jarvis.agents.base import NetworkAgent
+from jarvis.agents.dependency_health import DependencyHealth, is_unreachable_error
+
+
+class RokuStub(NetworkAgent):
+    """Answers every request with whatever reply the test queues."""
+
+    def __init__(self, probe=None):
+        super().__init__("RokuAgent")
+        self.handled = 0
+        self.reply = {"success": True, "response": "Paused."}
+        self._probe = probe
+
+    @property
+    def capabilities(self):
+        return {"roku_command"}
+
+    def dependency_probes(self):
+        return {"RokuDevice": self._probe} if self._probe else {}
+
+    async def _handle_capability_request(self, message):
+        self.handled += 1
+        await self.send_capability_response(
+            message.from_agent, self.reply, message.request_id, message.id
+        )
+
+
+def _unreachable():
+    return {
+        "success": False,
+        "response": "I couldn't reach the TV.",
+        "error": {
+            "message": "Failed to press key: All connection attempts failed",
+            "error_type": "FunctionExecutionError",
+            "details": {"exception_class": "ConnectError"},
+        },
+    }
+
+
+async def _ask(network, request_id):
+    await network.request_capability("Orchestrator", "roku_command", {"prompt": "pause"}, request_id)
+    return await network.wait_for_response(request_id, timeout=2.0)
+
+
+@pytest_asyncio.fixture
+async def running():
+    networks = []
+
+    async def make(agent, **kwargs):
+        network = AgentNetwork()
+        network.dependency_health = DependencyHealth(logger=network.logger, **kwargs)
+        network.register_agent(agent)
+        await network.start()
+        networks.append(network)
+        return network
+
+    yield make
+    for network in networks:
+        await network.stop()
+
+
+def test_unreachable_classifier():
+    assert is_unreachable_error({"message": "x", "error_type": "ConnectTimeout"})
+    assert is_unreachable_error({"message": "x", "details": {"exception_class": "ReadTimeout"}})
+    assert is_unreachable_error({"message": "x", "details": {"dependency": "GoogleSearchAPI"}})
+    # Text alone is never attributed to the backend
+    assert not is_unreachable_error({"message": "[Errno 113] No route to host"})
+    assert not is_unreachable_error("Failed to get device info: All connection attempts failed")
+    assert not is_unreachable_error({"message": "Unknown color 'mauve'"})
+    assert not is_unreachable_error(None)
+
+
+def test_llm_timeouts_do_not_mark_backend_down():
+    health = DependencyHealth(failure_threshold=1)
+    for error in (
+        {"message": "Request timed out.", "error_type": "APITimeoutError"},
+        {"message": "Connection error.", "error_type": "APIConnectionError"},
+        {"message": "LLM call timeout after 30s", "error_type": "TimeoutError"},
+    ):
+        health.observe_reply("SearchAgent", {"success": False, "error": error})
+    assert health.down() == {}
+
+
+def test_named_dependency_is_the_only_one_charged():
+    health = DependencyHealth(
+        hard_dependencies={"HomeAgent": ["RokuDevice", "HueBridge"]}, failure_threshold=1
+    )
+    health.observe_reply("HomeAgent", {
+        "success": False,
+        "error": {"message": "bridge offline", "details": {"dependency": "HueBridge"}},
+    })
+    assert set(health.down()) == {"HueBridge"}
+
+
+@pytest.mark.asyncio
+async def test_repeated_unreachable_errors_fail_fast(running):
+    agent = RokuStub()
+    agent.reply = _unreachable()
+    network = await running(agent, retry_interval=60.0)
+
+    for i in range(2):
+        result = await _ask(network, f"r{i}")
+        assert result["response"] == "I couldn't reach the TV."
+    assert agent.handled == 2
+
+    result = await _ask(network, "r2")
+    assert agent.handled == 2  # never dispatched
+    assert result["success"] is False
+    assert result["error"]["error_type"] == "DependencyUnavailable"
+    assert "can't reach the Roku" in result["response"]
+
+    stats = network.get_metrics()["dependency_health"]
+    assert stats["timeouts_avoided"] == 1
+    assert stats["fail_fast_by_dependency"] == {"RokuDevice": 1}
+    assert stats["seconds_saved_estimate"] == 15.0
+    assert "RokuDevice" in stats["down"]
+
+
+@pytest.mark.asyncio
+async def test_other_errors_do_not_open_outage(running):
+    agent = RokuStub()
+    agent.reply = {"success": False, "response": "?", "error": {"message": "Unknown app 'Foo'"}}
+    network = await running(agent)
+    for i in range(3):
+        await _ask(network, f"r{i}")
+    assert agent.handled == 3
+    assert network.dependency_health.down() == {}
+
+
+@pytest.mark.asyncio
+async def test_background_probe_reenables_route(running):
+    answers = [False, True]
+
+    async def probe():
+        return answers.pop(0)
+
+    agent = RokuStub(probe=probe)
+    network = await running(agent, retry_interval=0.01)
+    network.dependency_health.observe_probe("RokuDevice", False, "probe timed out")
+    assert network.dependency_health.blocking_dependency("RokuAgent") == "RokuDevice"
+
+    for _ in range(100):
+        if not network.dependency_health.down():
+            break
+        await asyncio.sleep(0.01)
+
+    assert answers == []
+    assert network.dependency_health.blocking_dependency("RokuAgent") is None
+    result = await _ask(network, "after")
+    assert result["response"] == "Paused."
+    stats = network.get_metrics()["dependency_health"]
+    assert stats["recoveries"] == 1
+    assert stats["probe_failures"] == 1
+
+
+@pytest.mark.asyncio
+async def test_without_probe_next_request_is_the_trial(running):
+    agent = RokuStub()
+    network = await running(agent, retry_interval=0.01)
+    health = network.dependency_health
+    health.mark_down("RokuDevice", "connection refused")
+    await asyncio.sleep(0.05)
+
+    # Trial request fails: the route closes again
+    assert health.blocking_dependency("RokuAgent") is None
+    agent.reply = _unreachable()
+    await _ask(network, "trial-1")
+    assert health.blocking_dependency("RokuAgent") == "RokuDevice"
+
+    # Next trial succeeds: outage cleared
+    await asyncio.sleep(0.05)
+    agent.reply = {"success": True, "response": "Paused."}
+    assert (await _ask(network, "trial-2"))["response"] == "Paused."
+    assert health.down() == {}
+
+
+def test_probe_components_map_to_dependencies():
+    health = DependencyHealth()
+    health.observe_probe("CalendarAPI", False, "HTTP 503")
+    health.observe_probe("SQLite", False, "locked")  # not a hard dependency
+    assert set(health.down()) == {"CalendarService"}
+    assert health.blocking_dependency("CalendarAgent") == "CalendarService"
+    health.observe_probe("CalendarAPI", True)
+    assert health.down() == {}
+
+
+def test_fail_fast_reply_is_not_counted_as_failure():
+    health = DependencyHealth(failure_threshold=1)
+    reply = health.fail_fast_response("RokuAgent", "RokuDevice")
+    health.observe_reply("RokuAgent", reply)
+    assert health.down() == {}
+
+
+@pytest.mark.asyncio
+async def test_health_agent_feeds_probe_results(tmp_path):
+    from jarvis.agents.health_agent import HealthAgent
+    from jarvis.agents.health_agent.models import ComponentStatus, ProbeResult, SystemHealthSnapshot
+    from jarvis.services.health_service import HealthService
+
+    network = AgentNetwork()
+    agent = HealthAgent(health_service=HealthService(), report_dir=str(tmp_path))
+    agent.network = network
+    down = ProbeResult("CalendarAPI", "service", ComponentStatus.UNHEALTHY, message="HTTP 502")
+    await agent._feed_dependency_health(
+        SystemHealthSnapshot(overall_status=ComponentStatus.UNHEALTHY, service_statuses=[down])
+    )
+    assert network.dependency_health.down()["CalendarService"].reason == "HTTP 502"
+
+    response = await agent._dependency_map()
+    nodes = {n["name"]: n for n in response.data["nodes"]}
+    assert nodes["CalendarService"]["status"] == "unhealthy"
+    await network.dependency_health.stop()
+
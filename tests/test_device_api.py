@@ -283,6 +283,35 @@ class TestDeviceRouterWithAgent:
             assert data["hours"] == 6
             assert data["data"] == []
 
+    @pytest.mark.asyncio
+    async def test_history_served_from_metrics_store(self, tmp_path):
+        from datetime import datetime, timedelta, timezone
+        from jarvis.services.metrics_store import MetricsStore
+
+        store = MetricsStore(db_path=str(tmp_path / "metrics.db"))
+        now = datetime.now(timezone.utc)
+        store.record_batch([
+            {"timestamp": (now - timedelta(minutes=i)).isoformat(), "component": "cpu",
+             "metric_name": "cpu_overall", "value": float(i)}
+            for i in range(30)
+        ])
+        transport, agent, snap = _app_with_agent()
+        agent.metrics_store = store
+        try:
+            async with httpx.AsyncClient(transport=transport, base_url="http://test") as c:
+                resp = await c.get("/device/history/cpu?metric=cpu_overall&hours=1")
+                data = resp.json()
+                assert data["resolution"] == "raw"
+                assert len(data["data"]) == 30
+                assert data["data"][-1]["value"] == 0.0  # oldest first
+
+                resp = await c.get("/device/history/cpu/aggregated?hours=720&limit=10")
+                data = resp.json()
+                assert data["resolution"] == "day"
+                assert sum(p["count"] for p in data["data"]) == 30
+        finally:
+            store.close()
+
     @pytest.mark.asyncio
     async def test_diagnostics_returns_agent_response(self):
         from jarvis.agents.response import AgentResponse
@@ -20,7 +20,14 @@ import pytest
 from jarvis.agents.agent_network import AgentNetwork
 from jarvis.agents.base import NetworkAgent
 from jarvis.agents.collaboration import CollaborationMixin
-from jarvis.agents.dialogue import DialogueSession, DialogueStatus, DialogueTurn
+from jarvis.agents.dialogue import (
+    DialogueSession,
+    DialogueStatus,
+    DialogueTurn,
+    context_messages,
+    estimate_tokens,
+)
+from jarvis.ai_clients.scripted_client import ScriptedAIClient
 from jarvis.agents.message import Message
 from jarvis.agents.response import AgentResponse
 from jarvis.core.errors import (
@@ -1067,3 +1074,132 @@ class TestHandleDialogueToolCall:
             assert result["turns"] >= 2
         finally:
             await network.stop()
+
+
+# ===========================================================================
+# Compact dialogue context
+# ===========================================================================
+
+
+class RecordingAIClient(ScriptedAIClient):
+    """ScriptedAIClient that keeps every prompt it was sent."""
+
+    def __init__(self):
+        super().__init__()
+        self.prompts: List[List[Dict[str, Any]]] = []
+
+    async def strong_chat(self, messages, tools=None):
+        self.prompts.append([dict(m) for m in messages])
+        return await super().strong_chat(messages, tools)
+
+
+class TestCompactDialogueContext:
+    def test_compact_folds_oldest_turns_into_summary(self):
+        session = DialogueSession(goal="g")
+        for i in range(8):
+            session.add_turn("A" if i % 2 == 0 else "B", f"Turn {i} says something. " + "x" * 200)
+        assert session.compact(max_tokens=200, keep_recent=2)
+        assert 0 < session.summarized_turns <= 6
+        context = session.context()
+        assert [t["turn"] for t in context["turns"]][-2:] == [7, 8]
+        assert "Turn 0 says something." in session.summary or session.summary.startswith("…")
+        assert estimate_tokens(session.summary) <= 200 // 3 + 60
+        # Full transcript is untouched
+        assert session.format_transcript().count("[Turn") == 8
+
+    def test_context_carries_data_not_prose(self):
+        session = DialogueSession(goal="g", capability="search")
+        session.add_turn("Lead", "Find flights")
+        session.add_turn("Search", "Found 2.", data={"flights": ["UA1", "AA2"]})
+        session.add_turn("Lead", "Book the first")
+        context = session.context(upto=2)
+        assert [t["message"] for t in context["turns"]] == ["Find flights", "Found 2."]
+        messages = context_messages(context, "Lead")
+        assert [m["role"] for m in messages] == ["assistant", "user"]
+        assert messages[1]["content"] == 'Found 2.\nData: {"flights": ["UA1", "AA2"]}'
+
+    def test_legacy_transcript_still_accepted(self):
+        messages = context_messages({"transcript": "[Turn 1] Lead: hi"}, "Search")
+        assert messages == [{"role": "system", "content": "Dialogue so far:\n[Turn 1] Lead: hi"}]
+
+    @pytest.mark.asyncio
+    async def test_prompts_keep_a_stable_prefix(self):
+        """Each side's prompt extends its previous one instead of rebuilding it."""
+        lead_ai, responder_ai = RecordingAIClient(), RecordingAIClient()
+        lead = DialogueLeadAgent("LeadAgent", ai_client=lead_ai)
+        provider = DialogueProviderAgent("SearchAgent", {"search"}, ai_client=responder_ai)
+        network = await setup_network(lead, provider)
+        try:
+            brief = make_brief()
+            session = await lead.dialogue(
+                capability="search",
+                initial_message="Plan a weekend trip",
+                goal="Plan a trip",
+                brief=brief,
+                max_turns=5,
+            )
+        finally:
+            await network.stop()
+
+        assert session.turn_count == 10
+        assert len(responder_ai.prompts) == 5 and len(lead_ai.prompts) == 4
+        for prompts in (responder_ai.prompts, lead_ai.prompts):
+            for earlier, later in zip(prompts, prompts[1:]):
+                assert later[: len(earlier) - 1] == earlier[:-1]
+        # The message being answered is not repeated inside the context
+        last = responder_ai.prompts[-1]
+        assert sum(m["content"] == last[-1]["content"] for m in last) == 1
+        # Structured results travel as data
+        assert session.turns[1].data == {"step": 1}
+        assert 'Data: {"step": 1}' in lead_ai.prompts[0][-1]["content"]
+
+        stats = brief.context.recruitment_results[0]["result"]["stats"]
+        assert stats["lead_llm_calls"] == 4
+        assert stats["context_tokens"] > 0 and stats["elapsed_ms"] >= 0
+
+    @pytest.mark.asyncio
+    async def test_context_stays_bounded_once_summarized(self):
+        responder_ai = RecordingAIClient()
+        lead = DialogueLeadAgent("LeadAgent", ai_client=RecordingAIClient())
+        provider = DialogueProviderAgent("SearchAgent", {"search"}, ai_client=responder_ai)
+        network = await setup_network(lead, provider)
+        try:
+            session = await lead.dialogue(
+                capability="search",
+                initial_message="Plan a weekend trip",
+                goal="Plan a trip",
+                brief=make_brief(),
+                max_turns=5,
+                context_tokens=80,
+            )
+        finally:
+            await network.stop()
+
+        assert session.summarized_turns > 0
+        sizes = [sum(estimate_tokens(m["content"]) for m in p) for p in responder_ai.prompts]
+        assert sizes[-1] - sizes[2] < sizes[2] - sizes[0]
+
+    @pytest.mark.asyncio
+    async def test_repeated_reply_ends_dialogue_without_lead_call(self):
+        responder_ai = SequenceAIClient([
+            {"message": "I can't find that.", "done": False},
+            {"message": "I can't  find that.", "done": False},
+        ])
+        lead_ai = DialogueReplyAIClient([("Try again", False), ("Again?", False)])
+        lead = DialogueLeadAgent("LeadAgent", ai_client=lead_ai)
+        provider = DialogueProviderAgent("SearchAgent", {"search"}, ai_client=responder_ai)
+        network = await setup_network(lead, provider)
+        try:
+            session = await lead.dialogue(
+                capability="search",
+                initial_message="Find it",
+                goal="Find",
+                brief=make_brief(),
+                max_turns=5,
+            )
+        finally:
+            await network.stop()
+
+        assert session.status == DialogueStatus.COMPLETED
+        assert session.turn_count == 4
+        assert lead_ai._call_count == 1
@@ -150,16 +150,68 @@ class TestMarkResolved:
         cid = fc.log_correction(1, "q1", "a1", "bad!")
         assert fc.mark_resolved(cid) is True
 
-        # Re-read from disk
+        # Resolution is appended, not rewritten into the original record
         with open(fc.corrections_file) as f:
-            record = json.loads(f.readline())
-        assert record["resolved"] is True
+            lines = [json.loads(l) for l in f if l.strip()]
+        assert lines[-1] == {"op": "resolve", "id": cid, "timestamp": lines[-1]["timestamp"]}
+
+        # A fresh collector replays the event from disk
+        reloaded = FeedbackCollector(feedback_dir=str(tmp_path / "feedback"))
+        assert reloaded.get_corrections() == []
+        assert reloaded.mark_resolved(cid) is False
 
     def test_returns_false_for_missing_id(self, tmp_path):
         fc = FeedbackCollector(feedback_dir=str(tmp_path / "feedback"))
         fc.log_correction(1, "q1", "a1", "bad!")
         assert fc.mark_resolved("nonexistent-id") is False
 
+    def test_compacts_once_dead_lines_dominate(self, tmp_path):
+        fc = FeedbackCollector(feedback_dir=str(tmp_path / "feedback"), compact_after=4)
+        ids = [fc.log_correction(1, f"q{i}", f"a{i}", "bad!") for i in range(3)]
+        fc.mark_resolved(ids[0])
+        assert len(fc.corrections_file.read_text().splitlines()) == 4
+
+        fc.mark_resolved(ids[1])
+        with open(fc.corrections_file) as f:
+            lines = [json.loads(l) for l in f if l.strip()]
+        assert [r["id"] for r in lines] == [ids[2]]
+
+    def test_reads_records_resolved_in_place(self, tmp_path):
+        """Logs written by the old rewrite-on-resolve scheme still load."""
+        path = tmp_path / "feedback" / "corrections.jsonl"
+        path.parent.mkdir()
+        path.write_text(
+            json.dumps({"id": "a", "user_id": 1, "original_input": "q1", "resolved": True}) + "\n"
+            + json.dumps({"id": "b", "user_id": 1, "original_input": "q2", "resolved": False}) + "\n"
+        )
+        fc = FeedbackCollector(feedback_dir=str(tmp_path / "feedback"))
+        assert [r["id"] for r in fc.get_corrections(user_id=1)] == ["b"]
+
+
+class TestRelevantCorrections:
+    def test_query_prefers_similar_inputs(self, tmp_path):
+        fc = FeedbackCollector(feedback_dir=str(tmp_path / "feedback"))
+        fc.log_correction(1, "what's the weather in Paris?", "It is sunny on Mars.", "bad!")
+        fc.log_correction(1, "turn the lights red", "Lights are now blue.", "wrong")
+        for i in range(3):
+            fc.log_correction(1, f"tell me joke number {i}", "no", "bad!")
+
+        picked = fc.get_corrections(limit=2, user_id=1, query="what's the weather in London")
+        assert picked[0]["original_input"] == "what's the weather in Paris?"
+        # Remaining slots go to the most recent corrections
+        assert picked[1]["original_input"] == "tell me joke number 2"
+
+    def test_per_user_ring_keeps_newest(self, tmp_path):
+        fc = FeedbackCollector(feedback_dir=str(tmp_path / "feedback"), per_user_capacity=3)
+        for i in range(5):
+            fc.log_correction(1, f"q{i}", f"a{i}", "bad!")
+
+        assert [r["original_input"] for r in fc.get_corrections(user_id=1)] == ["q2", "q3", "q4"]
+        # The log and the all-user view still hold everything
+        assert len(fc.get_corrections()) == 5
+        reloaded = FeedbackCollector(feedback_dir=str(tmp_path / "feedback"), per_user_capacity=3)
+        assert [r["original_input"] for r in reloaded.get_corrections(user_id=1)] == ["q2", "q3", "q4"]
+
 
 # ---------------------------------------------------------------------------
 # Orchestrator intercept
@@ -376,3 +376,99 @@ class TestOverallStatus:
     def test_empty_results(self, tmp_path):
         agent = _make_health_agent(str(tmp_path))
         assert agent._compute_overall_status([]) == ComponentStatus.UNKNOWN
+
+
+class TestHealthStore:
+    """Test in-memory snapshot, change detection and the snapshot endpoint."""
+
+    def test_readings_do_not_count_as_state_change(self):
+        from jarvis.agents.health_agent.store import HealthStore
+
+        def cpu(pct, status=ComponentStatus.HEALTHY):
+            return SystemHealthSnapshot(
+                overall_status=status,
+                resource_statuses=[ProbeResult("CPU", "resource", status, message=f"{pct}% usage")],
+            )
+
+        store = HealthStore()
+        assert store.update(cpu(10)) is True
+        etag = store.etag
+        assert store.update(cpu(12)) is False
+        # The body and ETag still track the latest readings
+        assert store.etag != etag and b"12% usage" in store.body
+        assert store.update(cpu(95, ComponentStatus.DEGRADED)) is True
+        assert store.version == 2
+        assert store.matches(f"W/{store.etag}, \"other\"")
+        assert not store.matches(etag)
+
+    @pytest.mark.asyncio
+    async def test_transitions_build_incident_timeline(self, tmp_path):
+        agent = _make_health_agent(str(tmp_path), _make_mock_network())
+        agent._component_statuses["Svc"] = ComponentStatus.HEALTHY
+
+        for status, message in [
+            (ComponentStatus.DEGRADED, "slow"),
+            (ComponentStatus.UNHEALTHY, "refused"),
+            (ComponentStatus.HEALTHY, "ok"),
+        ]:
+            await agent._process_transitions(SystemHealthSnapshot(
+                service_statuses=[ProbeResult("Svc", "service", status, message=message)],
+            ))
+
+        (incident,) = agent._incidents
+        assert [e.kind for e in incident.timeline] == ["opened", "status_change", "resolved"]
+        assert incident.to_dict()["timeline"][1]["status"] == "unhealthy"
+        (report,) = agent.report_writer.list_reports("incidents")
+        content = agent.report_writer.read_report(report)
+        assert content.index("**opened**") < content.index("**status_change**") < content.index("**resolved**")
+
+    @pytest.mark.asyncio
+    async def test_status_file_catches_change_seen_by_http_poll(self, tmp_path):
+        agent = _make_health_agent(str(tmp_path), _make_mock_network())
+        healthy = SystemHealthSnapshot(overall_status=ComponentStatus.HEALTHY)
+        degraded = SystemHealthSnapshot(overall_status=ComponentStatus.DEGRADED)
+        agent.store.update(healthy)
+        agent._refresh_status_file()
+        path = tmp_path / "current_status.md"
+        assert "HEALTHY" in path.read_text()
+
+        # An HTTP poll sees the transition first ...
+        agent._build_snapshot = AsyncMock(return_value=degraded)
+        await agent._system_health_check()
+        # ... so the monitor's own update reports no change
+        assert agent.store.update(degraded) is False
+        agent._refresh_status_file()
+        assert "DEGRADED" in path.read_text()
+
+    def test_snapshot_endpoint_serves_etag(self, tmp_path):
+        from fastapi import FastAPI
+        from fastapi.testclient import TestClient
+        from server.dependencies import get_jarvis
+        from server.routers.health import router
+
+        agent = _make_health_agent(str(tmp_path), _make_mock_network())
+        agent._build_snapshot = AsyncMock(return_value=SystemHealthSnapshot(
+            overall_status=ComponentStatus.HEALTHY, summary="1/1 components healthy",
+        ))
+        system = MagicMock()
+        system.network.agents = {"HealthAgent": agent}
+        app = FastAPI()
+        app.include_router(router, prefix="/health")
+        app.dependency_overrides[get_jarvis] = lambda: system
+        client = TestClient(app)
+
+        first = client.get("/health/snapshot")
+        assert first.status_code == 200
+        assert first.json()["summary"] == "1/1 components healthy"
+        etag = first.headers["etag"]
+
+        cached = client.get("/health/snapshot", headers={"If-None-Match": etag})
+        assert cached.status_code == 304
+        # Served from memory: no new probe cycle for either request
+        assert agent._build_snapshot.await_count == 1
+
+        agent.store.update(SystemHealthSnapshot(overall_status=ComponentStatus.DEGRADED))
+        changed = client.get("/health/snapshot", headers={"If-None-Match": etag})
+        assert changed.status_code == 200
+        assert changed.json()["overall_status"] == "degraded"
+        assert changed.headers["x-health-version"] == "2"
@@ -129,6 +129,42 @@ class TestReportWriter:
         assert "mermaid" in content
         assert "AgentA" in content
 
+    def test_status_file_only_rewritten_on_change(self, tmp_path):
+        writer = ReportWriter(str(tmp_path))
+        snapshot = SystemHealthSnapshot(overall_status=ComponentStatus.HEALTHY, summary="All good")
+        path = writer.write_status_file(snapshot)
+        mtime = os.stat(path).st_mtime_ns
+        # A new cycle with identical content leaves the file alone
+        writer.write_status_file(SystemHealthSnapshot(overall_status=ComponentStatus.HEALTHY, summary="All good"))
+        assert os.stat(path).st_mtime_ns == mtime
+        assert (writer.writes, writer.skipped) == (1, 1)
+
+        writer.write_status_file(SystemHealthSnapshot(overall_status=ComponentStatus.DEGRADED, summary="Meh"))
+        assert "DEGRADED" in open(path).read()
+        assert writer.writes == 2
+        assert not [p for p in os.listdir(tmp_path) if p.endswith(".tmp")]
+
+    def test_incident_report_appends_timeline(self, tmp_path):
+        writer = ReportWriter(str(tmp_path))
+        incident = IncidentRecord(component="Svc", title="Svc is degraded", description="slow")
+        incident.record("opened", "slow", ComponentStatus.DEGRADED)
+        path = writer.write_incident_report(incident)
+        first = open(path).read()
+
+        incident.record("status_change", "refused", ComponentStatus.UNHEALTHY)
+        incident.resolved_at = incident.started_at
+        incident.record("resolved", "back", ComponentStatus.HEALTHY)
+        assert writer.update_incident_report(incident) == path
+        content = open(path).read()
+        # Earlier content is untouched; only the new events were appended
+        assert content.startswith(first)
+        assert "**status_change** (unhealthy): refused" in content[len(first):]
+        assert "**resolved** (healthy): back" in content
+        assert content.count("# Incident:") == 1
+
+        writer.update_incident_report(incident)
+        assert open(path).read() == content
+
     def test_read_report(self, tmp_path):
         writer = ReportWriter(str(tmp_path))
         (tmp_path / "test.md").write_text("# Test")
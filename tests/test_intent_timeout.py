@@ -26,9 +26,9 @@ class SilentNLUAgent(NetworkAgent):
 
 
 @pytest.mark.asyncio
-async def test_nlu_classification_timeout():
+async def test_nlu_classification_timeout(shared_services):
     config = JarvisConfig(intent_timeout=0.05, response_timeout=0.5)
-    jarvis = JarvisSystem(config)
+    jarvis = JarvisSystem(config, services=shared_services)
     silent = SilentNLUAgent()
     jarvis.network.register_agent(silent)
 
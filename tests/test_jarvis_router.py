@@ -10,6 +10,7 @@ import pytest
 from httpx import ASGITransport
 
 import server
+from jarvis.utils.serialization import Payload
 from tests import disable_lifespan
 from server.auth import create_token, hash_password
 from server.database import init_database
@@ -64,7 +65,7 @@ def _setup_app(tmp_path, agents_dict=None, process_response=None):
             "success": True,
             "actions": [],
         }
-    mock_jarvis.process_request = AsyncMock(return_value=process_response)
+    mock_jarvis.respond = AsyncMock(return_value=Payload(process_response))
 
     def get_caps(name):
         if name in agents_dict:
@@ -181,7 +182,7 @@ class TestJarvisPostEndpoint:
             cleanup()
 
     @pytest.mark.asyncio
-    async def test_process_request_receives_metadata(self, tmp_path):
+    async def test_respond_receives_metadata(self, tmp_path):
         db, mock_jarvis, token, cleanup = _setup_app(tmp_path)
         try:
             transport = ASGITransport(app=server.app)
@@ -195,9 +196,9 @@ class TestJarvisPostEndpoint:
                         "X-Source": "voice",
                     },
                 )
-                call_args = mock_jarvis.process_request.call_args
+                call_args = mock_jarvis.respond.call_args
                 assert call_args is not None
-                # process_request(command, tz, metadata, allowed_agents=...)
+                # respond(command, tz, metadata, allowed_agents=...)
                 metadata = call_args[0][2]
                 assert metadata["device"] == "phone"
                 assert metadata["source"] == "voice"
@@ -205,7 +206,7 @@ class TestJarvisPostEndpoint:
             cleanup()
 
     @pytest.mark.asyncio
-    async def test_process_request_called_with_command(self, tmp_path):
+    async def test_respond_called_with_command(self, tmp_path):
         db, mock_jarvis, token, cleanup = _setup_app(tmp_path)
         try:
             transport = ASGITransport(app=server.app)
@@ -215,13 +216,13 @@ class TestJarvisPostEndpoint:
                     json={"command": "what is the weather"},
                     headers={"Authorization": f"Bearer {token}"},
                 )
-                call_args = mock_jarvis.process_request.call_args
+                call_args = mock_jarvis.respond.call_args
                 assert call_args[0][0] == "what is the weather"
         finally:
             cleanup()
 
     @pytest.mark.asyncio
-    async def test_process_request_error_propagates(self, tmp_path):
+    async def test_respond_error_propagates(self, tmp_path):
         error_resp = {"response": "Something went wrong", "success": False, "actions": []}
         db, mock_jarvis, token, cleanup = _setup_app(
             tmp_path, process_response=error_resp
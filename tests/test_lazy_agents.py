@@ -0,0 +1,263 @@
+"""Tests for lazy agent materialization and startup accounting."""
+
+import asyncio
+from unittest.mock import AsyncMock, MagicMock, patch
+
+import pytest
+
+from jarvis.agents.agent_network import AgentNetwork
+from jarvis.agents.base import NetworkAgent
+from jarvis.agents.factory import AgentFactory
+from jarvis.agents.lazy_agent import LazyAgent
+from jarvis.agents.message import Message
+from jarvis.ai_clients.dummy_client import DummyAIClient
+from jarvis.core.config import FeatureFlags, JarvisConfig
+from jarvis.logging import JarvisLogger
+
+
+class _RealAgent(NetworkAgent):
+    """Real agent used behind the stub."""
+
+    CAPABILITIES = frozenset({"do_thing", "other_thing"})
+
+    def __init__(self):
+        super().__init__("RealAgent")
+        self.calls = []
+        self.intent_map = {"do_thing": self._do_thing}
+
+    @property
+    def capabilities(self):
+        return set(self.CAPABILITIES)
+
+    async def _do_thing(self, value=None):
+        self.calls.append(value)
+        return {"value": value}
+
+    async def _handle_capability_request(self, message):
+        self.calls.append(message.content)
+
+
+def _stub(network, builder=None, refs=None):
+    built = []
+
+    def default_builder():
+        agent = _RealAgent()
+        built.append(agent)
+        return {"real_agent": agent, "real_service": object()}
+
+    stub = LazyAgent(
+        "RealAgent",
+        _RealAgent,
+        builder or default_builder,
+        "real_agent",
+        refs=refs,
+    )
+    network.register_agent(stub)
+    return stub, built
+
+
+class TestLazyAgent:
+    def test_stub_advertises_capabilities_without_building(self):
+        network = AgentNetwork()
+        stub, built = _stub(network)
+        assert stub.capabilities == {"do_thing", "other_thing"}
+        assert stub.description == "Real agent used behind the stub."
+        assert network.capability_registry["do_thing"] == ["RealAgent"]
+        assert not built
+        assert network.lazy_agents() == [stub]
+
+    @pytest.mark.asyncio
+    async def test_run_capability_builds_and_swaps(self):
+        network = AgentNetwork()
+        refs = {}
+        stub, built = _stub(network, refs=refs)
+        network.agents["Alias"] = stub
+
+        result = await stub.run_capability("do_thing", value=3)
+
+        assert result == {"value": 3}
+        assert len(built) == 1
+        real = built[0]
+        assert network.agents["RealAgent"] is real
+        assert network.agents["Alias"] is real
+        assert real.network is network
+        assert refs["real_agent"] is real and "real_service" in refs
+        assert stub.build_ms is not None
+        assert network.lazy_agents() == []
+
+    @pytest.mark.asyncio
+    async def test_concurrent_first_use_builds_once(self):
+        network = AgentNetwork()
+        stub, built = _stub(network)
+        await asyncio.gather(*(stub.materialize() for _ in range(10)))
+        assert len(built) == 1
+
+    @pytest.mark.asyncio
+    async def test_capability_request_is_forwarded(self):
+        network = AgentNetwork()
+        stub, built = _stub(network)
+        msg = Message(
+            from_agent="tester",
+            to_agent="RealAgent",
+            message_type="capability_request",
+            content={"capability": "do_thing"},
+            request_id="r1",
+        )
+        await stub.receive_message(msg)
+        assert built[0].calls == [{"capability": "do_thing"}]
+
+    @pytest.mark.asyncio
+    async def test_broadcasts_do_not_build(self):
+        network = AgentNetwork()
+        stub, built = _stub(network)
+        msg = Message(
+            from_agent="HealthAgent",
+            to_agent=None,
+            message_type="health_alert",
+            content={},
+            request_id="r1",
+        )
+        await stub.receive_message(msg)
+        assert not built
+
+    @pytest.mark.asyncio
+    async def test_failed_build_unregisters_stub(self):
+        network = AgentNetwork()
+
+        def broken():
+            raise ConnectionError("bridge unreachable")
+
+        stub, _ = _stub(network, builder=broken)
+        stub.send_error = AsyncMock()
+        msg = Message(
+            from_agent="tester",
+            to_agent="RealAgent",
+            message_type="capability_request",
+            content={"capability": "do_thing"},
+            request_id="r1",
+        )
+        await stub.receive_message(msg)
+
+        stub.send_error.assert_awaited_once()
+        assert "RealAgent" not in network.agents
+        assert "do_thing" not in network.capability_registry
+        assert await network.get_agent("RealAgent") is None
+        with pytest.raises(RuntimeError):
+            await stub.materialize()
+
+    @pytest.mark.asyncio
+    async def test_get_agent_materializes(self):
+        network = AgentNetwork()
+        stub, built = _stub(network)
+        agent = await network.get_agent("RealAgent")
+        assert agent is built[0]
+
+
+class TestDeclaredCapabilities:
+    """Stubs advertise CAPABILITIES; the built agents must agree."""
+
+    def test_device_monitor(self):
+        from jarvis.agents.device_monitor_agent import DeviceMonitorAgent
+
+        agent = DeviceMonitorAgent(device_service=MagicMock(), metrics_store=MagicMock())
+        assert agent.capabilities == set(DeviceMonitorAgent.CAPABILITIES)
+
+    def test_server_manager(self):
+        from jarvis.agents.server_manager_agent import ServerManagerAgent
+
+        agent = ServerManagerAgent(server_service=MagicMock())
+        assert agent.capabilities == set(ServerManagerAgent.CAPABILITIES)
+
+    def test_canvas(self):
+        from jarvis.agents.canvas import CanvasAgent
+
+        agent = CanvasAgent(MagicMock(), MagicMock())
+        assert agent.capabilities == set(CanvasAgent.CAPABILITIES)
+
+    def test_lights(self):
+        from jarvis.agents.lights_agent.lighting_agent import LightingAgent
+
+        agent = LightingAgent(backend=MagicMock(), ai_client=MagicMock())
+        assert agent.capabilities == set(LightingAgent.CAPABILITIES)
+
+    def test_roku(self):
+        from jarvis.agents.roku_agent import RokuAgent
+
+        agent = RokuAgent(ai_client=MagicMock(), device_registry=MagicMock())
+        assert agent.capabilities == set(RokuAgent.CAPABILITIES)
+
+
+class TestLazyFactory:
+    @pytest.fixture
+    def config(self):
+        return JarvisConfig(
+            flags=FeatureFlags(
+                enable_lights=False,
+                enable_canvas=True,
+                enable_night_mode=True,
+                enable_roku=False,
+                enable_self_improvement=False,
+            ),
+            google_search_api_key=None,
+            google_search_engine_id=None,
+        )
+
+    @pytest.mark.asyncio
+    async def test_device_agents_are_stubs_and_night_workers_deferred(self, config):
+        network = AgentNetwork()
+        factory = AgentFactory(config, JarvisLogger())
+        system = MagicMock()
+        with patch("jarvis.agents.factory.VectorMemoryService"), patch.object(
+            factory, "_create_canvas", side_effect=AssertionError("built eagerly")
+        ):
+            refs = await factory.build_all_async(network, DummyAIClient(), system)
+
+        for name in ("CanvasAgent", "DeviceMonitorAgent", "ServerManagerAgent"):
+            assert isinstance(network.agents[name], LazyAgent)
+        assert "canvas_agent" not in refs
+        assert "night_controller" in refs
+        assert "night_agents" not in refs
+        assert "chat" in factory.timings and "nlu" in factory.timings
+
+        factory.build_deferred(network, system, refs)
+        names = [a.name for a in refs["night_agents"]]
+        assert "LogCleanupAgent" in names
+        # Idempotent
+        factory.build_deferred(network, system, refs)
+        assert [a.name for a in refs["night_agents"]] == names
+
+    @pytest.mark.asyncio
+    async def test_materialized_stub_registers_dependency_probes(self, config):
+        from jarvis.agents.roku_agent import RokuAgent
+
+        config.flags.enable_roku = True
+        config.roku_ip_address = "10.0.0.5"
+        network = AgentNetwork()
+        factory = AgentFactory(config, JarvisLogger())
+        roku = RokuAgent(ai_client=MagicMock(), device_registry=MagicMock())
+        with patch("jarvis.agents.factory.VectorMemoryService"), patch.object(
+            factory, "_create_roku", return_value={"roku_agent": roku}
+        ):
+            refs = await factory.build_all_async(network, DummyAIClient(), MagicMock())
+            stub = network.agents["RokuAgent"]
+            assert isinstance(stub, LazyAgent)
+            assert "RokuDevice" not in await network.dependency_health.probe_all()
+
+            await stub.materialize()
+
+        assert network.agents["RokuAgent"] is roku and refs["roku_agent"] is roku
+        assert "RokuDevice" in await network.dependency_health.probe_all()
+
+    @pytest.mark.asyncio
+    async def test_eager_mode_builds_everything(self, config):
+        config.flags.enable_lazy_agents = False
+        config.flags.enable_canvas = False
+        config.flags.enable_device_monitor = False
+        config.flags.enable_server_manager = False
+        network = AgentNetwork()
+        factory = AgentFactory(config, JarvisLogger())
+        with patch("jarvis.agents.factory.VectorMemoryService"):
+            refs = await factory.build_all_async(network, DummyAIClient(), MagicMock())
+        assert network.lazy_agents() == []
+        assert refs["night_agents"]
+        assert "night_agents" in factory.timings
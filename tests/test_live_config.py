@@ -0,0 +1,228 @@
+"""Tests for applying configuration changes to a running system."""
+
+import asyncio
+import copy
+
+import pytest
+from unittest.mock import AsyncMock, MagicMock, patch
+
+from jarvis.agents.agent_network import AgentNetwork
+from jarvis.agents.base import NetworkAgent
+from jarvis.ai_clients import BaseAIClient, SwappableAIClient
+from jarvis.core.config import FeatureFlags, JarvisConfig
+from jarvis.core.live_config import LiveConfigReloader, diff_config
+from jarvis.core.system import JarvisSystem
+
+
+class SlowClient(BaseAIClient):
+    def __init__(self, label, delay=0.0):
+        self.label = label
+        self.delay = delay
+        self.calls = 0
+
+    async def strong_chat(self, messages, tools=None):
+        self.calls += 1
+        await asyncio.sleep(self.delay)
+        return self.label, None
+
+    async def weak_chat(self, messages, tools=None):
+        return await self.strong_chat(messages, tools)
+
+
+class ClosingClient(SlowClient):
+    def __init__(self, label, delay=0.0):
+        super().__init__(label, delay)
+        self.closed = False
+
+    async def close(self):
+        self.closed = True
+
+
+class SlowAgent(NetworkAgent):
+    def __init__(self, delay):
+        super().__init__("SlowAgent")
+        self.delay = delay
+
+    @property
+    def capabilities(self):
+        return {"slow_thing"}
+
+    async def _handle_capability_request(self, message):
+        await asyncio.sleep(self.delay)
+        await self.send_capability_response(
+            message.from_agent, {"response": "done"}, message.request_id, message.id
+        )
+
+
+def _config(**flags):
+    return JarvisConfig(
+        api_key="sk-test-fake-key",
+        google_search_api_key=None,
+        google_search_engine_id=None,
+        flags=FeatureFlags(
+            enable_lights=False,
+            enable_canvas=False,
+            enable_night_mode=False,
+            enable_roku=False,
+            enable_coordinator=False,
+            **flags,
+        ),
+    )
+
+
+def test_diff_classifies_each_key():
+    old = _config()
+    new = copy.deepcopy(old)
+    new.strong_model = "gpt-4.1"
+    new.flags.enable_coding = False
+    new.flags.enable_canvas = True
+    new.roku_ip_address = "10.0.0.9"  # Roku stays off: nothing to rebuild
+    new.hue_bridge_ip = "10.0.0.2"
+    new.response_timeout = 5.0
+    new.worker_count = 8
+
+    plan = diff_config(old, new)
+    assert plan.swap_ai_client
+    assert plan.enable == ["enable_canvas"]
+    assert plan.disable == ["enable_coding"]
+    assert plan.rebuild == []
+    assert plan.runtime == ["response_timeout"]
+    assert plan.restart_required == ["worker_count"]
+
+    new.flags.enable_roku = True
+    old.flags.enable_roku = True
+    assert diff_config(old, new).rebuild == ["enable_roku"]
+    assert diff_config(old, copy.deepcopy(old)).empty
+
+
+@pytest.mark.asyncio
+async def test_swap_lets_in_flight_call_finish_on_old_client():
+    old, new = SlowClient("old", delay=0.05), SlowClient("new")
+    client = SwappableAIClient(old)
+
+    pending = asyncio.create_task(client.strong_chat([]))
+    await asyncio.sleep(0)
+    assert client.in_flight == 1
+    assert client.swap(new) is old
+    assert (client.in_flight_on(old), client.in_flight_on(new)) == (1, 0)
+
+    assert (await client.strong_chat([]))[0] == "new"
+    assert (await pending)[0] == "old"
+    assert client.in_flight == 0
+    assert client.swaps == 1
+
+
+@pytest.mark.asyncio
+async def test_swapped_out_client_is_closed_once_idle():
+    old, new = ClosingClient("old", delay=0.1), ClosingClient("new")
+    system = MagicMock()
+    system.config = _config()
+    system._ai_client = SwappableAIClient(old)
+    reloader = LiveConfigReloader(system)
+
+    pending = asyncio.create_task(system._ai_client.strong_chat([]))
+    await asyncio.sleep(0)
+    with patch("jarvis.core.live_config.AIClientFactory.create", return_value=new):
+        reloader._swap_ai_client()
+    await asyncio.sleep(0.05)
+    assert not old.closed  # still serving the call that started on it
+
+    assert (await pending)[0] == "old"
+    for _ in range(50):
+        if old.closed:
+            break
+        await asyncio.sleep(0.01)
+    assert old.closed and not new.closed
+
+
+@pytest.mark.asyncio
+async def test_retire_agent_drains_in_flight_requests():
+    network = AgentNetwork()
+    agent = SlowAgent(delay=0.05)
+    network.register_agent(agent)
+    await network.start()
+    try:
+        await network.request_capability("Orchestrator", "slow_thing", {}, "r1")
+        for _ in range(50):
+            if network.inflight_count("SlowAgent"):
+                break
+            await asyncio.sleep(0.005)
+        assert network.inflight_count("SlowAgent") == 1
+
+        retiring = asyncio.create_task(network.retire_agent(agent))
+        await asyncio.sleep(0)
+        # Routing stops at once, the accepted request still completes
+        assert "slow_thing" not in network.capability_registry
+        assert (await network.wait_for_response("r1", timeout=1.0))["response"] == "done"
+        assert await retiring is True
+        assert "SlowAgent" not in network.agents
+    finally:
+        await network.stop()
+
+
+@pytest.mark.asyncio
+async def test_retire_agent_reports_undrained_after_timeout():
+    network = AgentNetwork()
+    agent = SlowAgent(delay=0.5)
+    network.register_agent(agent)
+    await network.start()
+    try:
+        await network.request_capability("Orchestrator", "slow_thing", {}, "r1")
+        await asyncio.sleep(0.01)
+        assert await network.retire_agent(agent, drain_timeout=0.01) is False
+        assert "SlowAgent" not in network.agents
+    finally:
+        await network.stop()
+
+
+@pytest.fixture
+def mock_mongo():
+    with patch("jarvis.core.system.ProtocolUsageLogger") as usage_cls, \
+         patch("jarvis.core.system.InteractionLogger") as interaction_cls:
+        for cls in (usage_cls, interaction_cls):
+            inst = MagicMock()
+            inst.connect = AsyncMock()
+            inst.close = AsyncMock()
+            cls.return_value = inst
+        yield
+
+
+@pytest.fixture
+def mock_vector_memory():
+    with patch("jarvis.agents.factory.VectorMemoryService") as cls:
+        cls.return_value = MagicMock()
+        yield
+
+
+@pytest.mark.asyncio
+async def test_reload_applies_in_place(mock_mongo, mock_vector_memory, shared_services):
+    system = JarvisSystem(_config(enable_capabilities=False), services=shared_services)
+    try:
+        await system.initialize(load_protocol_directory=False)
+        chat = system.network.agents["ChatAgent"]
+        handle = system._ai_client
+        assert "CodingAgent" in system.network.agents
+
+        new = copy.deepcopy(system.config)
+        new.strong_model = "gpt-4.1"
+        new.flags.enable_coding = False
+        new.flags.enable_capabilities = True
+        new.response_timeout = 7.0
+        new.worker_count = 9
+        report = await system.reload_config(new)
+
+        assert report["elapsed_ms"] < 1000
+        assert report["ai_client_swapped"]
+        assert system._ai_client is handle and chat.ai_client is handle
+        assert handle.target.strong_model == "gpt-4.1"
+        assert "CodingAgent" not in system.network.agents
+        assert "coding_agent" not in system._agent_refs
+        assert system.network.agents["CapabilitiesAgent"].ai_client is handle
+        assert system._orchestrator.response_timeout == 7.0
+        assert report["restart_required"] == ["worker_count"]
+        # The system's own config now reflects the change, and a second
+        # reload with nothing new is a no-op
+        assert system.config.worker_count == 9
+        assert (await system.reload_config())["changed"] == []
+    finally:
+        await system.shutdown()
@@ -116,12 +116,12 @@ class DummyVectorMemoryService(DummyMemoryService):
 
 
 @pytest.mark.asyncio
-async def test_process_request_unknown_intent_memory():
+async def test_process_request_unknown_intent_memory(shared_services):
     import json
 
     output = json.dumps({"dag": {"store_memory": []}})
     ai_client = DummyAIClient(output)
-    jarvis = JarvisSystem(JarvisConfig(response_timeout=3.0))
+    jarvis = JarvisSystem(JarvisConfig(response_timeout=3.0), services=shared_services)
     service = DummyVectorMemoryService()
     memory_agent = MemoryAgent(service, None, jarvis.logger)
     nlu_agent = NLUAgent(ai_client, jarvis.logger)
@@ -1,8 +1,9 @@
 """Tests for the MetricsStore SQLite time-series storage."""
 
+import sqlite3
 from datetime import datetime, timedelta, timezone
 
-from jarvis.services.metrics_store import MetricsStore
+from jarvis.services.metrics_store import TIERS, MetricsStore, lttb_indices
 
 
 def _make_rows(component, metric_name, values, base_time=None, unit="%", severity="ok"):
@@ -103,20 +104,18 @@ def test_query_aggregated(tmp_path):
     store = MetricsStore(db_path=str(tmp_path / "test.db"))
     try:
         # Directly insert hourly rollup data
-        with store._lock:
-            store._conn.execute(
-                """INSERT INTO metrics_hourly
-                   (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
-                   VALUES (?, ?, ?, ?, ?, ?, ?)""",
-                ("2026-03-10T10:00:00", "cpu", "cpu_overall", 5.0, 95.0, 50.0, 120),
-            )
-            store._conn.execute(
-                """INSERT INTO metrics_hourly
-                   (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
-                   VALUES (?, ?, ?, ?, ?, ?, ?)""",
-                ("2026-03-10T11:00:00", "cpu", "cpu_overall", 10.0, 80.0, 45.0, 115),
-            )
-            store._conn.commit()
+        store._db.write(
+            """INSERT INTO metrics_hourly
+               (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
+               VALUES (?, ?, ?, ?, ?, ?, ?)""",
+            ("2026-03-10T10:00:00", "cpu", "cpu_overall", 5.0, 95.0, 50.0, 120),
+        )
+        store._db.write(
+            """INSERT INTO metrics_hourly
+               (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
+               VALUES (?, ?, ?, ?, ?, ?, ?)""",
+            ("2026-03-10T11:00:00", "cpu", "cpu_overall", 10.0, 80.0, 45.0, 115),
+        )
 
         results = store.query_aggregated("cpu")
         assert len(results) == 2
@@ -154,16 +153,21 @@ def test_compact(tmp_path):
         store.record_batch(old_rows + recent_rows)
         assert len(store.query("cpu", limit=10000)) == 5
 
+        # Hourly rollup is built as the samples arrive
+        rollups = store.query_aggregated("cpu", metric_name="cpu_overall")
+        assert sum(r["sample_count"] for r in rollups) == 5
+
         result = store.compact(retention_hours=24)
-        assert result["aggregated"] == 1  # one (hour, component, metric_name) group
         assert result["deleted"] == 3     # the three old rows
+        assert result["pruned"] == 0
 
         # Fresh rows remain
         remaining = store.query("cpu")
         assert len(remaining) == 2
 
-        # Hourly rollup was created
-        rollups = store.query_aggregated("cpu", metric_name="cpu_overall")
+        # The old hour keeps its rollup after the raw rows are gone
+        old_hour = old_time.strftime("%Y-%m-%dT%H:00:00")
+        rollups = store.query_aggregated("cpu", start=old_hour, end=old_hour)
         assert len(rollups) >= 1
         rollup = rollups[0]
         assert rollup["min_value"] == 10.0
@@ -182,20 +186,18 @@ def test_cleanup(tmp_path):
         )
         recent_hour = datetime.now(timezone.utc).strftime("%Y-%m-%dT%H:00:00")
 
-        with store._lock:
-            store._conn.execute(
-                """INSERT INTO metrics_hourly
-                   (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
-                   VALUES (?, ?, ?, ?, ?, ?, ?)""",
-                (old_hour, "memory", "ram_percent", 30.0, 90.0, 60.0, 60),
-            )
-            store._conn.execute(
-                """INSERT INTO metrics_hourly
-                   (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
-                   VALUES (?, ?, ?, ?, ?, ?, ?)""",
-                (recent_hour, "memory", "ram_percent", 40.0, 80.0, 55.0, 50),
-            )
-            store._conn.commit()
+        store._db.write(
+            """INSERT INTO metrics_hourly
+               (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
+               VALUES (?, ?, ?, ?, ?, ?, ?)""",
+            (old_hour, "memory", "ram_percent", 30.0, 90.0, 60.0, 60),
+        )
+        store._db.write(
+            """INSERT INTO metrics_hourly
+               (hour, component, metric_name, min_value, max_value, avg_value, sample_count)
+               VALUES (?, ?, ?, ?, ?, ?, ?)""",
+            (recent_hour, "memory", "ram_percent", 40.0, 80.0, 55.0, 50),
+        )
 
         deleted = store.cleanup(retention_days=30)
         assert deleted == 1
@@ -208,6 +210,125 @@ def test_cleanup(tmp_path):
         store.close()
 
 
+# ------------------------------------------------------------------
+# Tiered history
+# ------------------------------------------------------------------
+
+
+def test_rollup_tiers_kept_up_on_write(tmp_path):
+    store = MetricsStore(db_path=str(tmp_path / "test.db"))
+    try:
+        base = datetime(2026, 3, 10, 10, 0, 0, tzinfo=timezone.utc)
+        # 3 samples in one minute, 1 in the next
+        store.record_batch(_make_rows("cpu", "cpu_overall", [10.0, 20.0, 30.0], base_time=base))
+        store.record_batch(_make_rows("cpu", "cpu_overall", [50.0], base_time=base + timedelta(minutes=1)))
+
+        minutes = store._db.fetchall("SELECT * FROM metrics_minute ORDER BY minute")
+        assert [(r["minute"], r["sample_count"]) for r in minutes] == [
+            ("2026-03-10T10:00:00", 3), ("2026-03-10T10:01:00", 1),
+        ]
+        assert minutes[0]["avg_value"] == 20.0
+        day = store._db.fetchone("SELECT * FROM metrics_daily")
+        assert (day["day"], day["min_value"], day["max_value"], day["sample_count"]) == (
+            "2026-03-10T00:00:00", 10.0, 50.0, 4,
+        )
+        assert day["avg_value"] == 27.5
+    finally:
+        store.close()
+
+
+def test_pick_tier():
+    now = datetime(2026, 3, 10, 12, 0, 0, tzinfo=timezone.utc)
+    minute, hour, day = TIERS
+
+    def pick(hours, limit=1000, raw=True):
+        return MetricsStore.pick_tier(now - timedelta(hours=hours), now, limit, raw=raw, now=now)
+
+    assert pick(1) is None              # 60 minute buckets < 1000 -> raw samples
+    assert pick(1, raw=False) is minute
+    assert pick(24) is minute           # 1440 minute buckets, only 24 hourly
+    assert pick(24, limit=24) is hour
+    assert pick(24 * 30) is hour        # minutes are gone after 7 days
+    assert pick(24 * 30, limit=30) is day
+    assert pick(24 * 400) is day        # past every retention
+
+
+def test_history_downsamples_large_ranges(tmp_path):
+    store = MetricsStore(db_path=str(tmp_path / "test.db"))
+    try:
+        end = datetime.now(timezone.utc).replace(second=0, microsecond=0)
+        start = end - timedelta(hours=12)
+        rows = []
+        for i in range(12 * 60):
+            ts = (start + timedelta(minutes=i)).isoformat()
+            value = 90.0 if i == 400 else 20.0 + (i % 7)
+            rows.append({"timestamp": ts, "component": "cpu", "metric_name": "cpu_overall", "value": value})
+            rows.append({"timestamp": ts, "component": "cpu", "metric_name": "cpu_temp", "value": 50.0})
+        store.record_batch(rows)
+
+        result = store.history("cpu", start=start.isoformat(), end=end.isoformat(), limit=100)
+        assert result["resolution"] == "minute"
+        assert result["downsampled"] is True
+        overall = [p for p in result["data"] if p["metric_name"] == "cpu_overall"]
+        assert len(overall) == 100
+        assert max(p["value"] for p in overall) == 90.0  # the spike survives
+        timestamps = [p["timestamp"] for p in result["data"]]
+        assert timestamps == sorted(timestamps)
+
+        only_temp = store.history("cpu", "cpu_temp", start=start.isoformat(), end=end.isoformat(), limit=1000)
+        assert only_temp["resolution"] == "raw"
+        assert {p["metric_name"] for p in only_temp["data"]} == {"cpu_temp"}
+        assert len(only_temp["data"]) == 720
+    finally:
+        store.close()
+
+
+def test_lttb_keeps_endpoints_and_extremes():
+    xs = list(range(50))
+    ys = [0.0] * 50
+    ys[25] = 10.0
+    keep = lttb_indices(xs, ys, 5)
+    assert len(keep) == 5
+    assert keep[0] == 0 and keep[-1] == 49
+    assert 25 in keep
+    assert lttb_indices(xs, ys, 100) == xs
+
+
+def test_existing_database_backfills_tiers(tmp_path):
+    path = tmp_path / "legacy.db"
+    conn = sqlite3.connect(path)
+    conn.execute(
+        """CREATE TABLE metrics (id INTEGER PRIMARY KEY AUTOINCREMENT, timestamp TEXT NOT NULL,
+           component TEXT NOT NULL, metric_name TEXT NOT NULL, value REAL NOT NULL,
+           unit TEXT DEFAULT '', severity TEXT DEFAULT 'ok', metadata TEXT DEFAULT '{}')"""
+    )
+    conn.execute(
+        """CREATE TABLE metrics_hourly (id INTEGER PRIMARY KEY AUTOINCREMENT, hour TEXT NOT NULL,
+           component TEXT NOT NULL, metric_name TEXT NOT NULL, min_value REAL, max_value REAL,
+           avg_value REAL, sample_count INTEGER, UNIQUE(hour, component, metric_name))"""
+    )
+    conn.execute(
+        "INSERT INTO metrics_hourly (hour, component, metric_name, min_value, max_value, avg_value, sample_count)"
+        " VALUES ('2026-03-10T09:00:00', 'cpu', 'cpu_overall', 5.0, 15.0, 10.0, 2)"
+    )
+    conn.execute(
+        "INSERT INTO metrics (timestamp, component, metric_name, value)"
+        " VALUES ('2026-03-10T10:30:00+00:00', 'cpu', 'cpu_overall', 40.0)"
+    )
+    conn.commit()
+    conn.close()
+
+    store = MetricsStore(db_path=str(path))
+    try:
+        day = store._db.fetchone("SELECT * FROM metrics_daily")
+        assert (day["min_value"], day["max_value"], day["sample_count"]) == (5.0, 40.0, 3)
+        assert day["avg_value"] == 20.0
+        assert len(store._db.fetchall("SELECT * FROM metrics_minute")) == 1
+        assert len(store.query_aggregated("cpu")) == 2
+    finally:
+        store.close()
+
+
 def test_record_batch_empty(tmp_path):
     store = MetricsStore(db_path=str(tmp_path / "test.db"))
     try:
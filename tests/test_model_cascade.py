@@ -0,0 +1,314 @@
+"""Tests for the weak-first ModelCascade."""
+
+import json
+
+import pytest
+
+from jarvis.agents.chat_agent.agent import ChatAgent
+from jarvis.ai_clients.base import BaseAIClient
+from jarvis.ai_clients.cascade import CascadePolicy, ModelCascade
+
+
+# ---------------------------------------------------------------------------
+# Helpers
+# ---------------------------------------------------------------------------
+
+def _msg(content):
+    return type("Message", (), {"content": content})()
+
+
+def _call(name, arguments, call_id="call_1"):
+    func = type("Function", (), {"name": name, "arguments": arguments})()
+    return type("ToolCall", (), {"id": call_id, "function": func})()
+
+
+class TieredClient(BaseAIClient):
+    """Returns configurable weak/strong responses and counts calls."""
+
+    def __init__(self, weak=("weak answer", None), strong=("strong answer", None)):
+        self.weak = weak
+        self.strong = strong
+        self.weak_calls = 0
+        self.strong_calls = 0
+
+    async def weak_chat(self, messages, tools=None):
+        self.weak_calls += 1
+        content, tool_calls = self.weak
+        return _msg(content), tool_calls
+
+    async def strong_chat(self, messages, tools=None):
+        self.strong_calls += 1
+        content, tool_calls = self.strong
+        return _msg(content), tool_calls
+
+
+# ---------------------------------------------------------------------------
+# Escalation signals
+# ---------------------------------------------------------------------------
+
+class TestEscalation:
+
+    @pytest.mark.asyncio
+    async def test_confident_weak_answer_is_accepted(self):
+        client = TieredClient()
+        cascade = ModelCascade(client)
+        result = await cascade.chat("chat", [{"role": "user", "content": "hi"}])
+        assert result.tier == "weak"
+        assert result.message.content == "weak answer"
+        assert client.strong_calls == 0
+
+    @pytest.mark.asyncio
+    async def test_refusal_escalates(self):
+        client = TieredClient(weak=("I'm unable to help with that.", None))
+        cascade = ModelCascade(client)
+        result = await cascade.chat("chat", [])
+        assert result.tier == "strong"
+        assert result.escalated is True
+        assert result.reason == "refusal"
+
+    @pytest.mark.asyncio
+    async def test_malformed_tool_args_escalate(self):
+        client = TieredClient(weak=("", [_call("get_facts", "{not json")]))
+        cascade = ModelCascade(client)
+        result = await cascade.chat("chat", [])
+        assert result.reason == "malformed_tool_args"
+        assert client.strong_calls == 1
+
+    @pytest.mark.asyncio
+    async def test_valid_tool_call_accepted(self):
+        client = TieredClient(weak=("", [_call("get_facts", json.dumps({"query": "x"}))]))
+        cascade = ModelCascade(client)
+        result = await cascade.chat("chat", [])
+        assert result.tier == "weak"
+        assert result.tool_calls
+
+    @pytest.mark.asyncio
+    async def test_expected_json_missing_escalates(self):
+        client = TieredClient(weak=("sure thing", None))
+        cascade = ModelCascade(
+            client, policies={"classify": CascadePolicy(site="classify", expect_json=True)}
+        )
+        result = await cascade.chat("classify", [])
+        assert result.reason == "malformed_json"
+
+    @pytest.mark.asyncio
+    async def test_self_reported_uncertainty_escalates(self):
+        client = TieredClient(weak=(json.dumps({"answer": "maybe", "confidence": 0.2}), None))
+        cascade = ModelCascade(client)
+        result = await cascade.chat("nlu_format", [])
+        assert result.reason == "self_reported_uncertainty"
+
+    @pytest.mark.asyncio
+    async def test_disabled_policy_goes_straight_to_strong(self):
+        client = TieredClient()
+        cascade = ModelCascade(client, policies={"chat": CascadePolicy(site="chat", enabled=False)})
+        result = await cascade.chat("chat", [])
+        assert result.tier == "strong"
+        assert client.weak_calls == 0
+
+
+# ---------------------------------------------------------------------------
+# Learning & stats
+# ---------------------------------------------------------------------------
+
+class TestLearning:
+
+    @pytest.mark.asyncio
+    async def test_repeated_escalations_route_strong_first(self):
+        client = TieredClient(weak=("I cannot do that", None))
+        policy = CascadePolicy(site="chat", min_samples=3, explore_every=100)
+        cascade = ModelCascade(client, policies={"chat": policy})
+        for _ in range(3):
+            await cascade.chat("chat", [], capability="chat")
+        weak_before = client.weak_calls
+        result = await cascade.chat("chat", [], capability="chat")
+        assert result.tier == "strong"
+        assert client.weak_calls == weak_before
+
+    @pytest.mark.asyncio
+    async def test_negative_feedback_penalizes_only_the_rated_call(self):
+        client = TieredClient()
+        cascade = ModelCascade(client)
+        rated = await cascade.chat("chat", [], capability="chat")
+        # A later weak call (another user's turn, a format pass) is not charged
+        later = await cascade.chat("nlu_format", [])
+        assert rated.key == ("chat", "chat") and later.key == ("nlu_format", "nlu_format")
+        assert cascade.record_negative_feedback([rated.key]) == 1
+        keys = cascade.get_stats()["keys"]
+        assert keys["chat:chat"]["negative_feedback"] == 1
+        assert keys["nlu_format:nlu_format"]["negative_feedback"] == 0
+        assert cascade.record_negative_feedback([]) == 0
+
+    @pytest.mark.asyncio
+    async def test_strong_answers_carry_no_key(self):
+        client = TieredClient(weak=("I cannot do that", None))
+        cascade = ModelCascade(client)
+        assert (await cascade.chat("chat", [])).key is None
+
+    def test_learn_from_corrections(self):
+        cascade = ModelCascade(TieredClient())
+        applied = cascade.learn_from_corrections(
+            [{"capability": None}, {"capability": "search"}] + [{"capability": "chat"}] * 10
+        )
+        # Untagged records are skipped and each key takes at most
+        # min_samples // 2 corrections
+        assert applied == 3
+        keys = cascade.get_stats()["keys"]
+        assert keys["lead:search"]["prior_attempts"] == 1
+        assert keys["chat:chat"]["prior_attempts"] == 2
+
+    @pytest.mark.asyncio
+    async def test_corrections_alone_never_route_strong_first(self):
+        client = TieredClient()
+        cascade = ModelCascade(client)
+        cascade.learn_from_corrections([{"capability": "chat"}] * 500)
+        for _ in range(10):
+            assert (await cascade.chat("chat", [], capability="chat")).tier == "weak"
+
+    @pytest.mark.asyncio
+    async def test_lead_priors_match_live_lead_calls(self):
+        from jarvis.core.mission import MissionBrief, MissionBudget, MissionContext, MissionComplexity
+        import time as _time
+
+        client = TieredClient(weak=("Done.", None))
+        cascade = ModelCascade(client)
+        agent = ChatAgent(ai_client=client)
+        agent.model_cascade = cascade
+        brief = MissionBrief(
+            user_input="plan my day",
+            complexity=MissionComplexity.COMPLEX,
+            lead_agent="ChatAgent",
+            lead_capability="chat",
+            budget=MissionBudget(
+                max_depth=1, remaining_depth=1, deadline=_time.time() + 5,
+                max_recruitments=1, remaining_recruitments=1,
+            ),
+            context=MissionContext(user_input="plan my day"),
+        )
+        result = await agent._execute_as_lead("plan my day", brief)
+        assert [tuple(k) for k in result["metadata"]["cascade_keys"]] == [("lead", "chat")]
+
+
+class TestOutcomeStoreHistory:
+
+    @pytest.mark.asyncio
+    async def test_outcomes_persist_and_reload_as_bounded_priors(self, tmp_path):
+        from jarvis.services.outcome_store import OutcomeStore
+
+        store = OutcomeStore(db_path=str(tmp_path / "outcomes.db"))
+        client = TieredClient(weak=("I cannot do that", None))
+        # Never learns strong-first, so every call makes a weak attempt
+        first = ModelCascade(
+            client,
+            policies={"chat": CascadePolicy(site="chat", max_failure_rate=1.0)},
+            outcome_store=store,
+        )
+        for _ in range(30):
+            await first.chat("chat", [], capability="chat")
+        store._db.flush()
+        assert store.cascade_history()[("chat", "chat")] == (30, 30)
+
+        # A restarted cascade starts strong-first from history, but the
+        # prior is capped at prior_weight pseudo-attempts
+        second = ModelCascade(TieredClient(), outcome_store=store)
+        assert second.load_history() == 1
+        stats = second.get_stats()["keys"]["chat:chat"]
+        assert stats["prior_attempts"] == 10 and stats["failure_rate"] == 1.0
+        assert not second.should_try_weak("chat", "chat")
+        # History beats corrections for the same key
+        assert second.learn_from_corrections([{"capability": "chat"}]) == 0
+        store.close()
+
+    def test_outcomes_past_the_lookback_are_pruned_on_open(self, tmp_path):
+        from datetime import datetime, timedelta, timezone
+
+        from jarvis.services.outcome_store import OutcomeStore
+
+        db_path = str(tmp_path / "outcomes.db")
+        store = OutcomeStore(db_path=db_path)
+        stale = (datetime.now(timezone.utc) - timedelta(days=45)).isoformat()
+        store._db.write(
+            "INSERT INTO cascade_outcomes (timestamp, site, capability, outcome) VALUES (?, ?, ?, ?)",
+            (stale, "chat", "chat", "escalated"),
+        )
+        store.record_cascade_outcome("chat", "chat", "accepted")
+        store.close()
+
+        reopened = OutcomeStore(db_path=db_path)
+        rows = reopened._db.fetchall("SELECT outcome FROM cascade_outcomes")
+        assert [r["outcome"] for r in rows] == ["accepted"]
+        assert reopened.cascade_history()[("chat", "chat")] == (1, 0)
+        reopened.close()
+
+
+class TestFeedbackAttribution:
+
+    @pytest.mark.asyncio
+    async def test_orchestrator_charges_the_rated_turn(self):
+        from unittest.mock import MagicMock
+        from jarvis.core.orchestrator import RequestMetadata, RequestOrchestrator
+
+        cascade = ModelCascade(TieredClient())
+        feedback = MagicMock()
+        orchestrator = RequestOrchestrator(
+            network=MagicMock(),
+            protocol_runtime=MagicMock(),
+            response_logger=MagicMock(),
+            logger=MagicMock(),
+            feedback_collector=feedback,
+            model_cascade=cascade,
+        )
+        nlu_result = {
+            "response": "It's sunny.",
+            "metadata": {"cascade_keys": [("nlu_format", "nlu_format")]},
+            "results": [{"capability": "chat", "result": {
+                "response": "sunny", "metadata": {"cascade_keys": [("chat", "chat")]},
+            }}],
+        }
+        orchestrator._store_conversation_turn(1, "weather?", "It's sunny.", nlu_result, "chat")
+        orchestrator._store_conversation_turn(2, "hi", "hello", {
+            "response": "hello", "metadata": {"cascade_keys": [("lead", "search")]},
+        })
+
+        orchestrator._handle_feedback("that's wrong", RequestMetadata(user_id=1))
+        keys = cascade.get_stats()["keys"]
+        assert keys["chat:chat"]["negative_feedback"] == 1
+        assert keys["nlu_format:nlu_format"]["negative_feedback"] == 1
+        assert "lead:search" not in keys
+        assert feedback.log_correction.call_args.kwargs["capability"] == "chat"
+
+    @pytest.mark.asyncio
+    async def test_stats_report_escalation_rate(self):
+        client = TieredClient()
+        cascade = ModelCascade(client)
+        await cascade.chat("chat", [])
+        client.weak = ("As an AI I cannot", None)
+        await cascade.chat("chat", [])
+        stats = cascade.get_stats()
+        assert stats["total_weak_attempts"] == 2
+        assert stats["total_escalations"] == 1
+        assert stats["escalation_rate"] == 0.5
+
+
+# ---------------------------------------------------------------------------
+# Call-site integration
+# ---------------------------------------------------------------------------
+
+class TestChatAgentCascade:
+
+    @pytest.mark.asyncio
+    async def test_chat_agent_uses_weak_when_confident(self):
+        client = TieredClient(weak=("Hello there.", None))
+        agent = ChatAgent(ai_client=client)
+        agent.model_cascade = ModelCascade(client)
+        result = await agent._process_chat("hi")
+        assert result["response"] == "Hello there."
+        assert client.strong_calls == 0
+
+    @pytest.mark.asyncio
+    async def test_chat_agent_without_cascade_uses_strong(self):
+        client = TieredClient()
+        agent = ChatAgent(ai_client=client)
+        result = await agent._process_chat("hi")
+        assert result["response"] == "strong answer"
+        assert client.weak_calls == 0
@@ -0,0 +1,94 @@
+"""Tests for the bounded-concurrency night task scheduler."""
+
+import asyncio
+
+import pytest
+
+from jarvis.services import night_scheduler
+from jarvis.services.night_scheduler import NightTaskScheduler, ScheduledTask, slot_capacity
+
+
+def _tracking_worker(log, delay=0.02):
+    running = set()
+
+    async def worker(task):
+        running.add(task.index)
+        log.append(sorted(running))
+        await asyncio.sleep(delay)
+        running.discard(task.index)
+        return task.index * 10
+
+    return worker
+
+
+class TestNightTaskScheduler:
+    @pytest.mark.asyncio
+    async def test_runs_within_slot_budget(self):
+        log = []
+        tasks = [ScheduledTask(i) for i in range(5)]
+        scheduler = NightTaskScheduler(capacity=2)
+        results = await scheduler.run(tasks, _tracking_worker(log))
+        assert results == {i: i * 10 for i in range(5)}
+        assert max(len(r) for r in log) == 2
+        assert scheduler.peak_running == 2
+
+    @pytest.mark.asyncio
+    async def test_overlapping_files_never_run_together(self):
+        log = []
+        tasks = [
+            ScheduledTask(0, files=frozenset({"a.py"})),
+            ScheduledTask(1, files=frozenset({"a.py", "b.py"})),
+            ScheduledTask(2, files=frozenset({"c.py"})),
+        ]
+        await NightTaskScheduler(capacity=3).run(tasks, _tracking_worker(log))
+        assert all(not {0, 1} <= set(r) for r in log)
+        assert [0, 2] in log
+
+    @pytest.mark.asyncio
+    async def test_heavy_task_waits_and_small_ones_pass_it(self):
+        log = []
+        tasks = [ScheduledTask(0), ScheduledTask(1, weight=2), ScheduledTask(2)]
+        await NightTaskScheduler(capacity=2).run(tasks, _tracking_worker(log))
+        # The medium task cannot start next to task 0, task 2 can
+        assert log[:2] == [[0], [0, 2]]
+        assert [1] in log
+
+    @pytest.mark.asyncio
+    async def test_task_heavier_than_budget_runs_alone(self):
+        log = []
+        tasks = [ScheduledTask(0, weight=2), ScheduledTask(1)]
+        await NightTaskScheduler(capacity=1).run(tasks, _tracking_worker(log))
+        assert log == [[0], [1]]
+
+    @pytest.mark.asyncio
+    async def test_cancellation_cancels_running_workers(self):
+        cancelled = []
+
+        async def worker(task):
+            try:
+                await asyncio.sleep(10)
+            except asyncio.CancelledError:
+                cancelled.append(task.index)
+                raise
+
+        run = asyncio.create_task(
+            NightTaskScheduler(capacity=2).run([ScheduledTask(i) for i in range(3)], worker)
+        )
+        await asyncio.sleep(0.01)
+        run.cancel()
+        with pytest.raises(asyncio.CancelledError):
+            await run
+        assert sorted(cancelled) == [0, 1]
+
+
+class TestSlotCapacity:
+    def test_capped_by_cpu_and_memory(self, monkeypatch):
+        monkeypatch.setattr(night_scheduler.os, "cpu_count", lambda: 8)
+        monkeypatch.setattr(night_scheduler, "available_memory_mb", lambda: None)
+        assert slot_capacity(3) == 3
+        monkeypatch.setattr(
+            night_scheduler, "available_memory_mb", lambda: 2 * night_scheduler.MEMORY_PER_SLOT_MB
+        )
+        assert slot_capacity(3) == 2
+        monkeypatch.setattr(night_scheduler, "available_memory_mb", lambda: 100)
+        assert slot_capacity(3) == 1
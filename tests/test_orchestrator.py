@@ -10,8 +10,12 @@ from jarvis.agents.nlu_agent import NLUAgent
 from jarvis.agents.base import NetworkAgent
 from jarvis.ai_clients.base import BaseAIClient
 from jarvis.logging import JarvisLogger
+from jarvis.logging import tracer as tracer_module
+from jarvis.logging.trace_store import TraceStore
+from jarvis.logging.tracer import Tracer
 from jarvis.core.orchestrator import RequestOrchestrator
 from jarvis.core.response_logger import ResponseLogger
+from jarvis.utils.serialization import Payload
 
 
 class DummyAIClient(BaseAIClient):
@@ -110,6 +114,51 @@ async def test_orchestrator_sequence():
     assert msg is not None
 
 
+class RecordingLogger:
+    def __init__(self):
+        self.entries = []
+
+    def log(self, level, action, details=None):
+        self.entries.append((level, action, details))
+
+
+@pytest.mark.asyncio
+async def test_respond_encodes_response_once_for_trace_and_http(tmp_path, monkeypatch):
+    """The trace span and the HTTP body share one encoding."""
+    store = TraceStore(db_path=str(tmp_path / "traces.db"))
+    monkeypatch.setattr(tracer_module, "_tracer_instance", Tracer(store=store))
+    ai = DummyAIClient([
+        json.dumps({"dag": {"dummy_cap": []}}),
+    ])
+    logger = JarvisLogger()
+    network = AgentNetwork(logger)
+    network.register_agent(NLUAgent(ai, logger))
+    network.register_agent(ProviderAgent())
+    await network.start()
+
+    recorder = RecordingLogger()
+    orchestrator = RequestOrchestrator(
+        network=network,
+        protocol_runtime=None,
+        response_logger=_make_mock_response_logger(),
+        logger=recorder,
+        response_timeout=5.0,
+    )
+
+    payload = await orchestrator.respond("test", "UTC")
+    await network.stop()
+
+    assert isinstance(payload, Payload)
+    assert "response" in payload.value
+    # The response body is not written to the log on every request
+    assert not any(d is payload for _, _, d in recorder.entries)
+    (trace,) = store.list_traces()
+    trace_id = trace["trace_id"]
+    spans = {s["name"]: s for s in store.get_spans(trace_id)}
+    assert spans["orchestrator.response"]["output_data"] == payload.text
+    store.close()
+
+
 @pytest.mark.asyncio
 async def test_orchestrator_query_memory_plan():
     """Request flows through NLU to memory provider."""
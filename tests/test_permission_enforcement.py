@@ -76,9 +76,9 @@ async def test_protocol_run_disallowed_agent(tmp_path):
 
 
 @pytest.mark.asyncio
-async def test_voice_trigger_disallowed_agent(tmp_path):
+async def test_voice_trigger_disallowed_agent(tmp_path, shared_services):
     logger = JarvisLogger()
-    jarvis = JarvisSystem(JarvisConfig())
+    jarvis = JarvisSystem(JarvisConfig(), services=shared_services)
     dummy = DummyAgent()
     jarvis.network.register_agent(dummy)
 
@@ -0,0 +1,131 @@
+"""Tests for compiling recorded protocols into staged execution plans."""
+
+import asyncio
+import time
+
+import pytest
+
+from jarvis.core.method_recorder import MethodRecorder
+from jarvis.protocols import Protocol
+from jarvis.protocols.compiler import compile_protocol
+from jarvis.protocols.executor import ProtocolExecutor
+
+
+def _protocol(*steps):
+    return Protocol.from_dict(
+        {
+            "name": "recorded",
+            "steps": [
+                {
+                    "agent": agent,
+                    "function": function,
+                    "parameters": params or {},
+                    "parameter_mappings": mappings or {},
+                }
+                for agent, function, params, mappings in steps
+            ],
+        }
+    )
+
+
+class TestCompileProtocol:
+    def test_repeated_reads_removed_and_references_renumbered(self):
+        proto = _protocol(
+            ("CalendarAgent", "get_today_events", None, None),
+            ("CalendarAgent", "get_today_events", None, None),
+            ("ChatAgent", "summarize", None, {"events": "$step_1_get_today_events"}),
+        )
+        compiled, report = compile_protocol(proto)
+        assert [s.function for s in compiled.steps] == ["get_today_events", "summarize"]
+        assert compiled.steps[1].parameter_mappings == {"events": "$step_0_get_today_events"}
+        assert report.removed_steps == [1]
+        assert report.stages == [[0], [1]]
+
+    def test_read_after_write_to_same_agent_is_kept(self):
+        proto = _protocol(
+            ("LightsAgent", "get_state", None, None),
+            ("LightsAgent", "lights_on", None, None),
+            ("LightsAgent", "get_state", None, None),
+        )
+        compiled, report = compile_protocol(proto)
+        assert len(compiled.steps) == 3
+        assert report.stages == [[0], [1], [2]]
+        assert compiled.stages == []  # nothing to parallelize
+
+    def test_independent_agents_share_a_stage(self):
+        proto = _protocol(
+            ("LightsAgent", "lights_off", None, None),
+            ("RokuAgent", "power_off", None, None),
+            ("CalendarAgent", "get_today_events", None, None),
+            ("LightsAgent", "lights_color", {"color": "red"}, None),
+        )
+        compiled, report = compile_protocol(proto)
+        assert compiled.stages == [[0, 1, 2], [3]]
+        assert report.max_parallelism == 3
+        assert Protocol.from_dict(compiled.to_dict()).stages == compiled.stages
+
+    def test_known_arguments_are_bound(self):
+        proto = _protocol(("LightsAgent", "lights_color", {}, {"color": "$color"}))
+        compiled, report = compile_protocol(proto, {"color": "blue"})
+        assert compiled.steps[0].parameters == {"color": "blue"}
+        assert compiled.steps[0].parameter_mappings == {}
+        assert report.bound_parameters == 1
+        # The source protocol is left untouched
+        assert proto.steps[0].parameter_mappings == {"color": "$color"}
+
+
+class _SleepAgent:
+    def __init__(self, name, delay=0.05):
+        self.name = name
+        self.delay = delay
+        self.calls = []
+
+    async def run_capability(self, function, **params):
+        self.calls.append(function)
+        await asyncio.sleep(self.delay)
+        return {"function": function, **params}
+
+
+class _Network:
+    def __init__(self, *agents):
+        self.agents = {a.name: a for a in agents}
+
+
+class _Logger:
+    def log(self, *args, **kwargs):
+        pass
+
+
+@pytest.mark.asyncio
+async def test_executor_runs_stages_concurrently():
+    lights, roku = _SleepAgent("LightsAgent"), _SleepAgent("RokuAgent")
+    proto = _protocol(
+        ("LightsAgent", "lights_off", None, None),
+        ("RokuAgent", "power_off", None, None),
+        ("LightsAgent", "get_state", None, None),
+    )
+    compiled, _ = compile_protocol(proto)
+    executor = ProtocolExecutor(_Network(lights, roku), _Logger())
+
+    start = time.perf_counter()
+    results = await executor.run_protocol(compiled)
+    elapsed = time.perf_counter() - start
+
+    assert set(results) == {"step_0_lights_off", "step_1_power_off", "step_2_get_state"}
+    assert lights.calls == ["lights_off", "get_state"]
+    assert elapsed < 0.14  # two stages of 50 ms, not three
+
+
+@pytest.mark.asyncio
+async def test_recorder_replays_optimized_protocol():
+    agent = _SleepAgent("CalendarAgent", delay=0)
+    recorder = MethodRecorder()
+    recorder.start("demo")
+    recorder.record_step("CalendarAgent", "get_today_events", {})
+    recorder.record_step("CalendarAgent", "get_today_events", {})
+
+    results = await recorder.replay_last_protocol(_Network(agent), _Logger(), optimized=True)
+    assert list(results) == ["step_0_get_today_events"]
+    assert agent.calls == ["get_today_events"]
+    # The recording itself is unchanged
+    assert len(recorder.get_protocol().steps) == 2
@@ -23,8 +23,8 @@ class DummyAgent(NetworkAgent):
 
 
 @pytest.mark.asyncio
-async def test_list_protocols_filters_by_agents(tmp_path):
-    jarvis = JarvisSystem(JarvisConfig())
+async def test_list_protocols_filters_by_agents(tmp_path, shared_services):
+    jarvis = JarvisSystem(JarvisConfig(), services=shared_services)
     jarvis.logger = JarvisLogger()
     jarvis.network = AgentNetwork(jarvis.logger)
 
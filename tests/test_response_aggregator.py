@@ -207,9 +207,11 @@ class TestResponseAggregator:
         agg = self._make_aggregator()
         await agg.start()
         assert agg._running is True
-        assert agg._cleanup_task is not None
+        agg.register_request("r1", "cap", ["a"])
+        assert agg._timer is not None
         await agg.stop()
         assert agg._running is False
+        assert agg._timer is None
 
     @pytest.mark.asyncio
     async def test_register_request_returns_future(self):
@@ -405,3 +407,73 @@ class TestResponseAggregator:
         assert "a" in tracker.received_from
         assert "b" not in tracker.received_from
         fut.cancel()
+
+
+# ---------------------------------------------------------------------------
+# Deadline timer
+# ---------------------------------------------------------------------------
+class TestDeadlineTimer:
+    """One heap-driven timer serves every request deadline."""
+
+    def _make_aggregator(self):
+        return ResponseAggregator(logger=MagicMock(), default_timeout=30.0)
+
+    @pytest.mark.asyncio
+    async def test_no_task_per_request(self):
+        agg = self._make_aggregator()
+        before = len(asyncio.all_tasks())
+        futs = [agg.register_request(f"r{i}", "cap", ["a"]) for i in range(100)]
+        assert len(asyncio.all_tasks()) == before
+        assert agg._timer_at == agg.get_tracker("r0").deadline
+        for fut in futs:
+            fut.cancel()
+
+    @pytest.mark.asyncio
+    async def test_deadlines_fire_in_order(self):
+        agg = self._make_aggregator()
+        slow = agg.register_request("slow", "cap", ["a"], timeout=0.2)
+        fast = agg.register_request("fast", "cap", ["a"], timeout=0.05)
+        await asyncio.wait_for(fast, 1)
+        assert not slow.done()
+        await asyncio.wait_for(slow, 1)
+        stats = agg.get_stats()
+        assert stats["timed_out_trackers"] == 2
+        assert stats["active_trackers"] == 0 and stats["pending_deadlines"] == 0
+        assert agg._timer is None
+
+    @pytest.mark.asyncio
+    async def test_completed_tracker_removed_immediately(self):
+        agg = self._make_aggregator()
+        fut = agg.register_request("r1", "cap", ["a"])
+        agg.add_response("r1", "a", {"success": True, "response": "ok"})
+        assert fut.done()
+        assert agg.get_tracker("r1") is None
+        assert agg.add_response("r1", "a", "late") is False
+
+    @pytest.mark.asyncio
+    async def test_cancelled_future_drops_tracker(self):
+        agg = self._make_aggregator()
+        fut = agg.register_request("r1", "cap", ["a"])
+        fut.cancel()
+        await asyncio.sleep(0)
+        assert agg.get_tracker("r1") is None
+
+    @pytest.mark.asyncio
+    async def test_reused_id_keeps_its_own_deadline(self):
+        agg = self._make_aggregator()
+        first = agg.register_request("r1", "cap", ["a"], timeout=0.05)
+        agg.add_response("r1", "a", "done")
+        second = agg.register_request("r1", "cap", ["a"], timeout=0.5)
+        await asyncio.sleep(0.1)
+        assert first.done() and not second.done()
+        second.cancel()
+
+    @pytest.mark.asyncio
+    async def test_stale_deadlines_are_compacted(self):
+        agg = self._make_aggregator()
+        agg._COMPACT_MIN_STALE = 10
+        for i in range(50):
+            agg.register_request(f"r{i}", "cap", ["a"])
+            agg.add_response(f"r{i}", "a", "done")
+        assert len(agg._deadlines) <= 21
+        assert agg.get_stats()["completed_trackers"] == 50
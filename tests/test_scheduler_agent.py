@@ -278,6 +278,75 @@ class TestSchedulerServiceTick:
         assert abs((next_run_dt - expected).total_seconds()) < 5
 
 
+class TestSchedulerServiceHeap:
+    """Test the in-memory due-time heap."""
+
+    def test_next_due_at_tracks_earliest(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        assert svc.next_due_at() is None
+        later = datetime.now(timezone.utc) + timedelta(hours=2)
+        sooner = datetime.now(timezone.utc) + timedelta(hours=1)
+        svc.create(name="Later", schedule_type="once", request_text="x", run_at=later.isoformat(), timezone="UTC", user_id=1, created_by="user")
+        item = svc.create(name="Sooner", schedule_type="once", request_text="y", run_at=sooner.isoformat(), timezone="UTC", user_id=1, created_by="user")
+        assert svc.next_due_at() == pytest.approx(sooner.timestamp())
+
+        svc.disable(item.id)
+        assert svc.next_due_at() == pytest.approx(later.timestamp())
+        svc.enable(item.id)
+        assert svc.next_due_at() == pytest.approx(sooner.timestamp())
+        svc.delete(item.id)
+        assert svc.next_due_at() == pytest.approx(later.timestamp())
+
+    def test_heap_loaded_from_sqlite_at_startup(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        run_at = datetime.now(timezone.utc) + timedelta(minutes=10)
+        svc.create(name="Persisted", schedule_type="once", request_text="x", run_at=run_at.isoformat(), timezone="UTC", user_id=1, created_by="user")
+        svc.close()
+
+        reopened = _make_service(str(tmp_path))
+        assert reopened.next_due_at() == pytest.approx(run_at.timestamp())
+
+    def test_mark_fired_moves_heap_entry(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        item = svc.create(name="Every 5min", schedule_type="interval", request_text="check", interval_seconds=300, timezone="UTC", user_id=1, created_by="user")
+        svc.update(item.id, next_run=(datetime.now(timezone.utc) - timedelta(minutes=1)).isoformat())
+        assert len(svc.get_due_schedules()) == 1
+        svc.mark_fired(item.id)
+        assert svc.get_due_schedules() == []
+        assert svc.next_due_at() > datetime.now(timezone.utc).timestamp()
+
+    def test_mark_fired_many_single_commit(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        past = (datetime.now(timezone.utc) - timedelta(minutes=1)).isoformat()
+        ids = [
+            svc.create(name=f"Once {i}", schedule_type="once", request_text="x", run_at=past, timezone="UTC", user_id=1, created_by="user").id
+            for i in range(3)
+        ]
+        commits_before = svc.get_db_stats()["commits"]
+        fired = svc.mark_fired_many(ids)
+        assert len(fired) == 3
+        assert all(not item.enabled for item in fired)
+        assert svc.get_db_stats()["commits"] == commits_before + 1
+        assert svc.next_due_at() is None
+
+    def test_heap_load_uses_covering_index(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        plan = svc._db.fetchall(
+            "EXPLAIN QUERY PLAN SELECT id, next_run FROM schedules WHERE enabled = 1"
+        )
+        assert any("COVERING INDEX" in row["detail"] for row in plan)
+
+    def test_listeners_notified_on_change(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        calls = []
+        svc.add_listener(lambda: calls.append(1))
+        future = (datetime.now(timezone.utc) + timedelta(hours=1)).isoformat()
+        item = svc.create(name="n", schedule_type="once", request_text="x", run_at=future, timezone="UTC", user_id=1, created_by="user")
+        svc.disable(item.id)
+        svc.delete(item.id)
+        assert len(calls) == 3
+
+
 # =====================================================================
 # SchedulerAgent tests — operation dispatch
 # =====================================================================
@@ -487,6 +556,76 @@ class TestSchedulerTickLoop:
             tz_name="UTC",
             metadata={"source": "scheduler", "schedule_id": item.id},
         )
+        assert agent.fire_stats["fired"] == 1
+        assert agent.fire_stats["last_lateness_ms"] >= 5 * 60 * 1000 - 1000
+
+    @pytest.mark.asyncio
+    async def test_tick_loop_fires_without_polling_delay(self, tmp_path):
+        import asyncio
+
+        svc = _make_service(str(tmp_path))
+        agent = SchedulerAgent(
+            ai_client=FakeAIClient(), scheduler_service=svc, logger=None,
+            tick_interval=60.0,
+        )
+        fired = asyncio.Event()
+
+        async def process_request(**kwargs):
+            fired.set()
+            return {"success": True}
+
+        orchestrator = AsyncMock()
+        orchestrator.process_request = process_request
+        agent.set_orchestrator(orchestrator)
+        task = asyncio.create_task(agent._tick_loop())
+        try:
+            await asyncio.sleep(0.05)
+            # Created while the loop is idle: the heap change must wake it
+            run_at = (datetime.now(timezone.utc) + timedelta(milliseconds=200)).isoformat()
+            svc.create(name="Soon", schedule_type="once", request_text="go", run_at=run_at, timezone="UTC", user_id=1, created_by="user")
+            await asyncio.wait_for(fired.wait(), timeout=2.0)
+            assert agent.fire_stats["last_lateness_ms"] < 1000
+        finally:
+            task.cancel()
+
+    @pytest.mark.asyncio
+    async def test_simultaneous_due_schedules_respect_concurrency_cap(self, tmp_path):
+        import asyncio
+
+        svc = _make_service(str(tmp_path))
+        past = (datetime.now(timezone.utc) - timedelta(seconds=1)).isoformat()
+        for i in range(6):
+            svc.create(name=f"s{i}", schedule_type="once", request_text="go", run_at=past, timezone="UTC", user_id=1, created_by="user")
+        agent = SchedulerAgent(
+            ai_client=FakeAIClient(), scheduler_service=svc, logger=None,
+            max_concurrent_fires=2,
+        )
+        running = 0
+        peak = 0
+        done = 0
+
+        async def process_request(**kwargs):
+            nonlocal running, peak, done
+            running += 1
+            peak = max(peak, running)
+            await asyncio.sleep(0.05)
+            running -= 1
+            done += 1
+            return {"success": True}
+
+        orchestrator = AsyncMock()
+        orchestrator.process_request = process_request
+        agent.set_orchestrator(orchestrator)
+        task = asyncio.create_task(agent._tick_loop())
+        try:
+            for _ in range(100):
+                if done == 6:
+                    break
+                await asyncio.sleep(0.02)
+        finally:
+            task.cancel()
+        assert done == 6
+        assert peak == 2
 
 
 # =====================================================================
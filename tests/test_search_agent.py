@@ -572,3 +572,66 @@ class TestSearchAgentSynthesis:
 
         # Should fall back to raw formatting since AI response was empty
         assert "Raw Title" in captured["result"]["response"]
+
+
+# ---------------------------------------------------------------------------
+# Tests: extractive answers
+# ---------------------------------------------------------------------------
+
+class TestSearchAgentExtractive:
+    """Fact questions answered from snippets skip the LLM."""
+
+    EVEREST = [
+        {"title": "Mount Everest", "snippet": "Mount Everest is Earth's highest mountain above sea level.", "link": "https://a"},
+        {"title": "How tall", "snippet": "Mar 3, 2024 ... Mount Everest is 8,849 metres tall, according to a 2020 survey.", "link": "https://b"},
+        {"title": "Height", "snippet": "Everest stands 8,849 meters above sea level.", "link": "https://c"},
+    ]
+
+    async def _run(self, monkeypatch, prompt, results):
+        service = _make_mock_search_service()
+        service.search.return_value = {"success": True, "results": results, "total_results": len(results)}
+        ai_client = MagicMock()
+        reply = MagicMock()
+        reply.content = "LLM answer."
+        ai_client.weak_chat = AsyncMock(return_value=(reply, None))
+        agent = SearchAgent(search_service=service, ai_client=ai_client)
+        captured = {}
+
+        async def fake_send(to, result, request_id, msg_id):
+            captured["result"] = result
+
+        monkeypatch.setattr(agent, "send_capability_response", fake_send)
+        await agent._handle_capability_request(_make_search_message(prompt))
+        return captured["result"], ai_client
+
+    @pytest.mark.asyncio
+    async def test_confident_snippet_answers_without_llm(self, monkeypatch):
+        result, ai_client = await self._run(monkeypatch, "How tall is Mount Everest?", self.EVEREST)
+        assert result["response"] == "Mount Everest is 8,849 metres tall, according to a 2020 survey."
+        assert result["answer_source"] == "extractive"
+        ai_client.weak_chat.assert_not_awaited()
+
+    @pytest.mark.asyncio
+    async def test_open_ended_question_is_synthesized(self, monkeypatch):
+        result, ai_client = await self._run(monkeypatch, "Why is Mount Everest so tall?", self.EVEREST)
+        assert result["response"] == "LLM answer."
+        assert result["answer_source"] == "synthesized"
+
+    @pytest.mark.asyncio
+    async def test_restated_question_without_answer_falls_back_to_llm(self, monkeypatch):
+        # Full coverage at rank 0, but no answer-bearing token and nothing
+        # corroborated by the other results
+        results = [
+            {"title": "Tesla vote", "snippet": "Tesla CEO pay package vote is scheduled for the annual shareholder meeting.", "link": "a"},
+            {"title": "Tesla stock", "snippet": "Tesla shares rose after the quarterly delivery report.", "link": "b"},
+        ]
+        result, ai_client = await self._run(monkeypatch, "who is the CEO of Tesla", results)
+        assert result["answer_source"] == "synthesized"
+        ai_client.weak_chat.assert_awaited_once()
+
+    @pytest.mark.asyncio
+    async def test_weak_match_falls_back_to_llm(self, monkeypatch):
+        results = [{"title": "Sydney", "snippet": "Sydney is the largest city in Australia, with beaches.", "link": "x"}]
+        result, ai_client = await self._run(monkeypatch, "What is the capital of Australia?", results)
+        assert result["answer_source"] == "synthesized"
+        ai_client.weak_chat.assert_awaited_once()
@@ -7,13 +7,21 @@ Tests verify:
 3. Missing credentials handling
 4. HTTP error handling (status errors, timeouts, generic errors)
 5. Edge cases (empty results, malformed data, num_results clamping)
+6. Result caching against a local stand-in for the search API
 """
 
+import asyncio
+import json
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
 import pytest
 import httpx
 from unittest.mock import AsyncMock, MagicMock, patch
 
-from jarvis.services.search_service import GoogleSearchService
+from jarvis.services.search_service import GoogleSearchService, SearchResultCache
 
 
 @pytest.fixture
@@ -362,3 +370,124 @@ class TestGoogleSearchServiceSearch:
         assert result["success"] is True
         assert result["total_results"] == 0  # Defaults to 0 when missing
         assert len(result["results"]) == 1
+
+
+@pytest.fixture
+def search_api():
+    """Local HTTP stand-in for the Custom Search API that counts queries."""
+    state = {"queries": [], "delay": 0.0, "status": 200, "connections": set()}
+
+    class Handler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def do_GET(self):
+            query = parse_qs(urlparse(self.path).query)["q"][0]
+            state["queries"].append(query)
+            state["connections"].add(self.client_address)
+            time.sleep(state["delay"])
+            body = json.dumps({
+                "items": [{"title": f"About {query}", "snippet": f"call {len(state['queries'])}", "link": "https://x"}],
+                "searchInformation": {"totalResults": "1"},
+            }).encode()
+            self.send_response(state["status"])
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+        def log_message(self, *args):
+            pass
+
+    server = ThreadingHTTPServer(("127.0.0.1", 0), Handler)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+    state["url"] = f"http://127.0.0.1:{server.server_port}/customsearch/v1"
+    yield state
+    server.shutdown()
+    server.server_close()
+
+
+def _local_service(search_api, mock_logger, **cache_kwargs):
+    with patch.dict("os.environ", {"GOOGLE_SERVICE_ACCOUNT_FILE": ""}, clear=False):
+        return GoogleSearchService(
+            api_key="k",
+            search_engine_id="cx",
+            logger=mock_logger,
+            base_url=search_api["url"],
+            cache=SearchResultCache(**cache_kwargs),
+        )
+
+
+class TestSearchResultCache:
+    """Caching, revalidation and connection reuse against a local API."""
+
+    @pytest.mark.asyncio
+    async def test_normalized_repeat_is_served_from_cache(self, search_api, mock_logger):
+        service = _local_service(search_api, mock_logger)
+        first = await service.search("Who wrote Dune?")
+        second = await service.search("  who WROTE dune ")
+        await service.close()
+
+        assert search_api["queries"] == ["Who wrote Dune?"]
+        assert second == first
+        assert service.cache_stats()["hits"] == 1
+
+    @pytest.mark.asyncio
+    async def test_client_is_reused_across_queries(self, search_api, mock_logger):
+        service = _local_service(search_api, mock_logger)
+        for q in ("one", "two", "three"):
+            assert (await service.search(q))["success"] is True
+        await service.close()
+        assert len(search_api["queries"]) == 3
+        assert len(search_api["connections"]) == 1  # keep-alive
+
+    @pytest.mark.asyncio
+    async def test_stale_entry_served_while_revalidating(self, search_api, mock_logger):
+        service = _local_service(search_api, mock_logger, ttl=0.05, stale_ttl=60.0)
+        first = await service.search("dune author")
+        await asyncio.sleep(0.1)
+
+        stale = await service.search("dune author")
+        assert stale["results"] == first["results"]  # answered without waiting
+        for _ in range(100):
+            if len(search_api["queries"]) == 2 and not service._refreshing:
+                break
+            await asyncio.sleep(0.01)
+        refreshed = await service.search("dune author")
+        await service.close()
+
+        assert refreshed["results"][0]["snippet"] == "call 2"
+        assert service.cache_stats()["refreshes"] == 1
+
+    @pytest.mark.asyncio
+    async def test_concurrent_misses_share_one_call(self, search_api, mock_logger):
+        search_api["delay"] = 0.1
+        service = _local_service(search_api, mock_logger)
+        results = await asyncio.gather(*(service.search("same thing") for _ in range(5)))
+        await service.close()
+        assert len(search_api["queries"]) == 1
+        assert all(r == results[0] for r in results)
+        assert service.cache_stats()["coalesced"] == 4
+
+    @pytest.mark.asyncio
+    async def test_failures_are_not_cached(self, search_api, mock_logger):
+        search_api["status"] = 500
+        service = _local_service(search_api, mock_logger)
+        assert (await service.search("q"))["success"] is False
+        search_api["status"] = 200
+        assert (await service.search("q"))["success"] is True
+        await service.close()
+        assert len(search_api["queries"]) == 2
+
+    def test_volatile_queries_expire_quickly(self):
+        cache = SearchResultCache(ttl=3600, stale_ttl=3600, volatile_ttl=0.0)
+        cache.put(("weather in chicago", 5), {"results": []})
+        cache.put(("who wrote dune", 5), {"results": []})
+        assert cache.get(("weather in chicago", 5)) == (None, None)
+        assert cache.get(("who wrote dune", 5))[1] == "fresh"
+
+    def test_lru_bound(self):
+        cache = SearchResultCache(max_size=2)
+        for q in ("a", "b", "c"):
+            cache.put((q, 5), {"results": []})
+        assert cache.size == 2
+        assert cache.get(("a", 5)) == (None, None)
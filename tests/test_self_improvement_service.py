@@ -3,15 +3,22 @@
 from __future__ import annotations
 
 import json
+import subprocess
+import sys
+from datetime import datetime, timezone
 from enum import Enum
 from pathlib import Path
 from unittest.mock import AsyncMock, MagicMock, patch
 
 import pytest
 
+from jarvis.services import night_scheduler
+from jarvis.services.claude_code_runner import ClaudeCodeRunner
+from jarvis.services.code_analysis import CodeAnalysisEngine
 from jarvis.services.self_improvement_service import (
     PRIORITY_ORDER,
     ImprovementTaskResult,
+    NightCycleState,
     NightReport,
     SelfImprovementService,
 )
@@ -640,6 +647,59 @@ class TestExecuteTask:
         svc._runner.merge_to_main.assert_not_awaited()
         svc._runner.cleanup_worktree.assert_awaited_once()
 
+    @pytest.mark.asyncio
+    async def test_affected_tests_run_before_full_suite(self, tmp_path):
+        """Impacted tests run first; the full suite still gates the merge."""
+        svc = _make_service(tmp_path, use_prs=False)
+        svc._runner.create_worktree = AsyncMock(return_value=("/tmp/wt", "branch"))
+        exec_result = FakeExecutionResult(success=True, files_changed=1)
+        exec_result.changed_files = ["jarvis/services/foo.py"]
+        svc._runner.execute_task = AsyncMock(return_value=exec_result)
+        svc._runner.run_tests = AsyncMock(return_value=FakeExecutionResult(success=True))
+        svc._runner.merge_to_main = AsyncMock(return_value=True)
+        svc._runner.cleanup_worktree = AsyncMock()
+
+        with patch("jarvis.services.self_improvement_service.TestMapper") as MockMapper:
+            MockMapper.return_value.affected_tests.return_value = ["tests/test_foo.py"]
+            result = await svc._execute_task(
+                FakeDiscovery(FakeDiscoveryType.LOG_ERROR, "Fix foo", "desc", "high")
+            )
+
+        MockMapper.return_value.affected_tests.assert_called_once_with(["jarvis/services/foo.py"])
+        assert [c.args for c in svc._runner.run_tests.await_args_list] == [
+            ("/tmp/wt", ["tests/test_foo.py"]),
+            ("/tmp/wt",),
+        ]
+        assert result.merged is True
+        assert result.tests_selected == 1
+        assert {"worktree", "execute", "impacted_tests", "full_suite", "merge", "cleanup"} <= set(
+            result.timings
+        )
+
+    @pytest.mark.asyncio
+    async def test_affected_test_failure_skips_full_suite(self, tmp_path):
+        svc = _make_service(tmp_path, use_prs=False)
+        svc._runner.create_worktree = AsyncMock(return_value=("/tmp/wt", "branch"))
+        exec_result = FakeExecutionResult(success=True, files_changed=1)
+        exec_result.changed_files = ["jarvis/services/foo.py"]
+        svc._runner.execute_task = AsyncMock(return_value=exec_result)
+        svc._runner.run_tests = AsyncMock(
+            return_value=FakeExecutionResult(success=False, stderr="1 failed")
+        )
+        svc._runner.merge_to_main = AsyncMock()
+        svc._runner.cleanup_worktree = AsyncMock()
+
+        with patch("jarvis.services.self_improvement_service.TestMapper") as MockMapper:
+            MockMapper.return_value.affected_tests.return_value = ["tests/test_foo.py"]
+            result = await svc._execute_task(
+                FakeDiscovery(FakeDiscoveryType.LOG_ERROR, "Fix foo", "desc", "high")
+            )
+
+        svc._runner.run_tests.assert_awaited_once_with("/tmp/wt", ["tests/test_foo.py"])
+        svc._runner.merge_to_main.assert_not_awaited()
+        assert result.success is False and result.error_message == "1 failed"
+        assert "full_suite" not in result.timings
+
     @pytest.mark.asyncio
     async def test_exception_returns_failed_result(self, tmp_path):
         """Unexpected exception should be caught and return a failed result."""
@@ -1350,3 +1410,137 @@ class TestConfidenceBasedRouting:
         assert result.pr_url == "https://github.com/user/repo/pull/77"
         svc._runner.merge_to_main.assert_not_awaited()
         svc._runner.push_branch.assert_awaited_once()
+
+
+# ---------------------------------------------------------------------------
+# TestConcurrentCycle
+# ---------------------------------------------------------------------------
+
+# Stand-in for the coding CLI: appends to each relevant file listed in the
+# prompt, commits, and logs when it ran.
+FAKE_CLI = """\
+#!{python}
+import pathlib, re, subprocess, sys, time
+
+if sys.argv[1:] == ["--version"]:
+    print("fake-cli 1.0")
+    sys.exit(0)
+prompt = sys.argv[-1]
+section = prompt.split("RELEVANT FILES TO EXAMINE:")[1].split("INSTRUCTIONS:")[0]
+start = time.time()
+time.sleep(0.3)
+for name in re.findall(r"^- (\\S+)$", section, re.M):
+    with open(name, "a") as fh:
+        fh.write("fixed\\n")
+subprocess.run(["git", "add", "-A"], check=True)
+subprocess.run(["git", "commit", "-qm", "fix"], check=True)
+with open({log!r}, "a") as fh:
+    fh.write(f"{{start}} {{time.time()}}\\n")
+"""
+
+
+def _git(repo, *args):
+    subprocess.run(["git", *args], cwd=repo, check=True, capture_output=True)
+
+
+def _git_project(tmp_path):
+    repo = tmp_path / "repo"
+    (repo / "tests").mkdir(parents=True)
+    (repo / "tests" / "test_ok.py").write_text("def test_ok():\n    assert True\n")
+    for name in ("a.txt", "b.txt"):
+        (repo / name).write_text("start\n")
+    (repo / ".gitignore").write_text(".claude/\n")
+    _git(repo, "init", "-q", "-b", "main")
+    _git(repo, "config", "user.email", "night@example.com")
+    _git(repo, "config", "user.name", "Night")
+    _git(repo, "add", "-A")
+    _git(repo, "commit", "-qm", "init")
+    return repo
+
+
+class TestConcurrentCycle:
+    """Tasks run side by side in worktrees and merge one at a time."""
+
+    @pytest.mark.asyncio
+    async def test_parallel_tasks_merge_serially(self, tmp_path, monkeypatch):
+        repo = _git_project(tmp_path)
+        log = tmp_path / "cli.log"
+        cli = tmp_path / "fake-cli"
+        cli.write_text(FAKE_CLI.format(python=sys.executable, log=str(log)))
+        cli.chmod(0o755)
+        monkeypatch.setattr(night_scheduler.os, "cpu_count", lambda: 4)
+        monkeypatch.setattr(night_scheduler, "available_memory_mb", lambda: None)
+        monkeypatch.setattr(NightCycleState, "STATE_FILE", tmp_path / "night_state.json")
+
+        svc = _make_service(tmp_path, use_prs=False)
+        svc._runner = ClaudeCodeRunner(str(repo), claude_binary=str(cli), logger=MagicMock())
+        svc._analyzer.engine = CodeAnalysisEngine(cache=False)
+        svc._analyzer.run_full_analysis = AsyncMock(return_value=[
+            FakeDiscovery(FakeDiscoveryType.CODE_QUALITY, "Fix a", "a", "high", ["a.txt"]),
+            FakeDiscovery(FakeDiscoveryType.CODE_QUALITY, "Fix b", "b", "high", ["b.txt"]),
+            FakeDiscovery(FakeDiscoveryType.CODE_QUALITY, "Fix a again", "a2", "low", ["a.txt"]),
+        ])
+
+        report = await svc.run_improvement_cycle()
+
+        assert [r.task_title for r in report.results] == ["Fix a", "Fix b", "Fix a again"]
+        assert all(r.merged for r in report.results), [r.error_message for r in report.results]
+        # The second task on a.txt started from the first one's merge
+        assert (repo / "a.txt").read_text() == "start\nfixed\nfixed\n"
+        assert (repo / "b.txt").read_text() == "start\nfixed\n"
+        spans = [tuple(map(float, line.split())) for line in log.read_text().splitlines()]
+        assert any(s1 < e2 and s2 < e1 for i, (s1, e1) in enumerate(spans) for s2, e2 in spans[i + 1:])
+        assert not NightCycleState.STATE_FILE.exists()
+
+    @pytest.mark.asyncio
+    async def test_resume_reruns_only_unfinished_tasks(self, tmp_path, monkeypatch):
+        monkeypatch.setattr(NightCycleState, "STATE_FILE", tmp_path / "night_state.json")
+        discoveries = [
+            FakeDiscovery(FakeDiscoveryType.CODE_QUALITY, f"Task {i}", "d", "high", [f"{i}.py"])
+            for i in range(4)
+        ]
+        # Task 2 finished before task 1, which was still running at pause
+        NightCycleState(
+            cycle_id="c",
+            started_at=datetime.now(timezone.utc).isoformat(),
+            status="paused",
+            discoveries=[{**d.to_dict(), "discovery_type": "unused_import"} for d in discoveries],
+            completed_results=[{
+                "task_title": "Task 0", "discovery_type": "unused_import", "success": True,
+                "files_changed": 1, "test_passed": True, "merged": True,
+            }],
+            current_task_index=1,
+            skipped_count=0,
+            running_tasks=[1],
+            finished_tasks=[0, 2],
+        ).save()
+
+        svc = _make_service(tmp_path, use_prs=False)
+        svc._runner.create_worktree = AsyncMock(side_effect=lambda title: (f"/tmp/{title}", title))
+        svc._runner.execute_task = AsyncMock(return_value=FakeExecutionResult(success=True))
+        svc._runner.run_tests = AsyncMock(return_value=FakeExecutionResult(success=True))
+        svc._runner.merge_to_main = AsyncMock(return_value=True)
+        svc._runner.cleanup_worktree = AsyncMock()
+
+        report = await svc.run_improvement_cycle()
+
+        executed = [c.args[0] for c in svc._runner.create_worktree.await_args_list]
+        assert sorted(executed) == ["Task 1", "Task 3"]
+        assert [r.task_title for r in report.results] == ["Task 0", "Task 1", "Task 3"]
+        assert not NightCycleState.STATE_FILE.exists()
+
+    def test_state_from_sequential_cycle_loads(self, tmp_path, monkeypatch):
+        monkeypatch.setattr(NightCycleState, "STATE_FILE", tmp_path / "night_state.json")
+        NightCycleState.STATE_FILE.write_text(json.dumps({
+            "cycle_id": "c",
+            "started_at": datetime.now(timezone.utc).isoformat(),
+            "status": "paused",
+            "discoveries": [{}, {}, {}],
+            "completed_results": [],
+            "current_task_index": 2,
+            "skipped_count": 0,
+        }))
+        state = NightCycleState.load()
+        assert state.finished_tasks == [0, 1]
+        assert state.running_tasks == []
+        assert state.remaining == 1
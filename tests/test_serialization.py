@@ -0,0 +1,87 @@
+"""Tests for the shared JSON serializer and its Payload cache."""
+
+import json
+from datetime import datetime
+from unittest.mock import MagicMock, patch
+
+import httpx
+import pytest
+from httpx import ASGITransport
+from fastapi import FastAPI
+
+from jarvis.agents.response import AgentResponse, ErrorInfo
+from jarvis.logging.tracer import _truncate_data
+from jarvis.utils import serialization
+from jarvis.utils.serialization import Payload, dumps, dumps_str, loads
+from server.responses import JarvisJSONResponse
+
+
+class TestDumps:
+    def test_agent_response_uses_to_dict_shape(self):
+        resp = AgentResponse.error_response("boom", ErrorInfo("boom", error_type="X"))
+        assert loads(dumps(resp)) == json.loads(json.dumps(resp.to_dict()))
+
+    def test_compact_and_unicode(self):
+        assert dumps({"a": [1, 2], "b": "é"}) == '{"a":[1,2],"b":"é"}'.encode()
+
+    def test_non_native_values(self):
+        data = {"when": datetime(2024, 1, 2, 3, 4, 5), "tags": {"x"}, "pair": (1, 2), 3: "int key"}
+        assert loads(dumps(data)) == {
+            "when": "2024-01-02T03:04:05",
+            "tags": ["x"],
+            "pair": [1, 2],
+            "3": "int key",
+        }
+
+    def test_big_int_falls_back_to_stdlib(self):
+        assert loads(dumps({"n": 2 ** 80})) == {"n": 2 ** 80}
+
+    def test_mock_encodes_as_string(self):
+        assert isinstance(loads(dumps({"m": MagicMock()}))["m"], str)
+
+
+class TestPayload:
+    def test_encoded_once(self):
+        payload = Payload({"a": 1})
+        with patch.object(serialization, "dumps", wraps=serialization.dumps) as spy:
+            assert payload.json is payload.json
+        assert spy.call_count == 1
+        assert dumps(payload) is payload.json
+        assert dumps_str(payload) == '{"a":1}'
+
+    def test_nested_payload(self):
+        payload = Payload({"a": [1, 2]})
+        assert loads(dumps({"outer": payload})) == {"outer": {"a": [1, 2]}}
+
+    def test_nested_payload_survives_stdlib_fallback(self):
+        # The big int forces the stdlib path even when orjson is installed
+        payload = Payload({"a": [1, 2]})
+        encoded = dumps({"n": 2 ** 80, "outer": payload})
+        assert json.loads(encoded) == {"n": 2 ** 80, "outer": {"a": [1, 2]}}
+
+    def test_sinks_share_encoding(self):
+        payload = Payload({"result": 42})
+        assert _truncate_data(payload) == payload.text
+        big = Payload({"items": list(range(100))})
+        assert _truncate_data(big, max_size=50).endswith("... [truncated]")
+
+
+class TestJarvisJSONResponse:
+    @pytest.mark.asyncio
+    async def test_route_returns_agent_response(self):
+        app = FastAPI(default_response_class=JarvisJSONResponse)
+
+        @app.get("/resp")
+        async def resp():
+            return JarvisJSONResponse(AgentResponse.success_response("hi", actions=[{"t": 1}]))
+
+        @app.get("/plain")
+        async def plain():
+            return {"ok": True}
+
+        async with httpx.AsyncClient(transport=ASGITransport(app=app), base_url="http://t") as client:
+            r = await client.get("/resp")
+            assert r.headers["content-type"] == "application/json"
+            assert r.json()["response"] == "hi"
+            assert r.json()["actions"] == [{"t": 1}]
+            assert (await client.get("/plain")).json() == {"ok": True}
@@ -3,6 +3,8 @@
 import asyncio
 import json
 import os
+import sys
+import time
 from datetime import datetime, timezone
 from pathlib import Path
 from unittest.mock import AsyncMock, MagicMock, patch
@@ -472,6 +474,168 @@ class TestBootServers:
         assert "external-db" not in started
 
 
+def _sleeper(name, **kwargs):
+    return ServerConfig(
+        name=name,
+        mode=ServerMode.MANAGED,
+        command=[sys.executable, "-c", "import time; time.sleep(30)"],
+        start_on_boot=True,
+        restart_policy=RestartPolicy.NEVER,
+        **kwargs,
+    )
+
+
+def _record(service, method, events, delay=0.0):
+    real = getattr(service, method)
+
+    async def wrapped(name, *args, **kwargs):
+        events.append(("begin", name))
+        await asyncio.sleep(delay)
+        result = await real(name, *args, **kwargs)
+        events.append(("end", name))
+        return result
+
+    setattr(service, method, wrapped)
+
+
+class TestDependencyOrderedBoot:
+    @pytest.mark.asyncio
+    async def test_independent_servers_start_together(self, service):
+        service.register_server(_sleeper("db"))
+        service.register_server(_sleeper("cache"))
+        service.register_server(_sleeper("api", depends_on=["db", "cache"]))
+        events = []
+        _record(service, "start_server", events, delay=0.2)
+        try:
+            t0 = time.monotonic()
+            started = await service.start_boot_servers()
+            elapsed = time.monotonic() - t0
+
+            assert started == ["db", "cache", "api"]
+            assert events[:2] == [("begin", "db"), ("begin", "cache")]
+            assert events.index(("begin", "api")) > max(
+                events.index(("end", "db")), events.index(("end", "cache"))
+            )
+            assert elapsed < 0.8  # two waves, not three sequential starts
+
+            events.clear()
+            _record(service, "stop_server", events)
+            await service.stop_all()
+            assert events.index(("end", "api")) < events.index(("begin", "db"))
+            assert events.index(("end", "api")) < events.index(("begin", "cache"))
+        finally:
+            await service.stop_all()
+
+    @pytest.mark.asyncio
+    async def test_broken_dependencies_skip_dependents(self, service):
+        service.register_server(_sleeper("ok"))
+        service.register_server(_sleeper("orphan", depends_on=["ghost"]))
+        service.register_server(_sleeper("loop-a", depends_on=["loop-b"]))
+        service.register_server(_sleeper("loop-b", depends_on=["loop-a"]))
+        # Nothing listens on the port, so it never becomes ready
+        service.register_server(_sleeper("deaf", host="127.0.0.1", port=1, ready_timeout=0.2))
+        service.register_server(_sleeper("needs-deaf", depends_on=["deaf"]))
+        try:
+            started = await service.start_boot_servers()
+            assert started == ["ok", "deaf"]
+            assert "ghost" in service.get_server("orphan").error_message
+            assert "cycle" in service.get_server("loop-a").error_message
+            assert "not ready" in service.get_server("needs-deaf").error_message
+            assert service.get_server("needs-deaf").status == ServerStatus.STOPPED
+        finally:
+            await service.stop_all()
+
+    @pytest.mark.asyncio
+    async def test_stop_all_with_cycle_sharing_a_dependency(self, service):
+        # a and b form a cycle; x is a dependency of a but on no cycle
+        service.register_server(_sleeper("a", depends_on=["b", "x"]))
+        service.register_server(_sleeper("b", depends_on=["a"]))
+        service.register_server(_sleeper("x"))
+        for name in ("a", "b", "x"):
+            service.get_server(name).status = ServerStatus.RUNNING
+        order = []
+
+        async def fake_stop(name):
+            order.append(name)
+            service.get_server(name).status = ServerStatus.STOPPED
+            return True
+
+        service.stop_server = fake_stop
+        await asyncio.wait_for(service.stop_all(), timeout=2.0)
+
+        assert sorted(order) == ["a", "b", "x"]
+        assert order.index("a") < order.index("x")  # dependents first
+
+    def test_dependency_fields_round_trip(self):
+        config = _sleeper("api", depends_on=["db"], ready_timeout=5.0, health_timeout=1.5)
+        restored = ServerConfig.from_dict(config.to_dict())
+        assert restored.depends_on == ["db"]
+        assert restored.ready_timeout == 5.0
+        assert restored.health_timeout == 1.5
+        assert ServerConfig.from_dict({"name": "x"}).depends_on == []
+
+
+class TestProcessWatcher:
+    @pytest.mark.asyncio
+    async def test_exit_triggers_restart_immediately(self, service):
+        config = _sleeper("flaky")
+        config.command = [sys.executable, "-c", "import sys; sys.exit(3)"]
+        config.restart_policy = RestartPolicy.ON_FAILURE
+        service.register_server(config)
+        crashed = asyncio.Event()
+
+        async def on_crash(name):
+            crashed.set()
+
+        service.on_crash(on_crash)
+        await service.start_server("flaky")
+        await asyncio.wait_for(crashed.wait(), timeout=5.0)
+        await asyncio.sleep(0)
+
+        state = service.get_server("flaky")
+        assert state.status == ServerStatus.CRASHED
+        assert state.last_exit_code == 3
+        assert state.restart_count == 1
+        assert "flaky" in service._restart_timers
+        await service.stop_all()  # cancels the pending restart
+        assert service._restart_timers == {}
+
+    @pytest.mark.asyncio
+    async def test_requested_stop_is_not_a_crash(self, service):
+        service.register_server(_sleeper("calm"))
+        callback = AsyncMock()
+        service.on_crash(callback)
+        await service.start_server("calm")
+        await service.stop_server("calm")
+        await asyncio.sleep(0.05)
+        callback.assert_not_called()
+        assert service.get_server("calm").status == ServerStatus.STOPPED
+
+
+class TestConcurrentHealth:
+    @pytest.mark.asyncio
+    async def test_hung_check_does_not_delay_others(self, service):
+        for name in ("a", "b", "hung"):
+            service.register_server(ServerConfig(name=name, mode=ServerMode.EXTERNAL, health_timeout=0.1))
+        from jarvis.agents.health_agent.models import ComponentStatus, ProbeResult
+
+        async def fake_check(name):
+            await asyncio.sleep(30 if name == "hung" else 0.3)
+            return ProbeResult(f"server:{name}", "service", ComponentStatus.HEALTHY)
+
+        service.check_health = fake_check
+        t0 = time.monotonic()
+        probes = await service.check_all_health()
+        elapsed = time.monotonic() - t0
+
+        assert [p.component for p in probes] == ["server:a", "server:b", "server:hung"]
+        assert [p.status for p in probes[:2]] == [ComponentStatus.HEALTHY] * 2
+        assert probes[2].status == ComponentStatus.UNHEALTHY
+        assert "timed out" in probes[2].message
+        assert service.get_server("hung").status == ServerStatus.UNHEALTHY
+        assert elapsed < 1.5
+
+
 # ------------------------------------------------------------------
 # Crash detection tests
 # ------------------------------------------------------------------
@@ -0,0 +1,221 @@
+"""Tests for the shared service container."""
+
+import asyncio
+import threading
+
+import pytest
+from unittest.mock import AsyncMock, MagicMock, patch
+
+from jarvis.core import JarvisBuilder, JarvisConfig, FeatureFlags
+from jarvis.core.container import Lifetime, ServiceContainer
+from jarvis.core.system import JarvisSystem
+
+
+class Resource:
+    def __init__(self, *args):
+        self.args = args
+        self.closed = False
+
+    def close(self):
+        self.closed = True
+
+
+@pytest.fixture
+def root():
+    container = ServiceContainer()
+    container.register("shared", lambda scope, *args: Resource(*args))
+    container.register("per_tenant", lambda scope: Resource(), Lifetime.TENANT)
+    container.register("per_request", lambda scope: Resource(), Lifetime.REQUEST)
+    return container
+
+
+def test_lifetimes(root):
+    a, b = root.scope(), root.scope()
+    assert a.resolve("shared") is b.resolve("shared")
+    assert a.resolve("shared", "x") is not a.resolve("shared", "y")
+    assert a.resolve("per_tenant") is a.resolve("per_tenant")
+    assert a.resolve("per_tenant") is not b.resolve("per_tenant")
+
+    request = a.scope(Lifetime.REQUEST)
+    assert request.resolve("per_request") is not a.scope(Lifetime.REQUEST).resolve("per_request")
+    assert request.resolve("per_tenant") is a.resolve("per_tenant")
+
+    with pytest.raises(LookupError):
+        root.resolve("per_tenant")
+    with pytest.raises(KeyError):
+        a.resolve("missing")
+    with pytest.raises(ValueError):
+        request.scope(Lifetime.TENANT)
+
+
+def test_process_service_cannot_capture_tenant_one(root):
+    root.register("captive", lambda scope: scope.resolve("per_tenant"))
+    with pytest.raises(LookupError):
+        root.scope().resolve("captive")
+
+
+@pytest.mark.asyncio
+async def test_closing_a_tenant_leaves_shared_services_open(root):
+    a, b = root.scope(), root.scope()
+    shared, mine = a.resolve("shared"), a.resolve("per_tenant")
+    await a.aclose()
+    assert mine.closed and not shared.closed
+    assert b.resolve("shared") is shared
+    with pytest.raises(RuntimeError):
+        a.resolve("per_tenant")
+    await root.aclose()
+    assert shared.closed
+
+
+def test_register_without_replace_keeps_override(root):
+    override = Resource()
+    root.register("shared", lambda scope: override)
+    root.register("shared", lambda scope: Resource(), replace=False)
+    assert root.scope().resolve("shared") is override
+
+
+def test_concurrent_threads_build_once():
+    builds = []
+    started, release = threading.Event(), threading.Event()
+    order = []
+
+    def slow(scope):
+        builds.append(1)
+        started.set()
+        release.wait(timeout=2)
+        order.append("slow")
+        return Resource()
+
+    container = ServiceContainer()
+    container.register("slow", slow)
+    container.register("fast", lambda scope: Resource())
+    results = []
+    threads = [
+        threading.Thread(target=lambda: results.append(container.resolve("slow")))
+        for _ in range(4)
+    ]
+    for t in threads:
+        t.start()
+    # A different key resolves while the slow build is still in progress
+    assert started.wait(timeout=2)
+    container.resolve("fast")
+    order.append("fast")
+    release.set()
+    for t in threads:
+        t.join()
+    assert order == ["fast", "slow"]
+    assert len(builds) == 1
+    assert len({id(r) for r in results}) == 1
+
+
+@pytest.mark.asyncio
+async def test_aresolve_shares_pending_build_and_retries_failures():
+    calls = []
+
+    async def connect(scope, url):
+        calls.append(url)
+        await asyncio.sleep(0.01)
+        if len(calls) == 1:
+            raise ConnectionError("down")
+        return url
+
+    container = ServiceContainer()
+    container.register("conn", connect)
+    scope = container.scope()
+    results = await asyncio.gather(
+        scope.aresolve("conn", "u"), scope.aresolve("conn", "u"), return_exceptions=True
+    )
+    assert all(isinstance(r, ConnectionError) for r in results)
+    assert await scope.aresolve("conn", "u") == "u"
+    assert await scope.aresolve("conn", "u") == "u"
+    assert calls == ["u", "u"]
+    with pytest.raises(TypeError):
+        scope.resolve("conn", "u")
+
+
+def test_report_counts_builds_and_reuse(root):
+    a, b = root.scope(name="a"), root.scope(name="b")
+    a.resolve("shared")
+    b.resolve("shared")
+    b.resolve("per_tenant")
+    assert a.report()["services"]["shared"]["built"] == 1
+    report = b.report()
+    assert report["scope"] == "b"
+    assert report["services"]["shared"] == {"built": 0, "reused": 1, "build_ms": 0.0}
+    assert report["built"] == 1 and report["reused"] == 1
+
+
+# ---------------------------------------------------------------------------
+# Systems sharing one container
+# ---------------------------------------------------------------------------
+
+@pytest.fixture
+def mock_mongo():
+    with patch("jarvis.core.system.ProtocolUsageLogger") as usage_cls, \
+         patch("jarvis.core.system.InteractionLogger") as interaction_cls:
+        for cls in (usage_cls, interaction_cls):
+            cls.side_effect = lambda **kw: MagicMock(connect=AsyncMock(), close=AsyncMock())
+        yield usage_cls
+
+
+@pytest.fixture
+def vector_cls():
+    with patch("jarvis.agents.factory.VectorMemoryService") as cls:
+        cls.side_effect = lambda **kw: MagicMock()
+        yield cls
+
+
+def _config():
+    return JarvisConfig(
+        api_key="sk-test-fake-key",
+        google_search_api_key=None,
+        google_search_engine_id=None,
+        use_fast_classifier=False,
+        flags=FeatureFlags(
+            enable_lights=False,
+            enable_canvas=False,
+            enable_night_mode=False,
+            enable_roku=False,
+            enable_coordinator=False,
+        ),
+    )
+
+
+@pytest.mark.asyncio
+async def test_systems_share_process_services(mock_mongo, vector_cls, shared_services):
+    services = shared_services
+    first = JarvisSystem(_config(), services=services)
+    await first.initialize(load_protocol_directory=False)
+    second = await JarvisBuilder(_config()).services(services).protocol_directory(False).build()
+    third = JarvisSystem(_config(), services=services)
+    await third.initialize(load_protocol_directory=False)
+    try:
+        assert vector_cls.call_count == 1
+        assert mock_mongo.call_count == 1
+        calendar = first._agent_refs["calendar_service"]
+        assert third._agent_refs["calendar_service"] is calendar
+        assert second.logger is first.logger
+        assert first.usage_logger.connect.await_count == 1
+
+        cost = third.startup_report()["services"]
+        assert cost["built"] == 0 and cost["build_ms"] == 0.0
+        assert cost["services"]["calendar_service"]["reused"] == 1
+        assert first.startup_report()["services"]["built"] > 0
+
+        # Shutting one system down leaves the shared services to the others
+        await first.shutdown()
+        assert not calendar.client._client.is_closed
+    finally:
+        await second.shutdown()
+        await third.shutdown()
+        await services.aclose()
+    assert calendar.client._client.is_closed
+
+
+@pytest.mark.asyncio
+async def test_private_container_closed_at_shutdown(mock_mongo, vector_cls):
+    system = JarvisSystem(_config())
+    await system.initialize(load_protocol_directory=False)
+    usage = system.usage_logger
+    await system.shutdown()
+    usage.close.assert_awaited_once()
@@ -76,10 +76,10 @@ class TestSystemInitSmoke:
 
     @pytest.mark.asyncio
     async def test_initialize_completes(
-        self, minimal_config, mock_mongo, mock_vector_memory
+        self, minimal_config, mock_mongo, mock_vector_memory, shared_services
     ):
         """Full initialize path should succeed with minimal config."""
-        system = JarvisSystem(minimal_config)
+        system = JarvisSystem(minimal_config, services=shared_services)
         try:
             await system.initialize(load_protocol_directory=False)
 
@@ -94,10 +94,10 @@ class TestSystemInitSmoke:
 
     @pytest.mark.asyncio
     async def test_initialize_registers_core_agents(
-        self, minimal_config, mock_mongo, mock_vector_memory
+        self, minimal_config, mock_mongo, mock_vector_memory, shared_services
     ):
         """Core agents (NLU, Chat, Memory) should always be registered."""
-        system = JarvisSystem(minimal_config)
+        system = JarvisSystem(minimal_config, services=shared_services)
         try:
             await system.initialize(load_protocol_directory=False)
             agent_names = set(system.network.agents.keys())
@@ -116,10 +116,10 @@ class TestBuilderBuildSmoke:
 
     @pytest.mark.asyncio
     async def test_builder_build_completes(
-        self, minimal_config, mock_mongo, mock_vector_memory
+        self, minimal_config, mock_mongo, mock_vector_memory, shared_services
     ):
         """builder.build() should return a fully-initialized JarvisSystem."""
-        builder = JarvisBuilder(minimal_config)
+        builder = JarvisBuilder(minimal_config).services(shared_services)
         builder.weather(False).lights(False).roku(False).night_agents(False)
         jarvis = await builder.build()
         try:
@@ -133,10 +133,10 @@ class TestBuilderBuildSmoke:
 
     @pytest.mark.asyncio
     async def test_builder_with_all_disabled(
-        self, minimal_config, mock_mongo, mock_vector_memory
+        self, minimal_config, mock_mongo, mock_vector_memory, shared_services
     ):
         """Builder with everything disabled should still produce a valid system."""
-        builder = JarvisBuilder(minimal_config)
+        builder = JarvisBuilder(minimal_config).services(shared_services)
         builder.memory(False).nlu(False).calendar(False).chat(False)
         builder.search(False).weather(False).protocols(False)
         builder.lights(False).roku(False).night_agents(False)
@@ -149,10 +149,10 @@ class TestBuilderBuildSmoke:
 
     @pytest.mark.asyncio
     async def test_builder_protocol_runtime_initialized(
-        self, minimal_config, mock_mongo, mock_vector_memory
+        self, minimal_config, mock_mongo, mock_vector_memory, shared_services
     ):
         """_setup_protocol_system must be called and set protocol_runtime."""
-        builder = JarvisBuilder(minimal_config)
+        builder = JarvisBuilder(minimal_config).services(shared_services)
         builder.weather(False).lights(False).roku(False).night_agents(False)
         jarvis = await builder.build()
         try:
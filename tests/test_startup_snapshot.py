@@ -0,0 +1,267 @@
+"""Tests for the digest-validated startup snapshot and its consumers."""
+
+from unittest.mock import MagicMock
+
+import pytest
+
+from jarvis.agents.nlu_agent.fast_classifier import FastPathClassifier
+from jarvis.protocols import Protocol
+from jarvis.protocols.models import ArgumentDefinition, ArgumentType
+from jarvis.protocols.registry import ProtocolRegistry
+from jarvis.protocols.runtime import ProtocolRuntime
+from jarvis.protocols.voice_trigger import VoiceTriggerMatcher
+from jarvis.services.markdown_memory import MarkdownMemoryService
+from jarvis.storage import StartupSnapshot, content_digest
+
+
+def make_protocol(id, name, triggers, arg_defs=None):
+    return Protocol(
+        id=id,
+        name=name,
+        description="",
+        trigger_phrases=triggers,
+        steps=[],
+        argument_definitions=arg_defs or [],
+    )
+
+
+def reopen(path):
+    snap = StartupSnapshot(path)
+    snap.load()
+    return snap
+
+
+class TestStartupSnapshot:
+    def test_round_trip_requires_matching_digest(self, tmp_path):
+        path = tmp_path / "snap.bin"
+        snap = StartupSnapshot(path)
+        assert snap.load() is False
+        snap.put("section", "d1", {"a": [1, 2]})
+        assert snap.save() is True
+        assert snap.save() is False  # nothing changed
+
+        warm = reopen(path)
+        assert warm.loaded
+        assert warm.get("section", "d1") == {"a": [1, 2]}
+        assert warm.get("section", "d2") is None
+        report = warm.report()
+        assert report["hits"] == ["section"] and report["misses"] == ["section"]
+        assert report["warm"] is False
+
+    def test_get_returns_fresh_objects(self, tmp_path):
+        snap = StartupSnapshot(tmp_path / "snap.bin")
+        data = {"items": [1]}
+        snap.put("section", "d", data)
+        data["items"].append(2)  # later mutation is not captured
+        first = snap.get("section", "d")
+        first["items"].append(3)
+        assert snap.get("section", "d") == {"items": [1]}
+
+    def test_corrupt_or_foreign_file_is_ignored(self, tmp_path):
+        path = tmp_path / "snap.bin"
+        path.write_bytes(b"not a snapshot")
+        assert reopen(path).loaded is False
+        path.write_bytes(b"JSNAP\x00\x01garbage")
+        assert reopen(path).loaded is False
+
+    def test_content_digest_is_order_and_boundary_sensitive(self):
+        assert content_digest("ab", "c") != content_digest("a", "bc")
+        assert content_digest(b"x", "y") == content_digest(b"x", "y")
+
+
+class TestProtocolSnapshot:
+    @pytest.fixture
+    def db(self, tmp_path):
+        path = tmp_path / "protocols.db"
+        registry = ProtocolRegistry(db_path=str(path))
+        registry.register(make_protocol("1", "Lights Off", ["turn off lights"]))
+        registry.register(
+            make_protocol(
+                "2",
+                "Dim",
+                ["dim to {level}"],
+                [ArgumentDefinition(name="level", type=ArgumentType.RANGE, min_val=0, max_val=100)],
+            )
+        )
+        registry.close()
+        return str(path)
+
+    def test_registry_reuses_parsed_protocols(self, tmp_path, db):
+        path = tmp_path / "snap.bin"
+        cold = StartupSnapshot(path)
+        ProtocolRegistry(db_path=db, snapshot=cold).close()
+        assert cold.report()["misses"] == ["protocol_registry"]
+        cold.save()
+
+        warm = reopen(path)
+        registry = ProtocolRegistry(db_path=db, snapshot=warm)
+        assert warm.report()["hits"] == ["protocol_registry"]
+        assert set(registry.protocols) == {"1", "2"}
+        assert registry.get("2").argument_definitions[0].max_val == 100
+
+        # A change to the table is a miss on the next load
+        registry.register(make_protocol("3", "Lights On", ["turn on lights"]))
+        registry.close()
+        stale = StartupSnapshot(path)
+        stale.load()
+        registry = ProtocolRegistry(db_path=db, snapshot=stale)
+        assert "3" in registry.protocols
+        assert stale.report()["misses"] == ["protocol_registry"]
+        registry.close()
+
+    def test_model_change_invalidates_pickled_protocols(self, tmp_path, db, monkeypatch):
+        import dataclasses
+        from jarvis.protocols import registry as registry_module
+        from jarvis.storage import schema_fingerprint
+
+        path = tmp_path / "snap.bin"
+
+        def protocol_model(with_stages):
+            @dataclasses.dataclass
+            class Protocol:
+                id: str
+                if with_stages:
+                    stages: list = dataclasses.field(default_factory=list)
+
+            return Protocol
+
+        # Same rows, but the snapshot was written by a build before a
+        # field was added to the model
+        old = schema_fingerprint(protocol_model(False))
+        assert old != schema_fingerprint(protocol_model(True))
+        monkeypatch.setattr(registry_module, "SCHEMA_FINGERPRINT", old)
+        cold = reopen(path)
+        ProtocolRegistry(db_path=db, snapshot=cold).close()
+        cold.save()
+        monkeypatch.undo()
+
+        upgraded = reopen(path)
+        registry = ProtocolRegistry(db_path=db, snapshot=upgraded)
+        assert upgraded.report()["misses"] == ["protocol_registry"]
+        assert registry.get("1").stages == []
+        registry.close()
+
+    def test_refresh_after_register(self, tmp_path, db):
+        snap = StartupSnapshot(tmp_path / "snap.bin")
+        registry = ProtocolRegistry(db_path=db, snapshot=snap)
+        registry.register(make_protocol("3", "Lights On", ["turn on lights"]))
+        assert snap.get("protocol_registry", registry.digest) is None
+        registry.refresh_snapshot()
+        assert "3" in snap.get("protocol_registry", registry.digest)
+        registry.close()
+
+    def test_matcher_state_round_trip(self):
+        protocols = {
+            "1": make_protocol("1", "Lights Off", ["Turn Off Lights"]),
+            "2": make_protocol(
+                "2",
+                "Dim",
+                ["dim to {level}"],
+                [ArgumentDefinition(name="level", type=ArgumentType.RANGE, min_val=0, max_val=100)],
+            ),
+        }
+        built = VoiceTriggerMatcher(protocols)
+        restored = VoiceTriggerMatcher.from_state(protocols, built.export_state())
+        for command in ("turn off lights", "dim to 40", "dim to 400", "nothing"):
+            a, b = built.match_command(command), restored.match_command(command)
+            assert (a and a["arguments"], a and a["protocol"].id) == (
+                b and b["arguments"],
+                b and b["protocol"].id,
+            )
+        assert restored.get_all_triggers() == built.get_all_triggers()
+
+    def test_runtime_skips_unchanged_definitions(self, tmp_path, monkeypatch):
+        monkeypatch.setenv("PROTOCOLS_DB_PATH", str(tmp_path / "protocols.db"))
+        defs = tmp_path / "defs"
+        defs.mkdir()
+        (defs / "hello.json").write_text(
+            '{"id": "h", "name": "hello", "trigger_phrases": ["hello there"], "steps": []}'
+        )
+        path = tmp_path / "snap.bin"
+
+        def boot():
+            snap = reopen(path)
+            runtime = ProtocolRuntime(MagicMock(), MagicMock(), snapshot=snap)
+            runtime.loader.load_directory = MagicMock(wraps=runtime.loader.load_directory)
+            runtime.initialize(True, defs)
+            assert runtime.try_match("hello there")["protocol"].name == "hello"
+            runtime.registry.close()
+            snap.save()
+            return runtime.loader.load_directory.call_count, snap.report()
+
+        assert boot()[0] == 1
+        loads, report = boot()
+        assert loads == 0
+        assert report["warm"] is True
+
+        (defs / "hello.json").write_text(
+            '{"id": "h", "name": "hello", "trigger_phrases": ["hello again"], "steps": []}'
+        )
+        snap = reopen(path)
+        runtime = ProtocolRuntime(MagicMock(), MagicMock(), snapshot=snap)
+        runtime.initialize(True, defs)
+        assert runtime.try_match("hello again") is not None
+        runtime.registry.close()
+
+
+class TestVaultIndexSnapshot:
+    def test_index_parse_skipped_when_files_unchanged(self, tmp_path, monkeypatch):
+        vault = tmp_path / "vault"
+        path = tmp_path / "snap.bin"
+        MarkdownMemoryService(vault_dir=str(vault))
+        (vault / "indexes" / "topic_index.md").write_text(
+            "# Topic Index\n\n- **coffee**: a.md#m1, b.md#m2\n"
+        )
+
+        cold = StartupSnapshot(path)
+        svc = MarkdownMemoryService(vault_dir=str(vault), snapshot=cold)
+        assert svc._index.topic_map["coffee"] == [("a.md", "m1"), ("b.md", "m2")]
+        cold.save()
+
+        parse = MagicMock()
+        monkeypatch.setattr(MarkdownMemoryService, "_parse_index_file", parse)
+        warm = reopen(path)
+        svc = MarkdownMemoryService(vault_dir=str(vault), snapshot=warm)
+        parse.assert_not_called()
+        assert svc._index.topic_map["coffee"] == [("a.md", "m1"), ("b.md", "m2")]
+        assert svc._index.topic_map["missing"] == []  # still a defaultdict
+
+        (vault / "indexes" / "topic_index.md").write_text("# Topic Index\n\n- **tea**: c.md#m3\n")
+        MarkdownMemoryService(vault_dir=str(vault), snapshot=reopen(path))
+        assert parse.called
+
+
+class TestFastClassifierSnapshot:
+    def _classifier(self, snapshot, count=5):
+        collection = MagicMock()
+        collection.count.return_value = count
+        collection.get.return_value = {"ids": ["a", "b"]}
+        vector = MagicMock()
+        vector.persist_directory = "/tmp/chroma"
+        vector.client.get_or_create_collection.return_value = collection
+        return FastPathClassifier(vector, snapshot=snapshot), collection
+
+    @pytest.mark.asyncio
+    async def test_verified_seeds_skip_seed_query(self, tmp_path):
+        phrases = {"cap": ["one", "two"]}
+        path = tmp_path / "snap.bin"
+        cold = StartupSnapshot(path)
+        clf, collection = self._classifier(cold)
+        await clf.initialize(phrases)
+        assert clf._initialized and collection.get.called
+        cold.save()
+
+        clf, collection = self._classifier(reopen(path))
+        await clf.initialize(phrases)
+        assert clf._initialized
+        collection.get.assert_not_called()
+
+        # Collection lost documents behind our back: verify again
+        clf, collection = self._classifier(reopen(path), count=1)
+        await clf.initialize(phrases)
+        assert collection.get.called
+
+        # Different seed set: verify again
+        clf, collection = self._classifier(reopen(path))
+        await clf.initialize({"cap": ["one", "three"]})
+        assert collection.get.called
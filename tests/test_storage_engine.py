@@ -0,0 +1,171 @@
+"""Tests for the shared single-writer SQLite StorageEngine."""
+
+import asyncio
+import sqlite3
+import threading
+
+import pytest
+
+from jarvis.storage import StorageEngine
+
+
+@pytest.fixture
+def engine(tmp_path):
+    db = StorageEngine.open(tmp_path / "engine.db")
+    db.write("CREATE TABLE kv (k TEXT PRIMARY KEY, v INTEGER)")
+    yield db
+    db.release()
+
+
+class TestRegistry:
+    def test_open_returns_shared_instance(self, tmp_path):
+        path = tmp_path / "shared.db"
+        a = StorageEngine.open(path)
+        b = StorageEngine.open(str(path))
+        try:
+            assert a is b
+        finally:
+            b.release()
+        # Still usable while a reference is held
+        a.write("CREATE TABLE t (x INTEGER)")
+        a.release()
+        with pytest.raises(RuntimeError):
+            a.write("INSERT INTO t VALUES (1)")
+
+    def test_reopen_after_last_release(self, tmp_path):
+        path = tmp_path / "reopen.db"
+        a = StorageEngine.open(path)
+        a.write("CREATE TABLE t (x INTEGER)")
+        a.release()
+        b = StorageEngine.open(path)
+        try:
+            assert b is not a
+            b.write("INSERT INTO t VALUES (1)")
+            assert b.fetchone("SELECT COUNT(*) FROM t")[0] == 1
+        finally:
+            b.release()
+
+    def test_release_from_another_thread_during_open(self, tmp_path, monkeypatch):
+        # A finalizer running on the new writer thread may release an
+        # unrelated engine while open() is still constructing.
+        other = StorageEngine.open(tmp_path / "other.db")
+        original_init = StorageEngine.__init__
+
+        def init(self, *args, **kwargs):
+            releaser = threading.Thread(target=other.release)
+            releaser.start()
+            releaser.join(timeout=5)
+            assert not releaser.is_alive()
+            original_init(self, *args, **kwargs)
+
+        monkeypatch.setattr(StorageEngine, "__init__", init)
+        db = StorageEngine.open(tmp_path / "new.db")
+        db.release()
+
+    def test_connections_use_wal(self, engine):
+        assert engine.fetchone("PRAGMA journal_mode")[0] == "wal"
+
+
+class TestGroupCommit:
+    def test_concurrent_writes_share_commits(self, engine):
+        start = engine.get_stats()["commits"]
+        barrier = threading.Barrier(16)
+
+        def worker(n):
+            barrier.wait()
+            for i in range(25):
+                engine.write("INSERT INTO kv VALUES (?, ?)", (f"{n}-{i}", i))
+
+        threads = [threading.Thread(target=worker, args=(n,)) for n in range(16)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        stats = engine.get_stats()
+        assert engine.fetchone("SELECT COUNT(*) FROM kv")[0] == 400
+        assert stats["commits"] - start < 400
+        assert stats["max_group_size"] > 1
+
+    def test_failing_write_does_not_affect_group(self, engine):
+        futures = [
+            engine.submit(lambda c: c.execute("INSERT INTO kv VALUES ('a', 1)")),
+            engine.submit(lambda c: c.execute("INSERT INTO kv VALUES ('a', 2)")),
+            engine.submit(lambda c: c.execute("INSERT INTO kv VALUES ('b', 3)")),
+        ]
+        futures[0].result()
+        with pytest.raises(sqlite3.IntegrityError):
+            futures[1].result()
+        futures[2].result()
+        rows = engine.fetchall("SELECT k, v FROM kv ORDER BY k")
+        assert [tuple(r) for r in rows] == [("a", 1), ("b", 3)]
+
+    def test_write_result(self, engine):
+        res = engine.write("INSERT INTO kv VALUES ('x', 1)")
+        assert res.rowcount == 1
+        assert res.lastrowid
+        res = engine.write_many("INSERT INTO kv VALUES (?, ?)", [("y", 2), ("z", 3)])
+        assert res.rowcount == 2
+
+
+class TestTransaction:
+    def test_commit_and_read_your_writes(self, engine):
+        with engine.transaction() as conn:
+            conn.execute("INSERT INTO kv VALUES ('a', 1)")
+            engine.write("UPDATE kv SET v = v + 1 WHERE k = 'a'")
+            assert engine.fetchone("SELECT v FROM kv WHERE k = 'a'")[0] == 2
+        assert engine.fetchone("SELECT v FROM kv WHERE k = 'a'")[0] == 2
+
+    def test_rollback_on_error(self, engine):
+        with pytest.raises(ValueError):
+            with engine.transaction() as conn:
+                conn.execute("INSERT INTO kv VALUES ('a', 1)")
+                raise ValueError("boom")
+        assert engine.fetchone("SELECT COUNT(*) FROM kv")[0] == 0
+        # Writer keeps serving after the rollback
+        engine.write("INSERT INTO kv VALUES ('b', 1)")
+        assert engine.fetchone("SELECT COUNT(*) FROM kv")[0] == 1
+
+    def test_nested_blocks_join_outer(self, engine):
+        with pytest.raises(ValueError):
+            with engine.transaction() as outer:
+                with engine.transaction() as inner:
+                    assert inner is outer
+                    inner.execute("INSERT INTO kv VALUES ('a', 1)")
+                raise ValueError("boom")
+        assert engine.fetchone("SELECT COUNT(*) FROM kv")[0] == 0
+
+
+class TestAsyncAPI:
+    @pytest.mark.asyncio
+    async def test_awrite_does_not_block_loop(self, engine):
+        before = engine.get_stats()["loop_blocking_calls"]
+        results = await asyncio.gather(
+            *(engine.awrite("INSERT INTO kv VALUES (?, ?)", (str(i), i)) for i in range(50))
+        )
+        assert all(r.rowcount == 1 for r in results)
+        rows = await engine.afetchall("SELECT k FROM kv")
+        assert len(rows) == 50
+        assert engine.get_stats()["loop_blocking_calls"] == before
+
+    @pytest.mark.asyncio
+    async def test_sync_calls_on_loop_are_counted(self, engine):
+        before = engine.get_stats()["loop_blocking_calls"]
+        engine.write("INSERT INTO kv VALUES ('a', 1)")
+        engine.fetchone("SELECT v FROM kv")
+        assert engine.get_stats()["loop_blocking_calls"] == before + 2
+
+    @pytest.mark.asyncio
+    async def test_logger_does_not_wait_for_commit(self, tmp_path):
+        from jarvis.logging import JarvisLogger
+
+        logger = JarvisLogger(db_path=str(tmp_path / "logs.db"))
+        db = logger._engine()
+        before = db.get_stats()["loop_blocking_calls"]
+        for i in range(20):
+            logger.log("INFO", f"event {i}")
+        assert db.get_stats()["loop_blocking_calls"] == before
+        logger.flush()
+        assert db.fetchone("SELECT COUNT(*) FROM logs")[0] == 20
+        logger.close()
+        logger.close()
@@ -164,3 +164,48 @@ class TestEmptyProject:
 
         tests = mapper.tests_for_files(["jarvis/services/foo.py"])
         assert tests == []
+
+
+class TestAffectedTests:
+    def _project(self, tmp_path: Path) -> Path:
+        root = _setup_project(tmp_path)
+        (root / "jarvis" / "__init__.py").write_text("")
+        (root / "jarvis" / "services" / "__init__.py").write_text("")
+        # foo_service depends on bar_service via a relative import,
+        # chat_agent depends on foo_service via a parent-relative one
+        (root / "jarvis" / "services" / "foo_service.py").write_text(
+            "from .bar_service import BarService\n\nclass FooService:\n    pass\n"
+        )
+        (root / "jarvis" / "agents" / "chat_agent" / "__init__.py").write_text(
+            "from ...services import foo_service\n\nclass ChatAgent:\n    pass\n"
+        )
+        return root
+
+    def test_follows_imports_transitively(self, tmp_path):
+        mapper = TestMapper(str(self._project(tmp_path)))
+        assert mapper.affected_tests(["jarvis/services/bar_service.py"]) == [
+            "tests/test_bar_service.py",
+            "tests/test_chat_agent.py",
+            "tests/test_foo_service.py",
+        ]
+        assert mapper.affected_tests(["jarvis/agents/chat_agent/__init__.py"]) == [
+            "tests/test_chat_agent.py"
+        ]
+
+    def test_from_package_import_submodule_skips_package_init(self, tmp_path):
+        # chat_agent names foo_service explicitly, so the package __init__
+        # (imported only implicitly) does not pull its tests in
+        mapper = TestMapper(str(self._project(tmp_path)))
+        assert mapper.affected_tests(["jarvis/services/__init__.py"]) == []
+
+    def test_changed_tests_and_docs(self, tmp_path):
+        mapper = TestMapper(str(self._project(tmp_path)))
+        assert mapper.affected_tests(["README.md", "tests/test_chat_agent.py"]) == [
+            "tests/test_chat_agent.py"
+        ]
+
+    def test_unmappable_changes_request_full_suite(self, tmp_path):
+        mapper = TestMapper(str(self._project(tmp_path)))
+        assert mapper.affected_tests(["tests/conftest.py"]) is None
+        assert mapper.affected_tests(["pyproject.toml"]) is None
+        assert mapper.affected_tests(["jarvis/services/deleted.py"]) is None
@@ -0,0 +1,158 @@
+"""Tests for duration-balanced sharded pytest runs."""
+
+from __future__ import annotations
+
+import sys
+from types import SimpleNamespace
+
+import pytest
+
+from jarvis.services.test_sharding import (
+    ShardedTestRunner,
+    TestDurationStore,
+    ignored_paths,
+    parse_junit,
+    plan_shards,
+)
+
+JUNIT = """<?xml version="1.0" encoding="utf-8"?>
+<testsuites><testsuite name="pytest">
+<testcase classname="tests.test_a.TestX" name="test_one" file="tests/test_a.py" line="3" time="1.5"/>
+<testcase classname="tests.test_a" name="test_two" file="tests/test_a.py" line="9" time="0.5"/>
+<testcase classname="tests.test_b" name="test_three" time="2.0"/>
+</testsuite></testsuites>
+"""
+
+
+def _project(tmp_path, names, addopts=""):
+    tests = tmp_path / "tests"
+    tests.mkdir()
+    for name in names:
+        (tests / name).write_text("def test_ok():\n    assert True\n")
+    if addopts:
+        (tmp_path / "pyproject.toml").write_text(
+            f'[tool.pytest.ini_options]\naddopts = "{addopts}"\n'
+        )
+    return tmp_path
+
+
+class TestPlanShards:
+    def test_longest_files_spread_across_shards(self):
+        costs = {"a": 8.0, "b": 7.0, "c": 6.0, "d": 5.0}
+        shards = plan_shards(list(costs), costs, 2)
+        totals = sorted(sum(costs[f] for f in shard) for shard in shards)
+        assert totals == [13.0, 13.0]
+
+    def test_unknown_files_take_median_cost(self):
+        shards = plan_shards(["a", "b", "c", "new"], {"a": 3.0, "b": 1.0, "c": 1.0}, 2)
+        assert ["a"] in shards
+
+    def test_never_more_shards_than_files(self):
+        assert plan_shards(["a"], {}, 8) == [["a"]]
+
+
+class TestDurationStoreAndReports:
+    def test_parse_junit_keeps_cases_with_files(self, tmp_path):
+        path = tmp_path / "report.xml"
+        path.write_text(JUNIT)
+        durations = parse_junit(path)
+        assert durations == {
+            "tests.test_a.TestX::test_one": ("tests/test_a.py", 1.5),
+            "tests.test_a::test_two": ("tests/test_a.py", 0.5),
+        }
+        assert parse_junit(tmp_path / "missing.xml") == {}
+
+    def test_costs_are_smoothed_per_file(self, tmp_path):
+        store = TestDurationStore(str(tmp_path / "durations.db"))
+        store.record({"t1": ("tests/test_a.py", 2.0), "t2": ("tests/test_a.py", 1.0)})
+        store.record({"t1": ("tests/test_a.py", 4.0)})
+        assert store.file_costs(["tests/test_a.py", "tests/test_b.py"]) == {
+            "tests/test_a.py": pytest.approx(4.0)
+        }
+        store.close()
+
+    def test_ignored_paths_from_addopts(self, tmp_path):
+        root = _project(tmp_path, [], addopts="-q --ignore=tests/e2e/ --ignore tests/test_io.py")
+        assert ignored_paths(root) == ["tests/e2e", "tests/test_io.py"]
+        assert ignored_paths(tmp_path / "nowhere") == []
+
+
+class TestShardedTestRunner:
+    @pytest.mark.asyncio
+    async def test_shards_run_concurrently_and_record_durations(self, tmp_path):
+        root = _project(
+            tmp_path,
+            ["test_a.py", "test_b.py", "test_c.py", "test_io.py"],
+            addopts="--ignore=tests/test_io.py",
+        )
+        calls = []
+
+        async def fake_run(cmd, cwd=None, timeout=None):
+            calls.append(cmd)
+            report = next(a.split("=", 1)[1] for a in cmd if a.startswith("--junitxml="))
+            files = [a for a in cmd if a.startswith("tests/")]
+            cases = "".join(
+                f'<testcase classname="{f}" name="t" file="{f}" time="1.0"/>' for f in files
+            )
+            with open(report, "w") as fh:
+                fh.write(f"<testsuite>{cases}</testsuite>")
+            return SimpleNamespace(exit_code=0, stdout=f"{len(files)} passed", stderr="")
+
+        store = TestDurationStore(str(tmp_path / "durations.db"))
+        runner = ShardedTestRunner(store, max_shards=2, run_subprocess=fake_run)
+        run = await runner.run(str(root), ["pytest", "-q"], timeout=10)
+
+        assert run.success
+        assert len(calls) == 2
+        assert sorted(f for shard in run.shards for f in shard) == [
+            "tests/test_a.py", "tests/test_b.py", "tests/test_c.py"
+        ]
+        assert run.tests_recorded == 3
+        assert "=== shard 1/2 ===" in run.stdout
+        store.close()
+
+    @pytest.mark.asyncio
+    async def test_any_failing_shard_fails_the_run(self, tmp_path):
+        root = _project(tmp_path, ["test_a.py", "test_b.py"])
+
+        async def fake_run(cmd, cwd=None, timeout=None):
+            code = 1 if "tests/test_b.py" in cmd else 5
+            return SimpleNamespace(exit_code=code, stdout="", stderr="boom" if code == 1 else "")
+
+        runner = ShardedTestRunner(
+            TestDurationStore(str(tmp_path / "d.db")), max_shards=2, run_subprocess=fake_run
+        )
+        run = await runner.run(str(root), ["pytest"], ["tests/test_a.py", "tests/test_b.py"])
+        assert not run.success
+        assert run.exit_code == 1
+        assert "boom" in run.stderr
+
+    @pytest.mark.asyncio
+    async def test_single_core_full_suite_is_one_plain_run(self, tmp_path):
+        root = _project(tmp_path, ["test_a.py", "test_b.py"])
+        calls = []
+
+        async def fake_run(cmd, cwd=None, timeout=None):
+            calls.append(cmd)
+            return SimpleNamespace(exit_code=0, stdout="2 passed", stderr="")
+
+        run = await ShardedTestRunner(max_shards=1, run_subprocess=fake_run).run(
+            str(root), ["pytest", "-x"]
+        )
+        assert run.success and run.stdout == "2 passed"
+        assert not any(a.startswith("tests/") for a in calls[0])
+
+    @pytest.mark.asyncio
+    async def test_real_pytest_run(self, tmp_path):
+        root = _project(tmp_path, ["test_a.py", "test_b.py"])
+        store = TestDurationStore(str(tmp_path / "durations.db"))
+        runner = ShardedTestRunner(store, max_shards=2)
+        run = await runner.run(
+            str(root), [sys.executable, "-m", "pytest", "-q", "-p", "no:cacheprovider"], timeout=120
+        )
+        assert run.success, run.stdout + run.stderr
+        assert run.tests_recorded == 2
+        assert set(store.file_costs(["tests/test_a.py", "tests/test_b.py"])) == {
+            "tests/test_a.py", "tests/test_b.py"
+        }
+        store.close()
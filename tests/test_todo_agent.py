@@ -127,6 +127,15 @@ class TestTodoServiceCRUD:
         svc = _make_service(str(tmp_path))
         assert svc.update("nope", title="x") is None
 
+    def test_double_close_keeps_shared_engine_open(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        other = _make_service(str(tmp_path))
+        svc.close()
+        svc.close()
+        # The second close must not drop the reference ``other`` holds
+        assert other.create(title="Still writable").title == "Still writable"
+        other.close()
+
     def test_update_ignores_unknown_fields(self, tmp_path):
         svc = _make_service(str(tmp_path))
         item = svc.create(title="Task")
@@ -208,6 +217,50 @@ class TestTodoItemSerialization:
         assert items == []
 
 
+class TestTodoServiceStorage:
+    """WAL, indexes, batched writes and the DB-thread async API."""
+
+    def test_wal_mode_enabled(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        row = svc._db.fetchone("PRAGMA journal_mode")
+        assert row[0] == "wal"
+
+    def test_counts_by_status_uses_covering_index(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        plan = svc._db.fetchall(
+            "EXPLAIN QUERY PLAN SELECT status, COUNT(*) as cnt FROM todos GROUP BY status"
+        )
+        assert any("COVERING INDEX" in row["detail"] for row in plan)
+
+    def test_create_many_commits_once(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        commits_before = svc.get_db_stats()["commits"]
+        items = svc.create_many([{"title": "A"}, {"title": "B", "priority": "high"}])
+        assert [i.title for i in items] == ["A", "B"]
+        assert svc.get_db_stats()["commits"] == commits_before + 1
+        assert len(svc.list()) == 2
+
+    def test_batch_rolls_back_on_error(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        with pytest.raises(RuntimeError):
+            with svc.batch():
+                svc.create(title="Never committed")
+                raise RuntimeError("boom")
+        assert svc.list() == []
+
+    @pytest.mark.asyncio
+    async def test_run_keeps_queries_off_the_event_loop(self, tmp_path):
+        svc = _make_service(str(tmp_path))
+        svc.list()  # on the loop thread: counted as blocking
+        blocking = svc.get_db_stats()["loop_blocking_calls"]
+        assert blocking >= 1
+
+        item = await svc.run(svc.create, title="Async")
+        assert await svc.run(svc.get, item.id) is not None
+        assert svc.get_db_stats()["loop_blocking_calls"] == blocking
+        svc.close()
+
+
 # =====================================================================
 # TodoAgent tests
 # =====================================================================
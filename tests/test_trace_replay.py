@@ -0,0 +1,119 @@
+"""Tests for replaying recorded traces against the current NLU path."""
+
+import json
+from datetime import UTC, datetime
+from types import SimpleNamespace
+
+import pytest
+
+from jarvis.logging import tracer as tracer_module
+from jarvis.logging.trace_replay import (
+    RecordedAIClient,
+    ReplayCase,
+    build_corpus,
+    load_corpus,
+    replay_corpus,
+    save_corpus,
+)
+from jarvis.logging.trace_store import TraceStore
+from jarvis.logging.tracer import Span, Trace, _llm_output
+
+
+@pytest.fixture
+def trace_db(tmp_path):
+    store = TraceStore(db_path=str(tmp_path / "traces.db"))
+    yield store
+    store.close()
+
+
+def _record(store, trace_id, user_input, classification, llm_content=None):
+    now = datetime.now(UTC).isoformat()
+    store.save_trace(Trace(trace_id=trace_id, user_input=user_input, start_time=now))
+    spans = [
+        Span(f"{trace_id}-route", trace_id, None, "orchestrator.nlu_route", start_time=now, duration_ms=900.0),
+        Span(f"{trace_id}-classify", trace_id, f"{trace_id}-route", "nlu.classify", start_time=now,
+             duration_ms=400.0, output_data=json.dumps(classification)),
+        Span(f"{trace_id}-llm", trace_id, f"{trace_id}-classify", "llm.chat", kind="llm", start_time=now,
+             duration_ms=380.0,
+             output_data=json.dumps({"content": llm_content}) if llm_content else json.dumps({"type": "tuple"})),
+    ]
+    for span in spans:
+        store.save_span(span)
+
+
+class TestCorpus:
+    def test_case_from_trace(self, trace_db, tmp_path):
+        _record(trace_db, "t1", "turn the lights red", {"dag": {"lights_color": []}})
+        trace_db.save_trace(Trace(trace_id="no-nlu", user_input="goodnight"))
+
+        cases = build_corpus(trace_db)
+        assert [c.trace_id for c in cases] == ["t1"]
+        case = cases[0]
+        assert case.routing == ["lights_color"]
+        # Without traced LLM content the classification answers the NLU call
+        assert json.loads(case.llm_calls[0]["content"]) == {"dag": {"lights_color": []}}
+        assert case.llm_calls[0]["duration_ms"] == 380.0
+        assert case.downstream_ms == 500.0
+
+        path = tmp_path / "corpus.jsonl"
+        save_corpus(path, cases)
+        assert load_corpus(path) == cases
+
+    def test_traced_llm_content_is_used(self, trace_db):
+        content = '{"dag": {"search": []}}'
+        _record(trace_db, "t2", "search cats", {"dag": {"search": []}}, llm_content=content)
+        assert build_corpus(trace_db)[0].llm_calls[0]["content"] == content
+
+
+class TestRecordedAIClient:
+    @pytest.mark.asyncio
+    async def test_serves_calls_in_order_then_empty(self):
+        client = RecordedAIClient([{"content": "a"}, {"content": "b"}], replay_latency=False)
+        assert (await client.weak_chat([]))[0].content == "a"
+        assert (await client.strong_chat([]))[0].content == "b"
+        assert (await client.weak_chat([]))[0].content == ""
+
+
+def test_llm_output_captures_reply_and_tool_calls():
+    call = SimpleNamespace(id="c1", function=SimpleNamespace(name="get_weather", arguments='{"city":"x"}'))
+    message = SimpleNamespace(content="hi", tool_calls=[call])
+    assert _llm_output((message, [call])) == {
+        "content": "hi",
+        "tool_calls": [{"id": "c1", "name": "get_weather", "arguments": '{"city":"x"}'}],
+    }
+
+
+class TestReplay:
+    @pytest.mark.asyncio
+    async def test_replay_reports_stages_and_routing_changes(self):
+        same = ReplayCase(
+            trace_id="same",
+            user_input="turn the lights red",
+            classification={"dag": {"lights_color": []}},
+            llm_calls=[{"content": '{"dag": {"lights_color": []}}', "duration_ms": 5.0}],
+            downstream_ms=5.0,
+            stage_ms={"nlu.classify": 400.0, "orchestrator.nlu_route": 900.0},
+        )
+        # The recorded model answer no longer maps to the recorded routing
+        changed = ReplayCase(
+            trace_id="changed",
+            user_input="play jazz",
+            classification={"dag": {"music_play": []}},
+            llm_calls=[{"content": "not json", "duration_ms": 5.0}],
+            stage_ms={"nlu.classify": 300.0},
+        )
+        previous = tracer_module.get_tracer()
+
+        report = await replay_corpus([same, changed], llm_latency=False, timeout=5.0)
+
+        assert tracer_module.get_tracer() is previous
+        assert [r.error for r in report.results] == [None, None]
+        assert [r.trace_id for r in report.routing_changes()] == ["changed"]
+        assert report.routing_changes()[0].routing_after == ["chat"]
+        deltas = {d.name: d for d in report.stage_deltas()}
+        assert deltas["nlu.classify"].samples == 2
+        assert deltas["nlu.classify"].delta_ms < 0  # no real LLM wait
+        assert report.regressions(max_pct=20.0) == []
+        summary = report.to_dict()
+        assert summary["cases"] == 2
+        assert summary["routing_changes"][0]["before"] == ["music_play"]
@@ -315,7 +315,7 @@ class TestTracer:
         tracer.end_trace()
 
         spans = trace_db.get_spans("t-output")
-        assert '"result": 42' in spans[0]["output_data"]
+        assert json.loads(spans[0]["output_data"]) == {"result": 42}
 
     @pytest.mark.asyncio
     async def test_span_record_error_manual(self, tracer, trace_db):
@@ -399,6 +399,27 @@ class TestTracer:
             s.record_output({"x": 1})
             s.record_error("ignored")
 
+    def test_record_span_saves_finished_span(self, tracer, trace_db):
+        from datetime import UTC, datetime
+
+        tracer.start_trace(trace_id="t-recorded")
+        tracer.record_span(
+            "nlu.dag",
+            trace_id="t-recorded",
+            parent_span_id="parent-1",
+            start_time=datetime.now(UTC),
+            duration_ms=12.345,
+            kind=SpanKind.AGENT,
+            attributes={"critical_path": ["a", "b"]},
+        )
+        spans = trace_db.get_spans("t-recorded")
+        assert len(spans) == 1
+        assert spans[0]["parent_span_id"] == "parent-1"
+        assert spans[0]["duration_ms"] == 12.35
+        assert json.loads(spans[0]["attributes"]) == {"critical_path": ["a", "b"]}
+        # Without a trace there is nothing to attach the span to
+        tracer.record_span("orphan", None, None, datetime.now(UTC), 1.0)
+
 
 # ------------------------------------------------------------------
 # Disabled tracer
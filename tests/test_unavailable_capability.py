@@ -31,8 +31,10 @@ class DummyNLU(NetworkAgent):
 
 
 @pytest.mark.asyncio
-async def test_missing_capability_returns_error():
-    jarvis = JarvisSystem(JarvisConfig(intent_timeout=0.1, response_timeout=1.0))
+async def test_missing_capability_returns_error(shared_services):
+    jarvis = JarvisSystem(
+        JarvisConfig(intent_timeout=0.1, response_timeout=1.0), services=shared_services
+    )
     nlu = DummyNLU()
     jarvis.network.register_agent(nlu)
 
@@ -4,15 +4,16 @@ import pytest
 from httpx import ASGITransport
 
 import server
+from jarvis.utils.serialization import Payload
 from tests import disable_lifespan
 
 class DummyJarvis:
     def __init__(self):
         self.last_allowed = None
         self._orchestrator = None
-    async def process_request(self, command, tz, metadata, allowed_agents=None):
+    async def respond(self, command, tz, metadata, allowed_agents=None):
         self.last_allowed = allowed_agents
-        return {"response": "done"}
+        return Payload({"response": "done"})
     def list_agents(self):
         return {"A": {}, "B": {}}
 
@@ -4,6 +4,7 @@ import pytest
 from httpx import ASGITransport
 
 import server
+from jarvis.utils.serialization import Payload
 from tests import disable_lifespan
 
 
@@ -12,9 +13,9 @@ class DummyJarvis:
         self.last_metadata = None
         self._orchestrator = None
 
-    async def process_request(self, command, tz, metadata, allowed_agents=None):
+    async def respond(self, command, tz, metadata, allowed_agents=None):
         self.last_metadata = metadata
-        return {"response": "ok"}
+        return Payload({"response": "ok"})
 
     def list_agents(self):
         return {"A": {}}